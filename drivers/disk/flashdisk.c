@@ -17,10 +17,29 @@
 #define SECTOR_SIZE CONFIG_DISK_FLASH_SECTOR_SIZE
 
 static const struct device *flash_dev;
+static uint8_t erase_value;
 
+#if defined(CONFIG_DISK_FLASH_CACHE)
+/* Erase blocks cached for write-back, evicted in least recently written
+ * order.
+ */
+struct flash_cache_block {
+	off_t addr;
+	uint32_t stamp;
+	bool valid;
+	bool dirty;
+	/* The flash block is erased and can be programmed without erase */
+	bool erased;
+	uint8_t __aligned(4) data[CONFIG_DISK_ERASE_BLOCK_SIZE];
+};
+
+static struct flash_cache_block cache[CONFIG_DISK_FLASH_CACHE_BLOCKS];
+static uint32_t cache_stamp;
+#else
 /* flash read-copy-erase-write operation */
 static uint8_t __aligned(4) read_copy_buf[CONFIG_DISK_ERASE_BLOCK_SIZE];
 static uint8_t *fs_buff = read_copy_buf;
+#endif
 
 /* calculate number of blocks required for a given size */
 #define GET_NUM_BLOCK(total_size, block_size) \
@@ -61,19 +80,16 @@ static int disk_flash_access_init(struct disk_info *disk)
 		return -ENODEV;
 	}
 
+	erase_value = flash_get_parameters(flash_dev)->erase_value;
+
 	return 0;
 }
 
-static int disk_flash_access_read(struct disk_info *disk, uint8_t *buff,
-				uint32_t start_sector, uint32_t sector_count)
+static int read_flash_range(off_t fl_addr, uint8_t *buff, uint32_t remaining)
 {
-	off_t fl_addr;
-	uint32_t remaining;
 	uint32_t len;
 	uint32_t num_read;
 
-	fl_addr = lba_to_address(start_sector);
-	remaining = (sector_count * SECTOR_SIZE);
 	len = CONFIG_DISK_FLASH_MAX_RW_SIZE;
 
 	num_read = GET_NUM_BLOCK(remaining, CONFIG_DISK_FLASH_MAX_RW_SIZE);
@@ -95,27 +111,52 @@ static int disk_flash_access_read(struct disk_info *disk, uint8_t *buff,
 	return 0;
 }
 
-/* This performs read-copy into an output buffer */
-static int read_copy_flash_block(off_t start_addr, uint32_t size,
-				 const void *src_buff,
-				 uint8_t *dest_buff)
+static bool buf_is_erased(const uint8_t *buff, uint32_t size)
 {
-	off_t fl_addr;
-	uint32_t num_read;
-	uint32_t offset = 0U;
+	for (uint32_t i = 0; i < size; i++) {
+		if (buff[i] != erase_value) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/* check whether an erase-aligned flash block is erased, without a block
+ * sized buffer
+ */
+static int flash_block_is_erased(off_t fl_addr, bool *erased)
+{
+	uint8_t __aligned(4) buff[MIN(64, CONFIG_DISK_FLASH_MAX_RW_SIZE)];
 
-	/* adjust offset if starting address is not erase-aligned address */
-	if (start_addr & (CONFIG_DISK_FLASH_ERASE_ALIGNMENT - 1)) {
-		offset = start_addr & (CONFIG_DISK_FLASH_ERASE_ALIGNMENT - 1);
+	for (uint32_t i = 0; i < CONFIG_DISK_ERASE_BLOCK_SIZE;
+	     i += sizeof(buff)) {
+		uint32_t len = MIN(sizeof(buff),
+				   CONFIG_DISK_ERASE_BLOCK_SIZE - i);
+
+		if (flash_read(flash_dev, fl_addr + i, buff, len) != 0) {
+			return -EIO;
+		}
+
+		if (!buf_is_erased(buff, len)) {
+			*erased = false;
+			return 0;
+		}
 	}
 
-	/* align starting address to an aligned address for flash erase-write */
-	fl_addr = ROUND_DOWN(start_addr, CONFIG_DISK_FLASH_ERASE_ALIGNMENT);
+	*erased = true;
+
+	return 0;
+}
+
+/* read one erase-aligned block from flash */
+static int read_flash_block(off_t fl_addr, uint8_t *dest_buff)
+{
+	uint32_t num_read;
 
 	num_read = GET_NUM_BLOCK(CONFIG_DISK_ERASE_BLOCK_SIZE,
 				 CONFIG_DISK_FLASH_MAX_RW_SIZE);
 
-	/* read one block from flash */
 	for (uint32_t i = 0; i < num_read; i++) {
 		int rc;
 
@@ -128,38 +169,18 @@ static int read_copy_flash_block(off_t start_addr, uint32_t size,
 		}
 	}
 
-	/* overwrite with user data */
-	memcpy(dest_buff + offset, src_buff, size);
-
 	return 0;
 }
 
-/* input size is either less or equal to a block size,
- * CONFIG_DISK_ERASE_BLOCK_SIZE.
+/* erase an erase-aligned flash block, unless it is already erased, and
+ * program it with a block of data
  */
-static int update_flash_block(off_t start_addr, uint32_t size, const void *buff)
+static int program_flash_block(off_t fl_addr, const uint8_t *src, bool erased)
 {
-	off_t fl_addr;
-	uint8_t *src = (uint8_t *)buff;
 	uint32_t num_write;
 
-	/* if size is a partial block, perform read-copy with user data */
-	if (size < CONFIG_DISK_ERASE_BLOCK_SIZE) {
-		int rc;
-
-		rc = read_copy_flash_block(start_addr, size, buff, fs_buff);
-		if (rc != 0) {
-			return -EIO;
-		}
-
-		/* now use the local buffer as the source */
-		src = (uint8_t *)fs_buff;
-	}
-
-	/* always align starting address for flash write operation */
-	fl_addr = ROUND_DOWN(start_addr, CONFIG_DISK_FLASH_ERASE_ALIGNMENT);
-
-	if (flash_erase(flash_dev, fl_addr, CONFIG_DISK_ERASE_BLOCK_SIZE)
+	if (!erased &&
+	    flash_erase(flash_dev, fl_addr, CONFIG_DISK_ERASE_BLOCK_SIZE)
 			!= 0) {
 		return -EIO;
 	}
@@ -181,6 +202,178 @@ static int update_flash_block(off_t start_addr, uint32_t size, const void *buff)
 	return 0;
 }
 
+#if defined(CONFIG_DISK_FLASH_CACHE)
+static int cache_flush_block(struct flash_cache_block *blk)
+{
+	if (!blk->valid || !blk->dirty) {
+		return 0;
+	}
+
+	if (program_flash_block(blk->addr, blk->data, blk->erased) != 0) {
+		return -EIO;
+	}
+
+	blk->dirty = false;
+	blk->erased = buf_is_erased(blk->data, sizeof(blk->data));
+
+	return 0;
+}
+
+static int cache_sync(void)
+{
+	for (int i = 0; i < ARRAY_SIZE(cache); i++) {
+		if (cache_flush_block(&cache[i]) != 0) {
+			return -EIO;
+		}
+	}
+
+	return 0;
+}
+
+static struct flash_cache_block *cache_find(off_t fl_addr)
+{
+	for (int i = 0; i < ARRAY_SIZE(cache); i++) {
+		if (cache[i].valid && cache[i].addr == fl_addr) {
+			return &cache[i];
+		}
+	}
+
+	return NULL;
+}
+
+/* Get the cached block of an erase-aligned address, evicting the least
+ * recently written block if it is not cached. The block is read from flash
+ * unless it is about to be overwritten entirely.
+ */
+static struct flash_cache_block *cache_get(off_t fl_addr, bool load)
+{
+	struct flash_cache_block *blk;
+
+	blk = cache_find(fl_addr);
+	if (!blk) {
+		blk = &cache[0];
+
+		for (int i = 1; i < ARRAY_SIZE(cache) && blk->valid; i++) {
+			if (!cache[i].valid || cache[i].stamp < blk->stamp) {
+				blk = &cache[i];
+			}
+		}
+
+		if (cache_flush_block(blk) != 0) {
+			return NULL;
+		}
+
+		blk->valid = false;
+
+		if (load) {
+			if (read_flash_block(fl_addr, blk->data) != 0) {
+				return NULL;
+			}
+
+			blk->erased = buf_is_erased(blk->data,
+						    sizeof(blk->data));
+		} else if (flash_block_is_erased(fl_addr, &blk->erased) != 0) {
+			return NULL;
+		}
+
+		blk->addr = fl_addr;
+		blk->valid = true;
+	}
+
+	blk->stamp = ++cache_stamp;
+
+	return blk;
+}
+#endif /* CONFIG_DISK_FLASH_CACHE */
+
+static int disk_flash_access_read(struct disk_info *disk, uint8_t *buff,
+				uint32_t start_sector, uint32_t sector_count)
+{
+	off_t fl_addr;
+	uint32_t remaining;
+
+	fl_addr = lba_to_address(start_sector);
+	remaining = (sector_count * SECTOR_SIZE);
+
+#if defined(CONFIG_DISK_FLASH_CACHE)
+	/* read block by block, from the cache if the block is cached */
+	while (remaining) {
+		off_t block_addr = ROUND_DOWN(fl_addr,
+					      CONFIG_DISK_FLASH_ERASE_ALIGNMENT);
+		uint32_t size = MIN(remaining,
+				    GET_SIZE_TO_BOUNDARY(fl_addr,
+					CONFIG_DISK_ERASE_BLOCK_SIZE));
+		struct flash_cache_block *blk = cache_find(block_addr);
+
+		if (blk) {
+			memcpy(buff, blk->data + (fl_addr - block_addr), size);
+		} else if (read_flash_range(fl_addr, buff, size) != 0) {
+			return -EIO;
+		}
+
+		fl_addr += size;
+		buff += size;
+		remaining -= size;
+	}
+
+	return 0;
+#else
+	return read_flash_range(fl_addr, buff, remaining);
+#endif
+}
+
+/* input size is either less or equal to a block size,
+ * CONFIG_DISK_ERASE_BLOCK_SIZE.
+ */
+static int update_flash_block(off_t start_addr, uint32_t size, const void *buff)
+{
+	off_t fl_addr;
+	uint32_t offset;
+
+	/* always align starting address for flash write operation */
+	fl_addr = ROUND_DOWN(start_addr, CONFIG_DISK_FLASH_ERASE_ALIGNMENT);
+	offset = start_addr - fl_addr;
+
+#if defined(CONFIG_DISK_FLASH_CACHE)
+	struct flash_cache_block *blk;
+
+	/* coalesce the write into the cached block, it is written back when
+	 * evicted or on sync
+	 */
+	blk = cache_get(fl_addr, size < CONFIG_DISK_ERASE_BLOCK_SIZE);
+	if (!blk) {
+		return -EIO;
+	}
+
+	memcpy(blk->data + offset, buff, size);
+	blk->dirty = true;
+
+	return 0;
+#else
+	const uint8_t *src = buff;
+	bool erased;
+
+	/* if size is a partial block, perform read-copy with user data */
+	if (size < CONFIG_DISK_ERASE_BLOCK_SIZE) {
+		if (read_flash_block(fl_addr, fs_buff) != 0) {
+			return -EIO;
+		}
+
+		erased = buf_is_erased(fs_buff, CONFIG_DISK_ERASE_BLOCK_SIZE);
+
+		/* overwrite with user data */
+		memcpy(fs_buff + offset, buff, size);
+
+		/* now use the local buffer as the source */
+		src = fs_buff;
+	} else if (flash_block_is_erased(fl_addr, &erased) != 0) {
+		return -EIO;
+	}
+
+	return program_flash_block(fl_addr, src, erased);
+#endif
+}
+
 static int disk_flash_access_write(struct disk_info *disk, const uint8_t *buff,
 				 uint32_t start_sector, uint32_t sector_count)
 {
@@ -254,7 +447,11 @@ static int disk_flash_access_ioctl(struct disk_info *disk, uint8_t cmd, void *bu
 {
 	switch (cmd) {
 	case DISK_IOCTL_CTRL_SYNC:
+#if defined(CONFIG_DISK_FLASH_CACHE)
+		return cache_sync();
+#else
 		return 0;
+#endif
 	case DISK_IOCTL_GET_SECTOR_COUNT:
 		*(uint32_t *)buff = CONFIG_DISK_VOLUME_SIZE / SECTOR_SIZE;
 		return 0;
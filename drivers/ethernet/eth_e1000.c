@@ -38,14 +38,31 @@ LOG_MODULE_REGISTER(LOG_MODULE_NAME);
 #define hexdump(args...)
 #endif
 
+/* Causes polled by e1000_poll(), masked while the poll is pending */
+#define E1000_IRQ_MASK	(IMS_TXDW | IMS_RXDMT0 | IMS_RXO | IMS_RXT0)
+
+#define E1000_TX_TIMEOUT	K_MSEC(100)
+
+BUILD_ASSERT(E1000_TX_DESC_COUNT % 8 == 0,
+	     "TX ring length must be a multiple of 128 bytes");
+BUILD_ASSERT(E1000_RX_DESC_COUNT % 8 == 0,
+	     "RX ring length must be a multiple of 128 bytes");
+BUILD_ASSERT(CONFIG_ETH_E1000_RX_BUF_COUNT > E1000_RX_DESC_COUNT,
+	     "RX buffers must outnumber the RX descriptors");
+
+NET_BUF_POOL_FIXED_DEFINE(e1000_rx_pool, CONFIG_ETH_E1000_RX_BUF_COUNT,
+			  E1000_RX_BUF_SIZE, NULL);
+
 static const char *e1000_reg_to_string(enum e1000_reg_t r)
 {
 #define _(_x)	case _x: return #_x
 	switch (r) {
 	_(CTRL);
 	_(ICR);
+	_(ITR);
 	_(ICS);
 	_(IMS);
+	_(IMC);
 	_(RCTL);
 	_(TCTL);
 	_(RDBAL);
@@ -111,121 +128,235 @@ static const struct device *e1000_get_ptp_clock(const struct device *dev)
 }
 #endif
 
-static int e1000_tx(struct e1000_dev *dev, void *buf, size_t len)
+static uint16_t e1000_tx_free(struct e1000_dev *dev)
 {
-	hexdump(buf, len, "%zu byte(s)", len);
-
-	dev->tx.addr = POINTER_TO_INT(buf);
-	dev->tx.len = len;
-	dev->tx.cmd = TDESC_EOP | TDESC_RS;
+	/* One descriptor is left unused to tell a full ring from an empty one */
+	return (dev->tx_clean + E1000_TX_DESC_COUNT - dev->tx_tail - 1) %
+		E1000_TX_DESC_COUNT;
+}
 
-	iow32(dev, TDT, 1);
+/* Release the packets of the descriptors written back by the device, called
+ * with tx_lock held.
+ */
+static void e1000_tx_reclaim(struct e1000_dev *dev)
+{
+	while (dev->tx_clean != dev->tx_tail) {
+		uint16_t i = dev->tx_clean;
 
-	while (!(dev->tx.sta)) {
-		k_yield();
-	}
+		if (!(dev->tx[i].sta & TDESC_STA_DD)) {
+			break;
+		}
 
-	LOG_DBG("tx.sta: 0x%02hx", dev->tx.sta);
+		if (dev->tx_pkt[i]) {
+			net_pkt_unref(dev->tx_pkt[i]);
+			dev->tx_pkt[i] = NULL;
+		}
 
-	return (dev->tx.sta & TDESC_STA_DD) ? 0 : -EIO;
+		dev->tx_clean = (i + 1) % E1000_TX_DESC_COUNT;
+	}
 }
 
 static int e1000_send(const struct device *ddev, struct net_pkt *pkt)
 {
 	struct e1000_dev *dev = ddev->data;
-	size_t len = net_pkt_get_len(pkt);
+	struct net_buf *frag;
+	uint16_t count = 0U;
+	uint16_t i;
+
+	for (frag = pkt->buffer; frag; frag = frag->frags) {
+		count += (frag->len > 0);
+	}
+
+	if (count == 0U || count >= E1000_TX_DESC_COUNT) {
+		LOG_ERR("Cannot send %u fragment(s)", count);
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&dev->tx_lock, K_FOREVER);
+
+	e1000_tx_reclaim(dev);
+
+	while (e1000_tx_free(dev) < count) {
+		if (k_condvar_wait(&dev->tx_cond, &dev->tx_lock,
+				   E1000_TX_TIMEOUT)) {
+			k_mutex_unlock(&dev->tx_lock);
+			LOG_ERR("TX ring full");
+			return -EIO;
+		}
 
-	if (net_pkt_read(pkt, dev->txb, len)) {
-		return -EIO;
+		e1000_tx_reclaim(dev);
 	}
 
-	return e1000_tx(dev, dev->txb, len);
+	/* The fragments are sent in place, the packet is held until the
+	 * device has written back its last descriptor.
+	 */
+	i = dev->tx_tail;
+
+	for (frag = pkt->buffer; frag; frag = frag->frags) {
+		if (!frag->len) {
+			continue;
+		}
+
+		hexdump(frag->data, frag->len, "%u byte(s)", frag->len);
+
+		i = dev->tx_tail;
+		dev->tx[i].addr = POINTER_TO_INT(frag->data);
+		dev->tx[i].len = frag->len;
+		dev->tx[i].sta = 0;
+		dev->tx[i].cmd = TDESC_RS;
+
+		dev->tx_tail = (i + 1) % E1000_TX_DESC_COUNT;
+	}
+
+	dev->tx[i].cmd |= TDESC_EOP;
+	dev->tx_pkt[i] = net_pkt_ref(pkt);
+
+	iow32(dev, TDT, dev->tx_tail);
+
+	k_mutex_unlock(&dev->tx_lock);
+
+	return 0;
 }
 
-static struct net_pkt *e1000_rx(struct e1000_dev *dev)
+static void e1000_rx_post(struct e1000_dev *dev, uint16_t i,
+			  struct net_buf *buf)
+{
+	dev->rx_buf[i] = buf;
+	dev->rx[i].addr = POINTER_TO_INT(buf->data);
+	dev->rx[i].sta = 0;
+}
+
+/* Pass the buffer of RX descriptor i to a packet and post a new buffer to
+ * the descriptor. If the frame is dropped, the buffer is posted again.
+ */
+static struct net_pkt *e1000_rx(struct e1000_dev *dev, uint16_t i)
 {
+	volatile struct e1000_rx *desc = &dev->rx[i];
 	struct net_pkt *pkt = NULL;
-	void *buf;
+	struct net_buf *buf;
 	ssize_t len;
 
-	LOG_DBG("rx.sta: 0x%02hx", dev->rx.sta);
+	LOG_DBG("rx[%u].sta: 0x%02hx", i, desc->sta);
 
-	if (!(dev->rx.sta & RDESC_STA_DD)) {
-		LOG_ERR("RX descriptor not ready");
+	if (!(desc->sta & RDESC_STA_EOP) || desc->err) {
+		LOG_ERR("Invalid RX descriptor, sta: 0x%02hx err: 0x%02hx",
+			desc->sta, desc->err);
 		goto out;
 	}
 
-	buf = INT_TO_POINTER((uint32_t)dev->rx.addr);
-	len = dev->rx.len - 4;
+	len = desc->len - 4; /* The CRC is not stripped */
 
 	if (len <= 0) {
-		LOG_ERR("Invalid RX descriptor length: %hu", dev->rx.len);
+		LOG_ERR("Invalid RX descriptor length: %hu", desc->len);
 		goto out;
 	}
 
-	hexdump(buf, len, "%zd byte(s)", len);
+	buf = net_buf_alloc(&e1000_rx_pool, K_NO_WAIT);
+	if (!buf) {
+		LOG_ERR("Out of RX buffers");
+		goto out;
+	}
 
-	pkt = net_pkt_rx_alloc_with_buffer(dev->iface, len, AF_UNSPEC, 0,
-					   K_NO_WAIT);
+	pkt = net_pkt_rx_alloc_on_iface(dev->iface, K_NO_WAIT);
 	if (!pkt) {
 		LOG_ERR("Out of buffers");
+		net_buf_unref(buf);
 		goto out;
 	}
 
-	if (net_pkt_write(pkt, buf, len)) {
-		LOG_ERR("Out of memory for received frame");
-		net_pkt_unref(pkt);
-		pkt = NULL;
-	}
+	hexdump(dev->rx_buf[i]->data, len, "%zd byte(s)", len);
+
+	net_buf_add(dev->rx_buf[i], len);
+	net_pkt_append_buffer(pkt, dev->rx_buf[i]);
+
+	e1000_rx_post(dev, i, buf);
 
-out:
 	return pkt;
+
+out:
+	desc->sta = 0;
+
+	return NULL;
 }
 
-static void e1000_isr(const struct device *ddev)
+static void e1000_recv(struct e1000_dev *dev, struct net_pkt *pkt)
 {
-	struct e1000_dev *dev = ddev->data;
-	uint32_t icr = ior32(dev, ICR); /* Cleared upon read */
 	uint16_t vlan_tag = NET_VLAN_TAG_UNSPEC;
 
-	icr &= ~(ICR_TXDW | ICR_TXQE);
-
-	if (icr & ICR_RXO) {
-		struct net_pkt *pkt = e1000_rx(dev);
-
-		icr &= ~ICR_RXO;
+	if (!pkt) {
+		eth_stats_update_errors_rx(get_iface(dev, vlan_tag));
+		return;
+	}
 
-		if (pkt) {
 #if defined(CONFIG_NET_VLAN)
-			struct net_eth_hdr *hdr = NET_ETH_HDR(pkt);
+	struct net_eth_hdr *hdr = NET_ETH_HDR(pkt);
 
-			if (ntohs(hdr->type) == NET_ETH_PTYPE_VLAN) {
-				struct net_eth_vlan_hdr *hdr_vlan =
-					(struct net_eth_vlan_hdr *)
-					NET_ETH_HDR(pkt);
+	if (ntohs(hdr->type) == NET_ETH_PTYPE_VLAN) {
+		struct net_eth_vlan_hdr *hdr_vlan =
+			(struct net_eth_vlan_hdr *)NET_ETH_HDR(pkt);
 
-				net_pkt_set_vlan_tci(
-					pkt, ntohs(hdr_vlan->vlan.tci));
-				vlan_tag = net_pkt_vlan_tag(pkt);
+		net_pkt_set_vlan_tci(pkt, ntohs(hdr_vlan->vlan.tci));
+		vlan_tag = net_pkt_vlan_tag(pkt);
 
 #if CONFIG_NET_TC_RX_COUNT > 1
-				enum net_priority prio;
+		enum net_priority prio;
 
-				prio = net_vlan2priority(
-						net_pkt_vlan_priority(pkt));
-				net_pkt_set_priority(pkt, prio);
+		prio = net_vlan2priority(net_pkt_vlan_priority(pkt));
+		net_pkt_set_priority(pkt, prio);
 #endif
-			}
+	}
 #endif /* CONFIG_NET_VLAN */
 
-			net_recv_data(get_iface(dev, vlan_tag), pkt);
-		} else {
-			eth_stats_update_errors_rx(get_iface(dev, vlan_tag));
-		}
+	if (net_recv_data(get_iface(dev, vlan_tag), pkt) < 0) {
+		net_pkt_unref(pkt);
+	}
+}
+
+/* Bottom half of the interrupt: reclaims the TX ring and receives up to
+ * CONFIG_ETH_E1000_RX_BUDGET frames. The interrupts stay masked while
+ * frames are pending, the poll is resubmitted instead.
+ */
+static void e1000_poll(struct k_work *work)
+{
+	struct e1000_dev *dev = CONTAINER_OF(work, struct e1000_dev,
+					     poll_work);
+	int budget = CONFIG_ETH_E1000_RX_BUDGET;
+
+	k_mutex_lock(&dev->tx_lock, K_FOREVER);
+	e1000_tx_reclaim(dev);
+	k_condvar_broadcast(&dev->tx_cond);
+	k_mutex_unlock(&dev->tx_lock);
+
+	while (budget && (dev->rx[dev->rx_next].sta & RDESC_STA_DD)) {
+		uint16_t i = dev->rx_next;
+
+		e1000_recv(dev, e1000_rx(dev, i));
+
+		dev->rx_next = (i + 1) % E1000_RX_DESC_COUNT;
+		budget--;
 	}
 
-	if (icr) {
-		LOG_ERR("Unhandled interrupt, ICR: 0x%x", icr);
+	if (budget < CONFIG_ETH_E1000_RX_BUDGET) {
+		/* Return the descriptors up to the last one received */
+		iow32(dev, RDT, (dev->rx_next + E1000_RX_DESC_COUNT - 1) %
+		      E1000_RX_DESC_COUNT);
+	}
+
+	if (!budget) {
+		k_work_submit(&dev->poll_work);
+	} else {
+		iow32(dev, IMS, E1000_IRQ_MASK);
+	}
+}
+
+static void e1000_isr(const struct device *ddev)
+{
+	struct e1000_dev *dev = ddev->data;
+	uint32_t icr = ior32(dev, ICR); /* Cleared upon read */
+
+	if (icr & E1000_IRQ_MASK) {
+		iow32(dev, IMC, E1000_IRQ_MASK);
+		k_work_submit(&dev->poll_work);
 	}
 }
 
@@ -251,30 +382,44 @@ int e1000_probe(const struct device *ddev)
 	device_map(&dev->address, mbar.phys_addr, mbar.size,
 		   K_MEM_CACHE_NONE);
 
-	/* Setup TX descriptor */
+	k_mutex_init(&dev->tx_lock);
+	k_condvar_init(&dev->tx_cond);
+	k_work_init(&dev->poll_work, e1000_poll);
+
+	/* Setup TX descriptor ring */
 
 	iow32(dev, TDBAL, (uint32_t) &dev->tx);
 	iow32(dev, TDBAH, 0);
-	iow32(dev, TDLEN, 1*16);
+	iow32(dev, TDLEN, sizeof(dev->tx));
 
 	iow32(dev, TDH, 0);
 	iow32(dev, TDT, 0);
 
 	iow32(dev, TCTL, TCTL_EN);
 
-	/* Setup RX descriptor */
+	/* Setup RX descriptor ring, all descriptors but the tail one are
+	 * given to the device.
+	 */
+
+	for (int i = 0; i < E1000_RX_DESC_COUNT; i++) {
+		struct net_buf *buf = net_buf_alloc(&e1000_rx_pool, K_NO_WAIT);
 
-	dev->rx.addr = POINTER_TO_INT(dev->rxb);
-	dev->rx.len = sizeof(dev->rxb);
+		if (!buf) {
+			return -ENOMEM;
+		}
+
+		e1000_rx_post(dev, i, buf);
+	}
 
 	iow32(dev, RDBAL, (uint32_t) &dev->rx);
 	iow32(dev, RDBAH, 0);
-	iow32(dev, RDLEN, 1*16);
+	iow32(dev, RDLEN, sizeof(dev->rx));
 
 	iow32(dev, RDH, 0);
-	iow32(dev, RDT, 1);
+	iow32(dev, RDT, E1000_RX_DESC_COUNT - 1);
 
-	iow32(dev, IMS, IMS_RXO);
+	iow32(dev, ITR, CONFIG_ETH_E1000_ITR);
+	iow32(dev, IMS, E1000_IRQ_MASK);
 
 	ral = ior32(dev, RAL);
 	rah = ior32(dev, RAH);
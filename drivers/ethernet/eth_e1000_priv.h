@@ -18,9 +18,14 @@ extern "C" {
 
 #define ICR_TXDW	     (1) /* Transmit Descriptor Written Back */
 #define ICR_TXQE	(1 << 1) /* Transmit Queue Empty */
+#define ICR_RXDMT0	(1 << 4) /* Rx Descriptor Minimum Threshold */
 #define ICR_RXO		(1 << 6) /* Receiver Overrun */
+#define ICR_RXT0	(1 << 7) /* Receiver Timer Interrupt */
 
+#define IMS_TXDW	     (1) /* Transmit Descriptor Written Back */
+#define IMS_RXDMT0	(1 << 4) /* Rx Descriptor Minimum Threshold */
 #define IMS_RXO		(1 << 6) /* Receiver FIFO Overrun */
+#define IMS_RXT0	(1 << 7) /* Receiver Timer Interrupt */
 
 #define RCTL_MPE	(1 << 4) /* Multicast Promiscuous Enabled */
 
@@ -28,6 +33,7 @@ extern "C" {
 #define TDESC_RS	(1 << 3) /* Report Status */
 
 #define RDESC_STA_DD	     (1) /* Descriptor Done */
+#define RDESC_STA_EOP	(1 << 1) /* End Of Packet */
 #define TDESC_STA_DD	     (1) /* Descriptor Done */
 
 #define ETH_ALEN 6	/* TODO: Add a global reusable definition in OS */
@@ -35,8 +41,10 @@ extern "C" {
 enum e1000_reg_t {
 	CTRL	= 0x0000,	/* Device Control */
 	ICR	= 0x00C0,	/* Interrupt Cause Read */
+	ITR	= 0x00C4,	/* Interrupt Throttling */
 	ICS	= 0x00C8,	/* Interrupt Cause Set */
 	IMS	= 0x00D0,	/* Interrupt Mask Set */
+	IMC	= 0x00D8,	/* Interrupt Mask Clear */
 	RCTL	= 0x0100,	/* Receive Control */
 	TCTL	= 0x0400,	/* Transmit Control */
 	RDBAL	= 0x2800,	/* Rx Descriptor Base Address Low */
@@ -74,9 +82,26 @@ struct e1000_rx {
 	uint16_t special;
 };
 
+#define E1000_TX_DESC_COUNT	CONFIG_ETH_E1000_TX_DESC_COUNT
+#define E1000_RX_DESC_COUNT	CONFIG_ETH_E1000_RX_DESC_COUNT
+#define E1000_RX_BUF_SIZE	2048 /* RCTL.BSIZE default */
+
 struct e1000_dev {
-	volatile struct e1000_tx tx __aligned(16);
-	volatile struct e1000_rx rx __aligned(16);
+	/* Descriptor rings, their length must be a multiple of 128 bytes */
+	volatile struct e1000_tx tx[E1000_TX_DESC_COUNT] __aligned(16);
+	volatile struct e1000_rx rx[E1000_RX_DESC_COUNT] __aligned(16);
+	/* Packet sent with the last descriptor of each frame in the TX ring */
+	struct net_pkt *tx_pkt[E1000_TX_DESC_COUNT];
+	/* Buffer posted to each descriptor of the RX ring */
+	struct net_buf *rx_buf[E1000_RX_DESC_COUNT];
+	/* Next TX descriptor to fill and next one to reclaim */
+	uint16_t tx_tail;
+	uint16_t tx_clean;
+	/* Next RX descriptor written back by the device */
+	uint16_t rx_next;
+	struct k_mutex tx_lock;
+	struct k_condvar tx_cond;
+	struct k_work poll_work;
 	mm_reg_t address;
 	/* If VLAN is enabled, there can be multiple VLAN interfaces related to
 	 * this physical device. In that case, this iface pointer value is not
@@ -84,8 +109,6 @@ struct e1000_dev {
 	 */
 	struct net_if *iface;
 	uint8_t mac[ETH_ALEN];
-	uint8_t txb[NET_ETH_MTU];
-	uint8_t rxb[NET_ETH_MTU];
 #if defined(CONFIG_ETH_E1000_PTP_CLOCK)
 	const struct device *ptp_clock;
 	float clk_ratio;
@@ -55,6 +55,8 @@ struct eth_context {
 	k_tid_t rx_thread;
 	struct z_thread_stack_element *rx_stack;
 	size_t rx_stack_size;
+	struct k_timer rx_timer;
+	struct k_sem rx_sem;
 	int dev_fd;
 	bool init_done;
 	bool status;
@@ -178,12 +180,56 @@ static void update_gptp(struct net_if *iface, struct net_pkt *pkt,
 #define update_gptp(iface, pkt, send)
 #endif /* CONFIG_NET_GPTP */
 
+#if defined(CONFIG_ETH_NATIVE_POSIX_TX_VECTORED)
+/* Send the fragments of the packet with a single writev(), returns -E2BIG
+ * if the packet has too many fragments.
+ */
+static int eth_send_vectored(struct eth_context *ctx, struct net_pkt *pkt)
+{
+	struct eth_iovec iov[ETH_NATIVE_POSIX_IOV_MAX];
+	struct net_buf *frag;
+	int iovcnt = 0;
+
+	for (frag = pkt->buffer; frag; frag = frag->frags) {
+		if (!frag->len) {
+			continue;
+		}
+
+		if (iovcnt == ARRAY_SIZE(iov)) {
+			return -E2BIG;
+		}
+
+		iov[iovcnt].base = frag->data;
+		iov[iovcnt].len = frag->len;
+		iovcnt++;
+	}
+
+	update_gptp(net_pkt_iface(pkt), pkt, true);
+
+	LOG_DBG("Send pkt %p len %zu in %d fragment(s)", pkt,
+		net_pkt_get_len(pkt), iovcnt);
+
+	return eth_writev_data(ctx->dev_fd, iov, iovcnt);
+}
+#endif /* CONFIG_ETH_NATIVE_POSIX_TX_VECTORED */
+
 static int eth_send(const struct device *dev, struct net_pkt *pkt)
 {
 	struct eth_context *ctx = dev->data;
 	int count = net_pkt_get_len(pkt);
 	int ret;
 
+#if defined(CONFIG_ETH_NATIVE_POSIX_TX_VECTORED)
+	ret = eth_send_vectored(ctx, pkt);
+	if (ret != -E2BIG) {
+		if (ret < 0) {
+			LOG_DBG("Cannot send pkt %p (%d)", pkt, ret);
+		}
+
+		return ret < 0 ? ret : 0;
+	}
+#endif
+
 	ret = net_pkt_read(pkt, ctx->send, count);
 	if (ret) {
 		return ret;
@@ -329,7 +375,7 @@ static int read_data(struct eth_context *ctx, int fd)
 
 	count = eth_read_data(fd, ctx->recv, sizeof(ctx->recv));
 	if (count <= 0) {
-		return 0;
+		return -EAGAIN;
 	}
 
 #if defined(CONFIG_NET_VLAN)
@@ -370,22 +416,37 @@ static int read_data(struct eth_context *ctx, int fd)
 	return 0;
 }
 
+/* The host cannot interrupt the simulated CPU, so the TAP device is checked
+ * for data from a timer. The RX thread only runs when data is available.
+ */
+static void eth_rx_timer_expiry(struct k_timer *timer)
+{
+	struct eth_context *ctx = k_timer_user_data_get(timer);
+
+	if (k_sem_count_get(&ctx->rx_sem) == 0U &&
+	    eth_wait_data(ctx->dev_fd) == 0) {
+		k_sem_give(&ctx->rx_sem);
+	}
+}
+
 static void eth_rx(struct eth_context *ctx)
 {
 	LOG_DBG("Starting ZETH RX thread");
 
 	while (1) {
-		if (net_if_is_up(ctx->iface)) {
-			while (!eth_wait_data(ctx->dev_fd)) {
-				read_data(ctx, ctx->dev_fd);
-				k_yield();
-			}
+		k_sem_take(&ctx->rx_sem, K_FOREVER);
+
+		if (!net_if_is_up(ctx->iface)) {
+			continue;
 		}
 
-		if (IS_ENABLED(CONFIG_NET_GPTP)) {
-			k_sleep(K_MSEC(1));
-		} else {
-			k_sleep(K_MSEC(50));
+		/* The device is non-blocking, read until it is drained or
+		 * the batch is full. The rest is read on the next check.
+		 */
+		for (int i = 0; i < CONFIG_ETH_NATIVE_POSIX_RX_BATCH; i++) {
+			if (read_data(ctx, ctx->dev_fd) == -EAGAIN) {
+				break;
+			}
 		}
 	}
 }
@@ -398,6 +459,8 @@ static void eth_rx(struct eth_context *ctx)
 
 static void create_rx_handler(struct eth_context *ctx)
 {
+	k_sem_init(&ctx->rx_sem, 0, 1);
+
 	k_thread_create(ctx->rx_thread,
 			ctx->rx_stack,
 			ctx->rx_stack_size,
@@ -412,6 +475,12 @@ static void create_rx_handler(struct eth_context *ctx)
 			 ctx->if_name);
 		k_thread_name_set(ctx->rx_thread, name);
 	}
+
+	k_timer_init(&ctx->rx_timer, eth_rx_timer_expiry, NULL);
+	k_timer_user_data_set(&ctx->rx_timer, ctx);
+	k_timer_start(&ctx->rx_timer,
+		      K_USEC(CONFIG_ETH_NATIVE_POSIX_RX_CHECK_INTERVAL),
+		      K_USEC(CONFIG_ETH_NATIVE_POSIX_RX_CHECK_INTERVAL));
 }
 
 static void eth_iface_init(struct net_if *iface)
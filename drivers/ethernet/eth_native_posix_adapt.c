@@ -23,6 +23,7 @@
 #include <sys/ioctl.h>
 #include <sys/socket.h>
 #include <sys/select.h>
+#include <sys/uio.h>
 #include <net/if.h>
 #include <time.h>
 #include <arch/posix/posix_trace.h>
@@ -77,6 +78,14 @@ int eth_iface_create(const char *if_name, bool tun_only)
 	}
 #endif
 
+	/* Frames are read until the device is drained */
+	ret = fcntl(fd, F_GETFL);
+	if (ret < 0 || fcntl(fd, F_SETFL, ret | O_NONBLOCK) < 0) {
+		ret = -errno;
+		close(fd);
+		return ret;
+	}
+
 	return fd;
 }
 
@@ -175,6 +184,22 @@ ssize_t eth_write_data(int fd, void *buf, size_t buf_len)
 	return write(fd, buf, buf_len);
 }
 
+ssize_t eth_writev_data(int fd, const struct eth_iovec *iov, int iovcnt)
+{
+	struct iovec host_iov[ETH_NATIVE_POSIX_IOV_MAX];
+
+	if (iovcnt > ETH_NATIVE_POSIX_IOV_MAX) {
+		return -EINVAL;
+	}
+
+	for (int i = 0; i < iovcnt; i++) {
+		host_iov[i].iov_base = iov[i].base;
+		host_iov[i].iov_len = iov[i].len;
+	}
+
+	return writev(fd, host_iov, iovcnt);
+}
+
 #if defined(CONFIG_NET_GPTP)
 int eth_clock_gettime(struct net_ptp_time *time)
 {
@@ -25,6 +25,14 @@
 #define ETH_NATIVE_POSIX_STARTUP_SCRIPT_USER ""
 #endif
 
+/* Maximum number of fragments of a frame sent with eth_writev_data() */
+#define ETH_NATIVE_POSIX_IOV_MAX 16
+
+struct eth_iovec {
+	void *base;
+	size_t len;
+};
+
 int eth_iface_create(const char *if_name, bool tun_only);
 int eth_iface_remove(int fd);
 int eth_setup_host(const char *if_name);
@@ -32,6 +40,7 @@ int eth_start_script(const char *if_name);
 int eth_wait_data(int fd);
 ssize_t eth_read_data(int fd, void *buf, size_t buf_len);
 ssize_t eth_write_data(int fd, void *buf, size_t buf_len);
+ssize_t eth_writev_data(int fd, const struct eth_iovec *iov, int iovcnt);
 int eth_if_up(const char *if_name);
 int eth_if_down(const char *if_name);
 
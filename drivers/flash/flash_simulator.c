@@ -69,6 +69,7 @@
 		if (U < STATS_PAGE_COUNT_THRESHOLD) {			     \
 			(*(&flash_sim_stats.erase_cycles_unit0 + (U)) += 1); \
 		}							     \
+		unit_wear_inc(U);					     \
 	} while (0)
 
 #if (CONFIG_FLASH_SIMULATOR_STAT_PAGE_COUNT > STATS_PAGE_COUNT_THRESHOLD)
@@ -91,6 +92,8 @@ STATS_SECT_ENTRY32(flash_write_calls)   /* calls to flash_write() */
 STATS_SECT_ENTRY32(flash_write_time_us) /* time spent in flash_write() */
 STATS_SECT_ENTRY32(flash_erase_calls)   /* calls to flash_erase() */
 STATS_SECT_ENTRY32(flash_erase_time_us) /* time spent in flash_erase() */
+STATS_SECT_ENTRY32(erase_units)         /* num. of units erased */
+STATS_SECT_ENTRY32(max_erase_cycles)    /* erase cycles of most worn unit */
 /* -- per-unit statistics -- */
 /* erase cycle count for unit */
 UTIL_EVAL(UTIL_REPEAT(FLASH_SIMULATOR_FLASH_PAGE_COUNT, STATS_SECT_EC))
@@ -99,6 +102,23 @@ UTIL_EVAL(UTIL_REPEAT(FLASH_SIMULATOR_FLASH_PAGE_COUNT, STATS_SECT_DIRTYR))
 STATS_SECT_END;
 
 STATS_SECT_DECL(flash_sim_stats) flash_sim_stats;
+
+/* erase cycles of all units, also of those beyond the per-unit statistics */
+static uint32_t unit_erase_cycles[FLASH_SIMULATOR_PAGE_COUNT];
+
+static void unit_wear_inc(uint32_t unit)
+{
+	/* restart the wear count when the statistics have been reset */
+	if (flash_sim_stats.erase_units == 0) {
+		memset(unit_erase_cycles, 0, sizeof(unit_erase_cycles));
+	}
+
+	unit_erase_cycles[unit]++;
+	flash_sim_stats.erase_units++;
+	flash_sim_stats.max_erase_cycles =
+		MAX(flash_sim_stats.max_erase_cycles, unit_erase_cycles[unit]);
+}
+
 STATS_NAME_START(flash_sim_stats)
 STATS_NAME(flash_sim_stats, bytes_read)
 STATS_NAME(flash_sim_stats, bytes_written)
@@ -109,6 +129,8 @@ STATS_NAME(flash_sim_stats, flash_write_calls)
 STATS_NAME(flash_sim_stats, flash_write_time_us)
 STATS_NAME(flash_sim_stats, flash_erase_calls)
 STATS_NAME(flash_sim_stats, flash_erase_time_us)
+STATS_NAME(flash_sim_stats, erase_units)
+STATS_NAME(flash_sim_stats, max_erase_cycles)
 UTIL_EVAL(UTIL_REPEAT(FLASH_SIMULATOR_FLASH_PAGE_COUNT, STATS_NAME_EC))
 UTIL_EVAL(UTIL_REPEAT(FLASH_SIMULATOR_FLASH_PAGE_COUNT, STATS_NAME_DIRTYR))
 STATS_NAME_END(flash_sim_stats);
@@ -159,6 +181,76 @@ static const struct flash_parameters flash_sim_parameters = {
 	.erase_value = FLASH_SIMULATOR_ERASE_VALUE
 };
 
+#ifdef CONFIG_FLASH_SIMULATOR_SIMULATE_TIMING
+#ifdef CONFIG_FLASH_SIMULATOR_TIMING_SLEEP
+/* uptime at which the flash completes the last operation */
+static uint64_t busy_until_us;
+#endif
+
+/* make an operation take its time */
+static void flash_sim_wait(uint32_t time_us)
+{
+#ifdef CONFIG_FLASH_SIMULATOR_TIMING_SLEEP
+	if (!k_is_in_isr()) {
+		uint64_t now_us = k_ticks_to_us_floor64(k_uptime_ticks());
+		int64_t ticks;
+
+		/* sleep until the tick of the completion, the remainder is
+		 * carried over to the next operation
+		 */
+		busy_until_us = MAX(busy_until_us, now_us) + time_us;
+		ticks = k_us_to_ticks_floor64(busy_until_us) - k_uptime_ticks();
+		if (ticks > 0) {
+			k_sleep(K_TICKS(ticks));
+		}
+
+		return;
+	}
+#endif
+
+	k_busy_wait(time_us);
+}
+
+static uint32_t flash_sim_read_time(size_t len)
+{
+	uint64_t time_us = CONFIG_FLASH_SIMULATOR_MIN_READ_TIME_US;
+
+#if CONFIG_FLASH_SIMULATOR_READ_BANDWIDTH > 0
+	time_us += ((uint64_t)len * USEC_PER_SEC) /
+		   (CONFIG_FLASH_SIMULATOR_READ_BANDWIDTH * 1024U);
+#endif
+
+	return MIN(time_us, UINT32_MAX);
+}
+
+static uint32_t flash_sim_write_time(off_t offset, size_t len)
+{
+	const size_t page = CONFIG_FLASH_SIMULATOR_PROG_PAGE_SIZE;
+	uint64_t time_us = CONFIG_FLASH_SIMULATOR_MIN_WRITE_TIME_US;
+
+	offset -= FLASH_SIMULATOR_BASE_OFFSET;
+
+	if (len) {
+		/* pages touched by the write */
+		time_us += (uint64_t)((offset + len - 1) / page -
+				      offset / page + 1) *
+			   CONFIG_FLASH_SIMULATOR_PAGE_PROG_TIME_US;
+	}
+
+	return MIN(time_us, UINT32_MAX);
+}
+
+static uint32_t flash_sim_erase_time(size_t len)
+{
+	uint64_t time_us = CONFIG_FLASH_SIMULATOR_MIN_ERASE_TIME_US;
+
+	time_us += (uint64_t)(len / FLASH_SIMULATOR_ERASE_UNIT) *
+		   CONFIG_FLASH_SIMULATOR_UNIT_ERASE_TIME_US;
+
+	return MIN(time_us, UINT32_MAX);
+}
+#endif /* CONFIG_FLASH_SIMULATOR_SIMULATE_TIMING */
+
 static int flash_range_is_valid(const struct device *dev, off_t offset,
 				size_t len)
 {
@@ -195,9 +287,10 @@ static int flash_sim_read(const struct device *dev, const off_t offset,
 	FLASH_SIM_STATS_INCN(flash_sim_stats, bytes_read, len);
 
 #ifdef CONFIG_FLASH_SIMULATOR_SIMULATE_TIMING
-	k_busy_wait(CONFIG_FLASH_SIMULATOR_MIN_READ_TIME_US);
-	FLASH_SIM_STATS_INCN(flash_sim_stats, flash_read_time_us,
-		   CONFIG_FLASH_SIMULATOR_MIN_READ_TIME_US);
+	uint32_t time_us = flash_sim_read_time(len);
+
+	flash_sim_wait(time_us);
+	FLASH_SIM_STATS_INCN(flash_sim_stats, flash_read_time_us, time_us);
 #endif
 
 	return 0;
@@ -269,10 +362,11 @@ static int flash_sim_write(const struct device *dev, const off_t offset,
 	FLASH_SIM_STATS_INCN(flash_sim_stats, bytes_written, len);
 
 #ifdef CONFIG_FLASH_SIMULATOR_SIMULATE_TIMING
+	uint32_t time_us = flash_sim_write_time(offset, len);
+
 	/* wait before returning */
-	k_busy_wait(CONFIG_FLASH_SIMULATOR_MIN_WRITE_TIME_US);
-	FLASH_SIM_STATS_INCN(flash_sim_stats, flash_write_time_us,
-		   CONFIG_FLASH_SIMULATOR_MIN_WRITE_TIME_US);
+	flash_sim_wait(time_us);
+	FLASH_SIM_STATS_INCN(flash_sim_stats, flash_write_time_us, time_us);
 #endif
 
 	return 0;
@@ -323,10 +417,11 @@ static int flash_sim_erase(const struct device *dev, const off_t offset,
 	}
 
 #ifdef CONFIG_FLASH_SIMULATOR_SIMULATE_TIMING
+	uint32_t time_us = flash_sim_erase_time(len);
+
 	/* wait before returning */
-	k_busy_wait(CONFIG_FLASH_SIMULATOR_MIN_ERASE_TIME_US);
-	FLASH_SIM_STATS_INCN(flash_sim_stats, flash_erase_time_us,
-		   CONFIG_FLASH_SIMULATOR_MIN_ERASE_TIME_US);
+	flash_sim_wait(time_us);
+	FLASH_SIM_STATS_INCN(flash_sim_stats, flash_erase_time_us, time_us);
 #endif
 
 	return 0;
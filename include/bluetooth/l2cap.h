@@ -179,6 +179,17 @@ struct bt_l2cap_le_chan {
 	struct bt_l2cap_le_endpoint	rx;
 	/** Channel Transmission Endpoint */
 	struct bt_l2cap_le_endpoint	tx;
+#if defined(CONFIG_BT_L2CAP_RX_ZERO_COPY)
+	/** @brief Reassemble received SDUs without copying.
+	 *
+	 *  If set for a channel with an alloc_buf callback, the buffer
+	 *  allocated with alloc_buf is left empty and the received K-frames
+	 *  are added to it as fragments, so the recv callback shall read the
+	 *  SDU from the whole fragment chain. Otherwise the SDU is copied to
+	 *  the buffer, as without @kconfig{CONFIG_BT_L2CAP_RX_ZERO_COPY}.
+	 */
+	bool				rx_zero_copy;
+#endif /* CONFIG_BT_L2CAP_RX_ZERO_COPY */
 	/** Channel Transmission queue */
 	struct k_fifo                   tx_queue;
 	/** Channel Pending Transmission buffer  */
@@ -188,6 +199,14 @@ struct bt_l2cap_le_chan {
 	/** Segment SDU packet from upper layer */
 	struct net_buf			*_sdu;
 	uint16_t				_sdu_len;
+#if defined(CONFIG_BT_L2CAP_RX_CREDITS_TUNING)
+	/* Credits given to the peer and not restored yet */
+	atomic_t			_rx_credits_out;
+	/* Credits of the SDUs held by the application */
+	atomic_t			_rx_credits_held;
+	/* Maximum number of credits given and not restored */
+	uint16_t			_rx_window;
+#endif /* CONFIG_BT_L2CAP_RX_CREDITS_TUNING */
 
 	struct k_work			rx_work;
 	struct k_fifo			rx_queue;
@@ -269,6 +288,10 @@ struct bt_l2cap_chan_ops {
 	 *  must set this callback.
 	 *  If the application has not set a callback the L2CAP SDU MTU will be
 	 *  truncated to @ref BT_L2CAP_SDU_RX_MTU.
+	 *  With @kconfig{CONFIG_BT_L2CAP_RX_ZERO_COPY}, channels that set
+	 *  rx_zero_copy get the buffer left empty and the received K-frames
+	 *  added to it as fragments, up to
+	 *  @kconfig{CONFIG_BT_L2CAP_RX_ZERO_COPY_FRAGS} of them.
 	 *
 	 *  @param chan The channel requesting a buffer.
 	 *
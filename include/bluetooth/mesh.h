@@ -25,6 +25,7 @@
 #include <bluetooth/mesh/proxy.h>
 #include <bluetooth/mesh/heartbeat.h>
 #include <bluetooth/mesh/cdb.h>
+#include <bluetooth/mesh/statistic.h>
 #include <bluetooth/mesh/cfg.h>
 
 #endif /* ZEPHYR_INCLUDE_BLUETOOTH_MESH_H_ */
@@ -0,0 +1,61 @@
+/** @file
+ *  @brief Bluetooth mesh statistics APIs.
+ */
+
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef ZEPHYR_INCLUDE_BLUETOOTH_MESH_STATISTIC_H_
+#define ZEPHYR_INCLUDE_BLUETOOTH_MESH_STATISTIC_H_
+
+#include <zephyr/types.h>
+
+/**
+ * @brief Bluetooth mesh statistics
+ * @defgroup bt_mesh_stat Bluetooth mesh statistics
+ * @ingroup bt_mesh
+ * @{
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Network layer statistics for received network PDUs */
+struct bt_mesh_statistic {
+	/** Network header deobfuscations, one AES operation each. */
+	uint32_t net_deobfuscate;
+	/** Network PDU decryptions, one AES-CCM operation each. */
+	uint32_t net_decrypt;
+	/**
+	 * Network PDUs resolved by the decryption cache, each saving at
+	 * least one deobfuscation and one decryption.
+	 */
+	uint32_t net_decrypt_cached;
+};
+
+/** @brief Get the current Bluetooth mesh statistics.
+ *
+ *  Requires @kconfig{CONFIG_BT_MESH_STATISTIC}.
+ *
+ *  @param st Statistics structure to fill.
+ */
+void bt_mesh_stat_get(struct bt_mesh_statistic *st);
+
+/** @brief Reset all Bluetooth mesh statistics to zero.
+ *
+ *  Requires @kconfig{CONFIG_BT_MESH_STATISTIC}.
+ */
+void bt_mesh_stat_reset(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @}
+ */
+
+#endif /* ZEPHYR_INCLUDE_BLUETOOTH_MESH_STATISTIC_H_ */
@@ -8,6 +8,7 @@
 #define ZEPHYR_INCLUDE_DATA_JSON_H_
 
 #include <sys/util.h>
+#include <stdbool.h>
 #include <stddef.h>
 #include <zephyr/types.h>
 #include <sys/types.h>
@@ -556,6 +557,108 @@ int json_obj_parse(char *json, size_t len,
 	const struct json_obj_descr *descr, size_t descr_len,
 	void *val);
 
+/** Maximum nesting depth of objects and arrays for json_obj_stream_parse(). */
+#define JSON_STREAM_MAX_DEPTH 8
+
+/** Maximum length of an object key for json_obj_stream_parse(). */
+#define JSON_STREAM_KEY_MAX 127
+
+/**
+ * @brief Nesting level of a streaming parse. Internal, do not use.
+ */
+struct json_obj_stream_level {
+	/* Object: field descriptors. Array: element descriptor. */
+	const struct json_obj_descr *descr;
+	/* Object: number of field descriptors. Array: maximum elements. */
+	size_t descr_len;
+	/* Object: decoded struct. Array: next element. */
+	char *val;
+	/* Array: element counter in the parent struct, if any. */
+	size_t *elements;
+	/* Array: elements parsed. */
+	size_t count;
+	/* Object: bitmap of decoded fields. */
+	int32_t decoded;
+	/* Object: index of the field expected next. */
+	uint8_t cursor;
+	/* Object: index of the field being parsed, -1 if unknown. */
+	int8_t field;
+	/* JSON_TOK_OBJECT_START or JSON_TOK_LIST_START. */
+	uint8_t type;
+	uint8_t state;
+};
+
+/**
+ * @brief State of an incremental object parse
+ *
+ * Initialized by json_obj_stream_init(). Members are internal.
+ */
+struct json_obj_stream {
+	struct json_obj_stream_level stack[JSON_STREAM_MAX_DEPTH];
+	int depth;
+	int result;
+
+	/* Nesting depth of an object or array which is skipped. */
+	size_t skip;
+
+	/* Token spanning chunk boundaries. */
+	uint8_t tok;
+	bool in_key;
+	size_t tok_len;
+	const char *literal;
+	void *field;
+	char tok_buf[JSON_STREAM_KEY_MAX + 1];
+
+	/* Storage for decoded strings. */
+	char *str_buf;
+	size_t str_buf_size;
+	size_t str_used;
+	size_t str_start;
+};
+
+/**
+ * @brief Prepares an incremental parse of a JSON-encoded object
+ *
+ * Unlike json_obj_parse(), the payload does not have to be available
+ * in one buffer: it is fed to json_obj_stream_parse() in chunks of any
+ * size, which are not needed anymore once that function returns.
+ * Decoded strings are copied, NUL-terminated, to @a str_buf, and the
+ * string fields in @a val point there. As with json_obj_parse(), strings
+ * are not unescaped.
+ *
+ * @param stream Parser state to initialize
+ * @param descr Pointer to the descriptor array
+ * @param descr_len Number of elements in the descriptor array. Must be
+ * less than 31.
+ * @param val Pointer to the struct to hold the decoded values
+ * @param str_buf Buffer for decoded strings, may be NULL if @a descr
+ * contains no strings
+ * @param str_buf_size Size of @a str_buf
+ */
+void json_obj_stream_init(struct json_obj_stream *stream,
+			  const struct json_obj_descr *descr,
+			  size_t descr_len, void *val,
+			  char *str_buf, size_t str_buf_size);
+
+/**
+ * @brief Feeds a chunk of a JSON-encoded object to an incremental parse
+ *
+ * Data following the end of the object is ignored. Values of keys which
+ * are not in the descriptor are skipped, including null, and objects and
+ * arrays nested at any depth.
+ *
+ * @param stream Parser state initialized by json_obj_stream_init()
+ * @param chunk Next chunk of the JSON-encoded object
+ * @param len Length of @a chunk
+ * @return -EAGAIN if the object is not complete yet, bitmap of decoded
+ * fields once it is (see json_obj_parse()), -ENOMEM if @a str_buf is too
+ * small or the object is nested too deeply, or another negative error
+ * code if the payload is invalid. Once the parse has completed or
+ * failed, the same value is returned for any further chunk.
+ */
+int json_obj_stream_parse(struct json_obj_stream *stream,
+			  const char *chunk, size_t len);
+
 /**
  * @brief Escapes the string so it can be used to encode JSON objects
  *
@@ -609,6 +712,55 @@ ssize_t json_calc_encoded_len(const struct json_obj_descr *descr,
 int json_obj_encode_buf(const struct json_obj_descr *descr, size_t descr_len,
 			const void *val, char *buffer, size_t buf_size);
 
+/**
+ * @brief Encodes an object in a contiguous memory location, returning its
+ * encoded length
+ *
+ * The object is encoded in a single pass. If it does not fit, encoding
+ * carries on without writing so that the exact size needed is still
+ * returned, and the call can be retried with a large enough buffer
+ * without a separate json_calc_encoded_len() pass.
+ *
+ * @param descr Pointer to the descriptor array
+ * @param descr_len Number of elements in the descriptor array
+ * @param val Struct holding the values
+ * @param buffer Buffer to store the JSON data
+ * @param buf_size Size of buffer, in bytes, with space for the terminating
+ * NUL character
+ *
+ * @return Length of the encoded object, excluding the terminating NUL
+ * character. The object has been written to buffer only if this is less
+ * than buf_size, otherwise buffer holds a NUL terminated prefix of it.
+ * A negative value indicates an error (as defined on errno.h), buffer
+ * then holds the NUL terminated output up to the error.
+ */
+ssize_t json_obj_encode_buf_len(const struct json_obj_descr *descr,
+				size_t descr_len, const void *val,
+				char *buffer, size_t buf_size);
+
+#if defined(CONFIG_NET_BUF)
+struct net_buf;
+
+/**
+ * @brief Encodes an object at the tail of a network buffer
+ *
+ * The object is written directly into the tail room of @a buf, which is
+ * then extended by the encoded length. No NUL character is appended.
+ *
+ * @param descr Pointer to the descriptor array
+ * @param descr_len Number of elements in the descriptor array
+ * @param val Struct holding the values
+ * @param buf Network buffer to append the JSON data to
+ *
+ * @return Number of bytes added to @a buf. -ENOMEM if the object does not
+ * fit in the tail room, in which case @a buf is left unchanged. Another
+ * negative value indicates an error (as defined on errno.h).
+ */
+ssize_t json_obj_encode_net_buf(const struct json_obj_descr *descr,
+				size_t descr_len, const void *val,
+				struct net_buf *buf);
+#endif
+
 /**
  * @brief Encodes an array in a contiguous memory location
  *
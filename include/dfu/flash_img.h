@@ -16,6 +16,9 @@ extern "C" {
 
 struct flash_img_context {
 	uint8_t buf[CONFIG_IMG_BLOCK_BUF_SIZE];
+#ifdef CONFIG_IMG_ASYNC_WRITE
+	uint8_t async_buf[CONFIG_IMG_BLOCK_BUF_SIZE];
+#endif
 	const struct flash_area *flash_area;
 	struct stream_flash_ctx stream;
 };
@@ -34,6 +37,9 @@ struct flash_img_check {
 /**
  * @brief Initialize context needed for writing the image to the flash.
  *
+ * With CONFIG_IMG_ASYNC_WRITE, if @a ctx was initialized before, a block
+ * of that upload still being programmed in the background is waited for.
+ *
  * @param ctx     context to be initialized
  * @param area_id flash area id of partition where the image should be written
  *
@@ -2868,12 +2868,156 @@ static inline unsigned int z_impl_k_sem_count_get(struct k_sem *sem)
 
 /** @} */
 
+/**
+ * @cond INTERNAL_HIDDEN
+ */
+
+struct k_event {
+	_wait_q_t wait_q;
+	uint32_t events;
+	struct k_spinlock lock;
+
+	_POLL_EVENT;
+};
+
+#define Z_EVENT_INITIALIZER(obj) \
+	{ \
+	.wait_q = Z_WAIT_Q_INIT(&obj.wait_q), \
+	.events = 0, \
+	_POLL_EVENT_OBJ_INIT(obj) \
+	}
+
+/**
+ * INTERNAL_HIDDEN @endcond
+ */
+
+/**
+ * @defgroup event_apis Event APIs
+ * @ingroup kernel_apis
+ * @{
+ */
+
+/**
+ * @brief Initialize an event object.
+ *
+ * This routine initializes an event object, prior to its first use. All
+ * its events are cleared.
+ *
+ * @param event Address of the event object.
+ */
+__syscall void k_event_init(struct k_event *event);
+
+/**
+ * @brief Post one or more events to an event object.
+ *
+ * This routine sets the events in @a events in the event object, leaving
+ * the other events unchanged. Threads waiting for the resulting set of
+ * events are made ready.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param event Address of the event object.
+ * @param events Set of events to post.
+ */
+__syscall void k_event_post(struct k_event *event, uint32_t events);
+
+/**
+ * @brief Set the events of an event object.
+ *
+ * This routine replaces all events of the event object with @a events.
+ * Threads waiting for the resulting set of events are made ready.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param event Address of the event object.
+ * @param events Set of events to set.
+ */
+__syscall void k_event_set(struct k_event *event, uint32_t events);
+
+/**
+ * @brief Clear events of an event object.
+ *
+ * This routine clears the events in @a events in the event object, leaving
+ * the other events unchanged.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param event Address of the event object.
+ * @param events Set of events to clear.
+ */
+__syscall void k_event_clear(struct k_event *event, uint32_t events);
+
+/**
+ * @brief Wait for any of the specified events.
+ *
+ * This routine waits until any of the events in @a events is posted to the
+ * event object, or the timeout expires. Events are not consumed by waiting:
+ * use k_event_clear() or @a reset for that.
+ *
+ * @note @a timeout must be set to K_NO_WAIT if called from ISR.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param event Address of the event object.
+ * @param events Set of events to wait for.
+ * @param reset If true, clear all events of the event object before
+ *              checking them.
+ * @param timeout Waiting period for the events,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval set of the events in @a events that were set when the wait
+ *         ended, 0 if none were before the timeout expired.
+ */
+__syscall uint32_t k_event_wait(struct k_event *event, uint32_t events,
+				bool reset, k_timeout_t timeout);
+
+/**
+ * @brief Wait for all of the specified events.
+ *
+ * This routine waits until all of the events in @a events are set in the
+ * event object, or the timeout expires. Events are not consumed by waiting:
+ * use k_event_clear() or @a reset for that.
+ *
+ * @note @a timeout must be set to K_NO_WAIT if called from ISR.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param event Address of the event object.
+ * @param events Set of events to wait for.
+ * @param reset If true, clear all events of the event object before
+ *              checking them.
+ * @param timeout Waiting period for the events,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval @a events if all of them were set when the wait ended, 0 if
+ *         the timeout expired before.
+ */
+__syscall uint32_t k_event_wait_all(struct k_event *event, uint32_t events,
+				    bool reset, k_timeout_t timeout);
+
+/**
+ * @brief Statically define and initialize an event object.
+ *
+ * The event object can be accessed outside the module where it is defined
+ * using:
+ *
+ * @code extern struct k_event <name>; @endcode
+ *
+ * @param name Name of the event object.
+ */
+#define K_EVENT_DEFINE(name) \
+	STRUCT_SECTION_ITERABLE(k_event, name) = \
+		Z_EVENT_INITIALIZER(name)
+
+/** @} */
+
 /**
  * @cond INTERNAL_HIDDEN
  */
 
 struct k_work_delayable;
 struct k_work_sync;
+struct k_work_q_pool;
 
 /**
  * INTERNAL_HIDDEN @endcond
@@ -3138,6 +3282,77 @@ int k_work_queue_drain(struct k_work_q *queue, bool plug);
  */
 int k_work_queue_unplug(struct k_work_q *queue);
 
+#if defined(CONFIG_WORKQUEUE_POOL) || defined(__DOXYGEN__)
+/** @brief Start the work queues of a work queue pool.
+ *
+ * This starts one work queue per thread defined by
+ * K_WORK_QUEUE_POOL_DEFINE().  Each queue has its own list of pending work
+ * items, and a pool thread that runs out of work takes the oldest pending
+ * item from another queue of the pool.  The function should not be
+ * re-invoked on a pool.
+ *
+ * Work items submitted to the pool keep the semantics of work items
+ * submitted to a single queue: a work item is never run by more than one
+ * thread at a time, and it can be flushed and cancelled as usual.
+ *
+ * @param pool pointer to the pool, defined with K_WORK_QUEUE_POOL_DEFINE().
+ *
+ * @param prio initial priority of the pool threads
+ *
+ * @param cfg optional additional configuration parameters, applied to all
+ * pool threads.  Pass @c NULL if not required.
+ */
+void k_work_queue_pool_start(struct k_work_q_pool *pool, int prio,
+			     const struct k_work_queue_config *cfg);
+
+/** @brief Submit a work item to a work queue pool.
+ *
+ * This works like k_work_submit_to_queue().  Work submitted from a pool
+ * thread goes to the queue of that thread, other work goes to an idle
+ * queue of the pool if there is one.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param pool pointer to the pool.
+ *
+ * @param work pointer to the work item.
+ *
+ * @return as k_work_submit_to_queue().
+ */
+int k_work_submit_to_pool(struct k_work_q_pool *pool, struct k_work *work);
+
+/** @brief Wait until all queues of a work queue pool have drained,
+ * optionally plugging them.
+ *
+ * This works like k_work_queue_drain() applied to all queues of the pool
+ * at once.  Submissions from pool threads are still accepted while
+ * draining, other submissions are rejected until the whole pool has
+ * drained, even to queues that drained already.
+ *
+ * @param pool pointer to the pool.
+ *
+ * @param plug if true the pool queues will continue to block new
+ * submissions after all items have drained.
+ *
+ * @retval 1 if call had to wait for the drain to complete
+ * @retval 0 if call did not have to wait
+ * @retval negative if wait was interrupted or failed
+ */
+int k_work_queue_pool_drain(struct k_work_q_pool *pool, bool plug);
+
+/** @brief Release the queues of a work queue pool to accept new
+ * submissions.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param pool pointer to the pool.
+ *
+ * @retval 0 if successfully unplugged
+ * @retval -EALREADY if the pool was not plugged.
+ */
+int k_work_queue_pool_unplug(struct k_work_q_pool *pool);
+#endif /* CONFIG_WORKQUEUE_POOL */
+
 /** @brief Initialize a delayable work structure.
  *
  * This must be invoked before scheduling a delayable work structure for the
@@ -3331,6 +3546,46 @@ int k_work_reschedule_for_queue(struct k_work_q *queue,
 extern int k_work_reschedule(struct k_work_delayable *dwork,
 				     k_timeout_t delay);
 
+#if defined(CONFIG_WORKQUEUE_POOL) || defined(__DOXYGEN__)
+/** @brief Submit an idle work item to a work queue pool after a delay.
+ *
+ * This works like k_work_schedule_for_queue(), with the queue selected as
+ * in k_work_submit_to_pool().
+ *
+ * @funcprops \isr_ok
+ *
+ * @param pool pointer to the pool.
+ *
+ * @param dwork pointer to the delayable work item.
+ *
+ * @param delay the time to wait before submitting the work item.
+ *
+ * @return as with k_work_schedule_for_queue().
+ */
+int k_work_schedule_for_pool(struct k_work_q_pool *pool,
+			     struct k_work_delayable *dwork,
+			     k_timeout_t delay);
+
+/** @brief Reschedule a work item to a work queue pool after a delay.
+ *
+ * This works like k_work_reschedule_for_queue(), with the queue selected
+ * as in k_work_submit_to_pool().
+ *
+ * @funcprops \isr_ok
+ *
+ * @param pool pointer to the pool.
+ *
+ * @param dwork pointer to the delayable work item.
+ *
+ * @param delay the time to wait before submitting the work item.
+ *
+ * @return as with k_work_reschedule_for_queue().
+ */
+int k_work_reschedule_for_pool(struct k_work_q_pool *pool,
+			       struct k_work_delayable *dwork,
+			       k_timeout_t delay);
+#endif /* CONFIG_WORKQUEUE_POOL */
+
 /** @brief Flush delayable work.
  *
  * If the work is scheduled, it is immediately submitted.  Then the caller
@@ -3444,6 +3699,8 @@ enum {
 	K_WORK_QUEUE_DRAIN = BIT(K_WORK_QUEUE_DRAIN_BIT),
 	K_WORK_QUEUE_PLUGGED_BIT = 3,
 	K_WORK_QUEUE_PLUGGED = BIT(K_WORK_QUEUE_PLUGGED_BIT),
+	K_WORK_QUEUE_POOL_DRAIN_BIT = 4,
+	K_WORK_QUEUE_POOL_DRAIN = BIT(K_WORK_QUEUE_POOL_DRAIN_BIT),
 
 	/* Static work queue flags */
 	K_WORK_QUEUE_NO_YIELD_BIT = 8,
@@ -3649,8 +3906,58 @@ struct k_work_q {
 
 	/* Flags describing queue state. */
 	uint32_t flags;
+
+#ifdef CONFIG_WORKQUEUE_POOL
+	/* The pool this queue belongs to, if any. */
+	struct k_work_q_pool *pool;
+#endif
 };
 
+#if defined(CONFIG_WORKQUEUE_POOL) || defined(__DOXYGEN__)
+/** @brief A set of work queues sharing their work.
+ *
+ * Define with K_WORK_QUEUE_POOL_DEFINE() and start with
+ * k_work_queue_pool_start().
+ */
+struct k_work_q_pool {
+	/* One queue per pool thread. */
+	struct k_work_q *queues;
+
+	/* Thread stacks, one after the other. */
+	k_thread_stack_t *stacks;
+
+	/* Size of each thread stack. */
+	size_t stack_size;
+
+	/* Number of queues and threads. */
+	uint8_t num_queues;
+
+	/* Next queue to submit to when all are busy, accessed only while
+	 * the work module spinlock is held.
+	 */
+	uint8_t next;
+};
+
+/** @brief Statically define a work queue pool.
+ *
+ * @param name name of the pool object, a @c struct k_work_q_pool.
+ *
+ * @param n_threads number of pool threads, typically the number of CPUs.
+ *
+ * @param stack_sz stack size of each pool thread.
+ */
+#define K_WORK_QUEUE_POOL_DEFINE(name, n_threads, stack_sz)		\
+	static K_THREAD_STACK_ARRAY_DEFINE(_work_q_pool_stacks_##name,	\
+					   n_threads, stack_sz);	\
+	static struct k_work_q _work_q_pool_queues_##name[n_threads];	\
+	struct k_work_q_pool name = {					\
+		.queues = _work_q_pool_queues_##name,			\
+		.stacks = &(_work_q_pool_stacks_##name[0][0]),		\
+		.stack_size = stack_sz,					\
+		.num_queues = n_threads,				\
+	}
+#endif /* CONFIG_WORKQUEUE_POOL */
+
 /* Provide the implementation for inline functions declared above */
 
 static inline bool k_work_is_pending(const struct k_work *work)
@@ -4172,6 +4479,11 @@ struct k_msgq {
 
 	_POLL_EVENT;
 
+#ifdef CONFIG_MSGQ_SPSC
+	/** Number of used messages and waiter flag, in SPSC mode */
+	atomic_t spsc_state;
+#endif
+
 	/** Message queue */
 	uint8_t flags;
 };
@@ -4180,7 +4492,8 @@ struct k_msgq {
  */
 
 
-#define Z_MSGQ_INITIALIZER(obj, q_buffer, q_msg_size, q_max_msgs) \
+#define Z_MSGQ_INITIALIZER_FLAGS(obj, q_buffer, q_msg_size, q_max_msgs, \
+				 q_flags) \
 	{ \
 	.wait_q = Z_WAIT_Q_INIT(&obj.wait_q), \
 	.msg_size = q_msg_size, \
@@ -4191,14 +4504,22 @@ struct k_msgq {
 	.write_ptr = q_buffer, \
 	.used_msgs = 0, \
 	_POLL_EVENT_OBJ_INIT(obj) \
+	.flags = q_flags, \
 	}
 
+#define Z_MSGQ_INITIALIZER(obj, q_buffer, q_msg_size, q_max_msgs) \
+	Z_MSGQ_INITIALIZER_FLAGS(obj, q_buffer, q_msg_size, q_max_msgs, 0)
+
+/* Waiter flag of k_msgq.spsc_state, the other bits count used messages */
+#define Z_MSGQ_SPSC_WAITING	((atomic_val_t)BIT(30))
+
 /**
  * INTERNAL_HIDDEN @endcond
  */
 
 
 #define K_MSGQ_FLAG_ALLOC	BIT(0)
+#define K_MSGQ_FLAG_SPSC	BIT(1)
 
 /**
  * @brief Message Queue Attributes
@@ -4261,6 +4582,50 @@ struct k_msgq_attrs {
 void k_msgq_init(struct k_msgq *msgq, char *buffer, size_t msg_size,
 		 uint32_t max_msgs);
 
+#ifdef CONFIG_MSGQ_SPSC
+/**
+ * @brief Statically define and initialize a single-producer/single-consumer
+ * message queue.
+ *
+ * Like K_MSGQ_DEFINE(), but the message queue is in single-producer/
+ * single-consumer mode, see k_msgq_spsc_init().
+ *
+ * @param q_name Name of the message queue.
+ * @param q_msg_size Message size (in bytes).
+ * @param q_max_msgs Maximum number of messages that can be queued.
+ * @param q_align Alignment of the message queue's ring buffer.
+ *
+ */
+#define K_MSGQ_SPSC_DEFINE(q_name, q_msg_size, q_max_msgs, q_align)	\
+	static char __noinit __aligned(q_align)				\
+		_k_fifo_buf_##q_name[(q_max_msgs) * (q_msg_size)];	\
+	STRUCT_SECTION_ITERABLE(k_msgq, q_name) =			\
+	       Z_MSGQ_INITIALIZER_FLAGS(q_name, _k_fifo_buf_##q_name,	\
+					q_msg_size, q_max_msgs,	\
+					K_MSGQ_FLAG_SPSC)
+
+/**
+ * @brief Initialize a single-producer/single-consumer message queue.
+ *
+ * This routine initializes a message queue object like k_msgq_init(), in a
+ * mode where a single thread or ISR puts messages and a single thread gets,
+ * peeks at or purges them. Messages are then exchanged through the ring
+ * buffer without locking; the lock is only taken to sleep when the queue is
+ * full or empty and to wake up the other side when it does.
+ *
+ * Message queues in this mode can't be used with k_poll().
+ *
+ * @param msgq Address of the message queue.
+ * @param buffer Pointer to ring buffer that holds queued messages.
+ * @param msg_size Message size (in bytes).
+ * @param max_msgs Maximum number of messages that can be queued.
+ *
+ * @return N/A
+ */
+void k_msgq_spsc_init(struct k_msgq *msgq, char *buffer, size_t msg_size,
+		      uint32_t max_msgs);
+#endif /* CONFIG_MSGQ_SPSC */
+
 /**
  * @brief Initialize a message queue.
  *
@@ -4395,11 +4760,6 @@ __syscall void  k_msgq_get_attrs(struct k_msgq *msgq,
 				 struct k_msgq_attrs *attrs);
 
 
-static inline uint32_t z_impl_k_msgq_num_free_get(struct k_msgq *msgq)
-{
-	return msgq->max_msgs - msgq->used_msgs;
-}
-
 /**
  * @brief Get the number of messages in a message queue.
  *
@@ -4413,9 +4773,20 @@ __syscall uint32_t k_msgq_num_used_get(struct k_msgq *msgq);
 
 static inline uint32_t z_impl_k_msgq_num_used_get(struct k_msgq *msgq)
 {
+#ifdef CONFIG_MSGQ_SPSC
+	if ((msgq->flags & K_MSGQ_FLAG_SPSC) != 0U) {
+		return (uint32_t)(atomic_get(&msgq->spsc_state) &
+				  ~Z_MSGQ_SPSC_WAITING);
+	}
+#endif
 	return msgq->used_msgs;
 }
 
+static inline uint32_t z_impl_k_msgq_num_free_get(struct k_msgq *msgq)
+{
+	return msgq->max_msgs - z_impl_k_msgq_num_used_get(msgq);
+}
+
 /** @} */
 
 /**
@@ -4601,6 +4972,9 @@ struct k_pipe {
 		_wait_q_t      writers; /**< Writer wait queue */
 	} wait_q;			/** Wait queue */
 
+	size_t         put_claimed;     /**< # bytes claimed for writing */
+	size_t         get_claimed;     /**< # bytes claimed for reading */
+
 	uint8_t	       flags;		/**< Flags */
 };
 
@@ -4757,6 +5131,104 @@ __syscall size_t k_pipe_read_avail(struct k_pipe *pipe);
  */
 __syscall size_t k_pipe_write_avail(struct k_pipe *pipe);
 
+/**
+ * @brief Claim space in a pipe's buffer to write data to it in place.
+ *
+ * This routine gives direct access to the contiguous free space at the
+ * write position of @a pipe's ring buffer, waiting for some to become
+ * available if the buffer is full. Data written there is only made
+ * available to readers by k_pipe_put_commit().
+ *
+ * Only one write claim can be outstanding on a pipe, and no other thread
+ * may write to the pipe with k_pipe_put() until it is committed. Readers
+ * may use k_pipe_get() or k_pipe_get_claim() meanwhile.
+ *
+ * A user mode thread must have write access to the pipe's buffer, which
+ * must then be given to k_pipe_init() from a memory partition of the
+ * thread's memory domain.
+ *
+ * @param pipe Address of the pipe.
+ * @param data Address of area to hold the address of the claimed space.
+ * @param size Maximum number of bytes to claim.
+ * @param claimed Address of area to hold the number of bytes claimed,
+ *                which is less than @a size if the free space wraps around
+ *                the end of the ring buffer or is smaller.
+ * @param timeout Waiting period for space to become available,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Between 1 and @a size bytes were claimed.
+ * @retval -EINVAL The pipe has no buffer or @a size is zero.
+ * @retval -EBUSY A write claim is already outstanding.
+ * @retval -EIO Returned without waiting; the buffer is full.
+ * @retval -EAGAIN Waiting period timed out.
+ */
+__syscall int k_pipe_put_claim(struct k_pipe *pipe, uint8_t **data,
+			       size_t size, size_t *claimed,
+			       k_timeout_t timeout);
+
+/**
+ * @brief Commit data written to space claimed in a pipe's buffer.
+ *
+ * This routine ends the write claim on @a pipe, making the first @a size
+ * bytes of the claimed space available to readers and giving back the
+ * rest. Waiting readers are woken up.
+ *
+ * @param pipe Address of the pipe.
+ * @param size Number of bytes written, at most the number of bytes claimed.
+ *
+ * @retval 0 Data committed.
+ * @retval -EINVAL No write claim is outstanding or @a size is larger than
+ *                 the claimed space.
+ */
+__syscall int k_pipe_put_commit(struct k_pipe *pipe, size_t size);
+
+/**
+ * @brief Claim data in a pipe's buffer to read it in place.
+ *
+ * This routine gives direct access to the contiguous data at the read
+ * position of @a pipe's ring buffer, waiting for some to become available
+ * if the buffer is empty. The data stays in the pipe until it is released
+ * by k_pipe_get_commit().
+ *
+ * Only one read claim can be outstanding on a pipe, and no other thread
+ * may read from the pipe with k_pipe_get() until it is committed. Writers
+ * may use k_pipe_put() or k_pipe_put_claim() meanwhile.
+ *
+ * A user mode thread must have read access to the pipe's buffer.
+ *
+ * @param pipe Address of the pipe.
+ * @param data Address of area to hold the address of the claimed data.
+ * @param size Maximum number of bytes to claim.
+ * @param claimed Address of area to hold the number of bytes claimed.
+ * @param timeout Waiting period for data to become available,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Between 1 and @a size bytes were claimed.
+ * @retval -EINVAL The pipe has no buffer or @a size is zero.
+ * @retval -EBUSY A read claim is already outstanding.
+ * @retval -EIO Returned without waiting; the buffer is empty.
+ * @retval -EAGAIN Waiting period timed out.
+ */
+__syscall int k_pipe_get_claim(struct k_pipe *pipe, uint8_t **data,
+			       size_t size, size_t *claimed,
+			       k_timeout_t timeout);
+
+/**
+ * @brief Release data read from a pipe's buffer in place.
+ *
+ * This routine ends the read claim on @a pipe, freeing the first @a size
+ * bytes of the claimed data and leaving the rest in the pipe. Waiting
+ * writers are woken up.
+ *
+ * @param pipe Address of the pipe.
+ * @param size Number of bytes consumed, at most the number of bytes claimed.
+ *
+ * @retval 0 Data released.
+ * @retval -EINVAL No read claim is outstanding or @a size is larger than
+ *                 the claimed data.
+ */
+__syscall int k_pipe_get_commit(struct k_pipe *pipe, size_t size);
+
 /** @} */
 
 /**
@@ -5190,6 +5662,9 @@ enum _poll_types_bits {
 	/* msgq data availability */
 	_POLL_TYPE_MSGQ_DATA_AVAILABLE,
 
+	/* event object events posted */
+	_POLL_TYPE_EVENTS,
+
 	_POLL_NUM_TYPES
 };
 
@@ -5215,6 +5690,9 @@ enum _poll_states_bits {
 	/* data is available to read on a message queue */
 	_POLL_STATE_MSGQ_DATA_AVAILABLE,
 
+	/* events are set in an event object */
+	_POLL_STATE_EVENTS,
+
 	_POLL_NUM_STATES
 };
 
@@ -5246,6 +5724,7 @@ enum _poll_states_bits {
 #define K_POLL_TYPE_DATA_AVAILABLE Z_POLL_TYPE_BIT(_POLL_TYPE_DATA_AVAILABLE)
 #define K_POLL_TYPE_FIFO_DATA_AVAILABLE K_POLL_TYPE_DATA_AVAILABLE
 #define K_POLL_TYPE_MSGQ_DATA_AVAILABLE Z_POLL_TYPE_BIT(_POLL_TYPE_MSGQ_DATA_AVAILABLE)
+#define K_POLL_TYPE_EVENTS Z_POLL_TYPE_BIT(_POLL_TYPE_EVENTS)
 
 /* public - polling modes */
 enum k_poll_modes {
@@ -5263,6 +5742,7 @@ enum k_poll_modes {
 #define K_POLL_STATE_FIFO_DATA_AVAILABLE K_POLL_STATE_DATA_AVAILABLE
 #define K_POLL_STATE_MSGQ_DATA_AVAILABLE Z_POLL_STATE_BIT(_POLL_STATE_MSGQ_DATA_AVAILABLE)
 #define K_POLL_STATE_CANCELLED Z_POLL_STATE_BIT(_POLL_STATE_CANCELLED)
+#define K_POLL_STATE_EVENTS Z_POLL_STATE_BIT(_POLL_STATE_EVENTS)
 
 /* public - poll signal object */
 struct k_poll_signal {
@@ -5319,6 +5799,7 @@ struct k_poll_event {
 		struct k_fifo *fifo;
 		struct k_queue *queue;
 		struct k_msgq *msgq;
+		struct k_event *event;
 	};
 };
 
@@ -5712,6 +6193,118 @@ int k_thread_runtime_stats_all_get(k_thread_runtime_stats_t *stats);
 
 #endif
 
+/**
+ * @defgroup rcu_apis Read-Copy-Update APIs
+ * @ingroup kernel_apis
+ * @{
+ */
+
+/**
+ * @brief Read-copy-update read-side key type
+ *
+ * This type stores the interrupt state at the time of a call to
+ * k_rcu_read_lock(), to be passed to the matching k_rcu_read_unlock().
+ */
+typedef struct z_spinlock_key k_rcu_key_t;
+
+/**
+ * @brief Enter a read-side critical section
+ *
+ * Read-copy-update lets readers of data that is rarely modified access it
+ * without locks: writers publish a new version of the data with
+ * k_rcu_assign_pointer(), then call k_rcu_synchronize() to wait until no
+ * reader can still be using the old version before reclaiming it.
+ *
+ * Data protected by read-copy-update must only be accessed between
+ * k_rcu_read_lock() and k_rcu_read_unlock(), with k_rcu_dereference().
+ * Read-side critical sections may be nested, and used from ISRs, but must
+ * not block: interrupts are locked on the current CPU until the outermost
+ * k_rcu_read_unlock().  Entering and leaving a critical section only
+ * writes to per-CPU data, never to memory shared with other CPUs.
+ *
+ * @return A key value that must be passed to k_rcu_read_unlock().
+ */
+static ALWAYS_INLINE k_rcu_key_t k_rcu_read_lock(void)
+{
+	k_rcu_key_t k;
+
+	k.key = arch_irq_lock();
+
+#ifdef CONFIG_SMP
+	struct _cpu *cpu = arch_curr_cpu();
+
+	if (cpu->rcu_nested++ == 0U) {
+		cpu->rcu_seq++;
+		/* Make the sequence visible to k_rcu_synchronize() before
+		 * reading the protected data.
+		 */
+		__atomic_thread_fence(__ATOMIC_SEQ_CST);
+	}
+#endif
+
+	return k;
+}
+
+/**
+ * @brief Leave a read-side critical section
+ *
+ * @param key The value returned from the matching k_rcu_read_lock().
+ */
+static ALWAYS_INLINE void k_rcu_read_unlock(k_rcu_key_t key)
+{
+#ifdef CONFIG_SMP
+	struct _cpu *cpu = arch_curr_cpu();
+
+	if (--cpu->rcu_nested == 0U) {
+		/* Complete the reads of the protected data first */
+		__atomic_thread_fence(__ATOMIC_RELEASE);
+		cpu->rcu_seq++;
+	}
+#endif
+
+	arch_irq_unlock(key.key);
+}
+
+/**
+ * @brief Wait for the end of the ongoing read-side critical sections
+ *
+ * Returns once every read-side critical section that was entered on
+ * another CPU when this routine was called has been left.  Data that was
+ * unpublished before the call can then be reclaimed.  Read-side critical
+ * sections don't block, so this only waits for a short time.
+ *
+ * Must not be called from a read-side critical section.
+ */
+#ifdef CONFIG_SMP
+void k_rcu_synchronize(void);
+#else
+static inline void k_rcu_synchronize(void)
+{
+	/* Read-side critical sections lock interrupts on the only CPU */
+}
+#endif
+
+/**
+ * @brief Publish a pointer to data protected by read-copy-update
+ *
+ * Initialization of the data pointed to is visible to readers that get
+ * the pointer with k_rcu_dereference().
+ *
+ * @param p Pointer variable to update.
+ * @param v New value of the pointer.
+ */
+#define k_rcu_assign_pointer(p, v) __atomic_store_n(&(p), (v), __ATOMIC_RELEASE)
+
+/**
+ * @brief Read a pointer to data protected by read-copy-update
+ *
+ * @param p Pointer variable to read.
+ * @return Value of the pointer.
+ */
+#define k_rcu_dereference(p) __atomic_load_n(&(p), __ATOMIC_ACQUIRE)
+
+/** @} */
+
 #ifdef __cplusplus
 }
 #endif
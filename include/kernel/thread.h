@@ -155,6 +155,21 @@ struct _mem_domain_info {
 	struct k_mem_domain *mem_domain;
 };
 
+#ifdef CONFIG_USERSPACE_OBJ_CACHE
+struct z_object;
+
+/* Kernel objects a thread was found to have permission on */
+struct _thread_obj_cache {
+	/** Kernel object addresses, NULL if unused */
+	const void *objs[CONFIG_USERSPACE_OBJ_CACHE_SIZE];
+	/** Kernel object metadata */
+	struct z_object *kobjs[CONFIG_USERSPACE_OBJ_CACHE_SIZE];
+	/** Permission generation the entries are valid for */
+	uint32_t generation;
+	/** Next entry to replace */
+	uint8_t next;
+};
+#endif /* CONFIG_USERSPACE_OBJ_CACHE */
 #endif /* CONFIG_USERSPACE */
 
 #ifdef CONFIG_THREAD_USERSPACE_LOCAL_DATA
@@ -215,6 +230,17 @@ struct k_thread {
 	struct z_poller poller;
 #endif
 
+#if defined(CONFIG_EVENTS)
+	/** next thread to wake in k_event_post() */
+	struct k_thread *next_event_link;
+
+	/** events waited for, then events that ended the wait */
+	uint32_t events;
+
+	/** options of the wait for events */
+	uint32_t event_options;
+#endif
+
 #if defined(CONFIG_THREAD_MONITOR)
 	/** thread entry and parameters description */
 	struct __thread_entry entry;
@@ -256,6 +282,10 @@ struct k_thread {
 	k_thread_stack_t *stack_obj;
 	/** current syscall frame pointer */
 	void *syscall_frame;
+#ifdef CONFIG_USERSPACE_OBJ_CACHE
+	/** kernel objects verified for system calls */
+	struct _thread_obj_cache obj_cache;
+#endif
 #endif /* CONFIG_USERSPACE */
 
 
@@ -124,6 +124,12 @@ struct _cpu {
 #ifdef CONFIG_SMP
 	/* True when _current is allowed to context switch */
 	uint8_t swap_ok;
+
+	/* RCU read-side critical section nesting level, and sequence
+	 * number, odd while in a read-side critical section.
+	 */
+	uint32_t rcu_nested;
+	uint32_t rcu_seq;
 #endif
 
 	/* Per CPU architecture specifics */
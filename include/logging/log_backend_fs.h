@@ -0,0 +1,41 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef ZEPHYR_INCLUDE_LOGGING_LOG_BACKEND_FS_H_
+#define ZEPHYR_INCLUDE_LOGGING_LOG_BACKEND_FS_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Logger file system backend
+ * @defgroup log_backend_fs Logger file system backend
+ * @ingroup logger
+ * @{
+ */
+
+/**
+ * @brief Write out batched log data and synchronize the log file.
+ *
+ * Log data is written to the file in batches of
+ * @kconfig{CONFIG_LOG_BACKEND_FS_BATCH_SIZE} bytes and the file is
+ * synchronized according to the configured policy. This makes all the log
+ * data received so far by the backend persistent, e.g. before a reset.
+ *
+ * @retval 0 on success.
+ * @retval -errno Negative errno code if synchronizing the file failed.
+ */
+int log_backend_fs_flush(void);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_LOGGING_LOG_BACKEND_FS_H_ */
@@ -55,6 +55,7 @@ typedef struct pthread_mutex {
 	uint16_t lock_count;
 	int type;
 	_wait_q_t wait_q;
+	struct k_spinlock lock;
 } pthread_mutex_t;
 
 typedef struct pthread_mutexattr {
@@ -64,6 +65,7 @@ typedef struct pthread_mutexattr {
 /* Condition variables */
 typedef struct pthread_cond {
 	_wait_q_t wait_q;
+	struct k_spinlock lock;
 } pthread_cond_t;
 
 typedef struct pthread_condattr {
@@ -74,6 +76,7 @@ typedef struct pthread_barrier {
 	_wait_q_t wait_q;
 	int max;
 	int count;
+	struct k_spinlock lock;
 } pthread_barrier_t;
 
 typedef struct pthread_barrierattr {
@@ -82,9 +85,10 @@ typedef struct pthread_barrierattr {
 typedef uint32_t pthread_rwlockattr_t;
 
 typedef struct pthread_rwlock_obj {
-	struct k_sem rd_sem;
-	struct k_sem wr_sem;
-	struct k_sem reader_active;/* blocks WR till reader has acquired lock */
+	_wait_q_t rd_wait_q;	/* readers blocked by a writer */
+	_wait_q_t wr_wait_q;	/* writers blocked by readers or a writer */
+	struct k_spinlock lock;
+	uint32_t readers;	/* number of read locks held */
 	int32_t status;
 	k_tid_t wr_owner;
 } pthread_rwlock_t;
@@ -35,8 +35,10 @@ enum pthread_state {
 struct posix_thread {
 	struct k_thread thread;
 
-	/* List of keys that thread has called pthread_setspecific() on */
-	sys_slist_t key_list;
+	/* Values that thread has set with pthread_setspecific(), by key
+	 * index
+	 */
+	void *key_values[CONFIG_MAX_PTHREAD_KEY_COUNT];
 
 	/* Exit status */
 	void *retval;
@@ -199,6 +199,147 @@ static ALWAYS_INLINE void k_spin_release(struct k_spinlock *l)
 #endif
 }
 
+/* Reader-writer spinlock state: the number of readers holding the lock,
+ * and flags for a writer holding the lock or waiting for it.
+ */
+#define Z_RWSPIN_WRITER      (1 << 30)
+#define Z_RWSPIN_WRITER_WAIT (1 << 29)
+
+/**
+ * @brief Kernel Reader-Writer Spin Lock
+ *
+ * This struct defines a spin lock that can be held by any number of
+ * readers at the same time, or by a single writer.  Readers of data
+ * that is rarely modified don't exclude each other, unlike with
+ * k_spin_lock().
+ */
+struct k_rwspinlock {
+#ifdef CONFIG_SMP
+	atomic_t state;
+#endif
+
+#if defined(CONFIG_CPLUSPLUS) && !defined(CONFIG_SMP)
+	/* Same as for struct k_spinlock */
+	char dummy;
+#endif
+};
+
+/**
+ * @brief Lock a reader-writer spinlock for reading
+ *
+ * This routine locks the specified reader-writer spinlock for reading,
+ * returning a key handle representing interrupt state needed at unlock
+ * time.  Like with k_spin_lock(), the calling thread is not suspended or
+ * interrupted on its current CPU until it calls k_rwspin_read_unlock().
+ * Other CPUs can hold the lock for reading at the same time, but not for
+ * writing.
+ *
+ * A writer waiting for the lock has priority over new readers, so that
+ * readers can't starve writers.  Reader-writer spin locks are not
+ * recursive, and a CPU holding the lock for reading must not lock it
+ * again, for reading or for writing.
+ *
+ * @param l A pointer to the reader-writer spinlock to lock
+ * @return A key value that must be passed to k_rwspin_read_unlock() when
+ *         the lock is released.
+ */
+static ALWAYS_INLINE k_spinlock_key_t k_rwspin_read_lock(struct k_rwspinlock *l)
+{
+	ARG_UNUSED(l);
+	k_spinlock_key_t k;
+
+	k.key = arch_irq_lock();
+
+#ifdef CONFIG_SMP
+	while (true) {
+		atomic_val_t state = atomic_get(&l->state);
+
+		if ((state & (Z_RWSPIN_WRITER | Z_RWSPIN_WRITER_WAIT)) == 0 &&
+		    atomic_cas(&l->state, state, state + 1)) {
+			break;
+		}
+	}
+#endif
+
+	return k;
+}
+
+/**
+ * @brief Unlock a reader-writer spinlock locked for reading
+ *
+ * @param l A pointer to the reader-writer spinlock to release
+ * @param key The value returned from k_rwspin_read_lock() when this lock
+ *        was acquired
+ */
+static ALWAYS_INLINE void k_rwspin_read_unlock(struct k_rwspinlock *l,
+					       k_spinlock_key_t key)
+{
+	ARG_UNUSED(l);
+
+#ifdef CONFIG_SMP
+	(void)atomic_dec(&l->state);
+#endif
+	arch_irq_unlock(key.key);
+}
+
+/**
+ * @brief Lock a reader-writer spinlock for writing
+ *
+ * This routine locks the specified reader-writer spinlock for writing,
+ * with the same guarantees as k_spin_lock(): exactly one thread on one
+ * CPU holds the lock for writing, and no CPU holds it for reading.
+ *
+ * @param l A pointer to the reader-writer spinlock to lock
+ * @return A key value that must be passed to k_rwspin_write_unlock() when
+ *         the lock is released.
+ */
+static ALWAYS_INLINE k_spinlock_key_t k_rwspin_write_lock(struct k_rwspinlock *l)
+{
+	ARG_UNUSED(l);
+	k_spinlock_key_t k;
+
+	k.key = arch_irq_lock();
+
+#ifdef CONFIG_SMP
+	while (true) {
+		atomic_val_t state = atomic_get(&l->state);
+
+		if ((state & ~Z_RWSPIN_WRITER_WAIT) == 0) {
+			/* No reader nor writer: take the lock, dropping
+			 * the wait flag this or another writer set.
+			 */
+			if (atomic_cas(&l->state, state, Z_RWSPIN_WRITER)) {
+				break;
+			}
+		} else if ((state & Z_RWSPIN_WRITER_WAIT) == 0) {
+			/* Hold new readers off until the lock is free */
+			(void)atomic_or(&l->state, Z_RWSPIN_WRITER_WAIT);
+		}
+	}
+#endif
+
+	return k;
+}
+
+/**
+ * @brief Unlock a reader-writer spinlock locked for writing
+ *
+ * @param l A pointer to the reader-writer spinlock to release
+ * @param key The value returned from k_rwspin_write_lock() when this lock
+ *        was acquired
+ */
+static ALWAYS_INLINE void k_rwspin_write_unlock(struct k_rwspinlock *l,
+						k_spinlock_key_t key)
+{
+	ARG_UNUSED(l);
+
+#ifdef CONFIG_SMP
+	/* Keep the wait flag another writer may have set */
+	(void)atomic_and(&l->state, ~Z_RWSPIN_WRITER);
+#endif
+	arch_irq_unlock(key.key);
+}
+
 #ifdef __cplusplus
 }
 #endif
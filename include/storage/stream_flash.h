@@ -22,6 +22,9 @@
 
 #include <stdbool.h>
 #include <drivers/flash.h>
+#ifdef CONFIG_STREAM_FLASH_ASYNC
+#include <kernel.h>
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -36,7 +39,9 @@ extern "C" {
  * data read back from the flash after a flash write has completed.
  * This enables verifying that the data has been correctly stored (for
  * instance by using a SHA function). The write buffer 'buf' provided in
- * stream_flash_init is used as a read buffer for this purpose.
+ * stream_flash_init is used as a read buffer for this purpose. With
+ * asynchronous writes the callback may be given either of the two write
+ * buffers, and is invoked from the stream flash write thread.
  *
  * @param buf Pointer to the data read.
  * @param len The length of the data read.
@@ -62,6 +67,14 @@ struct stream_flash_ctx {
 #ifdef CONFIG_STREAM_FLASH_ERASE
 	off_t last_erased_page_start_offset; /* Last erased offset */
 #endif
+#ifdef CONFIG_STREAM_FLASH_ASYNC
+	uint8_t *async_buf; /* Buffer programmed in the background */
+	size_t async_bytes; /* Number of bytes being programmed */
+	size_t async_addr; /* Offset async_buf is being programmed at */
+	int async_err; /* Error of the last background operation */
+	struct k_sem async_idle; /* Given when async_buf is not in use */
+	struct k_work async_work; /* Background program operation */
+#endif
 };
 
 /**
@@ -83,6 +96,45 @@ struct stream_flash_ctx {
 int stream_flash_init(struct stream_flash_ctx *ctx, const struct device *fdev,
 		      uint8_t *buf, size_t buf_len, size_t offset, size_t size,
 		      stream_flash_callback_t cb);
+/**
+ * @brief Enable asynchronous double buffered writes for a context.
+ *
+ * Once enabled, stream_flash_buffered_write() hands each full write buffer
+ * over to a background thread and continues filling @p buf while it is
+ * being programmed. If erasing is enabled, the page needed by the next
+ * buffer is erased in the background as well. A write only blocks when
+ * both buffers are in use, and a flush write blocks until all data has
+ * been programmed.
+ *
+ * Errors of background operations are reported by the next call to
+ * stream_flash_buffered_write() or stream_flash_async_wait(), and then by
+ * every following call until the context is initialized again.
+ *
+ * Must be called after @ref stream_flash_init and before any data is
+ * written. The context must not be initialized again while an operation
+ * is in progress, see stream_flash_async_wait().
+ *
+ * @param ctx context
+ * @param buf Second write buffer, of the buf_len given to
+ *            @ref stream_flash_init
+ *
+ * @return non-negative on success, negative errno code on fail
+ */
+int stream_flash_async_enable(struct stream_flash_ctx *ctx, uint8_t *buf);
+
+/**
+ * @brief Wait for background write operations of a context to complete.
+ *
+ * Data still held in the write buffer is not written, use a flush write
+ * for that. Does nothing if asynchronous writes are not enabled.
+ *
+ * @param ctx context
+ *
+ * @return non-negative on success, negative errno code of a failed
+ *         background operation otherwise
+ */
+int stream_flash_async_wait(struct stream_flash_ctx *ctx);
+
 /**
  * @brief Read number of bytes written to the flash.
  *
@@ -96,6 +96,12 @@ struct k_mem_paging_stats_t {
 		/** Number of page faults while in ISR */
 		unsigned long			in_isr;
 #endif
+
+		/**
+		 * Time spent servicing page faults, in the same unit as the
+		 * timing histograms
+		 */
+		uint64_t			cycles;
 	} pagefaults;
 
 	struct {
@@ -104,7 +110,56 @@ struct k_mem_paging_stats_t {
 
 		/** Number of dirty pages selected for eviction */
 		unsigned long			dirty;
+
+		/** Number of page frames examined by the eviction algorithm */
+		unsigned long			scanned;
+
+		/**
+		 * Number of recently accessed page frames passed over by
+		 * the eviction algorithm
+		 */
+		unsigned long			second_chance;
+
+#ifdef CONFIG_EVICTION_CLOCK_PRO
+		/** Number of cold pages promoted to hot */
+		unsigned long			promoted;
+
+		/** Number of hot pages demoted to cold */
+		unsigned long			demoted;
+
+		/**
+		 * Number of page faults on data pages evicted while in
+		 * their test period
+		 */
+		unsigned long			refaults;
+#endif /* CONFIG_EVICTION_CLOCK_PRO */
 	} eviction;
+
+#ifdef CONFIG_DEMAND_PAGING_READ_AHEAD
+	struct {
+		/** Number of page faults which triggered read ahead */
+		unsigned long			triggers;
+
+		/** Number of data pages paged in by read ahead */
+		unsigned long			pages;
+	} read_ahead;
+#endif /* CONFIG_DEMAND_PAGING_READ_AHEAD */
+
+#ifdef CONFIG_BACKING_STORE_RAM_COMPRESSED
+	struct {
+		/** Number of data pages currently in the backing store */
+		unsigned long			pages;
+
+		/** Size of the data pages currently in the backing store */
+		unsigned long			bytes;
+
+		/**
+		 * Number of data pages paged out uncompressed because
+		 * compression didn't make them smaller
+		 */
+		unsigned long			incompressible;
+	} compression;
+#endif /* CONFIG_BACKING_STORE_RAM_COMPRESSED */
 #endif /* CONFIG_DEMAND_PAGING_STATS */
 };
 
@@ -535,6 +590,22 @@ struct z_page_frame *k_mem_paging_eviction_select(bool *dirty);
  */
 void k_mem_paging_eviction_init(void);
 
+/**
+ * Notify the eviction algorithm of a page-in
+ *
+ * The kernel will invoke this after a data page has been paged into a page
+ * frame, either for a page fault or for read ahead, for eviction algorithms
+ * which track page state beyond the accessed and dirty bits of the page
+ * tables. pf->addr will indicate the virtual address of the data page.
+ *
+ * This function is only invoked if CONFIG_EVICTION_TRACKING is enabled.
+ *
+ * This function is invoked with interrupts locked.
+ *
+ * @param pf Page frame the data page was paged into
+ */
+void k_mem_paging_eviction_add(struct z_page_frame *pf);
+
 /** @} */
 
 /**
@@ -11,9 +11,11 @@
  * sys_mutex behaves almost exactly like k_mutex, with the added advantage
  * that a sys_mutex instance can reside in user memory.
  *
- * Further enhancements will support locking/unlocking uncontended sys_mutexes
- * with simple atomic ops instead of syscalls, similar to Linux's
- * FUTEX_LOCK_PI and FUTEX_UNLOCK_PI
+ * With CONFIG_SYS_MUTEX_FAST_PATH, uncontended sys_mutexes are locked and
+ * unlocked with simple atomic ops instead of syscalls, similar to Linux's
+ * FUTEX_LOCK_PI and FUTEX_UNLOCK_PI: val holds the ID of the owner thread,
+ * with SYS_MUTEX_CONTENDED set once another thread waits for the mutex,
+ * telling the owner to let the kernel wake it when unlocking.
  */
 
 #ifdef __cplusplus
@@ -24,15 +26,29 @@ extern "C" {
 #include <sys/atomic.h>
 #include <zephyr/types.h>
 #include <sys_clock.h>
+#include <sys/util.h>
+#ifdef CONFIG_SYS_MUTEX_FAST_PATH
+#include <kernel.h>
+#endif
 
 struct sys_mutex {
-	/* Currently unused, but will be used to store state for fast mutexes
-	 * that can be locked/unlocked with atomic ops if there is no
-	 * contention
+#ifdef CONFIG_SYS_MUTEX_FAST_PATH
+	/* Owner thread and SYS_MUTEX_CONTENDED flag, so that the mutex
+	 * can be locked/unlocked with atomic ops if there is no contention
 	 */
+	atomic_ptr_t val;
+
+	/* Lock count, only accessed by the owner */
+	uint32_t lock_count;
+#else
+	/* Unused without the fast path */
 	atomic_t val;
+#endif
 };
 
+/* Set in sys_mutex val when threads are waiting for the mutex */
+#define SYS_MUTEX_CONTENDED BIT(0)
+
 /**
  * @defgroup user_mutex_apis User mode mutex APIs
  * @ingroup kernel_apis
@@ -100,11 +116,38 @@ __syscall int z_sys_mutex_kernel_unlock(struct sys_mutex *mutex);
  * @retval -EAGAIN Waiting period timed out.
  * @retval -EACCES Caller has no access to provided mutex address
  * @retval -EINVAL Provided mutex not recognized by the kernel
+ *
+ * With CONFIG_SYS_MUTEX_FAST_PATH the mutex is accessed directly, so an
+ * inaccessible address faults rather than returning -EACCES.
  */
 static inline int sys_mutex_lock(struct sys_mutex *mutex, k_timeout_t timeout)
 {
-	/* For now, make the syscall unconditionally */
+#ifdef CONFIG_SYS_MUTEX_FAST_PATH
+	void *self = k_current_get();
+	int ret;
+
+	if (likely(atomic_ptr_cas(&mutex->val, NULL, self))) {
+		mutex->lock_count = 1U;
+		return 0;
+	}
+
+	if (((uintptr_t)atomic_ptr_get(&mutex->val) & ~SYS_MUTEX_CONTENDED) ==
+	    (uintptr_t)self) {
+		mutex->lock_count++;
+		return 0;
+	}
+
+	/* Contended, wait in the kernel */
+	ret = z_sys_mutex_kernel_lock(mutex, timeout);
+	if (ret == 0) {
+		mutex->lock_count = 1U;
+	}
+
+	return ret;
+#else
+	/* Without the fast path, make the syscall unconditionally */
 	return z_sys_mutex_kernel_lock(mutex, timeout);
+#endif
 }
 
 /**
@@ -126,8 +169,27 @@ static inline int sys_mutex_lock(struct sys_mutex *mutex, k_timeout_t timeout)
  */
 static inline int sys_mutex_unlock(struct sys_mutex *mutex)
 {
-	/* For now, make the syscall unconditionally */
+#ifdef CONFIG_SYS_MUTEX_FAST_PATH
+	void *self = k_current_get();
+
+	if (((uintptr_t)atomic_ptr_get(&mutex->val) & ~SYS_MUTEX_CONTENDED) ==
+	    (uintptr_t)self) {
+		if (mutex->lock_count > 1U) {
+			mutex->lock_count--;
+			return 0;
+		}
+
+		if (likely(atomic_ptr_cas(&mutex->val, self, NULL))) {
+			return 0;
+		}
+	}
+
+	/* Contended or not owned, let the kernel sort it out */
 	return z_sys_mutex_kernel_unlock(mutex);
+#else
+	/* Without the fast path, make the syscall unconditionally */
+	return z_sys_mutex_kernel_unlock(mutex);
+#endif
 }
 
 #include <syscalls/mutex.h>
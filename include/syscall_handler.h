@@ -114,6 +114,15 @@ typedef void (*_wordlist_cb_func_t)(struct z_object *ko, void *context);
  */
 extern void z_object_wordlist_foreach(_wordlist_cb_func_t func, void *context);
 
+#ifdef CONFIG_USERSPACE_OBJ_CACHE
+/**
+ * Empty a new thread's cache of verified kernel objects
+ *
+ * @param thread Thread being created
+ */
+extern void z_thread_obj_cache_init(struct k_thread *thread);
+#endif
+
 /**
  * Copy all kernel object permissions from the parent to the child
  *
@@ -445,11 +454,35 @@ static inline int z_obj_validation_check(struct z_object *ko,
 	return ret;
 }
 
+#ifdef CONFIG_USERSPACE_OBJ_CACHE
+/**
+ * Validate a kernel object for a system call made by the current thread
+ *
+ * Like z_obj_validation_check() on the result of z_object_find(), but
+ * objects in the current thread's cache of objects it was found to have
+ * permission on are neither looked up nor checked for permission again.
+ *
+ * @param obj Address of the kernel object
+ * @param otype Expected type of the kernel object, or K_OBJ_ANY
+ * @param init Indicate whether the object needs to already be in initialized
+ *             or uninitialized state, or that we don't care
+ * @return See z_object_validate()
+ */
+extern int z_obj_cached_validation_check(const void *obj,
+					 enum k_objects otype,
+					 enum _obj_init_check init);
+
+#define Z_SYSCALL_IS_OBJ(ptr, type, init) \
+	Z_SYSCALL_VERIFY_MSG(z_obj_cached_validation_check(		\
+				     (const void *)ptr,			\
+				     type, init) == 0, "access denied")
+#else
 #define Z_SYSCALL_IS_OBJ(ptr, type, init) \
 	Z_SYSCALL_VERIFY_MSG(z_obj_validation_check(			\
 				     z_object_find((const void *)ptr),	\
 				     (const void *)ptr,			\
 				     type, init) == 0, "access denied")
+#endif
 
 /**
  * @brief Runtime check driver object pointer for presence of operation
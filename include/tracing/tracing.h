@@ -889,6 +889,98 @@
  * @}
  */ /* end of condvar_tracing_apis */
 
+/**
+ * @brief Event Tracing APIs
+ * @defgroup event_tracing_apis Event Tracing APIs
+ * @ingroup tracing_apis
+ * @{
+ */
+
+/**
+ * @brief Trace initialization of Event
+ * @param event Event object
+ */
+#define sys_port_trace_k_event_init(event)
+
+/**
+ * @brief Trace Event post enter
+ * @param event Event object
+ * @param events Set of events
+ */
+#define sys_port_trace_k_event_post_enter(event, events)
+
+/**
+ * @brief Trace Event post exit
+ * @param event Event object
+ * @param events Set of events
+ */
+#define sys_port_trace_k_event_post_exit(event, events)
+
+/**
+ * @brief Trace Event set enter
+ * @param event Event object
+ * @param events Set of events
+ */
+#define sys_port_trace_k_event_set_enter(event, events)
+
+/**
+ * @brief Trace Event set exit
+ * @param event Event object
+ * @param events Set of events
+ */
+#define sys_port_trace_k_event_set_exit(event, events)
+
+/**
+ * @brief Trace Event clear
+ * @param event Event object
+ * @param events Set of events
+ */
+#define sys_port_trace_k_event_clear(event, events)
+
+/**
+ * @brief Trace Event wait for any enter
+ * @param event Event object
+ * @param events Set of events
+ * @param timeout Timeout period
+ */
+#define sys_port_trace_k_event_wait_enter(event, events, timeout)
+
+/**
+ * @brief Trace Event wait blocking
+ * @param event Event object
+ * @param events Set of events
+ * @param timeout Timeout period
+ */
+#define sys_port_trace_k_event_wait_blocking(event, events, timeout)
+
+/**
+ * @brief Trace Event wait for any exit
+ * @param event Event object
+ * @param events Set of events
+ * @param ret Return value
+ */
+#define sys_port_trace_k_event_wait_exit(event, events, ret)
+
+/**
+ * @brief Trace Event wait for all enter
+ * @param event Event object
+ * @param events Set of events
+ * @param timeout Timeout period
+ */
+#define sys_port_trace_k_event_wait_all_enter(event, events, timeout)
+
+/**
+ * @brief Trace Event wait for all exit
+ * @param event Event object
+ * @param events Set of events
+ * @param ret Return value
+ */
+#define sys_port_trace_k_event_wait_all_exit(event, events, ret)
+
+/**
+ * @}
+ */ /* end of event_tracing_apis */
+
 
 
 
@@ -83,6 +83,12 @@
 	#define sys_port_trace_type_mask_k_condvar(trace_call)
 #endif
 
+#if defined(CONFIG_TRACING_EVENT)
+	#define sys_port_trace_type_mask_k_event(trace_call) trace_call
+#else
+	#define sys_port_trace_type_mask_k_event(trace_call)
+#endif
+
 #if defined(CONFIG_TRACING_QUEUE)
 	#define sys_port_trace_type_mask_k_queue(trace_call) trace_call
 #else
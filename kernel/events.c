@@ -0,0 +1,271 @@
+/*
+ * Copyright (c) 2021 Intel Corporation.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file event objects library
+ *
+ * An event object holds 32 event flags.  Threads wait for any or all of a
+ * subset of them; threads and ISRs post, set or clear them.  Waiting does
+ * not consume events.
+ *
+ * Waiting threads keep the events they wait for and the wait options in
+ * their thread structure, so that updating the events takes constant time
+ * when nobody waits, and a single pass over the wait queue otherwise.
+ */
+
+#include <kernel.h>
+#include <kernel_structs.h>
+#include <toolchain.h>
+#include <ksched.h>
+#include <wait_q.h>
+#include <syscall_handler.h>
+
+#define EVENT_WAIT_ANY      0x00U
+#define EVENT_WAIT_ALL      0x01U
+#define EVENT_WAIT_MASK     0x01U
+#define EVENT_WAIT_RESET    0x02U
+
+void z_impl_k_event_init(struct k_event *event)
+{
+	event->events = 0;
+	event->lock = (struct k_spinlock) {};
+
+	SYS_PORT_TRACING_OBJ_INIT(k_event, event);
+
+	z_waitq_init(&event->wait_q);
+
+#ifdef CONFIG_POLL
+	sys_dlist_init(&event->poll_events);
+#endif
+
+	z_object_init(event);
+}
+
+#ifdef CONFIG_USERSPACE
+void z_vrfy_k_event_init(struct k_event *event)
+{
+	Z_OOPS(Z_SYSCALL_OBJ_NEVER_INIT(event, K_OBJ_EVENT));
+	z_impl_k_event_init(event);
+}
+#include <syscalls/k_event_init_mrsh.c>
+#endif
+
+/* Check whether @p current events satisfy a wait for @p desired events
+ * with wait @p options.
+ */
+static bool are_wait_conditions_met(uint32_t desired, uint32_t current,
+				    uint32_t options)
+{
+	uint32_t match = current & desired;
+
+	if ((options & EVENT_WAIT_MASK) == EVENT_WAIT_ALL) {
+		return match == desired;
+	}
+
+	return match != 0U;
+}
+
+/* Replace the events selected by @p events_mask with those of @p events,
+ * and make ready the threads whose wait is satisfied.
+ */
+static void k_event_post_internal(struct k_event *event, uint32_t events,
+				  uint32_t events_mask)
+{
+	k_spinlock_key_t key;
+	struct k_thread *thread;
+	struct k_thread *head = NULL;
+
+	key = k_spin_lock(&event->lock);
+
+	events = (event->events & ~events_mask) | (events & events_mask);
+	event->events = events;
+
+	/* The wait queue can't be modified while walking it, so link the
+	 * threads to wake first.
+	 */
+	_WAIT_Q_FOR_EACH(&event->wait_q, thread) {
+		if (are_wait_conditions_met(thread->events, events,
+					    thread->event_options)) {
+			thread->next_event_link = head;
+			head = thread;
+		}
+	}
+
+	for (thread = head; thread != NULL; thread = thread->next_event_link) {
+		z_unpend_thread(thread);
+		arch_thread_return_value_set(thread, 0);
+		thread->events = events;
+		z_ready_thread(thread);
+	}
+
+#ifdef CONFIG_POLL
+	if (events != 0U) {
+		z_handle_obj_poll_events(&event->poll_events,
+					 K_POLL_STATE_EVENTS);
+	}
+#endif
+
+	z_reschedule(&event->lock, key);
+}
+
+void z_impl_k_event_post(struct k_event *event, uint32_t events)
+{
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_event, post, event, events);
+
+	k_event_post_internal(event, events, events);
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_event, post, event, events);
+}
+
+#ifdef CONFIG_USERSPACE
+void z_vrfy_k_event_post(struct k_event *event, uint32_t events)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(event, K_OBJ_EVENT));
+	z_impl_k_event_post(event, events);
+}
+#include <syscalls/k_event_post_mrsh.c>
+#endif
+
+void z_impl_k_event_set(struct k_event *event, uint32_t events)
+{
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_event, set, event, events);
+
+	k_event_post_internal(event, events, ~0U);
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_event, set, event, events);
+}
+
+#ifdef CONFIG_USERSPACE
+void z_vrfy_k_event_set(struct k_event *event, uint32_t events)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(event, K_OBJ_EVENT));
+	z_impl_k_event_set(event, events);
+}
+#include <syscalls/k_event_set_mrsh.c>
+#endif
+
+void z_impl_k_event_clear(struct k_event *event, uint32_t events)
+{
+	k_spinlock_key_t key = k_spin_lock(&event->lock);
+
+	SYS_PORT_TRACING_OBJ_FUNC(k_event, clear, event, events);
+
+	/* Clearing can't satisfy any wait, nothing to wake */
+	event->events &= ~events;
+
+	k_spin_unlock(&event->lock, key);
+}
+
+#ifdef CONFIG_USERSPACE
+void z_vrfy_k_event_clear(struct k_event *event, uint32_t events)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(event, K_OBJ_EVENT));
+	z_impl_k_event_clear(event, events);
+}
+#include <syscalls/k_event_clear_mrsh.c>
+#endif
+
+static uint32_t k_event_wait_internal(struct k_event *event, uint32_t events,
+				      uint32_t options, k_timeout_t timeout)
+{
+	uint32_t rv = 0;
+	k_spinlock_key_t key;
+	struct k_thread *thread;
+
+	__ASSERT(((arch_is_in_isr() == false) ||
+		  K_TIMEOUT_EQ(timeout, K_NO_WAIT)), "");
+
+	if (events == 0U) {
+		return 0;
+	}
+
+	key = k_spin_lock(&event->lock);
+
+	if ((options & EVENT_WAIT_RESET) != 0U) {
+		event->events = 0;
+	}
+
+	if (are_wait_conditions_met(events, event->events, options)) {
+		rv = event->events;
+		k_spin_unlock(&event->lock, key);
+		goto out;
+	}
+
+	if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		k_spin_unlock(&event->lock, key);
+		goto out;
+	}
+
+	SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_event, wait, event, events,
+					   timeout);
+
+	/* k_event_post_internal() replaces the events waited for with the
+	 * events that satisfied the wait.
+	 */
+	thread = _current;
+	thread->events = events;
+	thread->event_options = options;
+
+	if (z_pend_curr(&event->lock, key, &event->wait_q, timeout) == 0) {
+		rv = thread->events;
+	}
+
+out:
+	return rv & events;
+}
+
+uint32_t z_impl_k_event_wait(struct k_event *event, uint32_t events,
+			     bool reset, k_timeout_t timeout)
+{
+	uint32_t options = reset ? EVENT_WAIT_RESET : 0U;
+	uint32_t ret;
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_event, wait, event, events, timeout);
+
+	ret = k_event_wait_internal(event, events, options | EVENT_WAIT_ANY,
+				    timeout);
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_event, wait, event, events, ret);
+
+	return ret;
+}
+
+#ifdef CONFIG_USERSPACE
+uint32_t z_vrfy_k_event_wait(struct k_event *event, uint32_t events,
+			     bool reset, k_timeout_t timeout)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(event, K_OBJ_EVENT));
+	return z_impl_k_event_wait(event, events, reset, timeout);
+}
+#include <syscalls/k_event_wait_mrsh.c>
+#endif
+
+uint32_t z_impl_k_event_wait_all(struct k_event *event, uint32_t events,
+				 bool reset, k_timeout_t timeout)
+{
+	uint32_t options = reset ? EVENT_WAIT_RESET : 0U;
+	uint32_t ret;
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_event, wait_all, event, events,
+					timeout);
+
+	ret = k_event_wait_internal(event, events, options | EVENT_WAIT_ALL,
+				    timeout);
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_event, wait_all, event, events, ret);
+
+	return ret;
+}
+
+#ifdef CONFIG_USERSPACE
+uint32_t z_vrfy_k_event_wait_all(struct k_event *event, uint32_t events,
+				 bool reset, k_timeout_t timeout)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(event, K_OBJ_EVENT));
+	return z_impl_k_event_wait_all(event, events, reset, timeout);
+}
+#include <syscalls/k_event_wait_all_mrsh.c>
+#endif
@@ -180,6 +180,13 @@ void z_mem_domain_exit_thread(struct k_thread *thread);
  * not recommended.
  */
 extern struct k_spinlock z_mem_domain_lock;
+
+#ifdef CONFIG_SYS_MUTEX_FAST_PATH
+/* sys_mutex teardown hook, called from z_thread_abort() to forget the
+ * thread as the owner of any sys_mutex
+ */
+void z_sys_mutex_thread_abort(struct k_thread *thread);
+#endif
 #endif /* CONFIG_USERSPACE */
 
 #ifdef CONFIG_GDBSTUB
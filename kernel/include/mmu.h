@@ -291,6 +291,74 @@ int z_page_frame_evict(uintptr_t phys);
  *               be treated as an error, and not re-tried.
  */
 bool z_page_fault(void *addr);
+
+#ifdef CONFIG_DEMAND_PAGING_STATS
+/**
+ * Account the work done by the eviction algorithm to select a page frame
+ *
+ * Invoked by eviction algorithms with interrupts locked.
+ *
+ * @param scanned Number of page frames examined
+ * @param second_chance Number of examined page frames passed over because
+ *                      they were recently accessed
+ */
+void z_paging_stats_eviction_scan(unsigned long scanned,
+				  unsigned long second_chance);
+
+#ifdef CONFIG_EVICTION_CLOCK_PRO
+/**
+ * Account Clock-Pro page state changes
+ *
+ * Invoked by the Clock-Pro eviction algorithm with interrupts locked.
+ *
+ * @param promoted Number of cold pages promoted to hot
+ * @param demoted Number of hot pages demoted to cold
+ * @param refaults Number of page-ins of data pages evicted in their test
+ *                 period
+ */
+void z_paging_stats_clock_pro(unsigned long promoted, unsigned long demoted,
+			      unsigned long refaults);
+#endif /* CONFIG_EVICTION_CLOCK_PRO */
+
+#ifdef CONFIG_BACKING_STORE_RAM_COMPRESSED
+/**
+ * Account the compressed backing store contents
+ *
+ * Invoked by the compressed backing store with interrupts locked.
+ *
+ * @param pages Number of data pages stored
+ * @param bytes Size of the data pages stored, as compressed
+ * @param incompressible Number of data pages stored uncompressed since boot
+ */
+void z_paging_stats_compression(unsigned long pages, unsigned long bytes,
+				unsigned long incompressible);
+#endif /* CONFIG_BACKING_STORE_RAM_COMPRESSED */
+#else
+static inline void z_paging_stats_eviction_scan(unsigned long scanned,
+						unsigned long second_chance)
+{
+	ARG_UNUSED(scanned);
+	ARG_UNUSED(second_chance);
+}
+
+static inline void z_paging_stats_clock_pro(unsigned long promoted,
+					    unsigned long demoted,
+					    unsigned long refaults)
+{
+	ARG_UNUSED(promoted);
+	ARG_UNUSED(demoted);
+	ARG_UNUSED(refaults);
+}
+
+static inline void z_paging_stats_compression(unsigned long pages,
+					      unsigned long bytes,
+					      unsigned long incompressible)
+{
+	ARG_UNUSED(pages);
+	ARG_UNUSED(bytes);
+	ARG_UNUSED(incompressible);
+}
+#endif /* CONFIG_DEMAND_PAGING_STATS */
 #endif /* CONFIG_DEMAND_PAGING */
 #endif /* CONFIG_MMU */
 #endif /* KERNEL_INCLUDE_MMU_H */
@@ -1178,6 +1178,20 @@ static inline void paging_stats_faults_inc(struct k_thread *faulting_thread,
 #endif /* CONFIG_DEMAND_PAGING_STATS */
 }
 
+static inline void paging_stats_faults_time(struct k_thread *faulting_thread,
+					    uint64_t cycles)
+{
+#ifdef CONFIG_DEMAND_PAGING_STATS
+	paging_stats.pagefaults.cycles += cycles;
+
+#ifdef CONFIG_DEMAND_PAGING_THREAD_STATS
+	faulting_thread->paging_stats.pagefaults.cycles += cycles;
+#else
+	ARG_UNUSED(faulting_thread);
+#endif
+#endif /* CONFIG_DEMAND_PAGING_STATS */
+}
+
 static inline void paging_stats_eviction_inc(struct k_thread *faulting_thread,
 					     bool dirty)
 {
@@ -1233,15 +1247,168 @@ static inline struct z_page_frame *do_eviction_select(bool *dirty)
 	return pf;
 }
 
+/*
+ * Page in the paged out data page at addr from page_in_location, evicting
+ * some other data page if there are no free page frames. Called and returns
+ * with interrupts locked, which are released while the backing store is
+ * accessed if CONFIG_DEMAND_PAGING_ALLOW_IRQ is enabled.
+ */
+static struct z_page_frame *page_in_locked(void *addr,
+					   uintptr_t page_in_location,
+					   bool pin, int *key,
+					   struct k_thread *faulting_thread)
+{
+	struct z_page_frame *pf;
+	uintptr_t page_out_location;
+	bool dirty = false;
+	int ret;
+
+	pf = free_page_frame_list_get();
+	if (pf == NULL) {
+		/* Need to evict a page frame */
+		pf = do_eviction_select(&dirty);
+		__ASSERT(pf != NULL, "failed to get a page frame");
+		LOG_DBG("evicting %p at 0x%lx", pf->addr,
+			z_page_frame_to_phys(pf));
+
+		paging_stats_eviction_inc(faulting_thread, dirty);
+	}
+	ret = page_frame_prepare_locked(pf, &dirty, true, &page_out_location);
+	__ASSERT(ret == 0, "failed to prepare page frame");
+	(void)ret;
+
+#ifdef CONFIG_DEMAND_PAGING_ALLOW_IRQ
+	irq_unlock(*key);
+	/* Interrupts are now unlocked if they were not locked when we entered
+	 * this function, and we may service ISRs. The scheduler is still
+	 * locked.
+	 */
+#endif /* CONFIG_DEMAND_PAGING_ALLOW_IRQ */
+	if (dirty) {
+		do_backing_store_page_out(page_out_location);
+	}
+	do_backing_store_page_in(page_in_location);
+
+#ifdef CONFIG_DEMAND_PAGING_ALLOW_IRQ
+	*key = irq_lock();
+	pf->flags &= ~Z_PAGE_FRAME_BUSY;
+#endif /* CONFIG_DEMAND_PAGING_ALLOW_IRQ */
+	if (pin) {
+		pf->flags |= Z_PAGE_FRAME_PINNED;
+	}
+	pf->flags |= Z_PAGE_FRAME_MAPPED;
+	pf->addr = UINT_TO_POINTER(POINTER_TO_UINT(addr)
+				   & ~(CONFIG_MMU_PAGE_SIZE - 1));
+
+	arch_mem_page_in(addr, z_page_frame_to_phys(pf));
+	k_mem_paging_backing_store_page_finalize(pf, page_in_location);
+#ifdef CONFIG_EVICTION_TRACKING
+	k_mem_paging_eviction_add(pf);
+#endif
+
+	return pf;
+}
+
+#ifdef CONFIG_DEMAND_PAGING_READ_AHEAD
+/* Virtual page number and distance, in pages, from the previous page fault.
+ * Read ahead pages count as faults so that a stream which is being read
+ * ahead keeps its stride.
+ */
+static uintptr_t read_ahead_last;
+static intptr_t read_ahead_stride;
+
+/* Return the stride to read ahead at, or 0 if the page fault at addr isn't
+ * part of a stream.
+ */
+static intptr_t read_ahead_stride_get(void *addr)
+{
+	uintptr_t page = POINTER_TO_UINT(addr) / CONFIG_MMU_PAGE_SIZE;
+	intptr_t stride = (intptr_t)(page - read_ahead_last);
+	bool stream;
+
+	/* Sequential access is common enough to not wait for confirmation */
+	stream = (stride == 1) || (stride == -1) ||
+		 (stride == read_ahead_stride);
+	if ((stride > CONFIG_DEMAND_PAGING_READ_AHEAD_STRIDE_MAX) ||
+	    (stride < -CONFIG_DEMAND_PAGING_READ_AHEAD_STRIDE_MAX)) {
+		stream = false;
+	}
+
+	read_ahead_last = page;
+	read_ahead_stride = stride;
+
+	return stream ? stride : 0;
+}
+
+/*
+ * Page in the data pages following addr along the stream it belongs to, if
+ * any. The page frame of addr is kept from being evicted meanwhile.
+ */
+static void read_ahead_locked(void *addr, struct z_page_frame *pf, int *key,
+			      struct k_thread *faulting_thread)
+{
+	intptr_t stride = read_ahead_stride_get(addr);
+	uint8_t pinned = pf->flags & Z_PAGE_FRAME_PINNED;
+	uint8_t *pos = addr;
+	uintptr_t location;
+	enum arch_page_location status;
+
+	if (stride == 0) {
+		return;
+	}
+
+#ifdef CONFIG_DEMAND_PAGING_STATS
+	paging_stats.read_ahead.triggers++;
+#endif
+	pf->flags |= Z_PAGE_FRAME_PINNED;
+
+	for (int i = 0; i < CONFIG_DEMAND_PAGING_READ_AHEAD_PAGES; i++) {
+		intptr_t offset = stride * CONFIG_MMU_PAGE_SIZE;
+
+		if ((offset > 0 && (Z_VIRT_RAM_END - pos) <= offset) ||
+		    (offset < 0 && (pos - Z_VIRT_RAM_START) < -offset)) {
+			break;
+		}
+		pos += offset;
+
+		/* Don't read past the end of the mapping, but skip over
+		 * pages already loaded.
+		 */
+		status = arch_page_location_get(pos, &location);
+		if (status == ARCH_PAGE_LOCATION_BAD) {
+			break;
+		}
+		if (status == ARCH_PAGE_LOCATION_PAGED_IN) {
+			continue;
+		}
+
+		(void)page_in_locked(pos, location, false, key,
+				     faulting_thread);
+#ifdef CONFIG_DEMAND_PAGING_STATS
+		paging_stats.read_ahead.pages++;
+#endif
+	}
+
+	read_ahead_last = POINTER_TO_UINT(pos) / CONFIG_MMU_PAGE_SIZE;
+	pf->flags = (pf->flags & ~Z_PAGE_FRAME_PINNED) | pinned;
+}
+#endif /* CONFIG_DEMAND_PAGING_READ_AHEAD */
+
 static bool do_page_fault(void *addr, bool pin)
 {
 	struct z_page_frame *pf;
-	int key, ret;
-	uintptr_t page_in_location, page_out_location;
+	int key;
+	uintptr_t page_in_location;
 	enum arch_page_location status;
 	bool result;
-	bool dirty = false;
 	struct k_thread *faulting_thread = _current_cpu->current;
+#ifdef CONFIG_DEMAND_PAGING_STATS
+#ifdef CONFIG_DEMAND_PAGING_STATS_USING_TIMING_FUNCTIONS
+	timing_t time_start, time_end;
+#else
+	uint32_t time_start;
+#endif /* CONFIG_DEMAND_PAGING_STATS_USING_TIMING_FUNCTIONS */
+#endif /* CONFIG_DEMAND_PAGING_STATS */
 
 	__ASSERT(page_frames_initialized, "page fault at %p happened too early",
 		 addr);
@@ -1313,45 +1480,30 @@ static bool do_page_fault(void *addr, bool pin)
 		 "unexpected status value %d", status);
 
 	paging_stats_faults_inc(faulting_thread, key);
+#ifdef CONFIG_DEMAND_PAGING_STATS
+#ifdef CONFIG_DEMAND_PAGING_STATS_USING_TIMING_FUNCTIONS
+	time_start = timing_counter_get();
+#else
+	time_start = k_cycle_get_32();
+#endif /* CONFIG_DEMAND_PAGING_STATS_USING_TIMING_FUNCTIONS */
+#endif /* CONFIG_DEMAND_PAGING_STATS */
 
-	pf = free_page_frame_list_get();
-	if (pf == NULL) {
-		/* Need to evict a page frame */
-		pf = do_eviction_select(&dirty);
-		__ASSERT(pf != NULL, "failed to get a page frame");
-		LOG_DBG("evicting %p at 0x%lx", pf->addr,
-			z_page_frame_to_phys(pf));
-
-		paging_stats_eviction_inc(faulting_thread, dirty);
-	}
-	ret = page_frame_prepare_locked(pf, &dirty, true, &page_out_location);
-	__ASSERT(ret == 0, "failed to prepare page frame");
-
-#ifdef CONFIG_DEMAND_PAGING_ALLOW_IRQ
-	irq_unlock(key);
-	/* Interrupts are now unlocked if they were not locked when we entered
-	 * this function, and we may service ISRs. The scheduler is still
-	 * locked.
-	 */
-#endif /* CONFIG_DEMAND_PAGING_ALLOW_IRQ */
-	if (dirty) {
-		do_backing_store_page_out(page_out_location);
-	}
-	do_backing_store_page_in(page_in_location);
-
-#ifdef CONFIG_DEMAND_PAGING_ALLOW_IRQ
-	key = irq_lock();
-	pf->flags &= ~Z_PAGE_FRAME_BUSY;
-#endif /* CONFIG_DEMAND_PAGING_ALLOW_IRQ */
-	if (pin) {
-		pf->flags |= Z_PAGE_FRAME_PINNED;
-	}
-	pf->flags |= Z_PAGE_FRAME_MAPPED;
-	pf->addr = UINT_TO_POINTER(POINTER_TO_UINT(addr)
-				   & ~(CONFIG_MMU_PAGE_SIZE - 1));
+	pf = page_in_locked(addr, page_in_location, pin, &key,
+			    faulting_thread);
+#ifdef CONFIG_DEMAND_PAGING_READ_AHEAD
+	read_ahead_locked(addr, pf, &key, faulting_thread);
+#endif
 
-	arch_mem_page_in(addr, z_page_frame_to_phys(pf));
-	k_mem_paging_backing_store_page_finalize(pf, page_in_location);
+#ifdef CONFIG_DEMAND_PAGING_STATS
+#ifdef CONFIG_DEMAND_PAGING_STATS_USING_TIMING_FUNCTIONS
+	time_end = timing_counter_get();
+	paging_stats_faults_time(faulting_thread,
+				 timing_cycles_get(&time_start, &time_end));
+#else
+	paging_stats_faults_time(faulting_thread,
+				 k_cycle_get_32() - time_start);
+#endif /* CONFIG_DEMAND_PAGING_STATS_USING_TIMING_FUNCTIONS */
+#endif /* CONFIG_DEMAND_PAGING_STATS */
 out:
 	irq_unlock(key);
 #ifdef CONFIG_DEMAND_PAGING_ALLOW_IRQ
@@ -54,6 +54,179 @@ void k_msgq_init(struct k_msgq *msgq, char *buffer, size_t msg_size,
 	z_object_init(msgq);
 }
 
+#ifdef CONFIG_MSGQ_SPSC
+void k_msgq_spsc_init(struct k_msgq *msgq, char *buffer, size_t msg_size,
+		      uint32_t max_msgs)
+{
+	k_msgq_init(msgq, buffer, msg_size, max_msgs);
+	msgq->flags = K_MSGQ_FLAG_SPSC;
+	atomic_set(&msgq->spsc_state, 0);
+}
+
+/*
+ * In single-producer/single-consumer mode only the producer moves write_ptr
+ * and only the consumer moves read_ptr. They synchronize through
+ * spsc_state, which counts the used messages: a message is copied in before
+ * the count is incremented and copied out before it is decremented, so
+ * neither side needs the lock as long as the queue is neither full nor empty.
+ *
+ * The consumer only sleeps on an empty queue and the producer on a full one,
+ * so at most one thread is ever pended. It takes the lock and sets
+ * Z_MSGQ_SPSC_WAITING before checking the count a last time. The other side
+ * sees the flag when it next changes the count, and only then takes the lock
+ * to wake the sleeper up, which retries its operation. A flag left behind by
+ * a thread which timed out costs one extra lock round trip.
+ */
+static inline uint32_t spsc_used(atomic_val_t state)
+{
+	return (uint32_t)(state & ~Z_MSGQ_SPSC_WAITING);
+}
+
+static inline void spsc_advance(struct k_msgq *msgq, char **ptr)
+{
+	*ptr += msgq->msg_size;
+	if (*ptr == msgq->buffer_end) {
+		*ptr = msgq->buffer_start;
+	}
+}
+
+static void spsc_wake(struct k_msgq *msgq)
+{
+	struct k_thread *pending_thread;
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&msgq->lock);
+
+	atomic_and(&msgq->spsc_state, ~Z_MSGQ_SPSC_WAITING);
+	pending_thread = z_unpend_first_thread(&msgq->wait_q);
+	if (pending_thread != NULL) {
+		arch_thread_return_value_set(pending_thread, 0);
+		z_ready_thread(pending_thread);
+		z_reschedule(&msgq->lock, key);
+	} else {
+		k_spin_unlock(&msgq->lock, key);
+	}
+}
+
+/* Sleep until the other side changes the count, unless it already made
+ * the queue neither full nor empty: @a full tells which the caller waits on.
+ */
+static int spsc_wait(struct k_msgq *msgq, bool full, k_timeout_t timeout)
+{
+	k_spinlock_key_t key;
+	uint32_t used;
+
+	key = k_spin_lock(&msgq->lock);
+
+	used = spsc_used(atomic_or(&msgq->spsc_state, Z_MSGQ_SPSC_WAITING));
+	if (full ? (used < msgq->max_msgs) : (used > 0U)) {
+		/* Don't clear the flag, the other side may be pended already */
+		k_spin_unlock(&msgq->lock, key);
+		return 0;
+	}
+
+	return z_pend_curr(&msgq->lock, key, &msgq->wait_q, timeout);
+}
+
+static int spsc_put(struct k_msgq *msgq, const void *data, k_timeout_t timeout)
+{
+	int result;
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_msgq, put, msgq, timeout);
+
+	while (spsc_used(atomic_get(&msgq->spsc_state)) >= msgq->max_msgs) {
+		if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			result = -ENOMSG;
+			SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, put, msgq, timeout,
+						       result);
+			return result;
+		}
+
+		SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_msgq, put, msgq, timeout);
+
+		result = spsc_wait(msgq, true, timeout);
+		if (result != 0) {
+			SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, put, msgq, timeout,
+						       result);
+			return result;
+		}
+	}
+
+	(void)memcpy(msgq->write_ptr, data, msgq->msg_size);
+	spsc_advance(msgq, &msgq->write_ptr);
+	if ((atomic_inc(&msgq->spsc_state) & Z_MSGQ_SPSC_WAITING) != 0) {
+		spsc_wake(msgq);
+	}
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, put, msgq, timeout, 0);
+
+	return 0;
+}
+
+static int spsc_get(struct k_msgq *msgq, void *data, k_timeout_t timeout)
+{
+	int result;
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_msgq, get, msgq, timeout);
+
+	while (spsc_used(atomic_get(&msgq->spsc_state)) == 0U) {
+		if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			result = -ENOMSG;
+			SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, get, msgq, timeout,
+						       result);
+			return result;
+		}
+
+		SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_msgq, get, msgq, timeout);
+
+		result = spsc_wait(msgq, false, timeout);
+		if (result != 0) {
+			SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, get, msgq, timeout,
+						       result);
+			return result;
+		}
+	}
+
+	(void)memcpy(data, msgq->read_ptr, msgq->msg_size);
+	spsc_advance(msgq, &msgq->read_ptr);
+	if ((atomic_dec(&msgq->spsc_state) & Z_MSGQ_SPSC_WAITING) != 0) {
+		spsc_wake(msgq);
+	}
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, get, msgq, timeout, 0);
+
+	return 0;
+}
+
+static void spsc_purge(struct k_msgq *msgq)
+{
+	struct k_thread *pending_thread;
+	k_spinlock_key_t key;
+	uint32_t used;
+
+	key = k_spin_lock(&msgq->lock);
+
+	SYS_PORT_TRACING_OBJ_FUNC(k_msgq, purge, msgq);
+
+	/* Only drop the messages seen here, the producer may be adding more */
+	used = spsc_used(atomic_get(&msgq->spsc_state));
+	for (uint32_t i = 0; i < used; i++) {
+		spsc_advance(msgq, &msgq->read_ptr);
+	}
+	(void)atomic_sub(&msgq->spsc_state, used);
+
+	/* wake up the producer if it is waiting to write */
+	pending_thread = z_unpend_first_thread(&msgq->wait_q);
+	if (pending_thread != NULL) {
+		atomic_and(&msgq->spsc_state, ~Z_MSGQ_SPSC_WAITING);
+		arch_thread_return_value_set(pending_thread, -ENOMSG);
+		z_ready_thread(pending_thread);
+	}
+
+	z_reschedule(&msgq->lock, key);
+}
+#endif /* CONFIG_MSGQ_SPSC */
+
 int z_impl_k_msgq_alloc_init(struct k_msgq *msgq, size_t msg_size,
 			    uint32_t max_msgs)
 {
@@ -121,6 +294,12 @@ int z_impl_k_msgq_put(struct k_msgq *msgq, const void *data, k_timeout_t timeout
 	k_spinlock_key_t key;
 	int result;
 
+#ifdef CONFIG_MSGQ_SPSC
+	if ((msgq->flags & K_MSGQ_FLAG_SPSC) != 0U) {
+		return spsc_put(msgq, data, timeout);
+	}
+#endif
+
 	key = k_spin_lock(&msgq->lock);
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_msgq, put, msgq, timeout);
@@ -189,7 +368,7 @@ void z_impl_k_msgq_get_attrs(struct k_msgq *msgq, struct k_msgq_attrs *attrs)
 {
 	attrs->msg_size = msgq->msg_size;
 	attrs->max_msgs = msgq->max_msgs;
-	attrs->used_msgs = msgq->used_msgs;
+	attrs->used_msgs = z_impl_k_msgq_num_used_get(msgq);
 }
 
 #ifdef CONFIG_USERSPACE
@@ -211,6 +390,12 @@ int z_impl_k_msgq_get(struct k_msgq *msgq, void *data, k_timeout_t timeout)
 	struct k_thread *pending_thread;
 	int result;
 
+#ifdef CONFIG_MSGQ_SPSC
+	if ((msgq->flags & K_MSGQ_FLAG_SPSC) != 0U) {
+		return spsc_get(msgq, data, timeout);
+	}
+#endif
+
 	key = k_spin_lock(&msgq->lock);
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_msgq, get, msgq, timeout);
@@ -288,7 +473,7 @@ int z_impl_k_msgq_peek(struct k_msgq *msgq, void *data)
 
 	key = k_spin_lock(&msgq->lock);
 
-	if (msgq->used_msgs > 0U) {
+	if (z_impl_k_msgq_num_used_get(msgq) > 0U) {
 		/* take first available message from queue */
 		(void)memcpy(data, msgq->read_ptr, msgq->msg_size);
 		result = 0;
@@ -320,6 +505,13 @@ void z_impl_k_msgq_purge(struct k_msgq *msgq)
 	k_spinlock_key_t key;
 	struct k_thread *pending_thread;
 
+#ifdef CONFIG_MSGQ_SPSC
+	if ((msgq->flags & K_MSGQ_FLAG_SPSC) != 0U) {
+		spsc_purge(msgq);
+		return;
+	}
+#endif
+
 	key = k_spin_lock(&msgq->lock);
 
 	SYS_PORT_TRACING_OBJ_FUNC(k_msgq, purge, msgq);
@@ -9,6 +9,7 @@
 #include <syscall_handler.h>
 #include <toolchain.h>
 #include <sys/mem_manage.h>
+#include <mmu.h>
 
 extern struct k_mem_paging_stats_t paging_stats;
 
@@ -88,6 +89,33 @@ unsigned long z_num_pagefaults_get(void)
 	return ret;
 }
 
+void z_paging_stats_eviction_scan(unsigned long scanned,
+				  unsigned long second_chance)
+{
+	paging_stats.eviction.scanned += scanned;
+	paging_stats.eviction.second_chance += second_chance;
+}
+
+#ifdef CONFIG_EVICTION_CLOCK_PRO
+void z_paging_stats_clock_pro(unsigned long promoted, unsigned long demoted,
+			      unsigned long refaults)
+{
+	paging_stats.eviction.promoted += promoted;
+	paging_stats.eviction.demoted += demoted;
+	paging_stats.eviction.refaults += refaults;
+}
+#endif /* CONFIG_EVICTION_CLOCK_PRO */
+
+#ifdef CONFIG_BACKING_STORE_RAM_COMPRESSED
+void z_paging_stats_compression(unsigned long pages, unsigned long bytes,
+				unsigned long incompressible)
+{
+	paging_stats.compression.pages = pages;
+	paging_stats.compression.bytes = bytes;
+	paging_stats.compression.incompressible = incompressible;
+}
+#endif /* CONFIG_BACKING_STORE_RAM_COMPRESSED */
+
 void z_impl_k_mem_paging_stats_get(struct k_mem_paging_stats_t *stats)
 {
 	if (stats == NULL) {
@@ -92,6 +92,8 @@ void k_pipe_init(struct k_pipe *pipe, unsigned char *buffer, size_t size)
 	pipe->bytes_used = 0;
 	pipe->read_index = 0;
 	pipe->write_index = 0;
+	pipe->put_claimed = 0;
+	pipe->get_claimed = 0;
 	pipe->lock = (struct k_spinlock){};
 	z_waitq_init(&pipe->wait_q.writers);
 	z_waitq_init(&pipe->wait_q.readers);
@@ -825,3 +827,249 @@ size_t z_vrfy_k_pipe_write_avail(struct k_pipe *pipe)
 }
 #include <syscalls/k_pipe_write_avail_mrsh.c>
 #endif
+
+/*
+ * Claims give direct access to the pipe's circular buffer. Claimed space is
+ * not counted in bytes_used until it is committed, and claimed data stays
+ * counted until it is, so the other side never touches what is claimed.
+ *
+ * A thread waiting for a claim pends on the writers (or readers) wait_q
+ * with an empty descriptor: as it is never partially satisfied, the next
+ * get (or put) readies it and it tries again. It only waits on a full (or
+ * empty) buffer, so the invariants of pipe_xfer_prepare() still hold.
+ *
+ * Commits hand data to or take data from threads pended in k_pipe_get()
+ * or k_pipe_put(), as those only check the buffer when they start.
+ */
+static int pipe_claim(struct k_pipe *pipe, uint8_t **data, size_t size,
+		      size_t *claimed, k_timeout_t timeout, bool put)
+{
+	uint64_t end = sys_clock_timeout_end_calc(timeout);
+	size_t *claim = put ? &pipe->put_claimed : &pipe->get_claimed;
+	_wait_q_t *wait_q = put ? &pipe->wait_q.writers : &pipe->wait_q.readers;
+	struct k_pipe_desc pipe_desc = { .buffer = NULL, .bytes_to_xfer = 0 };
+	k_spinlock_key_t key;
+	size_t index, span;
+	int64_t remaining;
+
+	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
+
+	CHECKIF((pipe->buffer == NULL) || (pipe->size == 0U) || (size == 0U) ||
+		(claimed == NULL) || (data == NULL)) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&pipe->lock);
+
+	if (*claim != 0U) {
+		k_spin_unlock(&pipe->lock, key);
+		return -EBUSY;
+	}
+
+	for (;;) {
+		if (put) {
+			index = pipe->write_index;
+			span = MIN(pipe->size - pipe->bytes_used,
+				   pipe->size - index);
+		} else {
+			index = pipe->read_index;
+			span = MIN(pipe->bytes_used, pipe->size - index);
+		}
+
+		if (span != 0U) {
+			break;
+		}
+
+		if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			k_spin_unlock(&pipe->lock, key);
+			return -EIO;
+		}
+
+		if (!K_TIMEOUT_EQ(timeout, K_FOREVER)) {
+			remaining = (int64_t)(end - sys_clock_tick_get());
+			if (remaining <= 0) {
+				k_spin_unlock(&pipe->lock, key);
+				return -EAGAIN;
+			}
+			timeout = K_TICKS(remaining);
+		}
+
+		_current->base.swap_data = &pipe_desc;
+		(void)z_pend_curr(&pipe->lock, key, wait_q, timeout);
+		key = k_spin_lock(&pipe->lock);
+	}
+
+	*claim = MIN(span, size);
+	*data = pipe->buffer + index;
+	*claimed = *claim;
+
+	k_spin_unlock(&pipe->lock, key);
+
+	return 0;
+}
+
+/* Hand data committed to the buffer to readers pended in k_pipe_get() */
+static bool pipe_readers_feed(struct k_pipe *pipe)
+{
+	struct k_thread *thread;
+	struct k_pipe_desc *desc;
+	size_t bytes_copied;
+	bool readied = false;
+
+	while ((thread = z_waitq_head(&pipe->wait_q.readers)) != NULL) {
+		desc = (struct k_pipe_desc *)thread->base.swap_data;
+		bytes_copied = pipe_buffer_get(pipe, desc->buffer,
+						desc->bytes_to_xfer);
+
+		desc->buffer        += bytes_copied;
+		desc->bytes_to_xfer -= bytes_copied;
+		if (desc->bytes_to_xfer != 0U) {
+			break;
+		}
+
+		z_unpend_thread(thread);
+		z_ready_thread(thread);
+		readied = true;
+	}
+
+	return readied;
+}
+
+/* Move data of writers pended in k_pipe_put() to the freed buffer space */
+static bool pipe_writers_drain(struct k_pipe *pipe)
+{
+	struct k_thread *thread;
+	struct k_pipe_desc *desc;
+	size_t bytes_copied;
+	bool readied = false;
+
+	while ((thread = z_waitq_head(&pipe->wait_q.writers)) != NULL) {
+		desc = (struct k_pipe_desc *)thread->base.swap_data;
+		bytes_copied = pipe_buffer_put(pipe, desc->buffer,
+						desc->bytes_to_xfer);
+
+		desc->buffer        += bytes_copied;
+		desc->bytes_to_xfer -= bytes_copied;
+		if (desc->bytes_to_xfer != 0U) {
+			break;
+		}
+
+		z_unpend_thread(thread);
+		pipe_thread_ready(thread);
+		readied = true;
+	}
+
+	return readied;
+}
+
+static int pipe_commit(struct k_pipe *pipe, size_t size, bool put)
+{
+	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
+	size_t *claim = put ? &pipe->put_claimed : &pipe->get_claimed;
+	bool readied;
+
+	CHECKIF((*claim == 0U) || (size > *claim)) {
+		k_spin_unlock(&pipe->lock, key);
+		return -EINVAL;
+	}
+
+	*claim = 0;
+
+	if (put) {
+		pipe->bytes_used += size;
+		pipe->write_index += size;
+		if (pipe->write_index == pipe->size) {
+			pipe->write_index = 0;
+		}
+		readied = pipe_readers_feed(pipe);
+	} else {
+		pipe->bytes_used -= size;
+		pipe->read_index += size;
+		if (pipe->read_index == pipe->size) {
+			pipe->read_index = 0;
+		}
+		readied = pipe_writers_drain(pipe);
+	}
+
+	if (readied) {
+		z_reschedule(&pipe->lock, key);
+	} else {
+		k_spin_unlock(&pipe->lock, key);
+	}
+
+	return 0;
+}
+
+int z_impl_k_pipe_put_claim(struct k_pipe *pipe, uint8_t **data, size_t size,
+			    size_t *claimed, k_timeout_t timeout)
+{
+	return pipe_claim(pipe, data, size, claimed, timeout, true);
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_pipe_put_claim(struct k_pipe *pipe, uint8_t **data,
+					  size_t size, size_t *claimed,
+					  k_timeout_t timeout)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(pipe, K_OBJ_PIPE));
+	Z_OOPS(Z_SYSCALL_MEMORY_WRITE(data, sizeof(*data)));
+	Z_OOPS(Z_SYSCALL_MEMORY_WRITE(claimed, sizeof(*claimed)));
+	/* Only hand out buffers the caller can already write to */
+	Z_OOPS(Z_SYSCALL_MEMORY_WRITE(pipe->buffer, pipe->size));
+
+	return z_impl_k_pipe_put_claim(pipe, data, size, claimed, timeout);
+}
+#include <syscalls/k_pipe_put_claim_mrsh.c>
+#endif
+
+int z_impl_k_pipe_put_commit(struct k_pipe *pipe, size_t size)
+{
+	return pipe_commit(pipe, size, true);
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_pipe_put_commit(struct k_pipe *pipe, size_t size)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(pipe, K_OBJ_PIPE));
+
+	return z_impl_k_pipe_put_commit(pipe, size);
+}
+#include <syscalls/k_pipe_put_commit_mrsh.c>
+#endif
+
+int z_impl_k_pipe_get_claim(struct k_pipe *pipe, uint8_t **data, size_t size,
+			    size_t *claimed, k_timeout_t timeout)
+{
+	return pipe_claim(pipe, data, size, claimed, timeout, false);
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_pipe_get_claim(struct k_pipe *pipe, uint8_t **data,
+					  size_t size, size_t *claimed,
+					  k_timeout_t timeout)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(pipe, K_OBJ_PIPE));
+	Z_OOPS(Z_SYSCALL_MEMORY_WRITE(data, sizeof(*data)));
+	Z_OOPS(Z_SYSCALL_MEMORY_WRITE(claimed, sizeof(*claimed)));
+	/* Only hand out buffers the caller can already read */
+	Z_OOPS(Z_SYSCALL_MEMORY_READ(pipe->buffer, pipe->size));
+
+	return z_impl_k_pipe_get_claim(pipe, data, size, claimed, timeout);
+}
+#include <syscalls/k_pipe_get_claim_mrsh.c>
+#endif
+
+int z_impl_k_pipe_get_commit(struct k_pipe *pipe, size_t size)
+{
+	return pipe_commit(pipe, size, false);
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_pipe_get_commit(struct k_pipe *pipe, size_t size)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(pipe, K_OBJ_PIPE));
+
+	return z_impl_k_pipe_get_commit(pipe, size);
+}
+#include <syscalls/k_pipe_get_commit_mrsh.c>
+#endif
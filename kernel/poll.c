@@ -81,11 +81,19 @@ static inline bool is_condition_met(struct k_poll_event *event, uint32_t *state)
 		}
 		break;
 	case K_POLL_TYPE_MSGQ_DATA_AVAILABLE:
-		if (event->msgq->used_msgs > 0) {
+		if (z_impl_k_msgq_num_used_get(event->msgq) > 0U) {
 			*state = K_POLL_STATE_MSGQ_DATA_AVAILABLE;
 			return true;
 		}
 		break;
+#ifdef CONFIG_EVENTS
+	case K_POLL_TYPE_EVENTS:
+		if (event->event->events != 0U) {
+			*state = K_POLL_STATE_EVENTS;
+			return true;
+		}
+		break;
+#endif
 	case K_POLL_TYPE_IGNORE:
 		break;
 	default:
@@ -144,8 +152,16 @@ static inline void register_event(struct k_poll_event *event,
 		break;
 	case K_POLL_TYPE_MSGQ_DATA_AVAILABLE:
 		__ASSERT(event->msgq != NULL, "invalid message queue\n");
+		__ASSERT((event->msgq->flags & K_MSGQ_FLAG_SPSC) == 0U,
+			 "can't poll an SPSC message queue\n");
 		add_event(&event->msgq->poll_events, event, poller);
 		break;
+#ifdef CONFIG_EVENTS
+	case K_POLL_TYPE_EVENTS:
+		__ASSERT(event->event != NULL, "invalid event object\n");
+		add_event(&event->event->poll_events, event, poller);
+		break;
+#endif
 	case K_POLL_TYPE_IGNORE:
 		/* nothing to do */
 		break;
@@ -181,6 +197,12 @@ static inline void clear_event_registration(struct k_poll_event *event)
 		__ASSERT(event->msgq != NULL, "invalid message queue\n");
 		remove_event = true;
 		break;
+#ifdef CONFIG_EVENTS
+	case K_POLL_TYPE_EVENTS:
+		__ASSERT(event->event != NULL, "invalid event object\n");
+		remove_event = true;
+		break;
+#endif
 	case K_POLL_TYPE_IGNORE:
 		/* nothing to do */
 		break;
@@ -397,6 +419,11 @@ static inline int z_vrfy_k_poll(struct k_poll_event *events,
 		case K_POLL_TYPE_MSGQ_DATA_AVAILABLE:
 			Z_OOPS(Z_SYSCALL_OBJ(e->msgq, K_OBJ_MSGQ));
 			break;
+#ifdef CONFIG_EVENTS
+		case K_POLL_TYPE_EVENTS:
+			Z_OOPS(Z_SYSCALL_OBJ(e->event, K_OBJ_EVENT));
+			break;
+#endif
 		default:
 			ret = -EINVAL;
 			goto out_free;
@@ -1484,6 +1484,9 @@ static void end_thread(struct k_thread *thread)
 
 #ifdef CONFIG_USERSPACE
 		z_mem_domain_exit_thread(thread);
+#ifdef CONFIG_SYS_MUTEX_FAST_PATH
+		z_sys_mutex_thread_abort(thread);
+#endif
 		z_thread_perms_all_clear(thread);
 		z_object_uninit(thread->stack_obj);
 		z_object_uninit(thread);
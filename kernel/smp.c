@@ -102,6 +102,37 @@ void z_smp_init(void)
 	(void)atomic_set(&start_flag, 1);
 }
 
+void k_rcu_synchronize(void)
+{
+	uint32_t seq[CONFIG_MP_NUM_CPUS];
+	volatile uint32_t *cpu_seq;
+	unsigned int k = arch_irq_lock();
+
+	__ASSERT(arch_curr_cpu()->rcu_nested == 0U,
+		 "k_rcu_synchronize() in a read-side critical section");
+	arch_irq_unlock(k);
+
+	/* Order the updates of the protected data before the reads of the
+	 * sequences.
+	 */
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		seq[i] = *(volatile uint32_t *)&_kernel.cpus[i].rcu_seq;
+	}
+
+	/* A CPU in a read-side critical section (odd sequence) may use
+	 * unpublished data until its sequence changes.
+	 */
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		cpu_seq = &_kernel.cpus[i].rcu_seq;
+		while ((seq[i] & 1U) != 0U && *cpu_seq == seq[i]) {
+		}
+	}
+
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
 bool z_smp_cpu_mobile(void)
 {
 	unsigned int k = arch_irq_lock();
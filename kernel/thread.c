@@ -593,6 +593,9 @@ char *z_setup_new_thread(struct k_thread *new_thread,
 #endif
 #ifdef CONFIG_USERSPACE
 	z_mem_domain_init_thread(new_thread);
+#ifdef CONFIG_USERSPACE_OBJ_CACHE
+	z_thread_obj_cache_init(new_thread);
+#endif
 
 	if ((options & K_INHERIT_PERMS) != 0U) {
 		z_thread_perms_inherit(_current, new_thread);
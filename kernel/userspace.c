@@ -60,6 +60,14 @@ extern uint8_t _thread_idx_map[CONFIG_MAX_THREAD_BYTES];
 
 static void clear_perms_cb(struct z_object *ko, void *ctx_ptr);
 
+#ifdef CONFIG_USERSPACE_OBJ_CACHE
+static void obj_cache_invalidate(void);
+#else
+static inline void obj_cache_invalidate(void)
+{
+}
+#endif
+
 const char *otype_to_str(enum k_objects otype)
 {
 	const char *ret;
@@ -405,6 +413,7 @@ void k_object_free(void *obj)
 	k_spin_unlock(&objfree_lock, key);
 
 	if (dyn != NULL) {
+		obj_cache_invalidate();
 		k_free(dyn);
 	}
 }
@@ -546,6 +555,7 @@ void z_thread_perms_clear(struct z_object *ko, struct k_thread *thread)
 	if (index != -1) {
 		sys_bitfield_clear_bit((mem_addr_t)&ko->perms, index);
 		unref_check(ko, index);
+		obj_cache_invalidate();
 	}
 }
 
@@ -562,6 +572,7 @@ void z_thread_perms_all_clear(struct k_thread *thread)
 
 	if ((int)index != -1) {
 		z_object_wordlist_foreach(clear_perms_cb, (void *)index);
+		obj_cache_invalidate();
 	}
 }
 
@@ -649,6 +660,27 @@ void k_object_access_all_grant(const void *object)
 	}
 }
 
+static inline int obj_init_check(struct z_object *ko,
+				 enum _obj_init_check init)
+{
+	/* Initialization state checks. _OBJ_INIT_ANY, we don't care */
+	if (likely(init == _OBJ_INIT_TRUE)) {
+		/* Object MUST be initialized */
+		if (unlikely((ko->flags & K_OBJ_FLAG_INITIALIZED) == 0U)) {
+			return -EINVAL;
+		}
+	} else if (init == _OBJ_INIT_FALSE) { /* _OBJ_INIT_FALSE case */
+		/* Object MUST NOT be initialized */
+		if (unlikely((ko->flags & K_OBJ_FLAG_INITIALIZED) != 0U)) {
+			return -EADDRINUSE;
+		}
+	} else {
+		/* _OBJ_INIT_ANY */
+	}
+
+	return 0;
+}
+
 int z_object_validate(struct z_object *ko, enum k_objects otype,
 		       enum _obj_init_check init)
 {
@@ -664,23 +696,101 @@ int z_object_validate(struct z_object *ko, enum k_objects otype,
 		return -EPERM;
 	}
 
-	/* Initialization state checks. _OBJ_INIT_ANY, we don't care */
-	if (likely(init == _OBJ_INIT_TRUE)) {
-		/* Object MUST be initialized */
-		if (unlikely((ko->flags & K_OBJ_FLAG_INITIALIZED) == 0U)) {
-			return -EINVAL;
+	return obj_init_check(ko, init);
+}
+
+#ifdef CONFIG_USERSPACE_OBJ_CACHE
+/*
+ * Each thread caches the kernel objects it was found to have permission on
+ * by system calls. Caches are only valid for the permission generation
+ * they were filled in: revoking a permission or freeing an object starts a
+ * new one, and threads empty their cache when they see it. Granting
+ * permissions doesn't, as it can't make a cached entry wrong.
+ *
+ * The type and initialization state of cached objects are still checked
+ * on every system call, as they can change.
+ */
+static atomic_t obj_cache_generation = ATOMIC_INIT(1);
+
+static void obj_cache_invalidate(void)
+{
+	/* Skip 0, the generation of new threads' caches */
+	if (atomic_inc(&obj_cache_generation) == -1) {
+		atomic_inc(&obj_cache_generation);
+	}
+}
+
+void z_thread_obj_cache_init(struct k_thread *thread)
+{
+	(void)memset(&thread->obj_cache, 0, sizeof(thread->obj_cache));
+}
+
+static struct z_object *obj_cache_find(struct _thread_obj_cache *cache,
+				       const void *obj)
+{
+	uint32_t generation = (uint32_t)atomic_get(&obj_cache_generation);
+
+	if (unlikely(cache->generation != generation)) {
+		(void)memset(cache, 0, sizeof(*cache));
+		cache->generation = generation;
+		return NULL;
+	}
+
+	/* NULL marks unused entries, it is never a cached object */
+	if (obj == NULL) {
+		return NULL;
+	}
+
+	for (int i = 0; i < CONFIG_USERSPACE_OBJ_CACHE_SIZE; i++) {
+		if ((cache->objs[i] == obj) && (cache->kobjs[i] != NULL)) {
+			return cache->kobjs[i];
 		}
-	} else if (init == _OBJ_INIT_FALSE) { /* _OBJ_INIT_FALSE case */
-		/* Object MUST NOT be initialized */
-		if (unlikely((ko->flags & K_OBJ_FLAG_INITIALIZED) != 0U)) {
-			return -EADDRINUSE;
+	}
+
+	return NULL;
+}
+
+static void obj_cache_add(struct _thread_obj_cache *cache, const void *obj,
+			  struct z_object *ko)
+{
+	cache->objs[cache->next] = obj;
+	cache->kobjs[cache->next] = ko;
+	cache->next = (cache->next + 1) % CONFIG_USERSPACE_OBJ_CACHE_SIZE;
+}
+
+int z_obj_cached_validation_check(const void *obj, enum k_objects otype,
+				  enum _obj_init_check init)
+{
+	struct _thread_obj_cache *cache = &_current->obj_cache;
+	struct z_object *ko;
+	int ret;
+
+	ko = obj_cache_find(cache, obj);
+	if (likely(ko != NULL)) {
+		if (unlikely(otype != K_OBJ_ANY && ko->type != otype)) {
+			ret = -EBADF;
+		} else {
+			ret = obj_init_check(ko, init);
 		}
 	} else {
-		/* _OBJ_INIT_ANY */
+		ko = z_object_find(obj);
+		ret = z_object_validate(ko, otype, init);
+
+		/* Permission holds whatever state the object is in */
+		if ((ret == 0) || (ret == -EINVAL) || (ret == -EADDRINUSE)) {
+			obj_cache_add(cache, obj, ko);
+		}
 	}
 
-	return 0;
+#ifdef CONFIG_LOG
+	if (ret != 0) {
+		z_dump_object_error(ret, obj, ko, otype);
+	}
+#endif
+
+	return ret;
 }
+#endif /* CONFIG_USERSPACE_OBJ_CACHE */
 
 void z_object_init(const void *obj)
 {
@@ -713,6 +823,7 @@ void z_object_recycle(const void *obj)
 
 	if (ko != NULL) {
 		(void)memset(ko->perms, 0, sizeof(ko->perms));
+		obj_cache_invalidate();
 		z_thread_perms_set(ko, k_current_get());
 		ko->flags |= K_OBJ_FLAG_INITIALIZED;
 	}
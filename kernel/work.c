@@ -229,11 +229,183 @@ static inline bool notify_queue_locked(struct k_work_q *queue)
 	return rv;
 }
 
+#ifdef CONFIG_WORKQUEUE_POOL
+/* Find the queue of a pool that is served by the current thread.
+ *
+ * Invoked with work lock held.
+ *
+ * @param pool the pool to look in
+ *
+ * @return the queue, or null if not invoked from a pool thread.
+ */
+static struct k_work_q *pool_current_queue_locked(struct k_work_q_pool *pool)
+{
+	if (k_is_in_isr()) {
+		return NULL;
+	}
+
+	for (uint8_t i = 0; i < pool->num_queues; i++) {
+		if (_current == &pool->queues[i].thread) {
+			return &pool->queues[i];
+		}
+	}
+
+	return NULL;
+}
+
+/* Select the queue of a pool that new work should be submitted to.
+ *
+ * Work submitted from a pool thread stays on the queue of that thread,
+ * where its data is likely to be in cache.  Other work goes to the first
+ * idle queue found starting from the next queue in round robin order, or
+ * to that next queue if none is idle.
+ *
+ * Invoked with work lock held.
+ *
+ * @param pool the pool to select a queue from
+ *
+ * @return the selected queue.
+ */
+static struct k_work_q *pool_select_locked(struct k_work_q_pool *pool)
+{
+	struct k_work_q *queue = pool_current_queue_locked(pool);
+	uint8_t idx = pool->next % pool->num_queues;
+
+	if (queue != NULL) {
+		return queue;
+	}
+
+	/* Until the pool is started everything goes to the first queue,
+	 * which rejects the work if it isn't started either.
+	 */
+	if (pool->queues[0].pool == NULL) {
+		return &pool->queues[0];
+	}
+
+	for (uint8_t i = 0; i < pool->num_queues; i++) {
+		uint8_t n = (pool->next + i) % pool->num_queues;
+
+		if (z_waitq_head(&pool->queues[n].notifyq) != NULL) {
+			idx = n;
+			break;
+		}
+	}
+
+	pool->next = (idx + 1) % pool->num_queues;
+
+	return &pool->queues[idx];
+}
+
+/* Take pending work from another queue of the pool.
+ *
+ * The oldest work item of the first other queue found with work that can
+ * move is transferred to @p queue, along with the flushers queued right
+ * behind it, which are waiting for it.  Flushers at the head of a queue
+ * and work resubmitted while running must stay where they are: they have
+ * to run after the handler running on that queue.
+ *
+ * Invoked with work lock held.
+ *
+ * @param queue the queue of the calling thread, which has no pending
+ * work.
+ *
+ * @return the node of the transferred work item, or null if there is no
+ * work to take.
+ */
+static sys_snode_t *pool_steal_locked(struct k_work_q *queue)
+{
+	struct k_work_q_pool *pool = queue->pool;
+	uint8_t self = queue - pool->queues;
+
+	for (uint8_t i = 1; i < pool->num_queues; i++) {
+		struct k_work_q *victim
+			= &pool->queues[(self + i) % pool->num_queues];
+		sys_snode_t *node = sys_slist_peek_head(&victim->pending);
+		struct k_work *work;
+
+		if (node == NULL) {
+			continue;
+		}
+
+		work = CONTAINER_OF(node, struct k_work, node);
+		if ((work->handler == handle_flush)
+		    || flag_test(&work->flags, K_WORK_RUNNING_BIT)) {
+			continue;
+		}
+
+		(void)sys_slist_get(&victim->pending);
+		work->queue = queue;
+
+		while ((node = sys_slist_peek_head(&victim->pending)) != NULL) {
+			struct k_work *next = CONTAINER_OF(node, struct k_work,
+							   node);
+
+			if (next->handler != handle_flush) {
+				break;
+			}
+
+			(void)sys_slist_get(&victim->pending);
+			sys_slist_append(&queue->pending, node);
+		}
+
+		return &work->node;
+	}
+
+	return NULL;
+}
+
+/* Wake the thread of an idle queue of the pool, if any. */
+static void pool_notify_idle_locked(struct k_work_q_pool *pool)
+{
+	for (uint8_t i = 0; i < pool->num_queues; i++) {
+		if (notify_queue_locked(&pool->queues[i])) {
+			break;
+		}
+	}
+}
+#endif /* CONFIG_WORKQUEUE_POOL */
+
+/* Notify a queue that new work was submitted to it.
+ *
+ * If the queue belongs to a pool and its thread is busy, an idle thread
+ * of the pool is woken instead, to take the work.
+ *
+ * Invoked with work lock held.
+ *
+ * @param queue the queue the work was submitted to.
+ */
+static inline void notify_submit_locked(struct k_work_q *queue)
+{
+#ifdef CONFIG_WORKQUEUE_POOL
+	if (!notify_queue_locked(queue) && (queue->pool != NULL)) {
+		pool_notify_idle_locked(queue->pool);
+	}
+#else
+	(void)notify_queue_locked(queue);
+#endif
+}
+
+/* Determine whether a submission to a queue is chained, i.e. made by
+ * the thread of the queue or, for pools, any thread of the pool.
+ *
+ * Invoked with work lock held.
+ */
+static inline bool queue_chained_locked(struct k_work_q *queue)
+{
+#ifdef CONFIG_WORKQUEUE_POOL
+	if (queue->pool != NULL) {
+		return pool_current_queue_locked(queue->pool) != NULL;
+	}
+#endif
+
+	return (_current == &queue->thread) && !k_is_in_isr();
+}
+
 /* Submit an work item to a queue if queue state allows new work.
  *
- * Submission is rejected if no queue is provided, or if the queue is
- * draining and the work isn't being submitted from the queue's
- * thread (chained submission).
+ * Submission is rejected if no queue is provided, or if the queue (or
+ * the pool it belongs to) is draining and the work isn't being submitted
+ * from the queue's thread (chained submission).
  *
  * Invoked with work lock held.
  * Conditionally notifies queue.
@@ -256,8 +428,9 @@ static inline int queue_submit_locked(struct k_work_q *queue,
 	}
 
 	int ret = -EBUSY;
-	bool chained = (_current == &queue->thread) && !k_is_in_isr();
-	bool draining = flag_test(&queue->flags, K_WORK_QUEUE_DRAIN_BIT);
+	bool chained = queue_chained_locked(queue);
+	bool draining = (flags_get(&queue->flags)
+			 & (K_WORK_QUEUE_DRAIN | K_WORK_QUEUE_POOL_DRAIN)) != 0U;
 	bool plugged = flag_test(&queue->flags, K_WORK_QUEUE_PLUGGED_BIT);
 
 	/* Test for acceptability, in priority order:
@@ -276,7 +449,7 @@ static inline int queue_submit_locked(struct k_work_q *queue,
 	} else {
 		sys_slist_append(&queue->pending, &work->node);
 		ret = 1;
-		(void)notify_queue_locked(queue);
+		notify_submit_locked(queue);
 	}
 
 	return ret;
@@ -589,6 +762,11 @@ static void work_queue_main(void *workq_ptr, void *p2, void *p3)
 
 		/* Check for and prepare any new work. */
 		node = sys_slist_get(&queue->pending);
+#ifdef CONFIG_WORKQUEUE_POOL
+		if ((node == NULL) && (queue->pool != NULL)) {
+			node = pool_steal_locked(queue);
+		}
+#endif
 		if (node != NULL) {
 			/* Mark that there's some work active that's
 			 * not on the pending list.
@@ -779,6 +957,127 @@ int k_work_queue_unplug(struct k_work_q *queue)
 	return ret;
 }
 
+#ifdef CONFIG_WORKQUEUE_POOL
+void k_work_queue_pool_start(struct k_work_q_pool *pool, int prio,
+			     const struct k_work_queue_config *cfg)
+{
+	__ASSERT_NO_MSG(pool != NULL);
+	__ASSERT_NO_MSG(pool->num_queues > 0U);
+
+	size_t stride = K_THREAD_STACK_LEN(pool->stack_size);
+	k_spinlock_key_t key;
+
+	for (uint8_t i = 0; i < pool->num_queues; i++) {
+		k_work_queue_start(&pool->queues[i], &pool->stacks[stride * i],
+				   pool->stack_size, prio, cfg);
+	}
+
+	/* Only link the queues once they are all started, so that no
+	 * work moves to a queue that isn't.
+	 */
+	key = k_spin_lock(&lock);
+	for (uint8_t i = 0; i < pool->num_queues; i++) {
+		pool->queues[i].pool = pool;
+	}
+	k_spin_unlock(&lock, key);
+}
+
+int k_work_submit_to_pool(struct k_work_q_pool *pool,
+			  struct k_work *work)
+{
+	__ASSERT_NO_MSG(pool != NULL);
+	__ASSERT_NO_MSG(work != NULL);
+
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	struct k_work_q *queue = pool_select_locked(pool);
+	int ret = submit_to_queue_locked(work, &queue);
+
+	k_spin_unlock(&lock, key);
+
+	/* As in k_work_submit_to_queue() */
+	if ((ret > 0) && (k_is_preempt_thread() != 0)) {
+		k_yield();
+	}
+
+	return ret;
+}
+
+int k_work_queue_pool_drain(struct k_work_q_pool *pool, bool plug)
+{
+	__ASSERT_NO_MSG(pool != NULL);
+	__ASSERT_NO_MSG(!k_is_in_isr());
+
+	int ret = 0;
+	bool waited;
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	/* Block submissions to all queues before waiting for any.  The pool
+	 * drain flag keeps them blocked once a queue has drained, so that
+	 * new work can't keep the loop below going.
+	 */
+	for (uint8_t i = 0; i < pool->num_queues; i++) {
+		struct k_work_q *queue = &pool->queues[i];
+
+		flag_set(&queue->flags, K_WORK_QUEUE_DRAIN_BIT);
+		flag_set(&queue->flags, K_WORK_QUEUE_POOL_DRAIN_BIT);
+		if (plug) {
+			flag_set(&queue->flags, K_WORK_QUEUE_PLUGGED_BIT);
+		}
+
+		(void)notify_queue_locked(queue);
+	}
+
+	k_spin_unlock(&lock, key);
+
+	/* Work can move to a queue that has drained already, or be
+	 * chained to it, so repeat until no queue had anything left.
+	 */
+	do {
+		waited = false;
+
+		for (uint8_t i = 0; i < pool->num_queues; i++) {
+			int rc = k_work_queue_drain(&pool->queues[i], false);
+
+			if (rc < 0) {
+				ret = rc;
+				break;
+			}
+
+			if (rc > 0) {
+				waited = true;
+				ret = 1;
+			}
+		}
+	} while (waited && (ret >= 0));
+
+	key = k_spin_lock(&lock);
+
+	for (uint8_t i = 0; i < pool->num_queues; i++) {
+		flag_clear(&pool->queues[i].flags,
+			   K_WORK_QUEUE_POOL_DRAIN_BIT);
+	}
+
+	k_spin_unlock(&lock, key);
+
+	return ret;
+}
+
+int k_work_queue_pool_unplug(struct k_work_q_pool *pool)
+{
+	__ASSERT_NO_MSG(pool != NULL);
+
+	int ret = -EALREADY;
+
+	for (uint8_t i = 0; i < pool->num_queues; i++) {
+		if (k_work_queue_unplug(&pool->queues[i]) == 0) {
+			ret = 0;
+		}
+	}
+
+	return ret;
+}
+#endif /* CONFIG_WORKQUEUE_POOL */
+
 #ifdef CONFIG_SYS_CLOCK_EXISTS
 
 /* Timeout handler for delayable work.
@@ -1000,6 +1299,52 @@ int k_work_reschedule(struct k_work_delayable *dwork,
 	return ret;
 }
 
+#ifdef CONFIG_WORKQUEUE_POOL
+int k_work_schedule_for_pool(struct k_work_q_pool *pool,
+			     struct k_work_delayable *dwork,
+			     k_timeout_t delay)
+{
+	__ASSERT_NO_MSG(pool != NULL);
+	__ASSERT_NO_MSG(dwork != NULL);
+
+	struct k_work *work = &dwork->work;
+	int ret = 0;
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	/* Schedule the work item if it's idle or running. */
+	if ((work_busy_get_locked(work) & ~K_WORK_RUNNING) == 0U) {
+		struct k_work_q *queue = pool_select_locked(pool);
+
+		ret = schedule_for_queue_locked(&queue, dwork, delay);
+	}
+
+	k_spin_unlock(&lock, key);
+
+	return ret;
+}
+
+int k_work_reschedule_for_pool(struct k_work_q_pool *pool,
+			       struct k_work_delayable *dwork,
+			       k_timeout_t delay)
+{
+	__ASSERT_NO_MSG(pool != NULL);
+	__ASSERT_NO_MSG(dwork != NULL);
+
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	struct k_work_q *queue = pool_select_locked(pool);
+
+	/* Remove any active scheduling. */
+	(void)unschedule_locked(dwork);
+
+	/* Schedule the work item with the new parameters. */
+	int ret = schedule_for_queue_locked(&queue, dwork, delay);
+
+	k_spin_unlock(&lock, key);
+
+	return ret;
+}
+#endif /* CONFIG_WORKQUEUE_POOL */
+
 int k_work_cancel_delayable(struct k_work_delayable *dwork)
 {
 	__ASSERT_NO_MSG(dwork != NULL);
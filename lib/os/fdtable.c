@@ -69,21 +69,30 @@ static int z_fd_unref(int fd)
 	/* Reference counter must be checked to avoid decrement refcount below
 	 * zero causing file descriptor leak. Loop statement below executes
 	 * atomic decrement if refcount value is grater than zero. Otherwise,
-	 * refcount is not going to be written.
+	 * refcount is not going to be written. The last reference is dropped
+	 * below, once the entry can be reused.
 	 */
 	do {
 		old_rc = atomic_get(&fdtable[fd].refcount);
 		if (!old_rc) {
 			return 0;
 		}
+		if (old_rc == 1) {
+			break;
+		}
 	} while (!atomic_cas(&fdtable[fd].refcount, old_rc, old_rc - 1));
 
 	if (old_rc != 1) {
 		return old_rc - 1;
 	}
 
+	/* Lookups run in RCU read-side critical sections: wait until none
+	 * can still be using the entry before it can be reserved again.
+	 */
+	k_rcu_assign_pointer(fdtable[fd].vtable, NULL);
+	k_rcu_synchronize();
 	fdtable[fd].obj = NULL;
-	fdtable[fd].vtable = NULL;
+	atomic_clear(&fdtable[fd].refcount);
 
 	return 0;
 }
@@ -102,58 +111,73 @@ static int _find_fd_entry(void)
 	return -1;
 }
 
-static int _check_fd(int fd)
+/*
+ * Look up an open file descriptor, returning a consistent snapshot of its
+ * object and vtable. The lookup doesn't lock: it runs in an RCU read-side
+ * critical section, and an entry isn't reused before the critical sections
+ * that may have seen it open are left.
+ */
+static int _get_fd(int fd, void **obj, const struct fd_op_vtable **vtable)
 {
+	struct fd_entry *entry;
+	k_rcu_key_t key;
+
 	if (fd < 0 || fd >= ARRAY_SIZE(fdtable)) {
 		errno = EBADF;
 		return -1;
 	}
 
 	fd = k_array_index_sanitize(fd, ARRAY_SIZE(fdtable));
+	entry = &fdtable[fd];
+
+	key = k_rcu_read_lock();
 
-	if (!atomic_get(&fdtable[fd].refcount)) {
+	if (!atomic_get(&entry->refcount)) {
+		k_rcu_read_unlock(key);
 		errno = EBADF;
 		return -1;
 	}
 
+	/* z_finalize_fd() publishes the vtable after the object */
+	*vtable = k_rcu_dereference(entry->vtable);
+	*obj = entry->obj;
+
+	k_rcu_read_unlock(key);
+
 	return 0;
 }
 
 void *z_get_fd_obj(int fd, const struct fd_op_vtable *vtable, int err)
 {
-	struct fd_entry *entry;
+	const struct fd_op_vtable *fd_vtable;
+	void *obj;
 
-	if (_check_fd(fd) < 0) {
+	if (_get_fd(fd, &obj, &fd_vtable) < 0) {
 		return NULL;
 	}
 
-	entry = &fdtable[fd];
-
-	if (vtable != NULL && entry->vtable != vtable) {
+	if (vtable != NULL && fd_vtable != vtable) {
 		errno = err;
 		return NULL;
 	}
 
-	return entry->obj;
+	return obj;
 }
 
 void *z_get_fd_obj_and_vtable(int fd, const struct fd_op_vtable **vtable,
 			      struct k_mutex **lock)
 {
-	struct fd_entry *entry;
+	void *obj;
 
-	if (_check_fd(fd) < 0) {
+	if (_get_fd(fd, &obj, vtable) < 0) {
 		return NULL;
 	}
 
-	entry = &fdtable[fd];
-	*vtable = entry->vtable;
-
 	if (lock) {
-		*lock = &entry->lock;
+		*lock = &fdtable[fd].lock;
 	}
 
-	return entry->obj;
+	return obj;
 }
 
 int z_reserve_fd(void)
@@ -190,7 +214,7 @@ void z_finalize_fd(int fd, void *obj, const struct fd_op_vtable *vtable)
 	z_object_recycle(obj);
 #endif
 	fdtable[fd].obj = obj;
-	fdtable[fd].vtable = vtable;
+	k_rcu_assign_pointer(fdtable[fd].vtable, vtable);
 
 	/* Let the object know about the lock just in case it needs it
 	 * for something. For BSD sockets, the lock is used with condition
@@ -222,35 +246,59 @@ int z_alloc_fd(void *obj, const struct fd_op_vtable *vtable)
 
 #ifdef CONFIG_POSIX_API
 
+/* Look up a file descriptor whose operations can be called */
+static int _get_fd_ops(int fd, void **obj, const struct fd_op_vtable **vtable)
+{
+	if (_get_fd(fd, obj, vtable) < 0) {
+		return -1;
+	}
+
+	if (*vtable == NULL) {
+		/* Reserved, but not finalized yet */
+		errno = EBADF;
+		return -1;
+	}
+
+	return 0;
+}
+
 ssize_t read(int fd, void *buf, size_t sz)
 {
-	if (_check_fd(fd) < 0) {
+	const struct fd_op_vtable *vtable;
+	void *obj;
+
+	if (_get_fd_ops(fd, &obj, &vtable) < 0) {
 		return -1;
 	}
 
-	return fdtable[fd].vtable->read(fdtable[fd].obj, buf, sz);
+	return vtable->read(obj, buf, sz);
 }
 FUNC_ALIAS(read, _read, ssize_t);
 
 ssize_t write(int fd, const void *buf, size_t sz)
 {
-	if (_check_fd(fd) < 0) {
+	const struct fd_op_vtable *vtable;
+	void *obj;
+
+	if (_get_fd_ops(fd, &obj, &vtable) < 0) {
 		return -1;
 	}
 
-	return fdtable[fd].vtable->write(fdtable[fd].obj, buf, sz);
+	return vtable->write(obj, buf, sz);
 }
 FUNC_ALIAS(write, _write, ssize_t);
 
 int close(int fd)
 {
+	const struct fd_op_vtable *vtable;
+	void *obj;
 	int res;
 
-	if (_check_fd(fd) < 0) {
+	if (_get_fd_ops(fd, &obj, &vtable) < 0) {
 		return -1;
 	}
 
-	res = fdtable[fd].vtable->close(fdtable[fd].obj);
+	res = vtable->close(obj);
 
 	z_free_fd(fd);
 
@@ -260,35 +308,43 @@ FUNC_ALIAS(close, _close, int);
 
 int fsync(int fd)
 {
-	if (_check_fd(fd) < 0) {
+	const struct fd_op_vtable *vtable;
+	void *obj;
+
+	if (_get_fd_ops(fd, &obj, &vtable) < 0) {
 		return -1;
 	}
 
-	return z_fdtable_call_ioctl(fdtable[fd].vtable, fdtable[fd].obj, ZFD_IOCTL_FSYNC);
+	return z_fdtable_call_ioctl(vtable, obj, ZFD_IOCTL_FSYNC);
 }
 
 off_t lseek(int fd, off_t offset, int whence)
 {
-	if (_check_fd(fd) < 0) {
+	const struct fd_op_vtable *vtable;
+	void *obj;
+
+	if (_get_fd_ops(fd, &obj, &vtable) < 0) {
 		return -1;
 	}
 
-	return z_fdtable_call_ioctl(fdtable[fd].vtable, fdtable[fd].obj, ZFD_IOCTL_LSEEK,
+	return z_fdtable_call_ioctl(vtable, obj, ZFD_IOCTL_LSEEK,
 			  offset, whence);
 }
 FUNC_ALIAS(lseek, _lseek, off_t);
 
 int ioctl(int fd, unsigned long request, ...)
 {
+	const struct fd_op_vtable *vtable;
+	void *obj;
 	va_list args;
 	int res;
 
-	if (_check_fd(fd) < 0) {
+	if (_get_fd_ops(fd, &obj, &vtable) < 0) {
 		return -1;
 	}
 
 	va_start(args, request);
-	res = fdtable[fd].vtable->ioctl(fdtable[fd].obj, request, args);
+	res = vtable->ioctl(obj, request, args);
 	va_end(args);
 
 	return res;
@@ -296,10 +352,12 @@ int ioctl(int fd, unsigned long request, ...)
 
 int fcntl(int fd, int cmd, ...)
 {
+	const struct fd_op_vtable *vtable;
+	void *obj;
 	va_list args;
 	int res;
 
-	if (_check_fd(fd) < 0) {
+	if (_get_fd_ops(fd, &obj, &vtable) < 0) {
 		return -1;
 	}
 
@@ -312,7 +370,7 @@ int fcntl(int fd, int cmd, ...)
 
 	/* The rest of commands are per-fd, handled by ioctl vmethod. */
 	va_start(args, cmd);
-	res = fdtable[fd].vtable->ioctl(fdtable[fd].obj, cmd, args);
+	res = vtable->ioctl(obj, cmd, args);
 	va_end(args);
 
 	return res;
@@ -17,6 +17,10 @@
 
 #include <data/json.h>
 
+#if defined(CONFIG_NET_BUF)
+#include <net/buf.h>
+#endif
+
 struct token {
 	enum json_tokens type;
 	char *start;
@@ -107,12 +111,51 @@ static int peek(struct lexer *lexer)
 	return chr;
 }
 
+/* Word-at-a-time helpers to find bytes of interest in a string. */
+#define WORD_ONES  ((unsigned long)-1 / 0xff)
+#define WORD_HIGHS (WORD_ONES * 0x80)
+#define WORD_HAS_ZERO(w) (((w) - WORD_ONES) & ~(w) & WORD_HIGHS)
+#define WORD_HAS_BYTE(w, b) WORD_HAS_ZERO((w) ^ (WORD_ONES * (b)))
+
+/*
+ * Return the length of the run at the start of [pos, end) which contains
+ * neither a quote, a backslash nor a NUL character, i.e. the part of a
+ * string body which the lexer can skip without looking at it. Whole words
+ * are tested at once, only the word holding the terminator is walked byte
+ * by byte.
+ */
+static size_t string_run_len(const char *pos, const char *end)
+{
+	const char *start = pos;
+
+	while ((size_t)(end - pos) >= sizeof(unsigned long)) {
+		unsigned long word;
+
+		memcpy(&word, pos, sizeof(word));
+		if (WORD_HAS_BYTE(word, '"') || WORD_HAS_BYTE(word, '\\') ||
+		    WORD_HAS_ZERO(word)) {
+			break;
+		}
+
+		pos += sizeof(word);
+	}
+
+	while (pos < end && *pos != '"' && *pos != '\\' && *pos != '\0') {
+		pos++;
+	}
+
+	return (size_t)(pos - start);
+}
+
 static void *lexer_string(struct lexer *lexer)
 {
 	ignore(lexer);
 
 	while (true) {
-		int chr = next(lexer);
+		int chr;
+
+		lexer->pos += string_run_len(lexer->pos, lexer->end);
+		chr = next(lexer);
 
 		if (chr == '\0') {
 			emit(lexer, JSON_TOK_ERROR);
@@ -487,16 +530,23 @@ static ptrdiff_t get_elem_size(const struct json_obj_descr *descr)
 	case JSON_TOK_LIST_START:
 		return descr->array.n_elements * get_elem_size(descr->array.element_descr);
 	case JSON_TOK_OBJECT_START: {
+		const struct json_obj_descr *sub = descr->object.sub_descr;
 		ptrdiff_t total = 0;
+		uint32_t align_shift = 0;
 		size_t i;
 
+		/* As laid out by the compiler: the struct ends with the
+		 * member ending last, and is padded to its alignment, which
+		 * is that of its members.
+		 */
 		for (i = 0; i < descr->object.sub_descr_len; i++) {
-			ptrdiff_t s = get_elem_size(&descr->object.sub_descr[i]);
+			ptrdiff_t end = sub[i].offset + get_elem_size(&sub[i]);
 
-			total += ROUND_UP(s, 1 << descr->align_shift);
+			total = MAX(total, end);
+			align_shift = MAX(align_shift, sub[i].align_shift);
 		}
 
-		return total;
+		return ROUND_UP(total, 1 << align_shift);
 	}
 	default:
 		return -EINVAL;
@@ -544,12 +594,55 @@ static int arr_parse(struct json_obj *obj,
 	return -EINVAL;
 }
 
+/*
+ * Find the descriptor of a key which has not been decoded yet. Keys
+ * usually come in the order of the descriptor array, so the search starts
+ * at @a cursor, the field following the previous match, which makes the
+ * common case a single comparison.
+ */
+static int field_find(const struct json_obj_descr *descr, size_t descr_len,
+		      int32_t decoded_fields, const char *key, size_t key_len,
+		      size_t cursor)
+{
+	size_t i = cursor;
+	size_t n;
+
+	for (n = 0; n < descr_len; n++, i++) {
+		if (i == descr_len) {
+			i = 0;
+		}
+
+		/* Field has been decoded already, skip */
+		if (decoded_fields & (1 << i)) {
+			continue;
+		}
+
+		/* Check if it's the i-th field */
+		if (key_len != descr[i].field_name_len) {
+			continue;
+		}
+
+		if (key_len && (key[0] != descr[i].field_name[0])) {
+			continue;
+		}
+
+		if (memcmp(key, descr[i].field_name, key_len)) {
+			continue;
+		}
+
+		return (int)i;
+	}
+
+	return -ENOENT;
+}
+
 static int obj_parse(struct json_obj *obj, const struct json_obj_descr *descr,
 		     size_t descr_len, void *val)
 {
 	struct json_obj_key_value kv;
 	int32_t decoded_fields = 0;
-	size_t i;
+	size_t cursor = 0;
+	int i;
 	int ret;
 
 	while (!obj_next(obj, &kv)) {
@@ -557,34 +650,21 @@ static int obj_parse(struct json_obj *obj, const struct json_obj_descr *descr,
 			return decoded_fields;
 		}
 
-		for (i = 0; i < descr_len; i++) {
-			void *decode_field = (char *)val + descr[i].offset;
-
-			/* Field has been decoded already, skip */
-			if (decoded_fields & (1 << i)) {
-				continue;
-			}
-
-			/* Check if it's the i-th field */
-			if (kv.key_len != descr[i].field_name_len) {
-				continue;
-			}
-
-			if (memcmp(kv.key, descr[i].field_name,
-				   descr[i].field_name_len)) {
-				continue;
-			}
-
-			/* Store the decoded value */
-			ret = decode_value(obj, &descr[i], &kv.value,
-					   decode_field, val);
-			if (ret < 0) {
-				return ret;
-			}
+		i = field_find(descr, descr_len, decoded_fields,
+			       kv.key, kv.key_len, cursor);
+		if (i < 0) {
+			continue;
+		}
 
-			decoded_fields |= 1<<i;
-			break;
+		/* Store the decoded value */
+		ret = decode_value(obj, &descr[i], &kv.value,
+				   (char *)val + descr[i].offset, val);
+		if (ret < 0) {
+			return ret;
 		}
+
+		decoded_fields |= 1<<i;
+		cursor = i + 1;
 	}
 
 	return -EINVAL;
@@ -607,340 +687,1030 @@ int json_obj_parse(char *payload, size_t len,
 	return obj_parse(&obj, descr, descr_len, val);
 }
 
-static char escape_as(char chr)
-{
-	switch (chr) {
-	case '"':
-		return '"';
-	case '\\':
-		return '\\';
-	case '\b':
-		return 'b';
-	case '\f':
-		return 'f';
-	case '\n':
-		return 'n';
-	case '\r':
-		return 'r';
-	case '\t':
-		return 't';
-	}
+enum stream_tok {
+	STREAM_TOK_NONE,
+	STREAM_TOK_STRING,
+	STREAM_TOK_ESCAPE,
+	STREAM_TOK_UNICODE,
+	STREAM_TOK_NUMBER,
+	STREAM_TOK_LITERAL,
+};
 
-	return 0;
-}
+enum stream_state {
+	STREAM_KEY_OR_END,
+	STREAM_KEY,
+	STREAM_COLON,
+	STREAM_VALUE,
+	STREAM_COMMA_OR_END,
+	STREAM_ELEM_OR_END,
+	STREAM_ELEM,
+};
 
-static int json_escape_internal(const char *str,
-				json_append_bytes_t append_bytes,
-				void *data)
+static int stream_push(struct json_obj_stream *stream, uint8_t type,
+		       const struct json_obj_descr *descr, size_t descr_len,
+		       void *val)
 {
-	const char *cur;
-	int ret = 0;
-
-	for (cur = str; ret == 0 && *cur; cur++) {
-		char escaped = escape_as(*cur);
+	struct json_obj_stream_level *level;
 
-		if (escaped) {
-			char bytes[2] = { '\\', escaped };
-
-			ret = append_bytes(bytes, 2, data);
-		} else {
-			ret = append_bytes(cur, 1, data);
-		}
+	if (stream->depth == JSON_STREAM_MAX_DEPTH - 1) {
+		return -ENOMEM;
 	}
 
-	return ret;
+	level = &stream->stack[++stream->depth];
+	level->descr = descr;
+	level->descr_len = descr_len;
+	level->val = val;
+	level->elements = NULL;
+	level->count = 0;
+	level->decoded = 0;
+	level->cursor = 0;
+	level->field = -1;
+	level->type = type;
+	level->state = (type == JSON_TOK_LIST_START) ?
+		       STREAM_ELEM_OR_END : STREAM_KEY_OR_END;
+
+	return 0;
 }
 
-size_t json_calc_escaped_len(const char *str, size_t len)
+static int stream_pop(struct json_obj_stream *stream)
 {
-	size_t escaped_len = len;
-	size_t pos;
-
-	for (pos = 0; pos < len; pos++) {
-		if (escape_as(str[pos])) {
-			escaped_len++;
-		}
+	if (stream->depth-- == 0) {
+		/* End of the top level object */
+		stream->result = stream->stack[0].decoded;
+		return 1;
 	}
 
-	return escaped_len;
+	return 0;
 }
 
-ssize_t json_escape(char *str, size_t *len, size_t buf_size)
+static int stream_str_put(struct json_obj_stream *stream, const char *data,
+			  size_t len)
 {
-	char *next; /* Points after next character to escape. */
-	char *dest; /* Points after next place to write escaped character. */
-	size_t escaped_len = json_calc_escaped_len(str, *len);
+	if (stream->in_key) {
+		if (stream->tok_len + len > JSON_STREAM_KEY_MAX) {
+			/* Too long to match any field, only track the length */
+			stream->tok_len = JSON_STREAM_KEY_MAX + 1;
+		} else {
+			memcpy(&stream->tok_buf[stream->tok_len], data, len);
+			stream->tok_len += len;
+		}
 
-	if (escaped_len == *len) {
-		/*
-		 * If no escape is necessary, there is nothing to do.
-		 */
 		return 0;
 	}
 
-	if (escaped_len >= buf_size) {
-		return -ENOMEM;
+	if (stream->field == NULL) {
+		return 0;
 	}
 
-	/*
-	 * By walking backwards in the buffer from the end positions
-	 * of both the original and escaped strings, we avoid using
-	 * extra space. Characters in the original string are
-	 * overwritten only after they have already been escaped.
-	 */
-	str[escaped_len] = '\0';
-	for (next = &str[*len], dest = &str[escaped_len]; next != str;) {
-		char next_c = *(--next);
-		char escape = escape_as(next_c);
-
-		if (escape) {
-			*(--dest) = escape;
-			*(--dest) = '\\';
-		} else {
-			*(--dest) = next_c;
-		}
+	/* Keep room for the terminating NUL character */
+	if (len >= stream->str_buf_size - stream->str_used) {
+		return -ENOMEM;
 	}
-	*len = escaped_len;
+
+	memcpy(&stream->str_buf[stream->str_used], data, len);
+	stream->str_used += len;
 
 	return 0;
 }
 
-static int encode(const struct json_obj_descr *descr, const void *val,
-		  json_append_bytes_t append_bytes, void *data);
-
-static int arr_encode(const struct json_obj_descr *elem_descr,
-		      const void *field, const void *val,
-		      json_append_bytes_t append_bytes, void *data)
+static int stream_str_end(struct json_obj_stream *stream)
 {
-	ptrdiff_t elem_size = get_elem_size(elem_descr);
-	/*
-	 * NOTE: Since an element descriptor's offset isn't meaningful
-	 * (array elements occur at multiple offsets in `val'), we use
-	 * its space in elem_descr to store the offset to the field
-	 * containing the number of elements.
-	 */
-	size_t n_elem = *(size_t *)((char *)val + elem_descr->offset);
-	size_t i;
-	int ret;
+	struct json_obj_stream_level *level = &stream->stack[stream->depth];
+	int i;
 
-	ret = append_bytes("[", 1, data);
-	if (ret < 0) {
-		return ret;
-	}
+	stream->tok = STREAM_TOK_NONE;
 
-	for (i = 0; i < n_elem; i++) {
-		/*
-		 * Though "field" points at the next element in the
-		 * array which we need to encode, the value in
-		 * elem_descr->offset is actually the offset of the
-		 * length field in the "parent" struct containing the
-		 * array.
-		 *
-		 * To patch things up, we lie to encode() about where
-		 * the field is by exactly the amount it will offset
-		 * it. This is a size optimization for struct
-		 * json_obj_descr: the alternative is to keep a
-		 * separate field next to element_descr which is an
-		 * offset to the length field in the parent struct,
-		 * but that would add a size_t to every descriptor.
-		 */
-		ret = encode(elem_descr, (char *)field - elem_descr->offset,
-			     append_bytes, data);
-		if (ret < 0) {
-			return ret;
-		}
+	if (stream->in_key) {
+		stream->in_key = false;
 
-		if (i < n_elem - 1) {
-			ret = append_bytes(",", 1, data);
-			if (ret < 0) {
-				return ret;
-			}
+		if (level->type != JSON_TOK_OBJECT_START) {
+			return 0;
 		}
 
-		field = (char *)field + elem_size;
-	}
-
-	return append_bytes("]", 1, data);
-}
-
-static int str_encode(const char **str, json_append_bytes_t append_bytes,
-		      void *data)
-{
-	int ret;
+		i = field_find((const struct json_obj_descr *)level->descr,
+			       level->descr_len, level->decoded,
+			       stream->tok_buf, stream->tok_len, level->cursor);
+		level->field = (i < 0) ? -1 : i;
 
-	ret = append_bytes("\"", 1, data);
-	if (ret < 0) {
-		return ret;
+		return 0;
 	}
 
-	ret = json_escape_internal(*str, append_bytes, data);
-	if (!ret) {
-		return append_bytes("\"", 1, data);
+	if (stream->field == NULL) {
+		return 0;
 	}
 
-	return ret;
+	stream->str_buf[stream->str_used++] = '\0';
+	*(char **)stream->field = &stream->str_buf[stream->str_start];
+
+	return 0;
 }
 
-static int num_encode(const int32_t *num, json_append_bytes_t append_bytes,
-		      void *data)
+static int stream_num_end(struct json_obj_stream *stream)
 {
-	char buf[3 * sizeof(int32_t)];
-	int ret;
-
-	ret = snprintk(buf, sizeof(buf), "%d", *num);
-	if (ret < 0) {
-		return ret;
-	}
-	if (ret >= (int)sizeof(buf)) {
-		return -ENOMEM;
-	}
+	char *endptr;
+	int32_t num;
 
-	return append_bytes(buf, (size_t)ret, data);
-}
+	stream->tok = STREAM_TOK_NONE;
 
-static int bool_encode(const bool *value, json_append_bytes_t append_bytes,
-		       void *data)
-{
-	if (*value) {
-		return append_bytes("true", 4, data);
+	if (stream->field == NULL) {
+		return 0;
 	}
 
-	return append_bytes("false", 5, data);
-}
+	stream->tok_buf[stream->tok_len] = '\0';
 
-static int encode(const struct json_obj_descr *descr, const void *val,
-		  json_append_bytes_t append_bytes, void *data)
-{
-	void *ptr = (char *)val + descr->offset;
+	errno = 0;
+	num = strtol(stream->tok_buf, &endptr, 10);
+	if (errno != 0) {
+		return -errno;
+	}
 
-	switch (descr->type) {
-	case JSON_TOK_FALSE:
-	case JSON_TOK_TRUE:
-		return bool_encode(ptr, append_bytes, data);
-	case JSON_TOK_STRING:
-		return str_encode(ptr, append_bytes, data);
-	case JSON_TOK_LIST_START:
-		return arr_encode(descr->array.element_descr, ptr,
-				  val, append_bytes, data);
-	case JSON_TOK_OBJECT_START:
-		return json_obj_encode(descr->object.sub_descr,
-				       descr->object.sub_descr_len,
-				       ptr, append_bytes, data);
-	case JSON_TOK_NUMBER:
-		return num_encode(ptr, append_bytes, data);
-	default:
+	if (endptr != &stream->tok_buf[stream->tok_len]) {
 		return -EINVAL;
 	}
+
+	*(int32_t *)stream->field = num;
+
+	return 0;
 }
 
-int json_obj_encode(const struct json_obj_descr *descr, size_t descr_len,
-		    const void *val, json_append_bytes_t append_bytes,
-		    void *data)
+static int stream_value_start(struct json_obj_stream *stream,
+			      struct json_obj_stream_level *level, int chr)
 {
-	size_t i;
-	int ret;
+	const struct json_obj_descr *descr = NULL;
+	enum json_tokens type;
+	char *field = NULL;
+	char *parent = NULL;
 
-	ret = append_bytes("{", 1, data);
-	if (ret < 0) {
-		return ret;
+	switch (chr) {
+	case '{':
+	case '[':
+	case '"':
+		type = (enum json_tokens)chr;
+		break;
+	case 't':
+		type = JSON_TOK_TRUE;
+		break;
+	case 'f':
+		type = JSON_TOK_FALSE;
+		break;
+	case 'n':
+		type = JSON_TOK_NULL;
+		break;
+	default:
+		if (chr == '-' || isdigit(chr)) {
+			type = JSON_TOK_NUMBER;
+			break;
+		}
+
+		return -EINVAL;
 	}
 
-	for (i = 0; i < descr_len; i++) {
-		ret = str_encode((const char **)&descr[i].field_name,
-				 append_bytes, data);
-		if (ret < 0) {
-			return ret;
+	if (level->type == JSON_TOK_OBJECT_START) {
+		if (level->field >= 0) {
+			descr = &level->descr[level->field];
+			parent = level->val;
+			field = parent + descr->offset;
+			level->decoded |= 1 << level->field;
+			level->cursor = level->field + 1;
 		}
+	} else {
+		ptrdiff_t elem_size = get_elem_size(level->descr);
 
-		ret = append_bytes(":", 1, data);
-		if (ret < 0) {
-			return ret;
+		if (level->count == level->descr_len) {
+			return -ENOSPC;
 		}
 
-		ret = encode(&descr[i], val, append_bytes, data);
-		if (ret < 0) {
-			return ret;
+		descr = level->descr;
+		field = level->val;
+		level->val += elem_size;
+		level->count++;
+		if (level->elements) {
+			(*level->elements)++;
 		}
+	}
 
-		if (i < descr_len - 1) {
-			ret = append_bytes(",", 1, data);
-			if (ret < 0) {
-				return ret;
-			}
-		}
+	level->state = STREAM_COMMA_OR_END;
+
+	if (descr && !equivalent_types(type, descr->type)) {
+		return -EINVAL;
 	}
 
-	return append_bytes("}", 1, data);
-}
+	stream->field = field;
 
-int json_arr_encode(const struct json_obj_descr *descr, const void *val,
-		    json_append_bytes_t append_bytes, void *data)
-{
-	void *ptr = (char *)val + descr->offset;
+	switch (type) {
+	case JSON_TOK_OBJECT_START:
+		if (descr == NULL) {
+			stream->skip = 1;
+			return 0;
+		}
 
-	return arr_encode(descr->array.element_descr, ptr, val, append_bytes,
-			  data);
-}
+		return stream_push(stream, JSON_TOK_OBJECT_START,
+				   descr->object.sub_descr,
+				   descr->object.sub_descr_len, field);
+	case JSON_TOK_LIST_START: {
+		const struct json_obj_descr *elem_descr;
+		int ret;
 
-struct appender {
-	char *buffer;
-	size_t used;
+		if (descr == NULL) {
+			stream->skip = 1;
+			return 0;
+		}
+
+		elem_descr = descr->array.element_descr;
+		ret = stream_push(stream, JSON_TOK_LIST_START, elem_descr,
+				  descr->array.n_elements, field);
+		if (ret == 0 && parent) {
+			level = &stream->stack[stream->depth];
+			level->elements = (size_t *)(parent +
+						     elem_descr->offset);
+			*level->elements = 0;
+		}
+
+		return ret;
+	}
+	case JSON_TOK_STRING:
+		stream->tok = STREAM_TOK_STRING;
+		stream->str_start = stream->str_used;
+		return 0;
+	case JSON_TOK_NUMBER:
+		stream->tok = STREAM_TOK_NUMBER;
+		stream->tok_buf[0] = (char)chr;
+		stream->tok_len = 1;
+		return 0;
+	case JSON_TOK_NULL:
+		/* Only reached for a value which is skipped */
+		stream->tok = STREAM_TOK_LITERAL;
+		stream->literal = "null";
+		stream->tok_len = 1;
+		return 0;
+	default:
+		stream->tok = STREAM_TOK_LITERAL;
+		stream->literal = (type == JSON_TOK_TRUE) ? "true" : "false";
+		stream->tok_len = 1;
+		if (field) {
+			*(bool *)field = (type == JSON_TOK_TRUE);
+		}
+		return 0;
+	}
+}
+
+/*
+ * Skip the contents of an object or array which is not decoded. Only its
+ * nesting depth is tracked, it does not take a level of the stack.
+ */
+static void stream_skip(struct json_obj_stream *stream, int chr)
+{
+	switch (chr) {
+	case '"':
+		stream->tok = STREAM_TOK_STRING;
+		break;
+	case '{':
+	case '[':
+		stream->skip++;
+		break;
+	case '}':
+	case ']':
+		stream->skip--;
+		break;
+	default:
+		break;
+	}
+}
+
+/*
+ * Handle a character outside of a token. Returns 1 once the top level
+ * object has been parsed.
+ */
+static int stream_structural(struct json_obj_stream *stream, int chr)
+{
+	struct json_obj_stream_level *level;
+
+	if (stream->depth < 0) {
+		if (isspace(chr)) {
+			return 0;
+		}
+
+		if (chr != '{') {
+			return -EINVAL;
+		}
+
+		return stream_push(stream, JSON_TOK_OBJECT_START,
+				   stream->stack[0].descr,
+				   stream->stack[0].descr_len,
+				   stream->stack[0].val);
+	}
+
+	if (stream->skip) {
+		stream_skip(stream, chr);
+		return 0;
+	}
+
+	level = &stream->stack[stream->depth];
+
+	if (isspace(chr)) {
+		return 0;
+	}
+
+	switch (level->state) {
+	case STREAM_KEY_OR_END:
+		if (chr == '}') {
+			return stream_pop(stream);
+		}
+
+		__fallthrough;
+	case STREAM_KEY:
+		if (chr != '"') {
+			return -EINVAL;
+		}
+
+		stream->tok = STREAM_TOK_STRING;
+		stream->in_key = true;
+		stream->tok_len = 0;
+		level->state = STREAM_COLON;
+		return 0;
+	case STREAM_COLON:
+		if (chr != ':') {
+			return -EINVAL;
+		}
+
+		level->state = STREAM_VALUE;
+		return 0;
+	case STREAM_COMMA_OR_END:
+		if (chr == ',') {
+			level->state = (level->type == JSON_TOK_OBJECT_START) ?
+				       STREAM_KEY : STREAM_ELEM;
+			return 0;
+		}
+
+		if ((chr == '}' && level->type == JSON_TOK_OBJECT_START) ||
+		    (chr == ']' && level->type == JSON_TOK_LIST_START)) {
+			return stream_pop(stream);
+		}
+
+		return -EINVAL;
+	case STREAM_ELEM_OR_END:
+		if (chr == ']') {
+			return stream_pop(stream);
+		}
+
+		__fallthrough;
+	case STREAM_VALUE:
+	case STREAM_ELEM:
+		return stream_value_start(stream, level, chr);
+	default:
+		return -EINVAL;
+	}
+}
+
+void json_obj_stream_init(struct json_obj_stream *stream,
+			  const struct json_obj_descr *descr,
+			  size_t descr_len, void *val,
+			  char *str_buf, size_t str_buf_size)
+{
+	__ASSERT_NO_MSG(descr_len < (sizeof(stream->result) * CHAR_BIT - 1));
+
+	memset(stream, 0, sizeof(*stream));
+
+	/* The top level object is pushed when its opening brace is seen */
+	stream->stack[0].descr = descr;
+	stream->stack[0].descr_len = descr_len;
+	stream->stack[0].val = val;
+	stream->depth = -1;
+	stream->result = -EAGAIN;
+	stream->str_buf = str_buf;
+	stream->str_buf_size = str_buf_size;
+}
+
+static int stream_parse(struct json_obj_stream *stream,
+			const char *pos, const char *end)
+{
+	int ret;
+
+	while (pos < end) {
+		int chr;
+
+		switch (stream->tok) {
+		case STREAM_TOK_STRING: {
+			size_t run = string_run_len(pos, end);
+
+			ret = stream_str_put(stream, pos, run);
+			if (ret < 0) {
+				return ret;
+			}
+
+			pos += run;
+			if (pos == end) {
+				return -EAGAIN;
+			}
+
+			chr = *pos++;
+			if (chr == '"') {
+				ret = stream_str_end(stream);
+			} else if (chr == '\\') {
+				stream->tok = STREAM_TOK_ESCAPE;
+				ret = stream_str_put(stream, pos - 1, 1);
+			} else {
+				ret = -EINVAL;
+			}
+
+			if (ret < 0) {
+				return ret;
+			}
+
+			continue;
+		}
+		case STREAM_TOK_ESCAPE:
+			chr = *pos;
+			switch (chr) {
+			case '"':
+			case '\\':
+			case '/':
+			case 'b':
+			case 'f':
+			case 'n':
+			case 'r':
+			case 't':
+				stream->tok = STREAM_TOK_STRING;
+				break;
+			case 'u':
+				stream->tok = STREAM_TOK_UNICODE;
+				stream->literal = "xxxx";
+				break;
+			default:
+				return -EINVAL;
+			}
+
+			ret = stream_str_put(stream, pos++, 1);
+			if (ret < 0) {
+				return ret;
+			}
+
+			continue;
+		case STREAM_TOK_UNICODE:
+			if (!isxdigit((unsigned char)*pos)) {
+				return -EINVAL;
+			}
+
+			ret = stream_str_put(stream, pos++, 1);
+			if (ret < 0) {
+				return ret;
+			}
+
+			/* stream->literal counts the remaining hex digits */
+			if (*++stream->literal == '\0') {
+				stream->tok = STREAM_TOK_STRING;
+			}
+
+			continue;
+		case STREAM_TOK_NUMBER:
+			chr = (unsigned char)*pos;
+			if (isdigit(chr) || chr == '.') {
+				if (stream->tok_len == JSON_STREAM_KEY_MAX) {
+					return -EINVAL;
+				}
+
+				stream->tok_buf[stream->tok_len++] = (char)chr;
+				pos++;
+				continue;
+			}
+
+			/* The terminating character is handled below */
+			ret = stream_num_end(stream);
+			if (ret < 0) {
+				return ret;
+			}
+
+			break;
+		case STREAM_TOK_LITERAL:
+			if (*pos++ != stream->literal[stream->tok_len]) {
+				return -EINVAL;
+			}
+
+			if (stream->literal[++stream->tok_len] == '\0') {
+				stream->tok = STREAM_TOK_NONE;
+			}
+
+			continue;
+		default:
+			break;
+		}
+
+		ret = stream_structural(stream, (unsigned char)*pos++);
+		if (ret < 0) {
+			return ret;
+		}
+
+		if (ret > 0) {
+			return stream->result;
+		}
+	}
+
+	return -EAGAIN;
+}
+
+int json_obj_stream_parse(struct json_obj_stream *stream,
+			  const char *chunk, size_t len)
+{
+	if (stream->result != -EAGAIN) {
+		return stream->result;
+	}
+
+	stream->result = stream_parse(stream, chunk, chunk + len);
+
+	return stream->result;
+}
+
+static char escape_as(char chr)
+{
+	switch (chr) {
+	case '"':
+		return '"';
+	case '\\':
+		return '\\';
+	case '\b':
+		return 'b';
+	case '\f':
+		return 'f';
+	case '\n':
+		return 'n';
+	case '\r':
+		return 'r';
+	case '\t':
+		return 't';
+	}
+
+	return 0;
+}
+
+size_t json_calc_escaped_len(const char *str, size_t len)
+{
+	size_t escaped_len = len;
+	size_t pos;
+
+	for (pos = 0; pos < len; pos++) {
+		if (escape_as(str[pos])) {
+			escaped_len++;
+		}
+	}
+
+	return escaped_len;
+}
+
+ssize_t json_escape(char *str, size_t *len, size_t buf_size)
+{
+	char *next; /* Points after next character to escape. */
+	char *dest; /* Points after next place to write escaped character. */
+	size_t escaped_len = json_calc_escaped_len(str, *len);
+
+	if (escaped_len == *len) {
+		/*
+		 * If no escape is necessary, there is nothing to do.
+		 */
+		return 0;
+	}
+
+	if (escaped_len >= buf_size) {
+		return -ENOMEM;
+	}
+
+	/*
+	 * By walking backwards in the buffer from the end positions
+	 * of both the original and escaped strings, we avoid using
+	 * extra space. Characters in the original string are
+	 * overwritten only after they have already been escaped.
+	 */
+	str[escaped_len] = '\0';
+	for (next = &str[*len], dest = &str[escaped_len]; next != str;) {
+		char next_c = *(--next);
+		char escape = escape_as(next_c);
+
+		if (escape) {
+			*(--dest) = escape;
+			*(--dest) = '\\';
+		} else {
+			*(--dest) = next_c;
+		}
+	}
+	*len = escaped_len;
+
+	return 0;
+}
+
+/*
+ * Output of the encoder. Bytes are either copied straight into a
+ * contiguous buffer, keeping room for the terminating NUL character, or
+ * staged in a small buffer that is handed to an append_bytes callback
+ * whenever it fills up. In both cases total counts every byte the object
+ * encodes to, so once a contiguous buffer overflows the encoder keeps
+ * going only to measure the size.
+ */
+struct json_writer {
+	char *buf;
 	size_t size;
+	size_t used;
+	size_t total;
+	json_append_bytes_t append_bytes;
+	void *data;
+	int err;
 };
 
-static int append_bytes_to_buf(const char *bytes, size_t len, void *data)
+/* Size of the staging buffer used with append_bytes callbacks */
+#define JSON_WRITER_STAGE_SIZE 64
+
+static void writer_flush(struct json_writer *writer)
 {
-	struct appender *appender = data;
+	if (writer->used && !writer->err) {
+		writer->err = writer->append_bytes(writer->buf, writer->used,
+						   writer->data);
+	}
 
-	if (len >= appender->size - appender->used) {
-		return -ENOMEM;
+	writer->used = 0;
+}
+
+static void writer_put(struct json_writer *writer, const char *bytes,
+		       size_t len)
+{
+	writer->total += len;
+
+	if (!writer->append_bytes) {
+		if (writer->used + len < writer->size) {
+			memcpy(writer->buf + writer->used, bytes, len);
+			writer->used += len;
+		} else {
+			/* Out of space, only measure from now on */
+			writer->size = 0;
+		}
+
+		return;
+	}
+
+	if (len > writer->size - writer->used) {
+		writer_flush(writer);
+
+		if (len > writer->size) {
+			if (!writer->err) {
+				writer->err = writer->append_bytes(bytes, len,
+								   writer->data);
+			}
+
+			return;
+		}
+	}
+
+	memcpy(writer->buf + writer->used, bytes, len);
+	writer->used += len;
+}
+
+static void writer_putc(struct json_writer *writer, char chr)
+{
+	writer_put(writer, &chr, 1);
+}
+
+/*
+ * Writes a string, escaping it as needed. Characters which do not need
+ * escaping are written in spans rather than one at a time.
+ */
+static void writer_put_escaped(struct json_writer *writer, const char *str,
+			       size_t len)
+{
+	const char *end = str + len;
+
+	while (str < end) {
+		const char *run = str;
+		char escaped[2] = { '\\' };
+
+		while (run < end && (unsigned char)*run >= ' ' &&
+		       *run != '"' && *run != '\\') {
+			run++;
+		}
+
+		writer_put(writer, str, run - str);
+		if (run == end) {
+			return;
+		}
+
+		escaped[1] = escape_as(*run);
+		if (escaped[1]) {
+			writer_put(writer, escaped, 2);
+		} else {
+			writer_putc(writer, *run);
+		}
+
+		str = run + 1;
+	}
+}
+
+static void writer_str(struct json_writer *writer, const char *str)
+{
+	writer_putc(writer, '"');
+	writer_put_escaped(writer, str, strlen(str));
+	writer_putc(writer, '"');
+}
+
+static void writer_num(struct json_writer *writer, int32_t num)
+{
+	char buf[3 * sizeof(int32_t)];
+	char *pos = &buf[sizeof(buf)];
+	uint32_t mag = (num < 0) ? -(uint32_t)num : (uint32_t)num;
+
+	do {
+		*--pos = '0' + mag % 10U;
+		mag /= 10U;
+	} while (mag);
+
+	if (num < 0) {
+		*--pos = '-';
+	}
+
+	writer_put(writer, pos, &buf[sizeof(buf)] - pos);
+}
+
+static int writer_obj(struct json_writer *writer,
+		      const struct json_obj_descr *descr, size_t descr_len,
+		      const void *val);
+
+static int writer_value(struct json_writer *writer,
+			const struct json_obj_descr *descr, const void *val);
+
+static int writer_arr(struct json_writer *writer,
+		      const struct json_obj_descr *elem_descr,
+		      const void *field, const void *val)
+{
+	ptrdiff_t elem_size = get_elem_size(elem_descr);
+	/*
+	 * NOTE: Since an element descriptor's offset isn't meaningful
+	 * (array elements occur at multiple offsets in `val'), we use
+	 * its space in elem_descr to store the offset to the field
+	 * containing the number of elements.
+	 */
+	size_t n_elem = *(size_t *)((char *)val + elem_descr->offset);
+	size_t i;
+	int ret;
+
+	writer_putc(writer, '[');
+
+	for (i = 0; i < n_elem; i++) {
+		if (i > 0) {
+			writer_putc(writer, ',');
+		}
+
+		/*
+		 * Though "field" points at the next element in the
+		 * array which we need to encode, the value in
+		 * elem_descr->offset is actually the offset of the
+		 * length field in the "parent" struct containing the
+		 * array.
+		 *
+		 * To patch things up, we lie to writer_value() about
+		 * where the field is by exactly the amount it will
+		 * offset it. This is a size optimization for struct
+		 * json_obj_descr: the alternative is to keep a
+		 * separate field next to element_descr which is an
+		 * offset to the length field in the parent struct,
+		 * but that would add a size_t to every descriptor.
+		 */
+		ret = writer_value(writer, elem_descr,
+				   (char *)field - elem_descr->offset);
+		if (ret < 0) {
+			return ret;
+		}
+
+		field = (char *)field + elem_size;
+	}
+
+	writer_putc(writer, ']');
+
+	return 0;
+}
+
+static int writer_value(struct json_writer *writer,
+			const struct json_obj_descr *descr, const void *val)
+{
+	const void *ptr = (const char *)val + descr->offset;
+
+	switch (descr->type) {
+	case JSON_TOK_FALSE:
+	case JSON_TOK_TRUE:
+		if (*(const bool *)ptr) {
+			writer_put(writer, "true", 4);
+		} else {
+			writer_put(writer, "false", 5);
+		}
+		return 0;
+	case JSON_TOK_STRING:
+		writer_str(writer, *(const char **)ptr);
+		return 0;
+	case JSON_TOK_LIST_START:
+		return writer_arr(writer, descr->array.element_descr, ptr,
+				  val);
+	case JSON_TOK_OBJECT_START:
+		return writer_obj(writer, descr->object.sub_descr,
+				  descr->object.sub_descr_len, ptr);
+	case JSON_TOK_NUMBER:
+		writer_num(writer, *(const int32_t *)ptr);
+		return 0;
+	default:
+		return -EINVAL;
+	}
+}
+
+static int writer_obj(struct json_writer *writer,
+		      const struct json_obj_descr *descr, size_t descr_len,
+		      const void *val)
+{
+	size_t i;
+	int ret;
+
+	writer_putc(writer, '{');
+
+	for (i = 0; i < descr_len; i++) {
+		/* Keys come with their length, so no strlen() is needed */
+		writer_put(writer, (i > 0) ? ",\"" : "\"", (i > 0) ? 2 : 1);
+		writer_put_escaped(writer, descr[i].field_name,
+				   descr[i].field_name_len);
+		writer_put(writer, "\":", 2);
+
+		ret = writer_value(writer, &descr[i], val);
+		if (ret < 0) {
+			return ret;
+		}
 	}
 
-	memcpy(appender->buffer + appender->used, bytes, len);
-	appender->used += len;
-	appender->buffer[appender->used] = '\0';
+	writer_putc(writer, '}');
+
+	return 0;
+}
+
+static void writer_init_buf(struct json_writer *writer, char *buffer,
+			    size_t buf_size)
+{
+	*writer = (struct json_writer) {
+		.buf = buffer,
+		.size = buf_size,
+	};
+}
+
+/*
+ * Terminates the output of a contiguous buffer writer. What has been
+ * written is terminated even on error, e.g. when the buffer is too small.
+ */
+static int writer_finish_buf(struct json_writer *writer, int ret,
+			     size_t buf_size)
+{
+	if (buf_size != 0) {
+		writer->buf[writer->used] = '\0';
+	}
+
+	if (ret < 0) {
+		return ret;
+	}
+
+	if (writer->size == 0) {
+		return -ENOMEM;
+	}
 
 	return 0;
 }
 
+static void writer_init_append(struct json_writer *writer, char *stage,
+			       json_append_bytes_t append_bytes, void *data)
+{
+	*writer = (struct json_writer) {
+		.buf = stage,
+		.size = JSON_WRITER_STAGE_SIZE,
+		.append_bytes = append_bytes,
+		.data = data,
+	};
+}
+
+static int writer_finish_append(struct json_writer *writer, int ret)
+{
+	if (ret < 0) {
+		return ret;
+	}
+
+	writer_flush(writer);
+
+	return writer->err;
+}
+
+int json_obj_encode(const struct json_obj_descr *descr, size_t descr_len,
+		    const void *val, json_append_bytes_t append_bytes,
+		    void *data)
+{
+	char stage[JSON_WRITER_STAGE_SIZE];
+	struct json_writer writer;
+
+	writer_init_append(&writer, stage, append_bytes, data);
+
+	return writer_finish_append(&writer, writer_obj(&writer, descr,
+							descr_len, val));
+}
+
+int json_arr_encode(const struct json_obj_descr *descr, const void *val,
+		    json_append_bytes_t append_bytes, void *data)
+{
+	char stage[JSON_WRITER_STAGE_SIZE];
+	struct json_writer writer;
+	void *ptr = (char *)val + descr->offset;
+
+	writer_init_append(&writer, stage, append_bytes, data);
+
+	return writer_finish_append(&writer,
+				    writer_arr(&writer,
+					       descr->array.element_descr,
+					       ptr, val));
+}
+
 int json_obj_encode_buf(const struct json_obj_descr *descr, size_t descr_len,
 			const void *val, char *buffer, size_t buf_size)
 {
-	struct appender appender = { .buffer = buffer, .size = buf_size };
+	struct json_writer writer;
 
-	return json_obj_encode(descr, descr_len, val, append_bytes_to_buf,
-			       &appender);
+	writer_init_buf(&writer, buffer, buf_size);
+
+	return writer_finish_buf(&writer, writer_obj(&writer, descr,
+						     descr_len, val),
+				 buf_size);
 }
 
 int json_arr_encode_buf(const struct json_obj_descr *descr, const void *val,
 			char *buffer, size_t buf_size)
 {
-	struct appender appender = { .buffer = buffer, .size = buf_size };
+	struct json_writer writer;
+	void *ptr = (char *)val + descr->offset;
 
-	return json_arr_encode(descr, val, append_bytes_to_buf, &appender);
+	writer_init_buf(&writer, buffer, buf_size);
+
+	return writer_finish_buf(&writer,
+				 writer_arr(&writer,
+					    descr->array.element_descr,
+					    ptr, val),
+				 buf_size);
 }
 
-static int measure_bytes(const char *bytes, size_t len, void *data)
+ssize_t json_obj_encode_buf_len(const struct json_obj_descr *descr,
+				size_t descr_len, const void *val,
+				char *buffer, size_t buf_size)
 {
-	ssize_t *total = data;
+	struct json_writer writer;
+	int ret;
 
-	*total += (ssize_t)len;
+	writer_init_buf(&writer, buffer, buf_size);
 
-	ARG_UNUSED(bytes);
+	ret = writer_obj(&writer, descr, descr_len, val);
 
-	return 0;
+	/* Terminate what has been written, also if incomplete or on error */
+	if (buf_size != 0) {
+		writer.buf[writer.used] = '\0';
+	}
+
+	if (ret < 0) {
+		return ret;
+	}
+
+	return writer.total;
+}
+
+#if defined(CONFIG_NET_BUF)
+ssize_t json_obj_encode_net_buf(const struct json_obj_descr *descr,
+				size_t descr_len, const void *val,
+				struct net_buf *buf)
+{
+	struct json_writer writer;
+	int ret;
+
+	/* The tail room is used as is, no NUL character is appended */
+	writer_init_buf(&writer, net_buf_tail(buf),
+			net_buf_tailroom(buf) + 1);
+
+	ret = writer_obj(&writer, descr, descr_len, val);
+	if (ret < 0) {
+		return ret;
+	}
+
+	if (writer.size == 0) {
+		return -ENOMEM;
+	}
+
+	net_buf_add(buf, writer.used);
+
+	return writer.used;
 }
+#endif
 
 ssize_t json_calc_encoded_len(const struct json_obj_descr *descr,
 			      size_t descr_len, const void *val)
 {
-	ssize_t total = 0;
+	struct json_writer writer;
 	int ret;
 
-	ret = json_obj_encode(descr, descr_len, val, measure_bytes, &total);
+	writer_init_buf(&writer, NULL, 0);
+
+	ret = writer_obj(&writer, descr, descr_len, val);
 	if (ret < 0) {
 		return ret;
 	}
 
-	return total;
+	return writer.total;
 }
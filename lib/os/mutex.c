@@ -8,6 +8,11 @@
 #include <sys/mutex.h>
 #include <syscall_handler.h>
 #include <kernel_structs.h>
+#ifdef CONFIG_SYS_MUTEX_FAST_PATH
+#include <ksched.h>
+#include <wait_q.h>
+#include <kernel_internal.h>
+#endif
 
 static struct k_mutex *get_k_mutex(struct sys_mutex *mutex)
 {
@@ -23,13 +28,236 @@ static struct k_mutex *get_k_mutex(struct sys_mutex *mutex)
 
 static bool check_sys_mutex_addr(struct sys_mutex *addr)
 {
-	/* sys_mutex memory is never touched, just used to lookup the
-	 * underlying k_mutex, but we don't want threads using mutexes
-	 * that are outside their memory domain
+	/* Without the fast path sys_mutex memory is never touched, just
+	 * used to lookup the underlying k_mutex, but we don't want threads
+	 * using mutexes that are outside their memory domain
 	 */
 	return Z_SYSCALL_MEMORY_WRITE(addr, sizeof(struct sys_mutex));
 }
 
+#ifdef CONFIG_SYS_MUTEX_FAST_PATH
+/*
+ * With the fast path, the owner of a sys_mutex is the thread ID stored in
+ * its val, and the k_mutex backing it is not used as a mutex. Its wait
+ * queue holds the threads waiting for the sys_mutex, and its owner and
+ * owner_orig_prio fields track the owner priority raised by them.
+ *
+ * A waiter sets SYS_MUTEX_CONTENDED before pending, so the owner has to
+ * come here to unlock the mutex. This hands it over to the first waiter
+ * by storing its ID in val directly. All updates of val made here are
+ * serialized by the lock below; the unlocked fast path only ever moves
+ * val between 0 and the ID of the calling thread, without the flag.
+ */
+static struct k_spinlock lock;
+
+static int32_t new_prio_for_inheritance(int32_t target, int32_t limit)
+{
+	int new_prio = z_is_prio_higher(target, limit) ? target : limit;
+
+	return z_get_new_prio_with_ceiling(new_prio);
+}
+
+/*
+ * The caller does not need permission on the owner: as with k_mutex,
+ * waiting for a mutex raises the priority of its owner, whichever thread
+ * it is, and at most to the priority of the waiter.
+ */
+static bool owner_is_valid(struct k_thread *owner)
+{
+	struct z_object *obj = z_object_find(owner);
+
+	return obj != NULL && obj->type == K_OBJ_THREAD &&
+	       (obj->flags & K_OBJ_FLAG_INITIALIZED) != 0U;
+}
+
+static struct k_thread *owner_get(uintptr_t val)
+{
+	struct k_thread *owner = (struct k_thread *)(val & ~SYS_MUTEX_CONTENDED);
+
+	/* val lives in user memory and can hold any value: make sure it
+	 * names a live thread before changing its priority.
+	 */
+	return owner_is_valid(owner) ? owner : NULL;
+}
+
+static bool owner_prio_restore(struct k_mutex *kernel_mutex)
+{
+	struct k_thread *owner = kernel_mutex->owner;
+	struct k_thread *waiter = z_waitq_head(&kernel_mutex->wait_q);
+	int new_prio = kernel_mutex->owner_orig_prio;
+
+	if (owner == NULL) {
+		return false;
+	}
+
+	/* The owner may have exited since its priority was raised */
+	if (!owner_is_valid(owner)) {
+		kernel_mutex->owner = NULL;
+		return false;
+	}
+
+	if (waiter != NULL) {
+		new_prio = new_prio_for_inheritance(waiter->base.prio,
+						    new_prio);
+	} else {
+		kernel_mutex->owner = NULL;
+	}
+
+	return z_set_prio(owner, new_prio);
+}
+
+static int fast_mutex_lock(struct sys_mutex *mutex,
+			   struct k_mutex *kernel_mutex, k_timeout_t timeout)
+{
+	uintptr_t self = (uintptr_t)_current;
+	struct k_thread *owner;
+	k_spinlock_key_t key;
+	uintptr_t val;
+	int ret;
+
+	key = k_spin_lock(&lock);
+
+	for (;;) {
+		val = (uintptr_t)atomic_ptr_get(&mutex->val);
+
+		if (val == 0U) {
+			if (atomic_ptr_cas(&mutex->val, NULL, (void *)self)) {
+				k_spin_unlock(&lock, key);
+				return 0;
+			}
+
+			continue;
+		}
+
+		if ((val & ~SYS_MUTEX_CONTENDED) == self ||
+		    K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			/* Recursive locking is handled by sys_mutex_lock() */
+			k_spin_unlock(&lock, key);
+			return -EBUSY;
+		}
+
+		/* The owner may unlock in user mode until the flag is set */
+		if ((val & SYS_MUTEX_CONTENDED) != 0U ||
+		    atomic_ptr_cas(&mutex->val, (void *)val,
+				   (void *)(val | SYS_MUTEX_CONTENDED))) {
+			break;
+		}
+	}
+
+	owner = owner_get(val);
+	if (owner != NULL) {
+		int new_prio;
+
+		if (kernel_mutex->owner != owner) {
+			kernel_mutex->owner = owner;
+			kernel_mutex->owner_orig_prio = owner->base.prio;
+		}
+
+		new_prio = new_prio_for_inheritance(_current->base.prio,
+						    owner->base.prio);
+		if (z_is_prio_higher(new_prio, owner->base.prio)) {
+			(void)z_set_prio(owner, new_prio);
+		}
+	}
+
+	ret = z_pend_curr(&lock, key, &kernel_mutex->wait_q, timeout);
+	if (ret == 0) {
+		/* The mutex was handed over by sys_mutex_unlock() */
+		return 0;
+	}
+
+	key = k_spin_lock(&lock);
+
+	if (z_waitq_head(&kernel_mutex->wait_q) == NULL) {
+		/* Nobody else is waiting, let the owner unlock in user mode */
+		val = (uintptr_t)atomic_ptr_get(&mutex->val);
+		if ((val & SYS_MUTEX_CONTENDED) != 0U) {
+			atomic_ptr_set(&mutex->val,
+				       (void *)(val & ~SYS_MUTEX_CONTENDED));
+		}
+	}
+
+	if (owner_prio_restore(kernel_mutex)) {
+		z_reschedule(&lock, key);
+	} else {
+		k_spin_unlock(&lock, key);
+	}
+
+	return -EAGAIN;
+}
+
+static int fast_mutex_unlock(struct sys_mutex *mutex,
+			     struct k_mutex *kernel_mutex)
+{
+	uintptr_t self = (uintptr_t)_current;
+	struct k_thread *new_owner;
+	k_spinlock_key_t key;
+	uintptr_t val;
+
+	key = k_spin_lock(&lock);
+
+	val = (uintptr_t)atomic_ptr_get(&mutex->val);
+	if ((val & ~SYS_MUTEX_CONTENDED) != self) {
+		k_spin_unlock(&lock, key);
+		return (val == 0U) ? -EINVAL : -EPERM;
+	}
+
+	if (kernel_mutex->owner == _current) {
+		(void)z_set_prio(_current, kernel_mutex->owner_orig_prio);
+		kernel_mutex->owner = NULL;
+	}
+
+	new_owner = z_unpend_first_thread(&kernel_mutex->wait_q);
+	if (new_owner == NULL) {
+		atomic_ptr_set(&mutex->val, NULL);
+		z_reschedule(&lock, key);
+		return 0;
+	}
+
+	val = (uintptr_t)new_owner;
+	if (z_waitq_head(&kernel_mutex->wait_q) != NULL) {
+		/* The wait queue is priority ordered, so the new owner
+		 * already has the highest priority of the remaining
+		 * waiters: no need to adjust it.
+		 */
+		kernel_mutex->owner = new_owner;
+		kernel_mutex->owner_orig_prio = new_owner->base.prio;
+		val |= SYS_MUTEX_CONTENDED;
+	}
+
+	atomic_ptr_set(&mutex->val, (void *)val);
+	arch_thread_return_value_set(new_owner, 0);
+	z_ready_thread(new_owner);
+	z_reschedule(&lock, key);
+
+	return 0;
+}
+
+static void owner_abort_cb(struct z_object *ko, void *thread)
+{
+	struct k_mutex *kernel_mutex;
+
+	if (ko->type != K_OBJ_SYS_MUTEX) {
+		return;
+	}
+
+	kernel_mutex = ko->data.mutex;
+	if (kernel_mutex->owner == thread) {
+		kernel_mutex->owner = NULL;
+	}
+}
+
+void z_sys_mutex_thread_abort(struct k_thread *thread)
+{
+	/* Called with sched_spinlock held, which is taken with the lock
+	 * above held: don't take it here. A waiter that found the thread
+	 * still valid before it got aborted can only store it after this,
+	 * and then finds it invalid in owner_prio_restore().
+	 */
+	z_object_wordlist_foreach(owner_abort_cb, thread);
+}
+#endif /* CONFIG_SYS_MUTEX_FAST_PATH */
+
 int z_impl_z_sys_mutex_kernel_lock(struct sys_mutex *mutex, k_timeout_t timeout)
 {
 	struct k_mutex *kernel_mutex = get_k_mutex(mutex);
@@ -38,7 +266,11 @@ int z_impl_z_sys_mutex_kernel_lock(struct sys_mutex *mutex, k_timeout_t timeout)
 		return -EINVAL;
 	}
 
+#ifdef CONFIG_SYS_MUTEX_FAST_PATH
+	return fast_mutex_lock(mutex, kernel_mutex, timeout);
+#else
 	return k_mutex_lock(kernel_mutex, timeout);
+#endif
 }
 
 static inline int z_vrfy_z_sys_mutex_kernel_lock(struct sys_mutex *mutex,
@@ -56,11 +288,19 @@ int z_impl_z_sys_mutex_kernel_unlock(struct sys_mutex *mutex)
 {
 	struct k_mutex *kernel_mutex = get_k_mutex(mutex);
 
+#ifdef CONFIG_SYS_MUTEX_FAST_PATH
+	if (kernel_mutex == NULL) {
+		return -EINVAL;
+	}
+
+	return fast_mutex_unlock(mutex, kernel_mutex);
+#else
 	if (kernel_mutex == NULL || kernel_mutex->lock_count == 0) {
 		return -EINVAL;
 	}
 
 	return k_mutex_unlock(kernel_mutex);
+#endif
 }
 
 static inline int z_vrfy_z_sys_mutex_kernel_unlock(struct sys_mutex *mutex)
@@ -37,6 +37,8 @@ static const pthread_attr_t init_pthread_attrs = {
 static struct posix_thread posix_thread_pool[CONFIG_MAX_PTHREAD_COUNT];
 PTHREAD_MUTEX_DEFINE(pthread_pool_lock);
 
+void z_pthread_key_values_release(struct posix_thread *thread);
+
 static bool is_posix_prio_valid(uint32_t priority, int policy)
 {
 	if (priority >= sched_get_priority_min(policy) &&
@@ -181,7 +183,7 @@ int pthread_create(pthread_t *newthread, const pthread_attr_t *attr,
 	pthread_mutex_unlock(&thread->state_lock);
 
 	pthread_cond_init(&thread->state_cond, &cond_attr);
-	sys_slist_init(&thread->key_list);
+	(void)memset(thread->key_values, 0, sizeof(thread->key_values));
 
 	*newthread = (pthread_t) k_thread_create(&thread->thread, attr->stack,
 						 attr->stacksize,
@@ -355,9 +357,6 @@ int pthread_once(pthread_once_t *once, void (*init_func)(void))
 void pthread_exit(void *retval)
 {
 	struct posix_thread *self = (struct posix_thread *)pthread_self();
-	pthread_key_obj *key_obj;
-	pthread_thread_data *thread_spec_data;
-	sys_snode_t *node_l;
 
 	/* Make a thread as cancelable before exiting */
 	pthread_mutex_lock(&self->cancel_lock);
@@ -377,20 +376,20 @@ void pthread_exit(void *retval)
 		self->state = PTHREAD_TERMINATED;
 	}
 
-	SYS_SLIST_FOR_EACH_NODE(&self->key_list, node_l) {
-		thread_spec_data = (pthread_thread_data *)node_l;
-		if (thread_spec_data != NULL) {
-			key_obj = thread_spec_data->key;
-			if (key_obj->destructor != NULL) {
-				(key_obj->destructor)(thread_spec_data->spec_data);
-			}
-		}
-	}
+	z_pthread_key_values_release(self);
 
 	pthread_mutex_unlock(&self->state_lock);
 	k_thread_abort((k_tid_t)self);
 }
 
+/* Clear the value of a deleted key in all the threads */
+void z_pthread_key_values_clear(uint32_t index)
+{
+	for (int i = 0; i < CONFIG_MAX_PTHREAD_COUNT; i++) {
+		posix_thread_pool[i].key_values[index] = NULL;
+	}
+}
+
 /**
  * @brief Wait for a thread termination.
  *
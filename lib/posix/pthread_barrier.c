@@ -9,11 +9,9 @@
 #include <ksched.h>
 #include <wait_q.h>
 
-extern struct k_spinlock z_pthread_spinlock;
-
 int pthread_barrier_wait(pthread_barrier_t *b)
 {
-	k_spinlock_key_t key = k_spin_lock(&z_pthread_spinlock);
+	k_spinlock_key_t key = k_spin_lock(&b->lock);
 	int ret = 0;
 
 	b->count++;
@@ -24,10 +22,10 @@ int pthread_barrier_wait(pthread_barrier_t *b)
 		while (z_waitq_head(&b->wait_q)) {
 			_ready_one_thread(&b->wait_q);
 		}
-		z_reschedule(&z_pthread_spinlock, key);
+		z_reschedule(&b->lock, key);
 		ret = PTHREAD_BARRIER_SERIAL_THREAD;
 	} else {
-		(void) z_pend_curr(&z_pthread_spinlock, key, &b->wait_q, K_FOREVER);
+		(void) z_pend_curr(&b->lock, key, &b->wait_q, K_FOREVER);
 	}
 
 	return ret;
@@ -9,9 +9,8 @@
 #include <wait_q.h>
 #include <posix/pthread.h>
 
-extern struct k_spinlock z_pthread_spinlock;
-
 int64_t timespec_to_timeoutms(const struct timespec *abstime);
+int z_pthread_mutex_release(pthread_mutex_t *m);
 
 static int cond_wait(pthread_cond_t *cv, pthread_mutex_t *mut,
 		     k_timeout_t timeout)
@@ -19,12 +18,15 @@ static int cond_wait(pthread_cond_t *cv, pthread_mutex_t *mut,
 	__ASSERT(mut->lock_count == 1U, "");
 
 	int ret;
-	k_spinlock_key_t key = k_spin_lock(&z_pthread_spinlock);
+	k_spinlock_key_t key = k_spin_lock(&cv->lock);
 
-	mut->lock_count = 0U;
-	mut->owner = NULL;
-	_ready_one_thread(&mut->wait_q);
-	ret = z_pend_curr(&z_pthread_spinlock, key, &cv->wait_q, timeout);
+	/* The mutex is released with the condition variable locked, so that
+	 * a signal sent once the mutex is released can't be missed. The
+	 * release doesn't reschedule: a mutex waiter it readies gets to run
+	 * once z_pend_curr() has made this thread pending.
+	 */
+	(void)z_pthread_mutex_release(mut);
+	ret = z_pend_curr(&cv->lock, key, &cv->wait_q, timeout);
 
 	/* FIXME: this extra lock (and the potential context switch it
 	 * can cause) could be optimized out.  At the point of the
@@ -52,23 +54,23 @@ static int cond_wait(pthread_cond_t *cv, pthread_mutex_t *mut,
 
 int pthread_cond_signal(pthread_cond_t *cv)
 {
-	k_spinlock_key_t key = k_spin_lock(&z_pthread_spinlock);
+	k_spinlock_key_t key = k_spin_lock(&cv->lock);
 
 	_ready_one_thread(&cv->wait_q);
-	z_reschedule(&z_pthread_spinlock, key);
+	z_reschedule(&cv->lock, key);
 
 	return 0;
 }
 
 int pthread_cond_broadcast(pthread_cond_t *cv)
 {
-	k_spinlock_key_t key = k_spin_lock(&z_pthread_spinlock);
+	k_spinlock_key_t key = k_spin_lock(&cv->lock);
 
 	while (z_waitq_head(&cv->wait_q)) {
 		_ready_one_thread(&cv->wait_q);
 	}
 
-	z_reschedule(&z_pthread_spinlock, key);
+	z_reschedule(&cv->lock, key);
 
 	return 0;
 }
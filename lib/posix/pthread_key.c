@@ -4,12 +4,31 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 #include <kernel.h>
+#include <sys/atomic.h>
 #include <posix/pthread.h>
 #include <posix/pthread_key.h>
 
-struct k_sem pthread_key_sem;
+/*
+ * A key holds the index of its value in the key values array of every
+ * pthread, plus one so that a NULL key is never valid. Keys are allocated
+ * from a bitmap with atomic operations, so that neither key management
+ * nor accessing thread-specific data needs a lock.
+ */
+static ATOMIC_DEFINE(keys_in_use, CONFIG_MAX_PTHREAD_KEY_COUNT);
+static void (*key_destructors[CONFIG_MAX_PTHREAD_KEY_COUNT])(void *);
+
+void z_pthread_key_values_clear(uint32_t index);
 
-K_SEM_DEFINE(pthread_key_sem, 1, 1);
+static inline uint32_t key_index(pthread_key_t key)
+{
+	return POINTER_TO_UINT(key) - 1U;
+}
+
+static inline bool index_is_valid(uint32_t index)
+{
+	return index < CONFIG_MAX_PTHREAD_KEY_COUNT &&
+	       atomic_test_bit(keys_in_use, index);
+}
 
 /**
  * @brief Create a key for thread-specific data
@@ -19,22 +38,17 @@ K_SEM_DEFINE(pthread_key_sem, 1, 1);
 int pthread_key_create(pthread_key_t *key,
 		void (*destructor)(void *))
 {
-	pthread_key_obj *new_key;
-
-	*key = NULL;
+	uint32_t index;
 
-	new_key = k_malloc(sizeof(pthread_key_obj));
-
-	if (new_key == NULL) {
-		return ENOMEM;
+	for (index = 0; index < CONFIG_MAX_PTHREAD_KEY_COUNT; index++) {
+		if (!atomic_test_and_set_bit(keys_in_use, index)) {
+			key_destructors[index] = destructor;
+			*key = UINT_TO_POINTER(index + 1U);
+			return 0;
+		}
 	}
 
-	sys_slist_init(&(new_key->key_data_l));
-
-	new_key->destructor = destructor;
-	*key = (void *)new_key;
-
-	return 0;
+	return EAGAIN;
 }
 
 /**
@@ -44,27 +58,17 @@ int pthread_key_create(pthread_key_t *key,
  */
 int pthread_key_delete(pthread_key_t key)
 {
-	pthread_key_obj *key_obj = (pthread_key_obj *)key;
-	pthread_key_data *key_data;
-	sys_snode_t *node_l, *next_node_l;
+	uint32_t index = key_index(key);
 
-	k_sem_take(&pthread_key_sem, K_FOREVER);
-
-	/* Delete thread-specific elements associated with the key */
-	SYS_SLIST_FOR_EACH_NODE_SAFE(&(key_obj->key_data_l),
-			node_l, next_node_l) {
-
-		/* Remove the object from the list key_data_l */
-		key_data = (pthread_key_data *)
-			sys_slist_get(&(key_obj->key_data_l));
-
-		/* Deallocate the object's memory */
-		k_free((void *)key_data);
+	if (!index_is_valid(index)) {
+		return EINVAL;
 	}
 
-	k_free((void *)key_obj);
+	/* Drop the values of all threads before the key can be reused */
+	z_pthread_key_values_clear(index);
+	key_destructors[index] = NULL;
 
-	k_sem_give(&pthread_key_sem);
+	atomic_clear_bit(keys_in_use, index);
 
 	return 0;
 }
@@ -76,59 +80,16 @@ int pthread_key_delete(pthread_key_t key)
  */
 int pthread_setspecific(pthread_key_t key, const void *value)
 {
-	pthread_key_obj *key_obj = (pthread_key_obj *)key;
 	struct posix_thread *thread = (struct posix_thread *)pthread_self();
-	pthread_key_data *key_data;
-	pthread_thread_data *thread_spec_data;
-	sys_snode_t *node_l;
-	int retval = 0;
-
-	/* Traverse the list of keys set by the thread, looking for key.
-	 * If the key is already in the list, re-assign its value.
-	 * Else add the key to the thread's list.
-	 */
-	k_sem_take(&pthread_key_sem, K_FOREVER);
+	uint32_t index = key_index(key);
 
-	SYS_SLIST_FOR_EACH_NODE(&(thread->key_list), node_l) {
-
-			thread_spec_data = (pthread_thread_data *)node_l;
-
-			if (thread_spec_data->key == key_obj) {
-
-				/* Key is already present so
-				 * associate thread specific data
-				 */
-				thread_spec_data->spec_data = (void *)value;
-				goto out;
-			}
+	if (!index_is_valid(index)) {
+		return EINVAL;
 	}
 
-	if (node_l == NULL) {
-		key_data = k_malloc(sizeof(pthread_key_data));
-
-		if (key_data == NULL) {
-			retval = ENOMEM;
-			goto out;
-
-		} else {
-			/* Associate thread specific data, initialize new key */
-			key_data->thread_data.key = key;
-			key_data->thread_data.spec_data = (void *)value;
-
-			/* Append new thread key data to thread's key list */
-			sys_slist_append((&thread->key_list),
-				(sys_snode_t *)(&key_data->thread_data));
-
-			/* Append new key data to the key object's list */
-			sys_slist_append(&(key_obj->key_data_l),
-					(sys_snode_t *)key_data);
-		}
-	}
+	thread->key_values[index] = (void *)value;
 
-out:
-	k_sem_give(&pthread_key_sem);
-
-	return retval;
+	return 0;
 }
 
 /**
@@ -138,28 +99,33 @@ out:
  */
 void *pthread_getspecific(pthread_key_t key)
 {
-	pthread_key_obj *key_obj = (pthread_key_obj *)key;
 	struct posix_thread *thread = (struct posix_thread *)pthread_self();
-	pthread_thread_data *thread_spec_data;
-	void *value = NULL;
-	sys_snode_t *node_l;
+	uint32_t index = key_index(key);
 
-	k_sem_take(&pthread_key_sem, K_FOREVER);
+	if (!index_is_valid(index)) {
+		return NULL;
+	}
 
-	node_l = sys_slist_peek_head(&(thread->key_list));
+	return thread->key_values[index];
+}
 
-	/* Traverse the list of keys set by the thread, looking for key */
+/* Call the key destructors on the values of an exiting thread */
+void z_pthread_key_values_release(struct posix_thread *thread)
+{
+	void (*destructor)(void *);
+	void *value;
+
+	for (uint32_t index = 0; index < CONFIG_MAX_PTHREAD_KEY_COUNT;
+	     index++) {
+		value = thread->key_values[index];
+		if (value == NULL || !index_is_valid(index)) {
+			continue;
+		}
 
-	SYS_SLIST_FOR_EACH_NODE(&(thread->key_list), node_l) {
-		thread_spec_data = (pthread_thread_data *)node_l;
-		if (thread_spec_data->key == key_obj) {
-			/* Key is present, so get the set thread data */
-			value = thread_spec_data->spec_data;
-			break;
+		thread->key_values[index] = NULL;
+		destructor = key_destructors[index];
+		if (destructor != NULL) {
+			destructor(value);
 		}
 	}
-
-	k_sem_give(&pthread_key_sem);
-
-	return value;
 }
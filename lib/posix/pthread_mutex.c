@@ -9,8 +9,6 @@
 #include <wait_q.h>
 #include <posix/pthread.h>
 
-struct k_spinlock z_pthread_spinlock;
-
 int64_t timespec_to_timeoutms(const struct timespec *abstime);
 
 #define MUTEX_MAX_REC_LOCK 32767
@@ -22,16 +20,20 @@ static const pthread_mutexattr_t def_attr = {
 	.type = PTHREAD_MUTEX_DEFAULT,
 };
 
+/*
+ * Each mutex is protected by its own spinlock, so that threads using
+ * unrelated mutexes never contend with each other on SMP.
+ */
 static int acquire_mutex(pthread_mutex_t *m, k_timeout_t timeout)
 {
 	int rc = 0;
-	k_spinlock_key_t key = k_spin_lock(&z_pthread_spinlock);
+	k_spinlock_key_t key = k_spin_lock(&m->lock);
 
 	if (m->lock_count == 0U && m->owner == NULL) {
 		m->lock_count++;
 		m->owner = pthread_self();
 
-		k_spin_unlock(&z_pthread_spinlock, key);
+		k_spin_unlock(&m->lock, key);
 		return 0;
 	} else if (m->owner == pthread_self()) {
 		if (m->type == PTHREAD_MUTEX_RECURSIVE &&
@@ -44,16 +46,16 @@ static int acquire_mutex(pthread_mutex_t *m, k_timeout_t timeout)
 			rc = EINVAL;
 		}
 
-		k_spin_unlock(&z_pthread_spinlock, key);
+		k_spin_unlock(&m->lock, key);
 		return rc;
 	}
 
 	if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
-		k_spin_unlock(&z_pthread_spinlock, key);
+		k_spin_unlock(&m->lock, key);
 		return EINVAL;
 	}
 
-	rc = z_pend_curr(&z_pthread_spinlock, key, &m->wait_q, timeout);
+	rc = z_pend_curr(&m->lock, key, &m->wait_q, timeout);
 	if (rc != 0) {
 		rc = ETIMEDOUT;
 	}
@@ -96,6 +98,7 @@ int pthread_mutex_init(pthread_mutex_t *m,
 
 	m->owner = NULL;
 	m->lock_count = 0U;
+	m->lock = (struct k_spinlock) {};
 
 	mattr = (attr == NULL) ? &def_attr : attr;
 
@@ -117,24 +120,22 @@ int pthread_mutex_lock(pthread_mutex_t *m)
 	return acquire_mutex(m, K_FOREVER);
 }
 
-/**
- * @brief Unlock POSIX mutex.
- *
- * See IEEE 1003.1
+/*
+ * Release a mutex held by the current thread, handing it over to its first
+ * waiter if there is one. Sets woken if a waiter was made ready, in which
+ * case the caller is responsible for rescheduling.
  */
-int pthread_mutex_unlock(pthread_mutex_t *m)
+static int mutex_release_locked(pthread_mutex_t *m, bool *woken)
 {
-	k_spinlock_key_t key = k_spin_lock(&z_pthread_spinlock);
-
 	k_tid_t thread;
 
+	*woken = false;
+
 	if (m->owner != pthread_self()) {
-		k_spin_unlock(&z_pthread_spinlock, key);
 		return EPERM;
 	}
 
 	if (m->lock_count == 0U) {
-		k_spin_unlock(&z_pthread_spinlock, key);
 		return EINVAL;
 	}
 
@@ -147,16 +148,49 @@ int pthread_mutex_unlock(pthread_mutex_t *m)
 			m->lock_count++;
 			arch_thread_return_value_set(thread, 0);
 			z_ready_thread(thread);
-			z_reschedule(&z_pthread_spinlock, key);
+			*woken = true;
 			return 0;
 		}
 		m->owner = NULL;
-
 	}
-	k_spin_unlock(&z_pthread_spinlock, key);
+
 	return 0;
 }
 
+/*
+ * Unlock a mutex without rescheduling, for callers that are about to pend
+ * and so reschedule anyway.
+ */
+int z_pthread_mutex_release(pthread_mutex_t *m)
+{
+	k_spinlock_key_t key = k_spin_lock(&m->lock);
+	bool woken;
+	int rc = mutex_release_locked(m, &woken);
+
+	k_spin_unlock(&m->lock, key);
+	return rc;
+}
+
+/**
+ * @brief Unlock POSIX mutex.
+ *
+ * See IEEE 1003.1
+ */
+int pthread_mutex_unlock(pthread_mutex_t *m)
+{
+	k_spinlock_key_t key = k_spin_lock(&m->lock);
+	bool woken;
+	int rc = mutex_release_locked(m, &woken);
+
+	if (woken) {
+		z_reschedule(&m->lock, key);
+	} else {
+		k_spin_unlock(&m->lock, key);
+	}
+
+	return rc;
+}
+
 /**
  * @brief Destroy POSIX mutex.
  *
@@ -4,6 +4,8 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 #include <kernel.h>
+#include <ksched.h>
+#include <wait_q.h>
 #include <errno.h>
 #include <posix/time.h>
 #include <posix/posix_types.h>
@@ -11,12 +13,30 @@
 #define INITIALIZED 1
 #define NOT_INITIALIZED 0
 
-#define CONCURRENT_READER_LIMIT  (CONFIG_MAX_PTHREAD_COUNT + 1)
+/*
+ * The lock is held for reading by any number of readers, or for writing by
+ * a single writer. Writers are preferred: once a writer waits, new readers
+ * block until it got and released the lock, so that a stream of readers
+ * can't starve writers. Unlocking hands the lock over to the threads it
+ * wakes up, which don't have to compete for it again.
+ */
 
 int64_t timespec_to_timeoutms(const struct timespec *abstime);
 static uint32_t read_lock_acquire(pthread_rwlock_t *rwlock, int32_t timeout);
 static uint32_t write_lock_acquire(pthread_rwlock_t *rwlock, int32_t timeout);
 
+/* Hand the lock over to all the blocked readers */
+static void wake_readers_locked(pthread_rwlock_t *rwlock)
+{
+	struct k_thread *thread;
+
+	while ((thread = z_unpend_first_thread(&rwlock->rd_wait_q)) != NULL) {
+		rwlock->readers++;
+		arch_thread_return_value_set(thread, 0);
+		z_ready_thread(thread);
+	}
+}
+
 /**
  * @brief Initialize read-write lock object.
  *
@@ -25,10 +45,10 @@ static uint32_t write_lock_acquire(pthread_rwlock_t *rwlock, int32_t timeout);
 int pthread_rwlock_init(pthread_rwlock_t *rwlock,
 			const pthread_rwlockattr_t *attr)
 {
-	k_sem_init(&rwlock->rd_sem, CONCURRENT_READER_LIMIT,
-		   CONCURRENT_READER_LIMIT);
-	k_sem_init(&rwlock->wr_sem, 1, 1);
-	k_sem_init(&rwlock->reader_active, 1, 1);
+	z_waitq_init(&rwlock->rd_wait_q);
+	z_waitq_init(&rwlock->wr_wait_q);
+	rwlock->lock = (struct k_spinlock) {};
+	rwlock->readers = 0U;
 	rwlock->wr_owner = NULL;
 	rwlock->status = INITIALIZED;
 	return 0;
@@ -45,7 +65,7 @@ int pthread_rwlock_destroy(pthread_rwlock_t *rwlock)
 		return EINVAL;
 	}
 
-	if (rwlock->wr_owner != NULL) {
+	if (rwlock->wr_owner != NULL || rwlock->readers != 0U) {
 		return EBUSY;
 	}
 
@@ -60,8 +80,8 @@ int pthread_rwlock_destroy(pthread_rwlock_t *rwlock)
 /**
  * @brief Lock a read-write lock object for reading.
  *
- * API behaviour is unpredictable if number of concurrent reader
- * lock held is greater than CONCURRENT_READER_LIMIT.
+ * A thread holding a read lock must not take it again for reading while
+ * a writer waits for it, as it would deadlock.
  *
  * See IEEE 1003.1
  */
@@ -77,9 +97,6 @@ int pthread_rwlock_rdlock(pthread_rwlock_t *rwlock)
 /**
  * @brief Lock a read-write lock object for reading within specific time.
  *
- * API behaviour is unpredictable if number of concurrent reader
- * lock held is greater than CONCURRENT_READER_LIMIT.
- *
  * See IEEE 1003.1
  */
 int pthread_rwlock_timedrdlock(pthread_rwlock_t *rwlock,
@@ -105,9 +122,6 @@ int pthread_rwlock_timedrdlock(pthread_rwlock_t *rwlock,
 /**
  * @brief Lock a read-write lock object for reading immedately.
  *
- * API behaviour is unpredictable if number of concurrent reader
- * lock held is greater than CONCURRENT_READER_LIMIT.
- *
  * See IEEE 1003.1
  */
 int pthread_rwlock_tryrdlock(pthread_rwlock_t *rwlock)
@@ -122,8 +136,8 @@ int pthread_rwlock_tryrdlock(pthread_rwlock_t *rwlock)
 /**
  * @brief Lock a read-write lock object for writing.
  *
- * Write lock does not have priority over reader lock,
- * threads get lock based on priority.
+ * Write lock has priority over reader lock, a waiting writer
+ * gets the lock before readers that come after it.
  *
  * See IEEE 1003.1
  */
@@ -139,8 +153,8 @@ int pthread_rwlock_wrlock(pthread_rwlock_t *rwlock)
 /**
  * @brief Lock a read-write lock object for writing within specific time.
  *
- * Write lock does not have priority over reader lock,
- * threads get lock based on priority.
+ * Write lock has priority over reader lock, a waiting writer
+ * gets the lock before readers that come after it.
  *
  * See IEEE 1003.1
  */
@@ -167,8 +181,8 @@ int pthread_rwlock_timedwrlock(pthread_rwlock_t *rwlock,
 /**
  * @brief Lock a read-write lock object for writing immedately.
  *
- * Write lock does not have priority over reader lock,
- * threads get lock based on priority.
+ * Write lock has priority over reader lock, a waiting writer
+ * gets the lock before readers that come after it.
  *
  * See IEEE 1003.1
  */
@@ -189,73 +203,95 @@ int pthread_rwlock_trywrlock(pthread_rwlock_t *rwlock)
  */
 int pthread_rwlock_unlock(pthread_rwlock_t *rwlock)
 {
+	k_spinlock_key_t key;
+	struct k_thread *thread;
+
 	if (rwlock->status == NOT_INITIALIZED) {
 		return EINVAL;
 	}
 
+	key = k_spin_lock(&rwlock->lock);
+
 	if (k_current_get() == rwlock->wr_owner) {
 		/* Write unlock */
 		rwlock->wr_owner = NULL;
-		k_sem_give(&rwlock->reader_active);
-		k_sem_give(&rwlock->wr_sem);
-	} else {
+	} else if (rwlock->readers != 0U) {
 		/* Read unlock */
-		if (k_sem_count_get(&rwlock->rd_sem) ==
-				    (CONCURRENT_READER_LIMIT - 1)) {
-			/* Last read lock, unlock writer */
-			k_sem_give(&rwlock->reader_active);
-		}
+		rwlock->readers--;
+	} else {
+		k_spin_unlock(&rwlock->lock, key);
+		return EPERM;
+	}
 
-		k_sem_give(&rwlock->rd_sem);
+	if (rwlock->readers == 0U) {
+		thread = z_unpend_first_thread(&rwlock->wr_wait_q);
+		if (thread != NULL) {
+			rwlock->wr_owner = thread;
+			arch_thread_return_value_set(thread, 0);
+			z_ready_thread(thread);
+		} else {
+			wake_readers_locked(rwlock);
+		}
 	}
+
+	z_reschedule(&rwlock->lock, key);
+
 	return 0;
 }
 
-
 static uint32_t read_lock_acquire(pthread_rwlock_t *rwlock, int32_t timeout)
 {
-	uint32_t ret = 0U;
+	k_spinlock_key_t key = k_spin_lock(&rwlock->lock);
 
-	if (k_sem_take(&rwlock->wr_sem, SYS_TIMEOUT_MS(timeout)) == 0) {
-		k_sem_take(&rwlock->reader_active, K_NO_WAIT);
-		k_sem_take(&rwlock->rd_sem, K_NO_WAIT);
-		k_sem_give(&rwlock->wr_sem);
-	} else {
-		ret = EBUSY;
+	if (rwlock->wr_owner == NULL &&
+	    z_waitq_head(&rwlock->wr_wait_q) == NULL) {
+		rwlock->readers++;
+		k_spin_unlock(&rwlock->lock, key);
+		return 0U;
 	}
 
-	return ret;
+	if (timeout == 0) {
+		k_spin_unlock(&rwlock->lock, key);
+		return EBUSY;
+	}
+
+	/* The unlocking thread counts the reader it wakes up */
+	if (z_pend_curr(&rwlock->lock, key, &rwlock->rd_wait_q,
+			SYS_TIMEOUT_MS(timeout)) != 0) {
+		return EBUSY;
+	}
+
+	return 0U;
 }
 
 static uint32_t write_lock_acquire(pthread_rwlock_t *rwlock, int32_t timeout)
 {
-	uint32_t ret = 0U;
-	int64_t elapsed_time, st_time = k_uptime_get();
-	k_timeout_t k_timeout;
-
-	k_timeout = SYS_TIMEOUT_MS(timeout);
-
-	/* waiting for release of write lock */
-	if (k_sem_take(&rwlock->wr_sem, k_timeout) == 0) {
-		/* update remaining timeout time for 2nd sem */
-		if (timeout != SYS_FOREVER_MS) {
-			elapsed_time = k_uptime_get() - st_time;
-			timeout = timeout <= elapsed_time ? 0 :
-				  timeout - elapsed_time;
-		}
+	k_spinlock_key_t key = k_spin_lock(&rwlock->lock);
 
-		k_timeout = SYS_TIMEOUT_MS(timeout);
+	if (rwlock->wr_owner == NULL && rwlock->readers == 0U) {
+		rwlock->wr_owner = k_current_get();
+		k_spin_unlock(&rwlock->lock, key);
+		return 0U;
+	}
 
-		/* waiting for reader to complete operation */
-		if (k_sem_take(&rwlock->reader_active, k_timeout) == 0) {
-			rwlock->wr_owner = k_current_get();
-		} else {
-			k_sem_give(&rwlock->wr_sem);
-			ret = EBUSY;
+	if (timeout == 0) {
+		k_spin_unlock(&rwlock->lock, key);
+		return EBUSY;
+	}
+
+	/* The unlocking thread makes this thread the owner when waking it */
+	if (z_pend_curr(&rwlock->lock, key, &rwlock->wr_wait_q,
+			SYS_TIMEOUT_MS(timeout)) != 0) {
+		/* Readers blocked only by this writer can go now */
+		key = k_spin_lock(&rwlock->lock);
+		if (rwlock->wr_owner == NULL &&
+		    z_waitq_head(&rwlock->wr_wait_q) == NULL) {
+			wake_readers_locked(rwlock);
 		}
+		z_reschedule(&rwlock->lock, key);
 
-	} else {
-		ret = EBUSY;
+		return EBUSY;
 	}
-	return ret;
+
+	return 0U;
 }
@@ -88,6 +88,16 @@ struct ticker_node {
 #endif /* !CONFIG_BT_TICKER_LOW_LAT &&
 	* !CONFIG_BT_TICKER_SLOT_AGNOSTIC
 	*/
+
+#if defined(CONFIG_BT_TICKER_INDEX)
+	uint32_t ticks_index;		    /* Expiration ticks relative to
+					     * instance ticks_index_base
+					     */
+	uint8_t  index_parent;		    /* Parent node in index */
+	uint8_t  index_left;		    /* Left child node in index */
+	uint8_t  index_right;		    /* Right child node in index */
+	uint32_t index_priority;	    /* Heap priority in index */
+#endif /* CONFIG_BT_TICKER_INDEX */
 };
 
 /* Operations to be performed in ticker_job.
@@ -256,6 +266,13 @@ struct ticker_instance {
 	uint8_t  ticker_id_head;	/* Index of first ticker node (next to
 					 * expire)
 					 */
+#if defined(CONFIG_BT_TICKER_INDEX)
+	uint32_t ticks_index_base;	/* Ticks elapsed at head of ticker node
+					 * list, base of ticks_index
+					 */
+	uint32_t index_seed;		/* Seed of index heap priorities */
+	uint8_t  index_root;		/* Root ticker node of index */
+#endif /* CONFIG_BT_TICKER_INDEX */
 	uint8_t  job_guard;		/* Flag preventing ticker_worker from
 					 * running if ticker_job is active
 					 */
@@ -464,7 +481,346 @@ static void ticker_by_next_slot_get(struct ticker_instance *instance,
 	*ticks_to_expire = _ticks_to_expire;
 }
 
-#if !defined(CONFIG_BT_TICKER_LOW_LAT)
+#if defined(CONFIG_BT_TICKER_INDEX)
+/**
+ * @brief Get index key of ticker node
+ *
+ * @details The index stores the expiration of each queued ticker node
+ * relative to a base which is advanced by the elapsed ticks applied to the
+ * head of the ticker node list. The key of a queued ticker node hence is
+ * the sum of ticks_to_expire of all nodes up to and including it.
+ *
+ * @param instance Pointer to ticker instance
+ * @param ticker   Pointer to queued ticker node
+ *
+ * @return Ticks until expiration of ticker node
+ * @internal
+ */
+static inline uint32_t ticker_index_key(struct ticker_instance *instance,
+					struct ticker_node *ticker)
+{
+	return ticker->ticks_index - instance->ticks_index_base;
+}
+
+/**
+ * @brief Get last ticker node in index subtree
+ *
+ * @param node Pointer to ticker node array
+ * @param id   Id of subtree root ticker node
+ *
+ * @return Id of last ticker node in subtree
+ * @internal
+ */
+static uint8_t ticker_index_last(struct ticker_node *node, uint8_t id)
+{
+	while (node[id].index_right != TICKER_NULL) {
+		id = node[id].index_right;
+	}
+
+	return id;
+}
+
+/**
+ * @brief Get previous ticker node in index
+ *
+ * @param node Pointer to ticker node array
+ * @param id   Id of queued ticker node
+ *
+ * @return Id of ticker node before the given one in the ticker node list,
+ * or TICKER_NULL if it is the head
+ * @internal
+ */
+static uint8_t ticker_index_prev(struct ticker_node *node, uint8_t id)
+{
+	uint8_t parent;
+
+	if (node[id].index_left != TICKER_NULL) {
+		return ticker_index_last(node, node[id].index_left);
+	}
+
+	parent = node[id].index_parent;
+	while ((parent != TICKER_NULL) && (node[parent].index_left == id)) {
+		id = parent;
+		parent = node[id].index_parent;
+	}
+
+	return parent;
+}
+
+/**
+ * @brief Rotate ticker node up in index
+ *
+ * @details Swaps the given ticker node with its parent, keeping the order
+ * of the ticker nodes in the index.
+ *
+ * @param instance Pointer to ticker instance
+ * @param id       Id of ticker node with a parent
+ *
+ * @internal
+ */
+static void ticker_index_rotate(struct ticker_instance *instance, uint8_t id)
+{
+	struct ticker_node *node = &instance->nodes[0];
+	struct ticker_node *ticker = &node[id];
+	uint8_t parent = ticker->index_parent;
+	uint8_t grand = node[parent].index_parent;
+	uint8_t child;
+
+	if (node[parent].index_left == id) {
+		child = ticker->index_right;
+		node[parent].index_left = child;
+		ticker->index_right = parent;
+	} else {
+		child = ticker->index_left;
+		node[parent].index_right = child;
+		ticker->index_left = parent;
+	}
+
+	if (child != TICKER_NULL) {
+		node[child].index_parent = parent;
+	}
+
+	node[parent].index_parent = id;
+	ticker->index_parent = grand;
+
+	if (grand == TICKER_NULL) {
+		instance->index_root = id;
+	} else if (node[grand].index_left == parent) {
+		node[grand].index_left = id;
+	} else {
+		node[grand].index_right = id;
+	}
+}
+
+/**
+ * @brief Insert ticker node in index
+ *
+ * @details The index is a treap over the queued ticker nodes, in the order
+ * of the ticker node list, with pseudo-random heap priorities drawn at
+ * insertion. Insertion and removal take expected logarithmic time in the
+ * number of queued ticker nodes.
+ *
+ * @param instance Pointer to ticker instance
+ * @param id       Id of ticker node to insert
+ * @param next     Id of ticker node following the inserted node in the
+ *                 ticker node list, or TICKER_NULL if it is the last
+ * @internal
+ */
+static void ticker_index_insert(struct ticker_instance *instance, uint8_t id,
+				uint8_t next)
+{
+	struct ticker_node *node = &instance->nodes[0];
+	struct ticker_node *ticker = &node[id];
+	uint8_t parent;
+
+	ticker->index_left = TICKER_NULL;
+	ticker->index_right = TICKER_NULL;
+	ticker->index_priority = instance->index_seed;
+	instance->index_seed = (instance->index_seed * 1664525U) + 1013904223U;
+
+	/* Link in as the rightmost leaf before next */
+	if (next == TICKER_NULL) {
+		parent = instance->index_root;
+		if (parent == TICKER_NULL) {
+			ticker->index_parent = TICKER_NULL;
+			instance->index_root = id;
+
+			return;
+		}
+
+		parent = ticker_index_last(node, parent);
+		node[parent].index_right = id;
+	} else if (node[next].index_left == TICKER_NULL) {
+		parent = next;
+		node[parent].index_left = id;
+	} else {
+		parent = ticker_index_last(node, node[next].index_left);
+		node[parent].index_right = id;
+	}
+
+	ticker->index_parent = parent;
+
+	/* Restore heap order */
+	while ((ticker->index_parent != TICKER_NULL) &&
+	       (node[ticker->index_parent].index_priority <
+		ticker->index_priority)) {
+		ticker_index_rotate(instance, id);
+	}
+}
+
+/**
+ * @brief Remove ticker node from index
+ *
+ * @param instance Pointer to ticker instance
+ * @param id       Id of ticker node to remove
+ *
+ * @internal
+ */
+static void ticker_index_remove(struct ticker_instance *instance, uint8_t id)
+{
+	struct ticker_node *node = &instance->nodes[0];
+	struct ticker_node *ticker = &node[id];
+	uint8_t parent;
+	uint8_t child;
+
+	/* Rotate down until the node has at most one child */
+	while ((ticker->index_left != TICKER_NULL) &&
+	       (ticker->index_right != TICKER_NULL)) {
+		if (node[ticker->index_left].index_priority >
+		    node[ticker->index_right].index_priority) {
+			ticker_index_rotate(instance, ticker->index_left);
+		} else {
+			ticker_index_rotate(instance, ticker->index_right);
+		}
+	}
+
+	if (ticker->index_left != TICKER_NULL) {
+		child = ticker->index_left;
+	} else {
+		child = ticker->index_right;
+	}
+
+	parent = ticker->index_parent;
+	if (child != TICKER_NULL) {
+		node[child].index_parent = parent;
+	}
+
+	if (parent == TICKER_NULL) {
+		instance->index_root = child;
+	} else if (node[parent].index_left == id) {
+		node[parent].index_left = child;
+	} else {
+		node[parent].index_right = child;
+	}
+
+	ticker->index_parent = TICKER_NULL;
+}
+
+/**
+ * @brief Check if ticker node is in index
+ *
+ * @param instance Pointer to ticker instance
+ * @param id       Id of ticker node
+ *
+ * @return true if ticker node is queued, otherwise false
+ * @internal
+ */
+static inline bool ticker_index_has(struct ticker_instance *instance,
+				    uint8_t id)
+{
+	return (instance->nodes[id].index_parent != TICKER_NULL) ||
+	       (instance->index_root == id);
+}
+
+#if defined(CONFIG_BT_TICKER_EXT)
+/**
+ * @brief Rebuild index from ticker node list
+ *
+ * @details Called after the ticker node list has been re-ordered without
+ * using ticker_enqueue and ticker_dequeue.
+ *
+ * @param instance Pointer to ticker instance
+ *
+ * @internal
+ */
+static void ticker_index_rebuild(struct ticker_instance *instance)
+{
+	struct ticker_node *node = &instance->nodes[0];
+	uint32_t ticks_index;
+	uint8_t id;
+
+	for (id = 0U; id < instance->count_node; id++) {
+		node[id].index_parent = TICKER_NULL;
+	}
+
+	instance->index_root = TICKER_NULL;
+	ticks_index = instance->ticks_index_base;
+	id = instance->ticker_id_head;
+	while (id != TICKER_NULL) {
+		ticks_index += node[id].ticks_to_expire;
+		node[id].ticks_index = ticks_index;
+		ticker_index_insert(instance, id, TICKER_NULL);
+		id = node[id].next;
+	}
+}
+#endif /* CONFIG_BT_TICKER_EXT */
+
+/**
+ * @brief Enqueue ticker node
+ *
+ * @details Finds insertion point for new ticker node using the index and
+ * inserts the node in the linked node list. The node is placed exactly as
+ * by walking the list: after all nodes expiring earlier or in the same tick,
+ * except that it precedes the first node expiring in the same tick with
+ * less latency.
+ *
+ * @param instance Pointer to ticker instance
+ * @param id       Ticker node id to enqueue
+ *
+ * @return Id of enqueued ticker node
+ * @internal
+ */
+static uint8_t ticker_enqueue(struct ticker_instance *instance, uint8_t id)
+{
+	struct ticker_node *ticker_new;
+	struct ticker_node *node;
+	uint32_t ticks_to_expire;
+	uint8_t previous;
+	uint8_t current;
+	uint8_t iter;
+
+	node = &instance->nodes[0];
+	ticker_new = &node[id];
+	ticks_to_expire = ticker_new->ticks_to_expire;
+
+	/* Find first ticker node expiring in the same tick or later, and the
+	 * ticker node before it
+	 */
+	previous = TICKER_NULL;
+	current = TICKER_NULL;
+	iter = instance->index_root;
+	while (iter != TICKER_NULL) {
+		if (ticker_index_key(instance, &node[iter]) >= ticks_to_expire) {
+			current = iter;
+			iter = node[iter].index_left;
+		} else {
+			previous = iter;
+			iter = node[iter].index_right;
+		}
+	}
+
+	/* Check for timeout in same tick - prioritize according to latency */
+	while ((current != TICKER_NULL) &&
+	       (ticker_index_key(instance, &node[current]) ==
+		ticks_to_expire) &&
+	       (ticker_new->lazy_current <= node[current].lazy_current)) {
+		previous = current;
+		current = node[current].next;
+	}
+
+	/* Link in new ticker node and adjust ticks_to_expire to relative value
+	 */
+	ticker_new->ticks_index = instance->ticks_index_base + ticks_to_expire;
+	ticker_new->next = current;
+
+	if (previous == TICKER_NULL) {
+		instance->ticker_id_head = id;
+	} else {
+		ticks_to_expire -= ticker_index_key(instance, &node[previous]);
+		node[previous].next = id;
+	}
+
+	ticker_new->ticks_to_expire = ticks_to_expire;
+
+	if (current != TICKER_NULL) {
+		node[current].ticks_to_expire -= ticks_to_expire;
+	}
+
+	ticker_index_insert(instance, id, current);
+
+	return id;
+}
+#elif !defined(CONFIG_BT_TICKER_LOW_LAT)
 /**
  * @brief Enqueue ticker node
  *
@@ -632,6 +988,61 @@ static uint8_t ticker_enqueue(struct ticker_instance *instance, uint8_t id)
 }
 #endif /* !CONFIG_BT_TICKER_LOW_LAT */
 
+#if defined(CONFIG_BT_TICKER_INDEX)
+/**
+ * @brief Dequeue ticker node
+ *
+ * @details Finds the previous ticker node using the index, unlinks the node
+ * and adjusts the links and ticks_to_expire. Returns the ticks until
+ * expiration for dequeued ticker node.
+ *
+ * @param instance Pointer to ticker instance
+ * @param id       Ticker node id to dequeue
+ *
+ * @return Total ticks until expiration for dequeued ticker node, or 0 if
+ * node was not found
+ * @internal
+ */
+static uint32_t ticker_dequeue(struct ticker_instance *instance, uint8_t id)
+{
+	struct ticker_node *ticker_current;
+	struct ticker_node *node;
+	uint8_t previous;
+	uint32_t total;
+
+	if (!ticker_index_has(instance, id)) {
+		/* Ticker not in active list */
+		return 0;
+	}
+
+	node = &instance->nodes[0];
+	ticker_current = &node[id];
+	total = ticker_index_key(instance, ticker_current);
+	previous = ticker_index_prev(node, id);
+
+	/* Link previous ticker with next of this ticker
+	 * i.e. removing the ticker from list
+	 */
+	if (previous == TICKER_NULL) {
+		/* Ticker is the first in the list */
+		instance->ticker_id_head = ticker_current->next;
+	} else {
+		node[previous].next = ticker_current->next;
+	}
+
+	/* If this is not the last ticker, increment the
+	 * next ticker by this ticker timeout
+	 */
+	if (ticker_current->next != TICKER_NULL) {
+		node[ticker_current->next].ticks_to_expire +=
+			ticker_current->ticks_to_expire;
+	}
+
+	ticker_index_remove(instance, id);
+
+	return total;
+}
+#else /* !CONFIG_BT_TICKER_INDEX */
 /**
  * @brief Dequeue ticker node
  *
@@ -702,6 +1113,7 @@ static uint32_t ticker_dequeue(struct ticker_instance *instance, uint8_t id)
 
 	return (total + timeout);
 }
+#endif /* !CONFIG_BT_TICKER_INDEX */
 
 #if !defined(CONFIG_BT_TICKER_LOW_LAT) && \
 	!defined(CONFIG_BT_TICKER_SLOT_AGNOSTIC)
@@ -1494,6 +1906,11 @@ static inline void ticker_job_worker_bh(struct ticker_instance *instance,
 	ticks_latency = ticker_ticks_diff_get(ticks_now, ticks_previous);
 #endif /* !CONFIG_BT_TICKER_LOW_LAT */
 
+#if defined(CONFIG_BT_TICKER_INDEX)
+	/* Elapsed ticks are applied to the head of the list */
+	instance->ticks_index_base += ticks_elapsed;
+#endif /* CONFIG_BT_TICKER_INDEX */
+
 	node = &instance->nodes[0];
 	ticks_expired = 0U;
 	while (instance->ticker_id_head != TICKER_NULL) {
@@ -1553,6 +1970,9 @@ static inline void ticker_job_worker_bh(struct ticker_instance *instance,
 
 		/* remove the expired ticker from head */
 		instance->ticker_id_head = ticker->next;
+#if defined(CONFIG_BT_TICKER_INDEX)
+		ticker_index_remove(instance, id_expired);
+#endif /* CONFIG_BT_TICKER_INDEX */
 
 		/* Ticker will be restarted if periodic or to be re-scheduled */
 		if ((ticker->ticks_periodic != 0U) ||
@@ -2462,6 +2882,9 @@ void ticker_job(void *param)
 #if defined(CONFIG_BT_TICKER_EXT)
 		/* Re-schedule any pending nodes with slot_window */
 		if (ticker_job_reschedule_in_window(instance, ticks_elapsed)) {
+#if defined(CONFIG_BT_TICKER_INDEX)
+			ticker_index_rebuild(instance);
+#endif /* CONFIG_BT_TICKER_INDEX */
 			flag_compare_update = 1U;
 		}
 #endif /* CONFIG_BT_TICKER_EXT */
@@ -2541,6 +2964,12 @@ uint32_t ticker_init(uint8_t instance_index, uint8_t count_node, void *node,
 	instance->count_node = count_node;
 	instance->nodes = node;
 
+#if defined(CONFIG_BT_TICKER_INDEX)
+	for (uint8_t i = 0U; i < count_node; i++) {
+		instance->nodes[i].index_parent = TICKER_NULL;
+	}
+#endif /* CONFIG_BT_TICKER_INDEX */
+
 #if !defined(CONFIG_BT_TICKER_LOW_LAT) && \
 	!defined(CONFIG_BT_TICKER_SLOT_AGNOSTIC)
 	while (count_node--) {
@@ -2571,6 +3000,10 @@ uint32_t ticker_init(uint8_t instance_index, uint8_t count_node, void *node,
 	instance->trigger_set_cb = trigger_set_cb;
 
 	instance->ticker_id_head = TICKER_NULL;
+#if defined(CONFIG_BT_TICKER_INDEX)
+	instance->index_root = TICKER_NULL;
+	instance->ticks_index_base = 0U;
+#endif /* CONFIG_BT_TICKER_INDEX */
 	instance->ticker_id_slot_previous = TICKER_NULL;
 	instance->ticks_slot_previous = 0U;
 	instance->ticks_current = 0U;
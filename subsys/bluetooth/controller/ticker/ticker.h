@@ -35,18 +35,26 @@
  * @}
  */
 
+/** \brief Timer node index size.
+ */
+#if defined(CONFIG_BT_TICKER_INDEX)
+#define TICKER_NODE_INDEX_T_SIZE 12
+#else
+#define TICKER_NODE_INDEX_T_SIZE 0
+#endif /* CONFIG_BT_TICKER_INDEX */
+
 /** \brief Timer node type size.
  */
 #if defined(CONFIG_BT_TICKER_LOW_LAT)
 #define TICKER_NODE_T_SIZE      40
 #else
 #if defined(CONFIG_BT_TICKER_EXT)
-#define TICKER_NODE_T_SIZE      48
+#define TICKER_NODE_T_SIZE      (48 + TICKER_NODE_INDEX_T_SIZE)
 #else
 #if defined(CONFIG_BT_TICKER_SLOT_AGNOSTIC)
-#define TICKER_NODE_T_SIZE      36
+#define TICKER_NODE_T_SIZE      (36 + TICKER_NODE_INDEX_T_SIZE)
 #else
-#define TICKER_NODE_T_SIZE      44
+#define TICKER_NODE_T_SIZE      (44 + TICKER_NODE_INDEX_T_SIZE)
 #endif /* CONFIG_BT_TICKER_SLOT_AGNOSTIC */
 #endif /* CONFIG_BT_TICKER_EXT */
 #endif /* CONFIG_BT_TICKER_LOW_LAT */
@@ -393,8 +393,9 @@ static bt_conn_tx_cb_t att_cb(bt_att_chan_sent_t cb)
 	}
 }
 
-struct net_buf *bt_att_chan_create_pdu(struct bt_att_chan *chan, uint8_t op,
-				       size_t len)
+static struct net_buf *att_chan_create_pdu(struct bt_att_chan *chan,
+					   uint8_t op, size_t len,
+					   k_timeout_t timeout)
 {
 	struct bt_att_hdr *hdr;
 	struct net_buf *buf;
@@ -405,18 +406,12 @@ struct net_buf *bt_att_chan_create_pdu(struct bt_att_chan *chan, uint8_t op,
 		return NULL;
 	}
 
-	switch (att_op_get_type(op)) {
-	case ATT_RESPONSE:
-	case ATT_CONFIRMATION:
-		/* Use a timeout only when responding/confirming */
-		buf = bt_l2cap_create_pdu_timeout(NULL, 0, BT_ATT_TIMEOUT);
-		break;
-	default:
-		buf = bt_l2cap_create_pdu(NULL, 0);
-	}
-
+	buf = bt_l2cap_create_pdu_timeout(NULL, 0, timeout);
 	if (!buf) {
-		BT_ERR("Unable to allocate buffer for op 0x%02x", op);
+		/* Callers not waiting handle running out of buffers */
+		if (!K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			BT_ERR("Unable to allocate buffer for op 0x%02x", op);
+		}
 		return NULL;
 	}
 
@@ -426,6 +421,19 @@ struct net_buf *bt_att_chan_create_pdu(struct bt_att_chan *chan, uint8_t op,
 	return buf;
 }
 
+struct net_buf *bt_att_chan_create_pdu(struct bt_att_chan *chan, uint8_t op,
+				       size_t len)
+{
+	switch (att_op_get_type(op)) {
+	case ATT_RESPONSE:
+	case ATT_CONFIRMATION:
+		/* Use a timeout only when responding/confirming */
+		return att_chan_create_pdu(chan, op, len, BT_ATT_TIMEOUT);
+	default:
+		return att_chan_create_pdu(chan, op, len, K_FOREVER);
+	}
+}
+
 static inline bool att_chan_is_connected(struct bt_att_chan *chan)
 {
 	return (chan->att->conn->state != BT_CONN_CONNECTED ||
@@ -2515,6 +2523,30 @@ struct net_buf *bt_att_create_pdu(struct bt_conn *conn, uint8_t op, size_t len)
 	return NULL;
 }
 
+struct net_buf *bt_att_create_pdu_timeout(struct bt_conn *conn, uint8_t op,
+					  size_t len, k_timeout_t timeout)
+{
+	struct bt_att *att;
+	struct bt_att_chan *chan, *tmp;
+
+	att = att_get(conn);
+	if (!att) {
+		return NULL;
+	}
+
+	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&att->chans, chan, tmp, node) {
+		if (len + sizeof(op) > chan->chan.tx.mtu) {
+			continue;
+		}
+
+		return att_chan_create_pdu(chan, op, len, timeout);
+	}
+
+	BT_WARN("No ATT channel for MTU %zu", len + sizeof(op));
+
+	return NULL;
+}
+
 static void att_reset(struct bt_att *att)
 {
 	struct bt_att_req *req, *tmp;
@@ -2968,6 +3000,26 @@ uint16_t bt_att_get_mtu(struct bt_conn *conn)
 	return mtu;
 }
 
+uint16_t bt_att_get_min_mtu(struct bt_conn *conn)
+{
+	struct bt_att_chan *chan, *tmp;
+	struct bt_att *att;
+	uint16_t mtu = 0;
+
+	att = att_get(conn);
+	if (!att) {
+		return 0;
+	}
+
+	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&att->chans, chan, tmp, node) {
+		if (!mtu || chan->chan.tx.mtu < mtu) {
+			mtu = chan->chan.tx.mtu;
+		}
+	}
+
+	return mtu;
+}
+
 static void att_chan_mtu_updated(struct bt_att_chan *updated_chan)
 {
 	struct bt_att *att = updated_chan->att;
@@ -280,8 +280,13 @@ void att_sent(struct bt_conn *conn, void *user_data);
 
 void bt_att_init(void);
 uint16_t bt_att_get_mtu(struct bt_conn *conn);
+/* Get the MTU that all ATT channels of a connection support */
+uint16_t bt_att_get_min_mtu(struct bt_conn *conn);
 struct net_buf *bt_att_create_pdu(struct bt_conn *conn, uint8_t op,
 				  size_t len);
+/* Allocate a new PDU waiting at most timeout for a buffer */
+struct net_buf *bt_att_create_pdu_timeout(struct bt_conn *conn, uint8_t op,
+					  size_t len, k_timeout_t timeout);
 
 /* Allocate a new request */
 struct bt_att_req *bt_att_req_alloc(k_timeout_t timeout);
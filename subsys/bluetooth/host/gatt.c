@@ -82,6 +82,48 @@ static sys_slist_t db;
 static atomic_t init;
 static atomic_t service_init;
 
+#if defined(CONFIG_BT_GATT_ATTR_INDEX)
+/* Attributes by handle, for handles up to the size of the index */
+static const struct bt_gatt_attr *attr_index[CONFIG_BT_GATT_ATTR_INDEX_SIZE];
+/* Highest handle in the index */
+static uint16_t attr_index_last;
+
+/* Handles of static attributes, hashed by attribute address. Entries are
+ * only hints, which are checked against the index.
+ */
+static uint16_t handle_cache[CONFIG_BT_GATT_ATTR_HANDLE_CACHE_SIZE];
+
+static inline bool attr_index_has(uint16_t handle)
+{
+	return handle != 0U && handle <= CONFIG_BT_GATT_ATTR_INDEX_SIZE;
+}
+
+static void attr_index_set(uint16_t handle, const struct bt_gatt_attr *attr)
+{
+	if (!attr_index_has(handle)) {
+		return;
+	}
+
+	attr_index[handle - 1] = attr;
+
+	if (attr) {
+		attr_index_last = MAX(attr_index_last, handle);
+		return;
+	}
+
+	while (attr_index_last && !attr_index[attr_index_last - 1]) {
+		attr_index_last--;
+	}
+}
+
+static uint16_t *handle_cache_entry(const struct bt_gatt_attr *attr)
+{
+	uintptr_t idx = (uintptr_t)attr / sizeof(*attr);
+
+	return &handle_cache[idx % ARRAY_SIZE(handle_cache)];
+}
+#endif /* CONFIG_BT_GATT_ATTR_INDEX */
+
 static ssize_t read_name(struct bt_conn *conn, const struct bt_gatt_attr *attr,
 			 void *buf, uint16_t len, uint16_t offset)
 {
@@ -940,6 +982,12 @@ populate:
 
 	gatt_insert(svc, last_handle);
 
+#if defined(CONFIG_BT_GATT_ATTR_INDEX)
+	for (uint16_t i = 0; i < svc->attr_count; i++) {
+		attr_index_set(svc->attrs[i].handle, &svc->attrs[i]);
+	}
+#endif /* CONFIG_BT_GATT_ATTR_INDEX */
+
 	return 0;
 }
 #endif /* CONFIG_BT_GATT_DYNAMIC_DB */
@@ -1095,6 +1143,12 @@ static void bt_gatt_service_init(void)
 	}
 
 	STRUCT_SECTION_FOREACH(bt_gatt_service_static, svc) {
+#if defined(CONFIG_BT_GATT_ATTR_INDEX)
+		for (uint16_t i = 0; i < svc->attr_count; i++) {
+			attr_index_set(last_static_handle + i + 1,
+				       &svc->attrs[i]);
+		}
+#endif /* CONFIG_BT_GATT_ATTR_INDEX */
 		last_static_handle += svc->attr_count;
 	}
 }
@@ -1240,6 +1294,10 @@ static int gatt_unregister(struct bt_gatt_service *svc)
 	for (uint16_t i = 0; i < svc->attr_count; i++) {
 		struct bt_gatt_attr *attr = &svc->attrs[i];
 
+#if defined(CONFIG_BT_GATT_ATTR_INDEX)
+		attr_index_set(attr->handle, NULL);
+#endif /* CONFIG_BT_GATT_ATTR_INDEX */
+
 		if (attr->write == bt_gatt_attr_write_ccc) {
 			gatt_unregister_ccc(attr->user_data);
 		}
@@ -1382,6 +1440,9 @@ static uint8_t get_service_handles(const struct bt_gatt_attr *attr,
 uint16_t bt_gatt_attr_get_handle(const struct bt_gatt_attr *attr)
 {
 	uint16_t handle = 1;
+#if defined(CONFIG_BT_GATT_ATTR_INDEX)
+	uint16_t *cached;
+#endif
 
 	if (!attr) {
 		return 0;
@@ -1391,6 +1452,13 @@ uint16_t bt_gatt_attr_get_handle(const struct bt_gatt_attr *attr)
 		return attr->handle;
 	}
 
+#if defined(CONFIG_BT_GATT_ATTR_INDEX)
+	cached = handle_cache_entry(attr);
+	if (attr_index_has(*cached) && attr_index[*cached - 1] == attr) {
+		return *cached;
+	}
+#endif /* CONFIG_BT_GATT_ATTR_INDEX */
+
 	STRUCT_SECTION_FOREACH(bt_gatt_service_static, static_svc) {
 		/* Skip ahead if start is not within service attributes array */
 		if ((attr < &static_svc->attrs[0]) ||
@@ -1401,6 +1469,9 @@ uint16_t bt_gatt_attr_get_handle(const struct bt_gatt_attr *attr)
 
 		for (size_t i = 0; i < static_svc->attr_count; i++, handle++) {
 			if (attr == &static_svc->attrs[i]) {
+#if defined(CONFIG_BT_GATT_ATTR_INDEX)
+				*cached = handle;
+#endif
 				return handle;
 			}
 		}
@@ -1584,6 +1655,35 @@ void bt_gatt_foreach_attr_type(uint16_t start_handle, uint16_t end_handle,
 		num_matches = UINT16_MAX;
 	}
 
+#if defined(CONFIG_BT_GATT_ATTR_INDEX)
+	if (attr_index_has(start_handle) && atomic_get(&service_init)) {
+		uint16_t last = MIN(end_handle, attr_index_last);
+
+		for (uint16_t handle = start_handle; handle <= last; handle++) {
+			const struct bt_gatt_attr *attr;
+
+			attr = attr_index[handle - 1];
+			if (!attr) {
+				continue;
+			}
+
+			if (gatt_foreach_iter(attr, handle, start_handle,
+					      end_handle, uuid, attr_data,
+					      &num_matches, func, user_data) ==
+			    BT_GATT_ITER_STOP) {
+				return;
+			}
+		}
+
+		if (end_handle <= CONFIG_BT_GATT_ATTR_INDEX_SIZE) {
+			return;
+		}
+
+		/* Walk the database for the handles past the index */
+		start_handle = CONFIG_BT_GATT_ATTR_INDEX_SIZE + 1;
+	}
+#endif /* CONFIG_BT_GATT_ATTR_INDEX */
+
 	if (start_handle <= last_static_handle) {
 		uint16_t handle = 1;
 
@@ -1938,6 +2038,260 @@ static int gatt_notify_mult(struct bt_conn *conn, uint16_t handle,
 }
 #endif /* CONFIG_BT_GATT_NOTIFY_MULTIPLE */
 
+#if defined(CONFIG_BT_GATT_NOTIFY_AGGREGATE)
+/* Retry delay when running out of buffers */
+#define NFY_AGG_RETRY K_MSEC(1)
+
+struct nfy_agg_entry {
+	uint16_t handle;
+	uint16_t len;
+	uint8_t value[CONFIG_BT_GATT_NOTIFY_AGGREGATE_LEN];
+};
+
+/* Pending notifications of a connection, in the order their handles were
+ * first queued. A new value of a pending handle replaces the stale one.
+ */
+struct nfy_agg {
+	struct nfy_agg_entry entries[CONFIG_BT_GATT_NOTIFY_AGGREGATE_COUNT];
+	uint8_t count;
+};
+
+static struct nfy_agg nfy_agg[CONFIG_BT_MAX_CONN];
+static struct k_spinlock nfy_agg_lock;
+
+static bool gatt_notify_agg_mult(struct bt_conn *conn)
+{
+#if defined(CONFIG_BT_GATT_NOTIFY_MULTIPLE)
+	return gatt_cf_notify_multi(conn);
+#else
+	return false;
+#endif /* CONFIG_BT_GATT_NOTIFY_MULTIPLE */
+}
+
+/* Build a PDU from the first pending notifications: a Multiple Handle Value
+ * Notification with as many of them as fit if the peer supports it, or a
+ * Handle Value Notification.
+ */
+static struct net_buf *notify_agg_pdu(struct bt_conn *conn,
+				      struct nfy_agg *agg, uint16_t mtu,
+				      bool mult)
+{
+	struct nfy_agg_entry *entry;
+	struct net_buf *buf;
+	size_t len = 0;
+	uint8_t i, n = 0;
+
+	if (mult) {
+		for (; n < agg->count; n++) {
+			size_t entry_len = sizeof(struct bt_att_notify_mult) +
+					   agg->entries[n].len;
+
+			if (sizeof(uint8_t) + len + entry_len > mtu) {
+				break;
+			}
+
+			len += entry_len;
+		}
+	}
+
+	if (n < 2) {
+		struct bt_att_notify *nfy;
+
+		entry = &agg->entries[0];
+
+		buf = bt_att_create_pdu_timeout(conn, BT_ATT_OP_NOTIFY,
+						sizeof(*nfy) + entry->len,
+						K_NO_WAIT);
+		if (!buf) {
+			return NULL;
+		}
+
+		nfy = net_buf_add(buf, sizeof(*nfy));
+		nfy->handle = sys_cpu_to_le16(entry->handle);
+		net_buf_add_mem(buf, entry->value, entry->len);
+		n = 1U;
+	} else {
+		buf = bt_att_create_pdu_timeout(conn, BT_ATT_OP_NOTIFY_MULT, len,
+						K_NO_WAIT);
+		if (!buf) {
+			return NULL;
+		}
+
+		for (i = 0U; i < n; i++) {
+			struct bt_att_notify_mult *nfy;
+
+			entry = &agg->entries[i];
+
+			nfy = net_buf_add(buf, sizeof(*nfy));
+			nfy->handle = sys_cpu_to_le16(entry->handle);
+			nfy->len = sys_cpu_to_le16(entry->len);
+			net_buf_add_mem(buf, entry->value, entry->len);
+		}
+	}
+
+	BT_DBG("conn %p %u notifications in %u bytes", conn, n, buf->len);
+
+	agg->count -= n;
+	memmove(agg->entries, &agg->entries[n],
+		agg->count * sizeof(agg->entries[0]));
+
+	return buf;
+}
+
+static bool notify_agg_send(struct bt_conn *conn, struct nfy_agg *agg)
+{
+	uint16_t mtu = bt_att_get_min_mtu(conn);
+	bool mult = gatt_notify_agg_mult(conn);
+	k_spinlock_key_t key;
+	struct net_buf *buf;
+	bool pending;
+
+	for (;;) {
+		key = k_spin_lock(&nfy_agg_lock);
+
+		if (conn->state != BT_CONN_CONNECTED || !mtu) {
+			agg->count = 0U;
+		}
+
+		buf = agg->count ? notify_agg_pdu(conn, agg, mtu, mult) : NULL;
+		pending = (agg->count > 0U);
+
+		k_spin_unlock(&nfy_agg_lock, key);
+
+		if (!buf) {
+			return pending;
+		}
+
+		/* Without a callback, any of the ATT bearers may send it */
+		bt_att_send(conn, buf, NULL, NULL);
+	}
+}
+
+static void notify_agg_reset(struct nfy_agg *agg)
+{
+	k_spinlock_key_t key = k_spin_lock(&nfy_agg_lock);
+
+	agg->count = 0U;
+
+	k_spin_unlock(&nfy_agg_lock, key);
+}
+
+static bool notify_agg_pending(struct nfy_agg *agg)
+{
+	k_spinlock_key_t key = k_spin_lock(&nfy_agg_lock);
+	bool pending = (agg->count > 0U);
+
+	k_spin_unlock(&nfy_agg_lock, key);
+
+	return pending;
+}
+
+static void notify_agg_process(struct k_work *work)
+{
+	bool pending = false;
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(nfy_agg); i++) {
+		struct bt_conn *conn;
+
+		if (!notify_agg_pending(&nfy_agg[i])) {
+			continue;
+		}
+
+		conn = bt_conn_lookup_index(i);
+		if (!conn) {
+			notify_agg_reset(&nfy_agg[i]);
+			continue;
+		}
+
+		pending |= notify_agg_send(conn, &nfy_agg[i]);
+		bt_conn_unref(conn);
+	}
+
+	/* Out of buffers, try again once some have been sent */
+	if (pending) {
+		k_work_reschedule(k_work_delayable_from_work(work),
+				  NFY_AGG_RETRY);
+	}
+}
+
+static K_WORK_DELAYABLE_DEFINE(nfy_agg_work, notify_agg_process);
+
+static int gatt_notify_agg(struct bt_conn *conn, uint16_t handle,
+			   struct bt_gatt_notify_params *params)
+{
+	struct nfy_agg *agg = &nfy_agg[bt_conn_index(conn)];
+	struct nfy_agg_entry *entry = NULL;
+	k_spinlock_key_t key;
+	uint8_t i;
+
+	/* Only queue values that fit in a PDU on any bearer */
+	if (sizeof(uint8_t) + sizeof(struct bt_att_notify) + params->len >
+	    bt_att_get_min_mtu(conn)) {
+		return -EMSGSIZE;
+	}
+
+	key = k_spin_lock(&nfy_agg_lock);
+
+	for (i = 0U; i < agg->count; i++) {
+		if (agg->entries[i].handle == handle) {
+			BT_DBG("handle 0x%04x stale value replaced", handle);
+			entry = &agg->entries[i];
+			break;
+		}
+	}
+
+	if (!entry && agg->count < ARRAY_SIZE(agg->entries)) {
+		entry = &agg->entries[agg->count++];
+		entry->handle = handle;
+	}
+
+	if (entry) {
+		entry->len = params->len;
+		memcpy(entry->value, params->data, params->len);
+	}
+
+	k_spin_unlock(&nfy_agg_lock, key);
+
+	if (!entry) {
+		return -ENOMEM;
+	}
+
+	/* The first notification of a burst starts the delay */
+	k_work_schedule(&nfy_agg_work,
+			K_MSEC(CONFIG_BT_GATT_NOTIFY_AGGREGATE_DELAY));
+
+	return 0;
+}
+
+/* Drop the pending value of a handle, about to be replaced by a value sent
+ * right away which it shall not follow.
+ */
+static void notify_agg_drop(struct bt_conn *conn, uint16_t handle)
+{
+	struct nfy_agg *agg = &nfy_agg[bt_conn_index(conn)];
+	k_spinlock_key_t key = k_spin_lock(&nfy_agg_lock);
+	uint8_t i;
+
+	for (i = 0U; i < agg->count; i++) {
+		if (agg->entries[i].handle == handle) {
+			BT_DBG("handle 0x%04x stale value dropped", handle);
+			agg->count--;
+			memmove(&agg->entries[i], &agg->entries[i + 1],
+				(agg->count - i) * sizeof(agg->entries[0]));
+			break;
+		}
+	}
+
+	k_spin_unlock(&nfy_agg_lock, key);
+}
+
+static void notify_agg_clear(struct bt_conn *conn)
+{
+	notify_agg_reset(&nfy_agg[bt_conn_index(conn)]);
+}
+#endif /* CONFIG_BT_GATT_NOTIFY_AGGREGATE */
+
 static int gatt_notify(struct bt_conn *conn, uint16_t handle,
 		       struct bt_gatt_notify_params *params)
 {
@@ -1962,12 +2316,25 @@ static int gatt_notify(struct bt_conn *conn, uint16_t handle,
 		return -EPERM;
 	}
 
+#if defined(CONFIG_BT_GATT_NOTIFY_AGGREGATE)
+	/* Values without a completion callback can be coalesced and sent
+	 * later, the others are sent as usual.
+	 */
+	if (!params->func &&
+	    params->len <= CONFIG_BT_GATT_NOTIFY_AGGREGATE_LEN &&
+	    !gatt_notify_agg(conn, handle, params)) {
+		return 0;
+	}
+
+	notify_agg_drop(conn, handle);
+#endif /* CONFIG_BT_GATT_NOTIFY_AGGREGATE */
+
 #if defined(CONFIG_BT_GATT_NOTIFY_MULTIPLE)
 	if (gatt_cf_notify_multi(conn)) {
 		int err;
 
 		err = gatt_notify_mult(conn, handle, params);
-		if (err && err != -ENOMEM) {
+		if (err != -ENOMEM) {
 			return err;
 		}
 	}
@@ -5467,4 +5834,8 @@ void bt_gatt_disconnected(struct bt_conn *conn)
 #if defined(CONFIG_BT_GATT_CACHING)
 	remove_cf_cfg(conn);
 #endif
+
+#if defined(CONFIG_BT_GATT_NOTIFY_AGGREGATE)
+	notify_agg_clear(conn);
+#endif
 }
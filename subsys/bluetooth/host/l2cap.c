@@ -34,6 +34,11 @@
 
 #define L2CAP_LE_MAX_CREDITS		(CONFIG_BT_BUF_ACL_RX_COUNT - 1)
 
+#if defined(CONFIG_BT_L2CAP_RX_ZERO_COPY)
+BUILD_ASSERT(CONFIG_BT_L2CAP_RX_ZERO_COPY_FRAGS < CONFIG_BT_BUF_ACL_RX_COUNT,
+	     "SDUs being reassembled shall not hold all ACL RX buffers");
+#endif /* CONFIG_BT_L2CAP_RX_ZERO_COPY */
+
 #define L2CAP_LE_CID_DYN_START	0x0040
 #define L2CAP_LE_CID_DYN_END	0x007f
 #define L2CAP_LE_CID_IS_DYN(_cid) \
@@ -831,6 +836,12 @@ static void l2cap_chan_rx_init(struct bt_l2cap_le_chan *chan)
 
 	atomic_set(&chan->rx.credits,  0);
 
+#if defined(CONFIG_BT_L2CAP_RX_CREDITS_TUNING)
+	atomic_set(&chan->_rx_credits_out, 0);
+	atomic_set(&chan->_rx_credits_held, 0);
+	chan->_rx_window = chan->rx.init_credits;
+#endif /* CONFIG_BT_L2CAP_RX_CREDITS_TUNING */
+
 	if (BT_DBG_ENABLED &&
 	    chan->rx.init_credits * chan->rx.mps <
 	    chan->rx.mtu + BT_L2CAP_SDU_HDR_SIZE) {
@@ -909,6 +920,10 @@ static void l2cap_chan_rx_give_credits(struct bt_l2cap_le_chan *chan,
 	BT_DBG("chan %p credits %u", chan, credits);
 
 	atomic_add(&chan->rx.credits, credits);
+
+#if defined(CONFIG_BT_L2CAP_RX_CREDITS_TUNING)
+	atomic_add(&chan->_rx_credits_out, credits);
+#endif /* CONFIG_BT_L2CAP_RX_CREDITS_TUNING */
 }
 
 static void l2cap_chan_destroy(struct bt_l2cap_chan *chan)
@@ -2125,6 +2140,78 @@ static void l2cap_chan_update_credits(struct bt_l2cap_le_chan *chan,
 	l2cap_chan_send_credits(chan, buf, credits);
 }
 
+#if defined(CONFIG_BT_L2CAP_RX_CREDITS_TUNING)
+static uint16_t l2cap_chan_rx_window_min(struct bt_l2cap_le_chan *chan)
+{
+	/* Credits needed to receive an SDU of MTU size */
+	return MIN(ceiling_fraction(chan->rx.mtu + BT_L2CAP_SDU_HDR_SIZE,
+				    chan->rx.mps),
+		   chan->rx.init_credits);
+}
+#endif /* CONFIG_BT_L2CAP_RX_CREDITS_TUNING */
+
+static void l2cap_chan_rx_hold_credits(struct bt_l2cap_le_chan *chan,
+				       uint16_t credits)
+{
+#if defined(CONFIG_BT_L2CAP_RX_CREDITS_TUNING)
+	uint16_t min = l2cap_chan_rx_window_min(chan);
+
+	/* The application drains SDUs slower than they are received if it
+	 * still holds a full SDU, shrink the window.
+	 */
+	if (atomic_add(&chan->_rx_credits_held, credits) >= min) {
+		chan->_rx_window = MAX(chan->_rx_window / 2U, min);
+		BT_DBG("chan %p window %u", chan, chan->_rx_window);
+	}
+#endif /* CONFIG_BT_L2CAP_RX_CREDITS_TUNING */
+}
+
+static void l2cap_chan_rx_restore_credits(struct bt_l2cap_le_chan *chan,
+					  struct net_buf *buf,
+					  uint16_t credits)
+{
+#if defined(CONFIG_BT_L2CAP_RX_CREDITS_TUNING)
+	atomic_val_t out;
+
+	atomic_sub(&chan->_rx_credits_held, credits);
+	out = atomic_sub(&chan->_rx_credits_out, credits) - credits;
+
+	/* The application keeps up if it has released all SDUs, grow the
+	 * window.
+	 */
+	if (!atomic_get(&chan->_rx_credits_held) &&
+	    chan->_rx_window < chan->rx.init_credits) {
+		chan->_rx_window++;
+	}
+
+	/* Only give the credits missing for the window */
+	if (out >= chan->_rx_window) {
+		BT_DBG("chan %p window %u out %d", chan, chan->_rx_window,
+		       out);
+		return;
+	}
+
+	credits = chan->_rx_window - out;
+#endif /* CONFIG_BT_L2CAP_RX_CREDITS_TUNING */
+
+	l2cap_chan_send_credits(chan, buf, credits);
+}
+
+static bool l2cap_chan_rx_stalled(struct bt_l2cap_le_chan *chan, uint16_t seg)
+{
+	if (atomic_get(&chan->rx.credits)) {
+		return false;
+	}
+
+#if defined(CONFIG_BT_L2CAP_RX_CREDITS_TUNING)
+	/* All the credits not held by the application are used by the SDU */
+	return seg == (atomic_get(&chan->_rx_credits_out) -
+		       atomic_get(&chan->_rx_credits_held));
+#else
+	return seg == chan->rx.init_credits;
+#endif /* CONFIG_BT_L2CAP_RX_CREDITS_TUNING */
+}
+
 int bt_l2cap_chan_recv_complete(struct bt_l2cap_chan *chan, struct net_buf *buf)
 {
 	struct bt_l2cap_le_chan *ch = BT_L2CAP_LE_CHAN(chan);
@@ -2144,10 +2231,16 @@ int bt_l2cap_chan_recv_complete(struct bt_l2cap_chan *chan, struct net_buf *buf)
 
 	BT_DBG("chan %p buf %p", chan, buf);
 
-	/* Restore credits used by packet */
-	memcpy(&credits, net_buf_user_data(buf), sizeof(credits));
+	/* Restore credits used by packet, the buffer of a channel without
+	 * segmentation is the K-frame itself which used a single credit.
+	 */
+	if (chan->ops->alloc_buf) {
+		memcpy(&credits, net_buf_user_data(buf), sizeof(credits));
+	} else {
+		credits = 1U;
+	}
 
-	l2cap_chan_send_credits(ch, buf, credits);
+	l2cap_chan_rx_restore_credits(ch, buf, credits);
 
 	net_buf_unref(buf);
 
@@ -2176,6 +2269,8 @@ static void l2cap_chan_le_recv_sdu(struct bt_l2cap_le_chan *chan,
 
 	BT_DBG("chan %p len %zu", chan, net_buf_frags_len(buf));
 
+	l2cap_chan_rx_hold_credits(chan, seg);
+
 	/* Receiving complete SDU, notify channel and reset SDU buf */
 	err = chan->chan.ops->recv(&chan->chan, buf);
 	if (err < 0) {
@@ -2187,10 +2282,30 @@ static void l2cap_chan_le_recv_sdu(struct bt_l2cap_le_chan *chan,
 		return;
 	}
 
-	l2cap_chan_send_credits(chan, buf, seg);
+	l2cap_chan_rx_restore_credits(chan, buf, seg);
 	net_buf_unref(buf);
 }
 
+static bool l2cap_chan_le_recv_chain(struct bt_l2cap_le_chan *chan,
+				     struct net_buf *buf, uint16_t seg)
+{
+#if defined(CONFIG_BT_L2CAP_RX_ZERO_COPY)
+	/* Copy the segments beyond the limit so that SDUs being reassembled
+	 * never hold all the ACL RX buffers.
+	 */
+	if (!chan->rx_zero_copy || seg > CONFIG_BT_L2CAP_RX_ZERO_COPY_FRAGS ||
+	    !buf->len) {
+		return false;
+	}
+
+	net_buf_frag_add(chan->_sdu, net_buf_ref(buf));
+
+	return true;
+#else
+	return false;
+#endif /* CONFIG_BT_L2CAP_RX_ZERO_COPY */
+}
+
 static void l2cap_chan_le_recv_seg(struct bt_l2cap_le_chan *chan,
 				   struct net_buf *buf)
 {
@@ -2214,13 +2329,15 @@ static void l2cap_chan_le_recv_seg(struct bt_l2cap_le_chan *chan,
 
 	BT_DBG("chan %p seg %d len %zu", chan, seg, net_buf_frags_len(buf));
 
-	/* Append received segment to SDU */
-	len = net_buf_append_bytes(chan->_sdu, buf->len, buf->data, K_NO_WAIT,
-				   l2cap_alloc_frag, chan);
-	if (len != buf->len) {
-		BT_ERR("Unable to store SDU");
-		bt_l2cap_chan_disconnect(&chan->chan);
-		return;
+	/* Append received segment to SDU, by reference if possible */
+	if (!l2cap_chan_le_recv_chain(chan, buf, seg)) {
+		len = net_buf_append_bytes(chan->_sdu, buf->len, buf->data,
+					   K_NO_WAIT, l2cap_alloc_frag, chan);
+		if (len != buf->len) {
+			BT_ERR("Unable to store SDU");
+			bt_l2cap_chan_disconnect(&chan->chan);
+			return;
+		}
 	}
 
 	if (net_buf_frags_len(chan->_sdu) < chan->_sdu_len) {
@@ -2228,8 +2345,7 @@ static void l2cap_chan_le_recv_seg(struct bt_l2cap_le_chan *chan,
 		 * should only happen if the remote cannot fully utilize the
 		 * MPS for some reason.
 		 */
-		if (!atomic_get(&chan->rx.credits) &&
-		    seg == chan->rx.init_credits) {
+		if (l2cap_chan_rx_stalled(chan, seg)) {
 			l2cap_chan_update_credits(chan, buf);
 		}
 		return;
@@ -2289,6 +2405,8 @@ static void l2cap_chan_le_recv(struct bt_l2cap_le_chan *chan,
 		return;
 	}
 
+	l2cap_chan_rx_hold_credits(chan, 1);
+
 	err = chan->chan.ops->recv(&chan->chan, buf);
 	if (err) {
 		if (err != -EINPROGRESS) {
@@ -2298,7 +2416,7 @@ static void l2cap_chan_le_recv(struct bt_l2cap_le_chan *chan,
 		return;
 	}
 
-	l2cap_chan_send_credits(chan, buf, 1);
+	l2cap_chan_rx_restore_credits(chan, buf, 1);
 }
 
 static void l2cap_chan_recv_queue(struct bt_l2cap_le_chan *chan,
@@ -37,6 +37,7 @@
 #include "host/ecc.h"
 #include "prov.h"
 #include "cfg.h"
+#include "statistic.h"
 
 #define LOOPBACK_MAX_PDU_LEN (BT_MESH_NET_HDR_LEN + 16)
 #define LOOPBACK_USER_DATA_SIZE sizeof(struct bt_mesh_subnet *)
@@ -84,6 +85,13 @@ static struct {
 } msg_cache[CONFIG_BT_MESH_MSG_CACHE_SIZE];
 static uint16_t msg_cache_next;
 
+/* Entries of the message and duplicate caches in use are hashed into
+ * chains, linked through the *_link[] arrays. Chain heads and links hold
+ * the index of an entry plus one, 0 ending a chain.
+ */
+static uint16_t msg_cache_hash[CONFIG_BT_MESH_MSG_CACHE_SIZE];
+static uint16_t msg_cache_link[CONFIG_BT_MESH_MSG_CACHE_SIZE];
+
 /* Singleton network context (the implementation only supports one) */
 struct bt_mesh_net bt_mesh = {
 	.local_queue = SYS_SLIST_STATIC_INIT(&bt_mesh.local_queue),
@@ -93,35 +101,91 @@ NET_BUF_POOL_DEFINE(loopback_buf_pool, CONFIG_BT_MESH_LOOPBACK_BUFS,
 		    LOOPBACK_MAX_PDU_LEN, LOOPBACK_USER_DATA_SIZE, NULL);
 
 static uint32_t dup_cache[CONFIG_BT_MESH_MSG_CACHE_SIZE];
-static int   dup_cache_next;
+static uint16_t dup_cache_hash[CONFIG_BT_MESH_MSG_CACHE_SIZE];
+static uint16_t dup_cache_link[CONFIG_BT_MESH_MSG_CACHE_SIZE];
+static uint16_t dup_cache_next;
+static uint16_t dup_cache_count;
+
+static void cache_chain_add(uint16_t *head, uint16_t *links, uint16_t idx)
+{
+	links[idx] = *head;
+	*head = idx + 1;
+}
+
+static void cache_chain_remove(uint16_t *head, uint16_t *links, uint16_t idx)
+{
+	uint16_t *link;
+
+	for (link = head; *link != idx + 1; link = &links[*link - 1]) {
+	}
+
+	*link = links[idx];
+}
+
+static inline uint16_t *dup_cache_head(uint32_t val)
+{
+	return &dup_cache_hash[val % ARRAY_SIZE(dup_cache_hash)];
+}
 
 static bool check_dup(struct net_buf_simple *data)
 {
 	const uint8_t *tail = net_buf_simple_tail(data);
 	uint32_t val;
-	int i;
+	uint16_t idx;
 
 	val = sys_get_be32(tail - 4) ^ sys_get_be32(tail - 8);
 
-	for (i = 0; i < ARRAY_SIZE(dup_cache); i++) {
-		if (dup_cache[i] == val) {
+	for (idx = *dup_cache_head(val); idx; idx = dup_cache_link[idx - 1]) {
+		if (dup_cache[idx - 1] == val) {
 			return true;
 		}
 	}
 
-	dup_cache[dup_cache_next++] = val;
-	dup_cache_next %= ARRAY_SIZE(dup_cache);
+	if (dup_cache_count < ARRAY_SIZE(dup_cache)) {
+		dup_cache_count++;
+	} else {
+		cache_chain_remove(dup_cache_head(dup_cache[dup_cache_next]),
+				   dup_cache_link, dup_cache_next);
+	}
+
+	dup_cache[dup_cache_next] = val;
+	cache_chain_add(dup_cache_head(val), dup_cache_link, dup_cache_next);
+	dup_cache_next = (dup_cache_next + 1) % ARRAY_SIZE(dup_cache);
 
 	return false;
 }
 
-static bool msg_cache_match(struct net_buf_simple *pdu)
+static uint16_t *msg_cache_head(uint16_t src, uint32_t seq)
+{
+	uint32_t key = ((uint32_t)src << 17) | (seq & BIT_MASK(17));
+
+	/* Fibonacci hashing, as sources and sequence numbers are sequential */
+	return &msg_cache_hash[((key * 0x9e3779b1U) >> 16) %
+			       ARRAY_SIZE(msg_cache_hash)];
+}
+
+static void msg_cache_remove(uint16_t idx)
 {
-	uint16_t i;
+	if (msg_cache[idx].src == BT_MESH_ADDR_UNASSIGNED) {
+		return;
+	}
 
-	for (i = 0U; i < ARRAY_SIZE(msg_cache); i++) {
-		if (msg_cache[i].src == SRC(pdu->data) &&
-		    msg_cache[i].seq == (SEQ(pdu->data) & BIT_MASK(17))) {
+	cache_chain_remove(msg_cache_head(msg_cache[idx].src,
+					  msg_cache[idx].seq),
+			   msg_cache_link, idx);
+	msg_cache[idx].src = BT_MESH_ADDR_UNASSIGNED;
+}
+
+static bool msg_cache_match(struct net_buf_simple *pdu)
+{
+	uint16_t src = SRC(pdu->data);
+	uint32_t seq = SEQ(pdu->data) & BIT_MASK(17);
+	uint16_t idx;
+
+	for (idx = *msg_cache_head(src, seq); idx;
+	     idx = msg_cache_link[idx - 1]) {
+		if (msg_cache[idx - 1].src == src &&
+		    msg_cache[idx - 1].seq == seq) {
 			return true;
 		}
 	}
@@ -132,9 +196,13 @@ static bool msg_cache_match(struct net_buf_simple *pdu)
 static void msg_cache_add(struct bt_mesh_net_rx *rx)
 {
 	rx->msg_cache_idx = msg_cache_next++;
+	msg_cache_remove(rx->msg_cache_idx);
 	msg_cache[rx->msg_cache_idx].src = rx->ctx.addr;
 	msg_cache[rx->msg_cache_idx].seq = rx->seq;
 	msg_cache_next %= ARRAY_SIZE(msg_cache);
+
+	cache_chain_add(msg_cache_head(rx->ctx.addr, rx->seq), msg_cache_link,
+			rx->msg_cache_idx);
 }
 
 static void store_iv(bool only_duration)
@@ -178,6 +246,7 @@ int bt_mesh_net_create(uint16_t idx, uint8_t flags, const uint8_t key[16],
 	}
 
 	(void)memset(msg_cache, 0, sizeof(msg_cache));
+	(void)memset(msg_cache_hash, 0, sizeof(msg_cache_hash));
 	msg_cache_next = 0U;
 
 	bt_mesh.iv_index = iv_index;
@@ -573,6 +642,31 @@ void bt_mesh_net_loopback_clear(uint16_t net_idx)
 	bt_mesh.local_queue = new_list;
 }
 
+/* Checks of the deobfuscated network header, done before decrypting */
+static bool net_header_check(struct bt_mesh_net_rx *rx,
+			     struct net_buf_simple *out)
+{
+	rx->ctx.addr = SRC(out->data);
+	if (!BT_MESH_ADDR_IS_UNICAST(rx->ctx.addr)) {
+		BT_DBG("Ignoring non-unicast src addr 0x%04x", rx->ctx.addr);
+		return false;
+	}
+
+	if (bt_mesh_has_addr(rx->ctx.addr)) {
+		BT_DBG("Dropping locally originated packet");
+		return false;
+	}
+
+	if (rx->net_if == BT_MESH_NET_IF_ADV && msg_cache_match(out)) {
+		BT_DBG("Duplicate found in Network Message Cache");
+		return false;
+	}
+
+	BT_DBG("src 0x%04x", rx->ctx.addr);
+
+	return true;
+}
+
 static bool net_decrypt(struct bt_mesh_net_rx *rx, struct net_buf_simple *in,
 			struct net_buf_simple *out,
 			const struct bt_mesh_net_cred *cred)
@@ -591,33 +685,155 @@ static bool net_decrypt(struct bt_mesh_net_rx *rx, struct net_buf_simple *in,
 	net_buf_simple_reset(out);
 	net_buf_simple_add_mem(out, in->data, in->len);
 
+	bt_mesh_stat_net_deobfuscate();
+
 	if (bt_mesh_net_obfuscate(out->data, BT_MESH_NET_IVI_RX(rx),
 				  cred->privacy)) {
 		return false;
 	}
 
-	rx->ctx.addr = SRC(out->data);
-	if (!BT_MESH_ADDR_IS_UNICAST(rx->ctx.addr)) {
-		BT_DBG("Ignoring non-unicast src addr 0x%04x", rx->ctx.addr);
+	if (!net_header_check(rx, out)) {
 		return false;
 	}
 
-	if (bt_mesh_has_addr(rx->ctx.addr)) {
-		BT_DBG("Dropping locally originated packet");
-		return false;
+	bt_mesh_stat_net_decrypt();
+
+	return bt_mesh_net_decrypt(cred->enc, out, BT_MESH_NET_IVI_RX(rx),
+				   proxy) == 0;
+}
+
+#if defined(CONFIG_BT_MESH_NET_DECRYPT_CACHE)
+/* Lifetime of the decryption cache entries, in milliseconds */
+#define NET_DECRYPT_CACHE_TIMEOUT 500
+
+/* Recently decrypted network PDUs, to resolve copies received again through
+ * another bearer without deobfuscating and decrypting them again. Entries
+ * are dropped on any subnet key change.
+ */
+static struct net_decrypt_cache_entry {
+	uint32_t timestamp;
+	uint32_t iv_index;
+	struct bt_mesh_subnet *sub;
+	uint8_t new_key:1,
+		friend_cred:1;
+	uint8_t in_len;  /* 0 if unused */
+	uint8_t out_len;
+	uint8_t in[BT_MESH_NET_MAX_PDU_LEN];
+	uint8_t out[BT_MESH_NET_MAX_PDU_LEN];
+} net_decrypt_cache[CONFIG_BT_MESH_NET_DECRYPT_CACHE_SIZE];
+static uint8_t net_decrypt_cache_next;
+
+static bool net_decrypt_cache_usable(struct bt_mesh_net_rx *rx)
+{
+	/* Proxy configuration PDUs use another nonce, and a Low Power node
+	 * waiting for an update only accepts its friendship credentials.
+	 */
+	return (rx->net_if != BT_MESH_NET_IF_PROXY_CFG &&
+		!bt_mesh_lpn_waiting_update());
+}
+
+/* Returns 0 for a cached PDU that passes the header checks, -EBADMSG for
+ * one that doesn't, and -ENOENT if the PDU isn't cached.
+ */
+static int net_decrypt_cache_get(struct bt_mesh_net_rx *rx,
+				 struct net_buf_simple *in,
+				 struct net_buf_simple *out)
+{
+	uint32_t now = k_uptime_get_32();
+	struct net_decrypt_cache_entry *entry;
+	int i;
+
+	if (!net_decrypt_cache_usable(rx)) {
+		return -ENOENT;
 	}
 
-	if (rx->net_if == BT_MESH_NET_IF_ADV && msg_cache_match(out)) {
-		BT_DBG("Duplicate found in Network Message Cache");
-		return false;
+	for (i = 0; i < ARRAY_SIZE(net_decrypt_cache); i++) {
+		entry = &net_decrypt_cache[i];
+
+		if (entry->in_len != in->len ||
+		    now - entry->timestamp > NET_DECRYPT_CACHE_TIMEOUT ||
+		    memcmp(entry->in, in->data, in->len)) {
+			continue;
+		}
+
+		rx->old_iv = (IVI(in->data) != (bt_mesh.iv_index & 0x01));
+		if (BT_MESH_NET_IVI_RX(rx) != entry->iv_index) {
+			return -ENOENT;
+		}
+
+		rx->sub = entry->sub;
+		rx->new_key = entry->new_key;
+		rx->friend_cred = entry->friend_cred;
+		rx->ctx.net_idx = entry->sub->net_idx;
+
+		net_buf_simple_reset(out);
+		net_buf_simple_add_mem(out, entry->out, entry->out_len);
+
+		bt_mesh_stat_net_decrypt_cached();
+
+		BT_DBG("Found in decryption cache");
+
+		return net_header_check(rx, out) ? 0 : -EBADMSG;
 	}
 
-	BT_DBG("src 0x%04x", rx->ctx.addr);
+	return -ENOENT;
+}
 
-	return bt_mesh_net_decrypt(cred->enc, out, BT_MESH_NET_IVI_RX(rx),
-				   proxy) == 0;
+static void net_decrypt_cache_add(struct bt_mesh_net_rx *rx,
+				  struct net_buf_simple *in,
+				  struct net_buf_simple *out)
+{
+	struct net_decrypt_cache_entry *entry;
+
+	if (!net_decrypt_cache_usable(rx)) {
+		return;
+	}
+
+	entry = &net_decrypt_cache[net_decrypt_cache_next];
+	net_decrypt_cache_next = (net_decrypt_cache_next + 1) %
+				 ARRAY_SIZE(net_decrypt_cache);
+
+	entry->timestamp = k_uptime_get_32();
+	entry->iv_index = BT_MESH_NET_IVI_RX(rx);
+	entry->sub = rx->sub;
+	entry->new_key = rx->new_key;
+	entry->friend_cred = rx->friend_cred;
+	entry->in_len = in->len;
+	entry->out_len = out->len;
+	memcpy(entry->in, in->data, in->len);
+	memcpy(entry->out, out->data, out->len);
 }
 
+static void net_decrypt_cache_clear(void)
+{
+	(void)memset(net_decrypt_cache, 0, sizeof(net_decrypt_cache));
+}
+
+static void subnet_evt(struct bt_mesh_subnet *sub, enum bt_mesh_key_evt evt)
+{
+	if (evt != BT_MESH_KEY_ADDED) {
+		net_decrypt_cache_clear();
+	}
+}
+
+BT_MESH_SUBNET_CB_DEFINE(net) = {
+	.evt_handler = subnet_evt,
+};
+#else
+static inline int net_decrypt_cache_get(struct bt_mesh_net_rx *rx,
+					struct net_buf_simple *in,
+					struct net_buf_simple *out)
+{
+	return -ENOENT;
+}
+
+static inline void net_decrypt_cache_add(struct bt_mesh_net_rx *rx,
+					 struct net_buf_simple *in,
+					 struct net_buf_simple *out)
+{
+}
+#endif /* CONFIG_BT_MESH_NET_DECRYPT_CACHE */
+
 /* Relaying from advertising to the advertising bearer should only happen
  * if the Relay state is set to enabled. Locally originated packets always
  * get sent to the advertising bearer. If the packet came in through GATT,
@@ -729,6 +945,8 @@ void bt_mesh_net_header_parse(struct net_buf_simple *buf,
 int bt_mesh_net_decode(struct net_buf_simple *in, enum bt_mesh_net_if net_if,
 		       struct bt_mesh_net_rx *rx, struct net_buf_simple *out)
 {
+	int err;
+
 	if (in->len < BT_MESH_NET_MIN_PDU_LEN) {
 		BT_WARN("Dropping too short mesh packet (len %u)", in->len);
 		BT_WARN("%s", bt_hex(in->data, in->len));
@@ -748,8 +966,15 @@ int bt_mesh_net_decode(struct net_buf_simple *in, enum bt_mesh_net_if net_if,
 
 	rx->net_if = net_if;
 
-	if (!bt_mesh_net_cred_find(rx, in, out, net_decrypt)) {
-		BT_DBG("Unable to find matching net for packet");
+	err = net_decrypt_cache_get(rx, in, out);
+	if (err == -ENOENT) {
+		if (!bt_mesh_net_cred_find(rx, in, out, net_decrypt)) {
+			BT_DBG("Unable to find matching net for packet");
+			return -ENOENT;
+		}
+
+		net_decrypt_cache_add(rx, in, out);
+	} else if (err) {
 		return -ENOENT;
 	}
 
@@ -829,7 +1054,7 @@ void bt_mesh_net_recv(struct net_buf_simple *data, int8_t rssi,
 	 */
 	if (bt_mesh_trans_recv(&buf, &rx) == -EAGAIN) {
 		BT_WARN("Removing rejected message from Network Message Cache");
-		msg_cache[rx.msg_cache_idx].src = BT_MESH_ADDR_UNASSIGNED;
+		msg_cache_remove(rx.msg_cache_idx);
 		/* Rewind the next index now that we're not using this entry */
 		msg_cache_next = rx.msg_cache_idx;
 	}
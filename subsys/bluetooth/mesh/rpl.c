@@ -38,11 +38,86 @@ struct rpl_val {
 static struct bt_mesh_rpl replay_list[CONFIG_BT_MESH_CRPL];
 static ATOMIC_DEFINE(store, CONFIG_BT_MESH_CRPL);
 
+/* Entries in use are hashed by source address into chains linked through
+ * rpl_next[]. Both hold the index of an entry plus one, 0 ending a chain.
+ */
+static uint16_t rpl_hash[CONFIG_BT_MESH_CRPL];
+static uint16_t rpl_next[CONFIG_BT_MESH_CRPL];
+static uint16_t rpl_count;
+
 static inline int rpl_idx(const struct bt_mesh_rpl *rpl)
 {
 	return rpl - &replay_list[0];
 }
 
+static inline uint16_t *rpl_head(uint16_t src)
+{
+	return &rpl_hash[src % ARRAY_SIZE(rpl_hash)];
+}
+
+static void rpl_src_set(struct bt_mesh_rpl *rpl, uint16_t src)
+{
+	uint16_t *link;
+
+	if (rpl->src == src) {
+		return;
+	}
+
+	if (rpl->src) {
+		for (link = rpl_head(rpl->src); *link != rpl_idx(rpl) + 1;
+		     link = &rpl_next[*link - 1]) {
+		}
+
+		*link = rpl_next[rpl_idx(rpl)];
+		rpl_count--;
+	}
+
+	rpl->src = src;
+
+	if (src) {
+		link = rpl_head(src);
+		rpl_next[rpl_idx(rpl)] = *link;
+		*link = rpl_idx(rpl) + 1;
+		rpl_count++;
+	}
+}
+
+static void rpl_entry_clear(struct bt_mesh_rpl *rpl)
+{
+	rpl_src_set(rpl, 0);
+	(void)memset(rpl, 0, sizeof(*rpl));
+}
+
+static struct bt_mesh_rpl *bt_mesh_rpl_find(uint16_t src)
+{
+	uint16_t idx;
+
+	for (idx = *rpl_head(src); idx; idx = rpl_next[idx - 1]) {
+		if (replay_list[idx - 1].src == src) {
+			return &replay_list[idx - 1];
+		}
+	}
+
+	return NULL;
+}
+
+static struct bt_mesh_rpl *rpl_free_find(void)
+{
+	int i;
+
+	if (rpl_count == ARRAY_SIZE(replay_list)) {
+		return NULL;
+	}
+
+	for (i = 0; i < ARRAY_SIZE(replay_list); i++) {
+		if (!replay_list[i].src) {
+			return &replay_list[i];
+		}
+	}
+
+	return NULL;
+}
+
 static void clear_rpl(struct bt_mesh_rpl *rpl)
 {
 	int err;
@@ -60,7 +135,7 @@ static void clear_rpl(struct bt_mesh_rpl *rpl)
 		BT_DBG("Cleared RPL");
 	}
 
-	(void)memset(rpl, 0, sizeof(*rpl));
+	rpl_entry_clear(rpl);
 	atomic_clear_bit(store, rpl_idx(rpl));
 }
 
@@ -92,7 +167,7 @@ void bt_mesh_rpl_update(struct bt_mesh_rpl *rpl,
 		rpl->seg = 0;
 	}
 
-	rpl->src = rx->ctx.addr;
+	rpl_src_set(rpl, rx->ctx.addr);
 	rpl->seq = rx->seq;
 	rpl->old_iv = rx->old_iv;
 
@@ -109,7 +184,7 @@ void bt_mesh_rpl_update(struct bt_mesh_rpl *rpl,
 bool bt_mesh_rpl_check(struct bt_mesh_net_rx *rx,
 		struct bt_mesh_rpl **match)
 {
-	int i;
+	struct bt_mesh_rpl *rpl;
 
 	/* Don't bother checking messages from ourselves */
 	if (rx->net_if == BT_MESH_NET_IF_LOCAL) {
@@ -121,11 +196,14 @@ bool bt_mesh_rpl_check(struct bt_mesh_net_rx *rx,
 		return false;
 	}
 
-	for (i = 0; i < ARRAY_SIZE(replay_list); i++) {
-		struct bt_mesh_rpl *rpl = &replay_list[i];
+	/* Existing slot for given address */
+	rpl = bt_mesh_rpl_find(rx->ctx.addr);
+	if (rpl) {
+		if (rx->old_iv && !rpl->old_iv) {
+			return true;
+		}
 
-		/* Empty slot */
-		if (!rpl->src) {
+		if ((!rx->old_iv && rpl->old_iv) || rpl->seq < rx->seq) {
 			if (match) {
 				*match = rpl;
 			} else {
@@ -135,29 +213,23 @@ bool bt_mesh_rpl_check(struct bt_mesh_net_rx *rx,
 			return false;
 		}
 
-		/* Existing slot for given address */
-		if (rpl->src == rx->ctx.addr) {
-			if (rx->old_iv && !rpl->old_iv) {
-				return true;
-			}
+		return true;
+	}
 
-			if ((!rx->old_iv && rpl->old_iv) ||
-			    rpl->seq < rx->seq) {
-				if (match) {
-					*match = rpl;
-				} else {
-					bt_mesh_rpl_update(rpl, rx);
-				}
+	/* Empty slot */
+	rpl = rpl_free_find();
+	if (!rpl) {
+		BT_ERR("RPL is full!");
+		return true;
+	}
 
-				return false;
-			} else {
-				return true;
-			}
-		}
+	if (match) {
+		*match = rpl;
+	} else {
+		bt_mesh_rpl_update(rpl, rx);
 	}
 
-	BT_ERR("RPL is full!");
-	return true;
+	return false;
 }
 
 void bt_mesh_rpl_clear(void)
@@ -168,34 +240,21 @@ void bt_mesh_rpl_clear(void)
 		schedule_rpl_clear();
 	} else {
 		(void)memset(replay_list, 0, sizeof(replay_list));
+		(void)memset(rpl_hash, 0, sizeof(rpl_hash));
+		rpl_count = 0U;
 	}
 }
 
-static struct bt_mesh_rpl *bt_mesh_rpl_find(uint16_t src)
-{
-	int i;
-
-	for (i = 0; i < ARRAY_SIZE(replay_list); i++) {
-		if (replay_list[i].src == src) {
-			return &replay_list[i];
-		}
-	}
-
-	return NULL;
-}
-
 static struct bt_mesh_rpl *bt_mesh_rpl_alloc(uint16_t src)
 {
-	int i;
+	struct bt_mesh_rpl *rpl;
 
-	for (i = 0; i < ARRAY_SIZE(replay_list); i++) {
-		if (!replay_list[i].src) {
-			replay_list[i].src = src;
-			return &replay_list[i];
-		}
+	rpl = rpl_free_find();
+	if (rpl) {
+		rpl_src_set(rpl, src);
 	}
 
-	return NULL;
+	return rpl;
 }
 
 void bt_mesh_rpl_reset(void)
@@ -213,7 +272,7 @@ void bt_mesh_rpl_reset(void)
 				if (IS_ENABLED(CONFIG_BT_SETTINGS)) {
 					clear_rpl(rpl);
 				} else {
-					(void)memset(rpl, 0, sizeof(*rpl));
+					rpl_entry_clear(rpl);
 				}
 			} else {
 				rpl->old_iv = true;
@@ -245,7 +304,7 @@ static int rpl_set(const char *name, size_t len_rd,
 	if (len_rd == 0) {
 		BT_DBG("val (null)");
 		if (entry) {
-			(void)memset(entry, 0, sizeof(*entry));
+			rpl_entry_clear(entry);
 		} else {
 			BT_WARN("Unable to find RPL entry for 0x%04x", src);
 		}
@@ -313,8 +372,18 @@ static void store_pending_rpl(struct bt_mesh_rpl *rpl)
 	}
 }
 
+static void rpl_entry_pending_store(struct bt_mesh_rpl *rpl)
+{
+	if (atomic_test_bit(bt_mesh.flags, BT_MESH_VALID)) {
+		store_pending_rpl(rpl);
+	} else {
+		clear_rpl(rpl);
+	}
+}
+
 void bt_mesh_rpl_pending_store(uint16_t addr)
 {
+	struct bt_mesh_rpl *rpl;
 	int i;
 
 	if (!IS_ENABLED(CONFIG_BT_SETTINGS) ||
@@ -323,24 +392,18 @@ void bt_mesh_rpl_pending_store(uint16_t addr)
 		return;
 	}
 
-	if (addr == BT_MESH_ADDR_ALL_NODES) {
-		bt_mesh_settings_store_cancel(BT_MESH_SETTINGS_RPL_PENDING);
-	}
-
-	for (i = 0; i < ARRAY_SIZE(replay_list); i++) {
-		if (addr != BT_MESH_ADDR_ALL_NODES &&
-		    addr != replay_list[i].src) {
-			continue;
+	if (addr != BT_MESH_ADDR_ALL_NODES) {
+		rpl = bt_mesh_rpl_find(addr);
+		if (rpl) {
+			rpl_entry_pending_store(rpl);
 		}
 
-		if (atomic_test_bit(bt_mesh.flags, BT_MESH_VALID)) {
-			store_pending_rpl(&replay_list[i]);
-		} else {
-			clear_rpl(&replay_list[i]);
-		}
+		return;
+	}
 
-		if (addr != BT_MESH_ADDR_ALL_NODES) {
-			break;
-		}
+	bt_mesh_settings_store_cancel(BT_MESH_SETTINGS_RPL_PENDING);
+
+	for (i = 0; i < ARRAY_SIZE(replay_list); i++) {
+		rpl_entry_pending_store(&replay_list[i]);
 	}
 }
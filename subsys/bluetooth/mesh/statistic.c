@@ -0,0 +1,38 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <string.h>
+#include <bluetooth/mesh.h>
+
+#include "statistic.h"
+
+static struct bt_mesh_statistic stat;
+
+void bt_mesh_stat_get(struct bt_mesh_statistic *st)
+{
+	memcpy(st, &stat, sizeof(stat));
+}
+
+void bt_mesh_stat_reset(void)
+{
+	(void)memset(&stat, 0, sizeof(stat));
+}
+
+void bt_mesh_stat_net_deobfuscate(void)
+{
+	stat.net_deobfuscate++;
+}
+
+void bt_mesh_stat_net_decrypt(void)
+{
+	stat.net_decrypt++;
+}
+
+void bt_mesh_stat_net_decrypt_cached(void)
+{
+	stat.net_decrypt_cached++;
+}
@@ -0,0 +1,15 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#if defined(CONFIG_BT_MESH_STATISTIC)
+void bt_mesh_stat_net_deobfuscate(void);
+void bt_mesh_stat_net_decrypt(void);
+void bt_mesh_stat_net_decrypt_cached(void);
+#else
+static inline void bt_mesh_stat_net_deobfuscate(void) {}
+static inline void bt_mesh_stat_net_decrypt(void) {}
+static inline void bt_mesh_stat_net_decrypt_cached(void) {}
+#endif
@@ -65,11 +65,185 @@ static struct bt_mesh_subnet subnets[CONFIG_BT_MESH_SUBNET_COUNT] = {
 	},
 };
 
+#if defined(CONFIG_BT_MESH_NET_CRED_INDEX)
+#if defined(CONFIG_BT_MESH_FRIEND)
+#define NET_CRED_FRND_COUNT CONFIG_BT_MESH_FRIEND_LPN_COUNT
+#else
+#define NET_CRED_FRND_COUNT 0
+#endif
+
+/* Network credentials of the friendships and subnets sorted by NID, keeping
+ * the order in which bt_mesh_net_cred_find() tries them among equal NIDs.
+ * The index is rebuilt on the next lookup after any credential changes, and
+ * entries are checked against their subnet and friendship when used.
+ */
+static struct net_cred_entry {
+	const struct bt_mesh_net_cred *cred;
+	struct bt_mesh_subnet *sub;
+#if defined(CONFIG_BT_MESH_FRIEND)
+	struct bt_mesh_friend *frnd;
+#endif
+	uint8_t nid;
+	uint8_t new_key:1,
+		friend_cred:1;
+} net_cred_index[2 * (CONFIG_BT_MESH_SUBNET_COUNT + NET_CRED_FRND_COUNT)];
+static uint16_t net_cred_count;
+static bool net_cred_index_valid;
+
+static void net_cred_index_invalidate(void)
+{
+	net_cred_index_valid = false;
+}
+
+static void net_cred_index_add(const struct bt_mesh_net_cred *cred,
+			       struct bt_mesh_subnet *sub,
+			       struct bt_mesh_friend *frnd, uint8_t key_idx)
+{
+	struct net_cred_entry *entry;
+	int i;
+
+	/* Insertion sort, stable among equal NIDs */
+	for (i = net_cred_count;
+	     i > 0 && net_cred_index[i - 1].nid > cred->nid; i--) {
+		net_cred_index[i] = net_cred_index[i - 1];
+	}
+
+	entry = &net_cred_index[i];
+	entry->cred = cred;
+	entry->sub = sub;
+#if defined(CONFIG_BT_MESH_FRIEND)
+	entry->frnd = frnd;
+#endif
+	entry->nid = cred->nid;
+	entry->new_key = (key_idx > 0);
+	entry->friend_cred = (frnd != NULL);
+
+	net_cred_count++;
+}
+
+static void net_cred_index_build(void)
+{
+	int i, j;
+
+	net_cred_count = 0U;
+
+#if defined(CONFIG_BT_MESH_FRIEND)
+	for (i = 0; i < ARRAY_SIZE(bt_mesh.frnd); i++) {
+		struct bt_mesh_friend *frnd = &bt_mesh.frnd[i];
+
+		if (!frnd->subnet) {
+			continue;
+		}
+
+		for (j = 0; j < ARRAY_SIZE(frnd->cred); j++) {
+			if (frnd->subnet->keys[j].valid) {
+				net_cred_index_add(&frnd->cred[j], frnd->subnet,
+						   frnd, j);
+			}
+		}
+	}
+#endif
+
+	for (i = 0; i < ARRAY_SIZE(subnets); i++) {
+		struct bt_mesh_subnet *sub = &subnets[i];
+
+		if (sub->net_idx == BT_MESH_KEY_UNUSED) {
+			continue;
+		}
+
+		for (j = 0; j < ARRAY_SIZE(sub->keys); j++) {
+			if (sub->keys[j].valid) {
+				net_cred_index_add(&sub->keys[j].msg, sub, NULL,
+						   j);
+			}
+		}
+	}
+
+	net_cred_index_valid = true;
+}
+
+static bool net_cred_entry_valid(const struct net_cred_entry *entry)
+{
+#if defined(CONFIG_BT_MESH_FRIEND)
+	if (entry->frnd && entry->frnd->subnet != entry->sub) {
+		return false;
+	}
+#endif
+
+	return (entry->sub->net_idx != BT_MESH_KEY_UNUSED &&
+		entry->sub->keys[entry->new_key].valid &&
+		entry->cred->nid == entry->nid);
+}
+
+static bool net_cred_index_find(struct bt_mesh_net_rx *rx,
+				struct net_buf_simple *in,
+				struct net_buf_simple *out,
+				bool (*cb)(struct bt_mesh_net_rx *rx,
+					   struct net_buf_simple *in,
+					   struct net_buf_simple *out,
+					   const struct bt_mesh_net_cred *cred))
+{
+	uint8_t nid = in->data[0] & 0x7f;
+	uint16_t lo = 0U, hi;
+	uint16_t mid;
+
+	if (!net_cred_index_valid) {
+		net_cred_index_build();
+	}
+
+	/* First entry with the packet's NID */
+	hi = net_cred_count;
+	while (lo < hi) {
+		mid = (lo + hi) / 2U;
+		if (net_cred_index[mid].nid < nid) {
+			lo = mid + 1U;
+		} else {
+			hi = mid;
+		}
+	}
+
+	for (; lo < net_cred_count && net_cred_index[lo].nid == nid; lo++) {
+		const struct net_cred_entry *entry = &net_cred_index[lo];
+
+		if (!net_cred_entry_valid(entry)) {
+			continue;
+		}
+
+		rx->sub = entry->sub;
+
+		if (cb(rx, in, out, entry->cred)) {
+			rx->new_key = entry->new_key;
+			rx->friend_cred = entry->friend_cred;
+			rx->ctx.net_idx = rx->sub->net_idx;
+			return true;
+		}
+	}
+
+	return false;
+}
+#else
+static inline void net_cred_index_invalidate(void) {}
+
+static inline bool net_cred_index_find(struct bt_mesh_net_rx *rx,
+				       struct net_buf_simple *in,
+				       struct net_buf_simple *out,
+				       bool (*cb)(struct bt_mesh_net_rx *rx,
+						  struct net_buf_simple *in,
+						  struct net_buf_simple *out,
+						  const struct bt_mesh_net_cred *cred))
+{
+	return false;
+}
+#endif /* CONFIG_BT_MESH_NET_CRED_INDEX */
+
 static void subnet_evt(struct bt_mesh_subnet *sub, enum bt_mesh_key_evt evt)
 {
 	STRUCT_SECTION_FOREACH(bt_mesh_subnet_cb, cb) {
 		cb->evt_handler(sub, evt);
 	}
+
+	/* The handlers may have changed friendship credentials */
+	net_cred_index_invalidate();
 }
 
 static void clear_net_key(uint16_t net_idx)
@@ -280,6 +454,8 @@ static void subnet_del(struct bt_mesh_subnet *sub)
 static int msg_cred_create(struct bt_mesh_net_cred *cred, const uint8_t *p,
 			   size_t p_len, const uint8_t key[16])
 {
+	net_cred_index_invalidate();
+
 	return bt_mesh_k2(key, p, p_len, &cred->nid, cred->enc, cred->privacy);
 }
 
@@ -744,6 +920,10 @@ bool bt_mesh_net_cred_find(struct bt_mesh_net_rx *rx, struct net_buf_simple *in,
 	}
 #endif
 
+	if (IS_ENABLED(CONFIG_BT_MESH_NET_CRED_INDEX)) {
+		return net_cred_index_find(rx, in, out, cb);
+	}
+
 #if defined(CONFIG_BT_MESH_FRIEND)
 	/** Each friendship has unique friendship credentials */
 	for (i = 0; i < ARRAY_SIZE(bt_mesh.frnd); i++) {
@@ -0,0 +1,238 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Compressed RAM-based backing store implementation
+ */
+#include <mmu.h>
+#include <string.h>
+#include <kernel_arch_interface.h>
+#include <lz4.h>
+
+/*
+ * Evicted data pages are compressed with LZ4 and stored in a pool of fixed
+ * size chunks managed by a memory slab. A data page takes as many chunks as
+ * needed for its compressed size, chained through chunk_next[]; data pages
+ * which don't compress are stored as is.
+ *
+ * Location tokens index an array of slots, each recording the first chunk
+ * and the compressed size of its data page. The compressed size of a data
+ * page isn't known until it is paged out, so getting a location reserves
+ * the chunks for an uncompressed data page and paging out gives back the
+ * ones not used. This works because page-outs always follow the
+ * k_mem_paging_backing_store_location_get() that reserved their location.
+ *
+ * Like the RAM backing store, locations are freed as soon as data pages
+ * are paged in, so Z_PAGE_FRAME_BACKED is never set.
+ */
+#define CHUNK_SIZE	CONFIG_BACKING_STORE_RAM_COMPRESSED_CHUNK_SIZE
+#define NUM_CHUNKS	(CONFIG_BACKING_STORE_RAM_COMPRESSED_POOL_SIZE / \
+			 CHUNK_SIZE)
+#define PAGE_CHUNKS	(CONFIG_MMU_PAGE_SIZE / CHUNK_SIZE)
+#define NUM_SLOTS	CONFIG_BACKING_STORE_RAM_COMPRESSED_PAGES
+
+BUILD_ASSERT(((CHUNK_SIZE & (CHUNK_SIZE - 1)) == 0) &&
+	     (CHUNK_SIZE >= sizeof(void *)) &&
+	     (CHUNK_SIZE < CONFIG_MMU_PAGE_SIZE),
+	     "invalid compressed backing store chunk size");
+BUILD_ASSERT(NUM_CHUNKS >= 2 * PAGE_CHUNKS,
+	     "compressed backing store pool can't hold two pages");
+BUILD_ASSERT(NUM_CHUNKS <= UINT16_MAX,
+	     "too many compressed backing store chunks");
+
+struct slot {
+	/* First chunk of the data page */
+	uint16_t first;
+
+	/* Compressed size, CONFIG_MMU_PAGE_SIZE if stored as is, or 0 if the
+	 * location is reserved but the data page not paged out yet.
+	 */
+	uint16_t size;
+};
+
+static char __aligned(sizeof(void *)) pool[NUM_CHUNKS * CHUNK_SIZE];
+static struct k_mem_slab chunk_slab;
+static uint16_t chunk_next[NUM_CHUNKS];
+static unsigned int free_chunks;
+
+static struct slot slots[NUM_SLOTS];
+static uint16_t free_slots[NUM_SLOTS];
+static unsigned int num_free_slots;
+
+/* Compression state and bounce buffer for compressed data pages, used by
+ * page-ins and page-outs which are serialized.
+ */
+static LZ4_stream_t lz4_state;
+static char compress_buf[CONFIG_MMU_PAGE_SIZE];
+
+static unsigned long stored_pages;
+static unsigned long stored_bytes;
+static unsigned long incompressible;
+
+static inline char *chunk_ptr(uint16_t chunk)
+{
+	return pool + ((size_t)chunk * CHUNK_SIZE);
+}
+
+static inline unsigned int size_to_chunks(uint16_t size)
+{
+	return ceiling_fraction(size, CHUNK_SIZE);
+}
+
+static struct slot *location_to_slot(uintptr_t location)
+{
+	__ASSERT(location % CONFIG_MMU_PAGE_SIZE == 0,
+		 "unaligned location 0x%lx", location);
+	__ASSERT(location < (NUM_SLOTS * CONFIG_MMU_PAGE_SIZE),
+		 "bad location 0x%lx, past bounds of backing store", location);
+
+	return &slots[location / CONFIG_MMU_PAGE_SIZE];
+}
+
+static void chunks_store(struct slot *slot, const char *src, uint16_t size)
+{
+	uint16_t *link = &slot->first;
+	void *chunk;
+	int ret;
+
+	for (size_t offset = 0; offset < size; offset += CHUNK_SIZE) {
+		ret = k_mem_slab_alloc(&chunk_slab, &chunk, K_NO_WAIT);
+		__ASSERT(ret == 0, "chunk count mismatch");
+		(void)ret;
+
+		*link = ((char *)chunk - pool) / CHUNK_SIZE;
+		link = &chunk_next[*link];
+		(void)memcpy(chunk, src + offset,
+			     MIN(CHUNK_SIZE, size - offset));
+	}
+}
+
+static void chunks_load(struct slot *slot, char *dst)
+{
+	uint16_t chunk = slot->first;
+
+	for (size_t offset = 0; offset < slot->size; offset += CHUNK_SIZE) {
+		(void)memcpy(dst + offset, chunk_ptr(chunk),
+			     MIN(CHUNK_SIZE, slot->size - offset));
+		chunk = chunk_next[chunk];
+	}
+}
+
+static void chunks_free(struct slot *slot)
+{
+	uint16_t chunk = slot->first;
+	void *ptr;
+
+	for (unsigned int i = size_to_chunks(slot->size); i > 0; i--) {
+		ptr = chunk_ptr(chunk);
+		chunk = chunk_next[chunk];
+		k_mem_slab_free(&chunk_slab, &ptr);
+	}
+}
+
+int k_mem_paging_backing_store_location_get(struct z_page_frame *pf,
+					    uintptr_t *location,
+					    bool page_fault)
+{
+	unsigned int pages = page_fault ? 1U : 2U;
+	uint16_t idx;
+
+	if ((num_free_slots < pages) || (free_chunks < pages * PAGE_CHUNKS)) {
+		return -ENOMEM;
+	}
+
+	idx = free_slots[--num_free_slots];
+	slots[idx].size = 0U;
+	free_chunks -= PAGE_CHUNKS;
+	*location = (uintptr_t)idx * CONFIG_MMU_PAGE_SIZE;
+
+	return 0;
+}
+
+void k_mem_paging_backing_store_location_free(uintptr_t location)
+{
+	struct slot *slot = location_to_slot(location);
+
+	if (slot->size == 0U) {
+		free_chunks += PAGE_CHUNKS;
+	} else {
+		chunks_free(slot);
+		free_chunks += size_to_chunks(slot->size);
+		stored_pages--;
+		stored_bytes -= slot->size;
+		z_paging_stats_compression(stored_pages, stored_bytes,
+					   incompressible);
+	}
+
+	free_slots[num_free_slots++] = slot - slots;
+}
+
+void k_mem_paging_backing_store_page_out(uintptr_t location)
+{
+	struct slot *slot = location_to_slot(location);
+	const char *src = compress_buf;
+	int size;
+	int key;
+
+	/* Only keep the compressed data page if it saves a chunk */
+	size = LZ4_compress_fast_extState(&lz4_state, Z_SCRATCH_PAGE,
+					  compress_buf, CONFIG_MMU_PAGE_SIZE,
+					  CONFIG_MMU_PAGE_SIZE - CHUNK_SIZE,
+				CONFIG_BACKING_STORE_RAM_COMPRESSED_ACCELERATION);
+	if (size <= 0) {
+		src = Z_SCRATCH_PAGE;
+		size = CONFIG_MMU_PAGE_SIZE;
+	}
+
+	key = irq_lock();
+	chunks_store(slot, src, size);
+	slot->size = size;
+	free_chunks += PAGE_CHUNKS - size_to_chunks(size);
+
+	stored_pages++;
+	stored_bytes += size;
+	if (src == Z_SCRATCH_PAGE) {
+		incompressible++;
+	}
+	z_paging_stats_compression(stored_pages, stored_bytes, incompressible);
+	irq_unlock(key);
+}
+
+void k_mem_paging_backing_store_page_in(uintptr_t location)
+{
+	struct slot *slot = location_to_slot(location);
+	int ret;
+
+	__ASSERT(slot->size != 0U, "location 0x%lx never paged out",
+		 location);
+
+	if (slot->size == CONFIG_MMU_PAGE_SIZE) {
+		chunks_load(slot, Z_SCRATCH_PAGE);
+		return;
+	}
+
+	chunks_load(slot, compress_buf);
+	ret = LZ4_decompress_safe(compress_buf, Z_SCRATCH_PAGE, slot->size,
+				  CONFIG_MMU_PAGE_SIZE);
+	__ASSERT(ret == CONFIG_MMU_PAGE_SIZE,
+		 "corrupted data page at location 0x%lx", location);
+	(void)ret;
+}
+
+void k_mem_paging_backing_store_page_finalize(struct z_page_frame *pf,
+					      uintptr_t location)
+{
+	k_mem_paging_backing_store_location_free(location);
+}
+
+void k_mem_paging_backing_store_init(void)
+{
+	k_mem_slab_init(&chunk_slab, pool, CHUNK_SIZE, NUM_CHUNKS);
+	free_chunks = NUM_CHUNKS;
+
+	for (uint16_t i = 0; i < NUM_SLOTS; i++) {
+		free_slots[i] = NUM_SLOTS - 1 - i;
+	}
+	num_free_slots = NUM_SLOTS;
+}
@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Clock (second chance) eviction algorithm for demand paging
+ */
+#include <kernel.h>
+#include <mmu.h>
+#include <kernel_arch_interface.h>
+
+/* The hand points to the next page frame to examine. Page frames are laid
+ * out in a circle in physical address order; the hand clears the accessed
+ * state of each page it passes over, so a page is evicted if it wasn't
+ * accessed during a whole revolution of the hand.
+ *
+ * Page frames which are not evictable are passed over without being
+ * examined.
+ */
+static size_t clock_hand;
+
+struct z_page_frame *k_mem_paging_eviction_select(bool *dirty_ptr)
+{
+	struct z_page_frame *pf, *victim = NULL;
+	unsigned long scanned = 0UL, second_chance = 0UL;
+	uintptr_t flags = 0UL;
+
+	/* After one revolution every page had its accessed state cleared, so
+	 * the second one always finds a page unless every page is pinned.
+	 */
+	while ((victim == NULL) && (scanned < 2UL * Z_NUM_PAGE_FRAMES)) {
+		pf = &z_page_frames[clock_hand];
+		clock_hand = (clock_hand + 1) % Z_NUM_PAGE_FRAMES;
+		scanned++;
+
+		if (!z_page_frame_is_evictable(pf)) {
+			continue;
+		}
+
+		/* Clear accessed bit in page tables, reporting its state */
+		flags = arch_page_info_get(pf->addr, NULL, true);
+
+		/* Implies a mismatch with page frame ontology and page
+		 * tables
+		 */
+		__ASSERT((flags & ARCH_DATA_PAGE_LOADED) != 0U,
+			 "non-present page, %s",
+			 ((flags & ARCH_DATA_PAGE_NOT_MAPPED) != 0U) ?
+			 "un-mapped" : "paged out");
+
+		if ((flags & ARCH_DATA_PAGE_ACCESSED) != 0UL) {
+			second_chance++;
+		} else {
+			victim = pf;
+		}
+	}
+
+	z_paging_stats_eviction_scan(scanned, second_chance);
+
+	/* Shouldn't ever happen unless every page is pinned */
+	__ASSERT(victim != NULL, "no page to evict");
+
+	*dirty_ptr = (flags & ARCH_DATA_PAGE_DIRTY) != 0UL;
+
+	return victim;
+}
+
+void k_mem_paging_eviction_init(void)
+{
+	clock_hand = 0;
+}
@@ -0,0 +1,266 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Clock-Pro eviction algorithm for demand paging
+ */
+#include <kernel.h>
+#include <mmu.h>
+#include <kernel_arch_interface.h>
+
+/* This is a simplified Clock-Pro. Data pages are either hot or cold, and only
+ * cold pages are evicted. Every page-in starts a cold page and its test
+ * period: if the page is accessed again before the test period ends it is
+ * promoted to hot, if it is faulted back in after having been evicted
+ * during its test period, the cold pages were too few to hold it and it
+ * comes back hot.
+ *
+ * Two hands sweep over the page frames in physical address order:
+ *
+ * - The cold hand looks for a page to evict. It passes over hot pages, it
+ *   promotes cold pages accessed during their test period, starts the test
+ *   period of other accessed cold pages and evicts the first cold page not
+ *   accessed since it was last passed. If that page was in its test period,
+ *   its virtual address is remembered in the history.
+ *
+ * - The hot hand runs whenever there are more hot pages than their target
+ *   and demotes the first hot page not accessed since it was last passed.
+ *   It ends the test period of the cold pages it passes.
+ *
+ * The target number of hot pages adapts to the workload: it decreases on
+ * refaults of pages in the history, and increases when test periods end
+ * without the page being reused, resident or not.
+ *
+ * Instead of keeping hot, cold and non-resident pages on a single list like
+ * the original algorithm, the state of resident pages is kept per page frame
+ * and non-resident pages have a small history of their own.
+ */
+#define CP_HOT		BIT(0)
+#define CP_TEST		BIT(1)
+
+static uint8_t cp_state[Z_NUM_PAGE_FRAMES];
+static size_t cold_hand, hot_hand;
+static size_t hot_count, hot_target, hot_max;
+
+static void *history[CONFIG_EVICTION_CLOCK_PRO_HISTORY];
+static size_t history_next;
+
+static inline uint8_t *state_get(struct z_page_frame *pf)
+{
+	return &cp_state[pf - z_page_frames];
+}
+
+static void hot_target_adjust(bool grow)
+{
+	if (grow) {
+		if (hot_target < hot_max) {
+			hot_target++;
+		}
+	} else if (hot_target > 0) {
+		hot_target--;
+	}
+}
+
+/* Forget the state of a page frame that is no longer evictable: it was
+ * unmapped, pinned or is busy being paged in or out.
+ */
+static void state_reset(struct z_page_frame *pf)
+{
+	uint8_t *state = state_get(pf);
+
+	if ((*state & CP_HOT) != 0U) {
+		hot_count--;
+	}
+	*state = 0U;
+}
+
+static void history_add(void *addr)
+{
+	if (history[history_next] != NULL) {
+		/* Oldest non-resident page ends its test period unused */
+		hot_target_adjust(true);
+	}
+
+	history[history_next] = addr;
+	history_next = (history_next + 1) % ARRAY_SIZE(history);
+}
+
+static bool history_remove(void *addr)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(history); i++) {
+		if (history[i] == addr) {
+			history[i] = NULL;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/* Demote one hot page to cold, returning false if there is no hot page */
+static bool hot_hand_run(unsigned long *scanned)
+{
+	struct z_page_frame *pf;
+	uint8_t *state;
+	uintptr_t flags;
+
+	for (size_t i = 0; (i < 2 * Z_NUM_PAGE_FRAMES) && (hot_count > 0); i++) {
+		pf = &z_page_frames[hot_hand];
+		hot_hand = (hot_hand + 1) % Z_NUM_PAGE_FRAMES;
+		state = state_get(pf);
+		(*scanned)++;
+
+		if (!z_page_frame_is_evictable(pf)) {
+			if (!z_page_frame_is_busy(pf)) {
+				state_reset(pf);
+			}
+			continue;
+		}
+
+		if ((*state & CP_HOT) == 0U) {
+			if ((*state & CP_TEST) != 0U) {
+				*state &= ~CP_TEST;
+				hot_target_adjust(true);
+			}
+			continue;
+		}
+
+		flags = arch_page_info_get(pf->addr, NULL, true);
+		if ((flags & ARCH_DATA_PAGE_ACCESSED) != 0UL) {
+			continue;
+		}
+
+		*state = 0U;
+		hot_count--;
+		z_paging_stats_clock_pro(0UL, 1UL, 0UL);
+
+		return true;
+	}
+
+	return false;
+}
+
+/* Find a cold page to evict within two revolutions of the cold hand */
+static struct z_page_frame *cold_hand_run(unsigned long *scanned,
+					  unsigned long *second_chance,
+					  uintptr_t *flags_ptr)
+{
+	struct z_page_frame *pf;
+	uint8_t *state;
+	uintptr_t flags;
+
+	for (size_t i = 0; i < 2 * Z_NUM_PAGE_FRAMES; i++) {
+		pf = &z_page_frames[cold_hand];
+		cold_hand = (cold_hand + 1) % Z_NUM_PAGE_FRAMES;
+		state = state_get(pf);
+		(*scanned)++;
+
+		if (!z_page_frame_is_evictable(pf)) {
+			if (!z_page_frame_is_busy(pf)) {
+				state_reset(pf);
+			}
+			continue;
+		}
+
+		if ((*state & CP_HOT) != 0U) {
+			continue;
+		}
+
+		flags = arch_page_info_get(pf->addr, NULL, true);
+
+		/* Implies a mismatch with page frame ontology and page
+		 * tables
+		 */
+		__ASSERT((flags & ARCH_DATA_PAGE_LOADED) != 0U,
+			 "non-present page, %s",
+			 ((flags & ARCH_DATA_PAGE_NOT_MAPPED) != 0U) ?
+			 "un-mapped" : "paged out");
+
+		if ((flags & ARCH_DATA_PAGE_ACCESSED) != 0UL) {
+			(*second_chance)++;
+			if ((*state & CP_TEST) != 0U) {
+				*state = CP_HOT;
+				hot_count++;
+				z_paging_stats_clock_pro(1UL, 0UL, 0UL);
+			} else {
+				*state = CP_TEST;
+			}
+			continue;
+		}
+
+		if ((*state & CP_TEST) != 0U) {
+			history_add(pf->addr);
+		}
+		*state = 0U;
+		*flags_ptr = flags;
+
+		return pf;
+	}
+
+	return NULL;
+}
+
+struct z_page_frame *k_mem_paging_eviction_select(bool *dirty_ptr)
+{
+	struct z_page_frame *pf;
+	unsigned long scanned = 0UL, second_chance = 0UL;
+	uintptr_t flags = 0UL;
+
+	while (hot_count > hot_target) {
+		if (!hot_hand_run(&scanned)) {
+			break;
+		}
+	}
+
+	/* If every evictable page is hot, demote some until there is a cold
+	 * page the cold hand didn't see accessed.
+	 */
+	do {
+		pf = cold_hand_run(&scanned, &second_chance, &flags);
+	} while ((pf == NULL) && hot_hand_run(&scanned));
+
+	z_paging_stats_eviction_scan(scanned, second_chance);
+
+	/* Shouldn't ever happen unless every page is pinned */
+	__ASSERT(pf != NULL, "no page to evict");
+
+	*dirty_ptr = (flags & ARCH_DATA_PAGE_DIRTY) != 0UL;
+
+	return pf;
+}
+
+void k_mem_paging_eviction_add(struct z_page_frame *pf)
+{
+	uint8_t *state = state_get(pf);
+
+	state_reset(pf);
+
+	if (history_remove(pf->addr)) {
+		/* Evicted while in its test period, the cold pages are too few */
+		hot_target_adjust(false);
+		*state = CP_HOT;
+		hot_count++;
+		z_paging_stats_clock_pro(0UL, 0UL, 1UL);
+	} else {
+		*state = CP_TEST;
+	}
+}
+
+void k_mem_paging_eviction_init(void)
+{
+	uintptr_t phys;
+	struct z_page_frame *pf;
+	size_t pageable = 0;
+
+	Z_PAGE_FRAME_FOREACH(phys, pf) {
+		if (!z_page_frame_is_reserved(pf) &&
+		    !z_page_frame_is_pinned(pf)) {
+			pageable++;
+		}
+	}
+
+	/* Keep at least one cold page, start with an even split */
+	hot_max = MAX(pageable, 2U) - 1U;
+	hot_target = pageable / 2U;
+}
@@ -45,8 +45,9 @@ struct z_page_frame *k_mem_paging_eviction_select(bool *dirty_ptr)
 	unsigned int last_prec = 4U;
 	struct z_page_frame *last_pf = NULL, *pf;
 	bool accessed;
-	bool dirty = false;
+	bool dirty = false, last_dirty = false;
 	uintptr_t flags, phys;
+	unsigned long scanned = 0UL, second_chance = 0UL;
 
 	Z_PAGE_FRAME_FOREACH(phys, pf) {
 		unsigned int prec;
@@ -55,6 +56,7 @@ struct z_page_frame *k_mem_paging_eviction_select(bool *dirty_ptr)
 			continue;
 		}
 
+		scanned++;
 		flags = arch_page_info_get(pf->addr, NULL, false);
 		accessed = (flags & ARCH_DATA_PAGE_ACCESSED) != 0UL;
 		dirty = (flags & ARCH_DATA_PAGE_DIRTY) != 0UL;
@@ -68,21 +70,29 @@ struct z_page_frame *k_mem_paging_eviction_select(bool *dirty_ptr)
 			 "un-mapped" : "paged out");
 
 		prec = (dirty ? 1U : 0U) + (accessed ? 2U : 0U);
+		if (accessed) {
+			second_chance++;
+		}
+
 		if (prec == 0) {
 			/* If we find a not accessed, clean page we're done */
 			last_pf = pf;
+			last_dirty = false;
 			break;
 		}
 
 		if (prec < last_prec) {
 			last_prec = prec;
 			last_pf = pf;
+			last_dirty = dirty;
 		}
 	}
 	/* Shouldn't ever happen unless every page is pinned */
 	__ASSERT(last_pf != NULL, "no page to evict");
 
-	*dirty_ptr = dirty;
+	z_paging_stats_eviction_scan(scanned, second_chance);
+
+	*dirty_ptr = last_dirty;
 
 	return last_pf;
 }
@@ -66,11 +66,32 @@ size_t flash_img_bytes_written(struct flash_img_context *ctx)
 	return stream_flash_bytes_written(&ctx->stream);
 }
 
+#ifdef CONFIG_IMG_ASYNC_WRITE
+/*
+ * Wait for the background write of an earlier upload with the context, if
+ * any, as its work item and semaphore are about to be initialized again.
+ * Its result does not matter anymore.
+ */
+static void async_write_wait(struct flash_img_context *ctx)
+{
+	uint8_t *buf = ctx->stream.async_buf;
+
+	/* The two buffers are swapped on every background write */
+	if (buf == ctx->buf || buf == ctx->async_buf) {
+		(void)stream_flash_async_wait(&ctx->stream);
+	}
+}
+#endif
+
 int flash_img_init_id(struct flash_img_context *ctx, uint8_t area_id)
 {
 	int rc;
 	const struct device *flash_dev;
 
+#ifdef CONFIG_IMG_ASYNC_WRITE
+	async_write_wait(ctx);
+#endif
+
 	rc = flash_area_open(area_id,
 			       (const struct flash_area **)&(ctx->flash_area));
 	if (rc) {
@@ -79,9 +100,16 @@ int flash_img_init_id(struct flash_img_context *ctx, uint8_t area_id)
 
 	flash_dev = flash_area_get_device(ctx->flash_area);
 
-	return stream_flash_init(&ctx->stream, flash_dev, ctx->buf,
+	rc = stream_flash_init(&ctx->stream, flash_dev, ctx->buf,
 			CONFIG_IMG_BLOCK_BUF_SIZE, ctx->flash_area->fa_off,
 			ctx->flash_area->fa_size, NULL);
+#ifdef CONFIG_IMG_ASYNC_WRITE
+	if (rc == 0) {
+		rc = stream_flash_async_enable(&ctx->stream, ctx->async_buf);
+	}
+#endif
+
+	return rc;
 }
 
 int flash_img_init(struct flash_img_context *ctx)
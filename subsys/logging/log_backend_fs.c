@@ -9,8 +9,10 @@
 #include <logging/log_backend.h>
 #include <logging/log_output_dict.h>
 #include <logging/log_backend_std.h>
+#include <logging/log_backend_fs.h>
 #include <assert.h>
 #include <fs/fs.h>
+#include <kernel.h>
 
 #define MAX_PATH_LEN 256
 #define MAX_FLASH_WRITE_SIZE 256
@@ -24,9 +26,37 @@ enum backend_fs_state {
 	BACKEND_FS_OK
 };
 
+#if (CONFIG_LOG_BACKEND_FS_BATCH_SIZE > 0) || \
+	defined(CONFIG_LOG_BACKEND_FS_SYNC_PERIODIC)
+#define DEFERRED_FLUSH 1
+#else
+#define DEFERRED_FLUSH 0
+#endif
+
 static struct fs_file_t file;
 static enum backend_fs_state backend_state = BACKEND_FS_NOT_INITIALIZED;
 static int file_ctr, newest, oldest;
+/* Write offset in the newest log file. */
+static size_t file_pos;
+/* Data written to the newest log file which has not been synchronized. */
+static bool unsynced;
+
+/* Serializes the log thread with the deferred flush work. */
+static K_MUTEX_DEFINE(write_lock);
+
+#if CONFIG_LOG_BACKEND_FS_BATCH_SIZE > 0
+static uint8_t __aligned(4) batch_buf[CONFIG_LOG_BACKEND_FS_BATCH_SIZE];
+static size_t batch_len;
+#endif
+
+#if DEFERRED_FLUSH
+static void flush_work_handler(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(flush_work, flush_work_handler);
+#endif
+
+#ifdef CONFIG_LOG_BACKEND_FS_SYNC_PERIODIC
+static int64_t last_sync;
+#endif
 
 static int allocate_new_file(struct fs_file_t *file);
 static int del_oldest_log(void);
@@ -143,7 +173,34 @@ close_dir:
 	return rc;
 }
 
-int write_log_to_file(uint8_t *data, size_t length, void *ctx)
+/* Synchronize the log file according to the configured policy. */
+static int sync_by_policy(struct fs_file_t *f)
+{
+#if defined(CONFIG_LOG_BACKEND_FS_SYNC_ALWAYS)
+	return fs_sync(f);
+#elif defined(CONFIG_LOG_BACKEND_FS_SYNC_PERIODIC)
+	int64_t elapsed = k_uptime_get() - last_sync;
+
+	if (elapsed >= CONFIG_LOG_BACKEND_FS_SYNC_PERIOD) {
+		last_sync += elapsed;
+		unsynced = false;
+
+		return fs_sync(f);
+	}
+
+	unsynced = true;
+	(void)k_work_schedule(&flush_work,
+			      K_MSEC(CONFIG_LOG_BACKEND_FS_SYNC_PERIOD - elapsed));
+
+	return 0;
+#else
+	unsynced = true;
+
+	return 0;
+#endif
+}
+
+static int file_write(uint8_t *data, size_t length)
 {
 	int rc;
 	struct fs_file_t *f = &file;
@@ -176,10 +233,12 @@ int write_log_to_file(uint8_t *data, size_t length, void *ctx)
 			if (rc < 0) {
 				goto on_error;
 			}
+			size = 0;
 		}
 
 		rc = fs_write(f, data, length);
 		if (rc >= 0) {
+			file_pos = size + rc;
 			if (IS_ENABLED(CONFIG_LOG_BACKEND_FS_OVERWRITE) &&
 			    (rc != length)) {
 				del_oldest_log();
@@ -208,7 +267,7 @@ int write_log_to_file(uint8_t *data, size_t length, void *ctx)
 			length = 0;
 		}
 
-		rc = fs_sync(f);
+		rc = sync_by_policy(f);
 		if (rc < 0) {
 			/* Something is wrong */
 			goto on_error;
@@ -222,6 +281,120 @@ on_error:
 	return length;
 }
 
+#if CONFIG_LOG_BACKEND_FS_BATCH_SIZE > 0
+static void batch_flush(void)
+{
+	uint8_t *data = batch_buf;
+	size_t len = batch_len;
+	int processed;
+
+	/* Same retry semantics as the log output buffer flush. */
+	while (len != 0) {
+		processed = file_write(data, len);
+		len -= processed;
+		data += processed;
+	}
+
+	batch_len = 0;
+}
+
+static int batch_write(uint8_t *data, size_t length)
+{
+	/* Write out pending data first if the chunk does not fit in the batch
+	 * or would push the log file over its size limit. That way the file
+	 * is rotated on the same chunk boundaries as without batching.
+	 */
+	if (((batch_len + length) > sizeof(batch_buf)) ||
+	    ((file_pos + batch_len + length) >
+	     CONFIG_LOG_BACKEND_FS_FILE_SIZE)) {
+		batch_flush();
+	}
+
+	if (length > sizeof(batch_buf)) {
+		return file_write(data, length);
+	}
+
+	if ((batch_len == 0) && (CONFIG_LOG_BACKEND_FS_BATCH_TIMEOUT > 0)) {
+		(void)k_work_schedule(&flush_work,
+			K_MSEC(CONFIG_LOG_BACKEND_FS_BATCH_TIMEOUT));
+	}
+
+	memcpy(&batch_buf[batch_len], data, length);
+	batch_len += length;
+
+	return length;
+}
+#endif /* CONFIG_LOG_BACKEND_FS_BATCH_SIZE > 0 */
+
+static int flush_locked(void)
+{
+	int rc = 0;
+
+#if CONFIG_LOG_BACKEND_FS_BATCH_SIZE > 0
+	batch_flush();
+#endif
+
+	if ((backend_state == BACKEND_FS_OK) && unsynced) {
+		unsynced = false;
+		rc = fs_sync(&file);
+		if (rc < 0) {
+			backend_state = BACKEND_FS_CORRUPTED;
+		}
+	}
+
+	return rc;
+}
+
+#if DEFERRED_FLUSH
+static void flush_work_handler(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	k_mutex_lock(&write_lock, K_FOREVER);
+
+#if CONFIG_LOG_BACKEND_FS_BATCH_SIZE > 0
+	batch_flush();
+#endif
+
+#ifdef CONFIG_LOG_BACKEND_FS_SYNC_PERIODIC
+	if ((backend_state == BACKEND_FS_OK) && unsynced &&
+	    (sync_by_policy(&file) < 0)) {
+		backend_state = BACKEND_FS_CORRUPTED;
+	}
+#endif
+
+	k_mutex_unlock(&write_lock);
+}
+#endif /* DEFERRED_FLUSH */
+
+int write_log_to_file(uint8_t *data, size_t length, void *ctx)
+{
+	int rc;
+
+	k_mutex_lock(&write_lock, K_FOREVER);
+
+#if CONFIG_LOG_BACKEND_FS_BATCH_SIZE > 0
+	rc = batch_write(data, length);
+#else
+	rc = file_write(data, length);
+#endif
+
+	k_mutex_unlock(&write_lock);
+
+	return rc;
+}
+
+int log_backend_fs_flush(void)
+{
+	int rc;
+
+	k_mutex_lock(&write_lock, K_FOREVER);
+	rc = flush_locked();
+	k_mutex_unlock(&write_lock);
+
+	return rc;
+}
+
 static int get_log_file_id(struct fs_dirent *ent)
 {
 	size_t len;
@@ -389,6 +562,8 @@ static int allocate_new_file(struct fs_file_t *file)
 	}
 	++file_ctr;
 	newest = curr_file_num;
+	file_pos = 0;
+	unsynced = false;
 
 out:
 	return rc;
@@ -443,6 +618,14 @@ static void log_backend_fs_init(const struct log_backend *const backend)
 
 static void panic(struct log_backend const *const backend)
 {
+	/* Write out batched data unless the panic interrupted an ongoing
+	 * file access.
+	 */
+	if (!k_is_in_isr() && (k_mutex_lock(&write_lock, K_NO_WAIT) == 0)) {
+		(void)flush_locked();
+		k_mutex_unlock(&write_lock);
+	}
+
 	/* In case of panic deinitialize backend. It is better to keep
 	 * current data rather than log new and risk of failure.
 	 */
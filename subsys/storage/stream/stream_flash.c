@@ -13,6 +13,7 @@ LOG_MODULE_REGISTER(LOG_MODULE_NAME, CONFIG_STREAM_FLASH_LOG_LEVEL);
 #include <zephyr/types.h>
 #include <string.h>
 #include <drivers/flash.h>
+#include <init.h>
 
 #include <storage/stream_flash.h>
 
@@ -104,23 +105,18 @@ int stream_flash_erase_page(struct stream_flash_ctx *ctx, off_t off)
 
 #endif /* CONFIG_STREAM_FLASH_ERASE */
 
-static int flash_sync(struct stream_flash_ctx *ctx)
+static int flash_program(struct stream_flash_ctx *ctx, uint8_t *buf,
+			 size_t buf_bytes, size_t write_addr)
 {
 	int rc = 0;
-	size_t write_addr = ctx->offset + ctx->bytes_written;
 	size_t buf_bytes_aligned;
 	size_t fill_length;
 	uint8_t filler;
 
-
-	if (ctx->buf_bytes == 0) {
-		return 0;
-	}
-
 	if (IS_ENABLED(CONFIG_STREAM_FLASH_ERASE)) {
 
 		rc = stream_flash_erase_page(ctx,
-					     write_addr + ctx->buf_bytes - 1);
+					     write_addr + buf_bytes - 1);
 		if (rc < 0) {
 			LOG_ERR("stream_flash_erase_page err %d offset=0x%08zx",
 				rc, write_addr);
@@ -129,17 +125,17 @@ static int flash_sync(struct stream_flash_ctx *ctx)
 	}
 
 	fill_length = flash_get_write_block_size(ctx->fdev);
-	if (ctx->buf_bytes % fill_length) {
-		fill_length -= ctx->buf_bytes % fill_length;
+	if (buf_bytes % fill_length) {
+		fill_length -= buf_bytes % fill_length;
 		filler = flash_get_parameters(ctx->fdev)->erase_value;
 
-		memset(ctx->buf + ctx->buf_bytes, filler, fill_length);
+		memset(buf + buf_bytes, filler, fill_length);
 	} else {
 		fill_length = 0;
 	}
 
-	buf_bytes_aligned = ctx->buf_bytes + fill_length;
-	rc = flash_write(ctx->fdev, write_addr, ctx->buf, buf_bytes_aligned);
+	buf_bytes_aligned = buf_bytes + fill_length;
+	rc = flash_write(ctx->fdev, write_addr, buf, buf_bytes_aligned);
 
 	if (rc != 0) {
 		LOG_ERR("flash_write error %d offset=0x%08zx", rc,
@@ -151,24 +147,200 @@ static int flash_sync(struct stream_flash_ctx *ctx)
 		/* Invert to ensure that caller is able to discover a faulty
 		 * flash_read() even if no error code is returned.
 		 */
-		for (int i = 0; i < ctx->buf_bytes; i++) {
-			ctx->buf[i] = ~ctx->buf[i];
+		for (int i = 0; i < buf_bytes; i++) {
+			buf[i] = ~buf[i];
 		}
 
-		rc = flash_read(ctx->fdev, write_addr, ctx->buf,
-				ctx->buf_bytes);
+		rc = flash_read(ctx->fdev, write_addr, buf, buf_bytes);
 		if (rc != 0) {
 			LOG_ERR("flash read failed: %d", rc);
 			return rc;
 		}
 
-		rc = ctx->callback(ctx->buf, ctx->buf_bytes, write_addr);
+		rc = ctx->callback(buf, buf_bytes, write_addr);
 		if (rc != 0) {
 			LOG_ERR("callback failed: %d", rc);
 			return rc;
 		}
 	}
 
+	return rc;
+}
+
+#ifdef CONFIG_STREAM_FLASH_ASYNC
+
+static K_KERNEL_STACK_DEFINE(stream_flash_work_q_stack,
+			     CONFIG_STREAM_FLASH_ASYNC_STACK_SIZE);
+
+static struct k_work_q stream_flash_work_q;
+
+static void async_program(struct k_work *work)
+{
+	struct stream_flash_ctx *ctx =
+		CONTAINER_OF(work, struct stream_flash_ctx, async_work);
+	size_t end = ctx->async_addr + ctx->async_bytes;
+	size_t area_end = ctx->offset + ctx->available;
+	int rc;
+
+	rc = flash_program(ctx, ctx->async_buf, ctx->async_bytes,
+			   ctx->async_addr);
+
+	/* Erase the page the next buffer ends in while it is being filled,
+	 * so that programming it does not have to wait for the erase.
+	 */
+	if (IS_ENABLED(CONFIG_STREAM_FLASH_ERASE) && rc == 0 &&
+	    end < area_end) {
+		rc = stream_flash_erase_page(ctx, MIN(end + ctx->buf_len,
+						      area_end) - 1);
+	}
+
+	ctx->async_err = rc;
+	k_sem_give(&ctx->async_idle);
+}
+
+/*
+ * Waits for the background buffer to become idle and accounts for the
+ * bytes it held. Leaves the semaphore taken.
+ */
+static int async_idle_take(struct stream_flash_ctx *ctx)
+{
+	k_sem_take(&ctx->async_idle, K_FOREVER);
+
+	if (ctx->async_err != 0) {
+		k_sem_give(&ctx->async_idle);
+		return ctx->async_err;
+	}
+
+	ctx->bytes_written += ctx->async_bytes;
+	ctx->async_bytes = 0;
+
+	return 0;
+}
+
+static int async_submit(struct stream_flash_ctx *ctx)
+{
+	uint8_t *buf = ctx->buf;
+	int rc;
+
+	rc = async_idle_take(ctx);
+	if (rc != 0) {
+		return rc;
+	}
+
+	ctx->buf = ctx->async_buf;
+	ctx->async_buf = buf;
+	ctx->async_bytes = ctx->buf_bytes;
+	ctx->async_addr = ctx->offset + ctx->bytes_written;
+	ctx->buf_bytes = 0U;
+
+	k_work_submit_to_queue(&stream_flash_work_q, &ctx->async_work);
+
+	return 0;
+}
+
+int stream_flash_async_enable(struct stream_flash_ctx *ctx, uint8_t *buf)
+{
+	if (!ctx || !buf) {
+		return -EFAULT;
+	}
+
+	if (ctx->async_buf || ctx->buf_bytes || ctx->bytes_written) {
+		return -EALREADY;
+	}
+
+	ctx->async_buf = buf;
+	ctx->async_bytes = 0;
+	ctx->async_err = 0;
+	k_sem_init(&ctx->async_idle, 1, 1);
+	k_work_init(&ctx->async_work, async_program);
+
+	return 0;
+}
+
+int stream_flash_async_wait(struct stream_flash_ctx *ctx)
+{
+	int rc;
+
+	if (!ctx) {
+		return -EFAULT;
+	}
+
+	if (!ctx->async_buf) {
+		return 0;
+	}
+
+	rc = async_idle_take(ctx);
+	if (rc == 0) {
+		k_sem_give(&ctx->async_idle);
+	}
+
+	return rc;
+}
+
+static int stream_flash_work_q_init(const struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	k_work_queue_start(&stream_flash_work_q, stream_flash_work_q_stack,
+			   K_KERNEL_STACK_SIZEOF(stream_flash_work_q_stack),
+			   CONFIG_STREAM_FLASH_ASYNC_PRIORITY, NULL);
+	k_thread_name_set(&stream_flash_work_q.thread, "stream_flash");
+
+	return 0;
+}
+
+SYS_INIT(stream_flash_work_q_init, POST_KERNEL,
+	 CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
+
+#else
+
+int stream_flash_async_enable(struct stream_flash_ctx *ctx, uint8_t *buf)
+{
+	return -ENOTSUP;
+}
+
+int stream_flash_async_wait(struct stream_flash_ctx *ctx)
+{
+	return 0;
+}
+
+#endif /* CONFIG_STREAM_FLASH_ASYNC */
+
+/* Number of bytes handed over to the flash, whether programmed yet or not */
+static size_t bytes_committed(struct stream_flash_ctx *ctx)
+{
+#ifdef CONFIG_STREAM_FLASH_ASYNC
+	return ctx->bytes_written + ctx->async_bytes;
+#else
+	return ctx->bytes_written;
+#endif
+}
+
+static int flash_sync(struct stream_flash_ctx *ctx, bool flush)
+{
+	int rc;
+
+	if (ctx->buf_bytes == 0) {
+		return flush ? stream_flash_async_wait(ctx) : 0;
+	}
+
+#ifdef CONFIG_STREAM_FLASH_ASYNC
+	if (ctx->async_buf) {
+		rc = async_submit(ctx);
+		if (rc != 0 || !flush) {
+			return rc;
+		}
+
+		return stream_flash_async_wait(ctx);
+	}
+#endif
+
+	rc = flash_program(ctx, ctx->buf, ctx->buf_bytes,
+			   ctx->offset + ctx->bytes_written);
+	if (rc != 0) {
+		return rc;
+	}
+
 	ctx->bytes_written += ctx->buf_bytes;
 	ctx->buf_bytes = 0U;
 
@@ -186,7 +358,7 @@ int stream_flash_buffered_write(struct stream_flash_ctx *ctx, const uint8_t *dat
 		return -EFAULT;
 	}
 
-	if (ctx->bytes_written + ctx->buf_bytes + len > ctx->available) {
+	if (bytes_committed(ctx) + ctx->buf_bytes + len > ctx->available) {
 		return -ENOMEM;
 	}
 
@@ -196,7 +368,7 @@ int stream_flash_buffered_write(struct stream_flash_ctx *ctx, const uint8_t *dat
 		       buf_empty_bytes);
 
 		ctx->buf_bytes = ctx->buf_len;
-		rc = flash_sync(ctx);
+		rc = flash_sync(ctx, false);
 
 		if (rc != 0) {
 			return rc;
@@ -212,8 +384,8 @@ int stream_flash_buffered_write(struct stream_flash_ctx *ctx, const uint8_t *dat
 		ctx->buf_bytes += len - processed;
 	}
 
-	if (flush && ctx->buf_bytes > 0) {
-		rc = flash_sync(ctx);
+	if (flush) {
+		rc = flash_sync(ctx, true);
 	}
 
 	return rc;
@@ -299,6 +471,10 @@ int stream_flash_init(struct stream_flash_ctx *ctx, const struct device *fdev,
 #ifdef CONFIG_STREAM_FLASH_ERASE
 	ctx->last_erased_page_start_offset = -1;
 #endif
+#ifdef CONFIG_STREAM_FLASH_ASYNC
+	ctx->async_buf = NULL;
+	ctx->async_bytes = 0;
+#endif
 
 	return 0;
 }
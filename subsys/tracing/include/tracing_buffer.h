@@ -104,6 +104,15 @@ int tracing_buffer_get_finish(uint32_t size);
  */
 uint32_t tracing_buffer_get(uint8_t *data, uint32_t size);
 
+/**
+ * @brief Get number of packets dropped to make room for new ones.
+ *
+ * Only non-zero in overwrite (flight recorder) mode.
+ *
+ * @return Number of overwritten packets.
+ */
+uint32_t tracing_buffer_overwritten_get(void);
+
 /**
  * @brief Get buffer from tracing command buffer.
  *
@@ -14,9 +14,16 @@
 extern "C" {
 #endif
 
+#ifdef CONFIG_TRACING_BUFFER_PER_CPU
+/* Per-CPU buffers only need protection against the local CPU. */
+#define TRACING_LOCK()		{ int key; key = arch_irq_lock()
+
+#define TRACING_UNLOCK()	{ arch_irq_unlock(key); } }
+#else
 #define TRACING_LOCK()		{ int key; key = irq_lock()
 
 #define TRACING_UNLOCK()	{ irq_unlock(key); } }
+#endif
 
 /**
  * @brief Check tracing enabled or not.
@@ -53,6 +60,14 @@ void tracing_cmd_handle(uint8_t *buf, uint32_t length);
  */
 void tracing_trigger_output(bool before_put_is_empty);
 
+/**
+ * @brief Wake the tracing thread to output all buffered packets.
+ *
+ * Used in flight recorder mode, where buffered packets are otherwise
+ * kept until overwritten.
+ */
+void tracing_flight_recorder_dump(void);
+
 /**
  * @brief Check if we are in tracing thread context.
  *
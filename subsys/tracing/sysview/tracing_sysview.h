@@ -473,6 +473,18 @@ void sys_trace_thread_info(struct k_thread *thread);
 #define sys_port_trace_k_condvar_wait_exit(condvar, ret)                                           \
 	SEGGER_SYSVIEW_RecordEndCallU32(TID_CONDVAR_WAIT, (uint32_t)ret)
 
+#define sys_port_trace_k_event_init(event)
+#define sys_port_trace_k_event_post_enter(event, events)
+#define sys_port_trace_k_event_post_exit(event, events)
+#define sys_port_trace_k_event_set_enter(event, events)
+#define sys_port_trace_k_event_set_exit(event, events)
+#define sys_port_trace_k_event_clear(event, events)
+#define sys_port_trace_k_event_wait_enter(event, events, timeout)
+#define sys_port_trace_k_event_wait_blocking(event, events, timeout)
+#define sys_port_trace_k_event_wait_exit(event, events, ret)
+#define sys_port_trace_k_event_wait_all_enter(event, events, timeout)
+#define sys_port_trace_k_event_wait_all_exit(event, events, ret)
+
 #define sys_port_trace_k_queue_init(queue)                                                         \
 	SEGGER_SYSVIEW_RecordU32(TID_QUEUE_INIT, (uint32_t)(uintptr_t)queue)
 
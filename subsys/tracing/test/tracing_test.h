@@ -154,6 +154,18 @@
 #define sys_port_trace_k_condvar_wait_exit(condvar, ret)                                           \
 	sys_trace_k_condvar_wait_exit(condvar, mutex, timeout, ret)
 
+#define sys_port_trace_k_event_init(event)
+#define sys_port_trace_k_event_post_enter(event, events)
+#define sys_port_trace_k_event_post_exit(event, events)
+#define sys_port_trace_k_event_set_enter(event, events)
+#define sys_port_trace_k_event_set_exit(event, events)
+#define sys_port_trace_k_event_clear(event, events)
+#define sys_port_trace_k_event_wait_enter(event, events, timeout)
+#define sys_port_trace_k_event_wait_blocking(event, events, timeout)
+#define sys_port_trace_k_event_wait_exit(event, events, ret)
+#define sys_port_trace_k_event_wait_all_enter(event, events, timeout)
+#define sys_port_trace_k_event_wait_all_exit(event, events, ret)
+
 #define sys_port_trace_k_queue_init(queue) sys_trace_k_queue_init(queue)
 #define sys_port_trace_k_queue_cancel_wait(queue) sys_trace_k_queue_cancel_wait(queue)
 #define sys_port_trace_k_queue_queue_insert_enter(queue, alloc)                                    \
@@ -67,3 +67,8 @@ uint32_t tracing_buffer_space_get(void)
 {
 	return ring_buf_space_get(&tracing_ring_buf);
 }
+
+uint32_t tracing_buffer_overwritten_get(void)
+{
+	return 0;
+}
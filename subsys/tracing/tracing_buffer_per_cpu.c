@@ -0,0 +1,403 @@
+/*
+ * Copyright (c) 2021 Intel corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Per-CPU tracing buffers.
+ *
+ * Every CPU owns a ring of CONFIG_TRACING_BUFFER_SIZE bytes into which only
+ * that CPU writes, with local interrupts locked (see TRACING_LOCK()). The
+ * tracing thread is the only reader. Head and tail are free running indexes
+ * so producers and the reader never share a lock.
+ *
+ * Data is stored as packets: a header holding the packet length and a
+ * timestamp, followed by the payload. Packets are aligned to the header size
+ * so that a header never wraps around the end of the ring. The reader merges
+ * the per-CPU streams by picking the oldest pending packet.
+ *
+ * In overwrite mode a producer which runs out of space drops the oldest
+ * packets of its ring by advancing the tail. The reader then copies a packet
+ * out before it is released and discards the copy if the tail moved
+ * underneath it.
+ */
+
+#include <kernel.h>
+#include <kernel_structs.h>
+#include <string.h>
+#include <sys/atomic.h>
+#include <sys/util.h>
+#include <tracing_buffer.h>
+
+BUILD_ASSERT((CONFIG_TRACING_BUFFER_SIZE &
+	      (CONFIG_TRACING_BUFFER_SIZE - 1)) == 0,
+	     "Per-CPU tracing buffer size must be a power of two");
+
+struct tracing_pkt_hdr {
+	uint32_t len;
+	uint32_t stamp;
+};
+
+#define PKT_HDR_SIZE sizeof(struct tracing_pkt_hdr)
+#define PKT_SIZE(len) ROUND_UP(PKT_HDR_SIZE + (len), PKT_HDR_SIZE)
+#define BUF_MASK (CONFIG_TRACING_BUFFER_SIZE - 1)
+
+struct tracing_cpu_buffer {
+	/* Index of the first free byte, written by the owning CPU. */
+	atomic_t head;
+	/* Index of the oldest packet, written by the reader and, in
+	 * overwrite mode, by the owning CPU.
+	 */
+	atomic_t tail;
+	/* End of the claimed but not yet committed packet. */
+	uint32_t tmp_head;
+	uint8_t data[CONFIG_TRACING_BUFFER_SIZE] __aligned(PKT_HDR_SIZE);
+};
+
+/* Not static so that a debugger can dump the buffers post-mortem. */
+struct tracing_cpu_buffer tracing_cpu_buffers[CONFIG_MP_NUM_CPUS];
+
+/* Packet currently handed out to the reader. */
+static struct {
+	uint8_t *data;
+	uint32_t pos;
+	uint32_t len;
+#ifndef CONFIG_TRACING_BUFFER_OVERWRITE
+	struct tracing_cpu_buffer *cpu_buf;
+	uint32_t next_tail;
+#endif
+} rd;
+
+#ifdef CONFIG_TRACING_BUFFER_OVERWRITE
+static uint8_t rd_copy[CONFIG_TRACING_PACKET_MAX_SIZE];
+static atomic_t overwritten_cnt;
+#endif
+
+static uint8_t tracing_cmd_buffer[CONFIG_TRACING_CMD_BUFFER_SIZE];
+
+uint32_t tracing_cmd_buffer_alloc(uint8_t **data)
+{
+	*data = &tracing_cmd_buffer[0];
+
+	return sizeof(tracing_cmd_buffer);
+}
+
+/* Must be called with local interrupts locked. */
+static inline struct tracing_cpu_buffer *local_buffer(void)
+{
+	return &tracing_cpu_buffers[_current_cpu->id];
+}
+
+static inline struct tracing_pkt_hdr *pkt_hdr(struct tracing_cpu_buffer *b,
+					      uint32_t idx)
+{
+	return (struct tracing_pkt_hdr *)&b->data[idx & BUF_MASK];
+}
+
+#ifdef CONFIG_TRACING_BUFFER_OVERWRITE
+static bool drop_oldest(struct tracing_cpu_buffer *b, uint32_t head)
+{
+	uint32_t tail = (uint32_t)atomic_get(&b->tail);
+
+	if (tail == head) {
+		return false;
+	}
+
+	/* The reader may release the same packet concurrently, in which
+	 * case the tail has moved on anyway.
+	 */
+	if (atomic_cas(&b->tail, (atomic_val_t)tail,
+		       (atomic_val_t)(tail + PKT_SIZE(pkt_hdr(b, tail)->len)))) {
+		atomic_inc(&overwritten_cnt);
+	}
+
+	return true;
+}
+#endif
+
+uint32_t tracing_buffer_put_claim(uint8_t **data, uint32_t size)
+{
+	struct tracing_cpu_buffer *b = local_buffer();
+	uint32_t head = (uint32_t)atomic_get(&b->head);
+	uint32_t avail, trail_size;
+
+	if (b->tmp_head == head) {
+		/* First claim of a packet, reserve its header. */
+		b->tmp_head = head + PKT_HDR_SIZE;
+	}
+
+#ifdef CONFIG_TRACING_BUFFER_OVERWRITE
+	/* Packets are copied out by the reader, which bounds their size. */
+	size = MIN(size, CONFIG_TRACING_PACKET_MAX_SIZE -
+			 (b->tmp_head - head - PKT_HDR_SIZE));
+
+	while ((ROUND_UP(b->tmp_head + size, PKT_HDR_SIZE) -
+		(uint32_t)atomic_get(&b->tail)) > CONFIG_TRACING_BUFFER_SIZE) {
+		if (!drop_oldest(b, head)) {
+			break;
+		}
+	}
+#endif
+
+	avail = CONFIG_TRACING_BUFFER_SIZE -
+		MIN(CONFIG_TRACING_BUFFER_SIZE,
+		    ROUND_UP(b->tmp_head, PKT_HDR_SIZE) -
+		    (uint32_t)atomic_get(&b->tail));
+	trail_size = CONFIG_TRACING_BUFFER_SIZE - (b->tmp_head & BUF_MASK);
+
+	size = MIN(size, avail);
+	size = MIN(size, trail_size);
+
+	*data = &b->data[b->tmp_head & BUF_MASK];
+	b->tmp_head += size;
+
+	return size;
+}
+
+int tracing_buffer_put_finish(uint32_t size)
+{
+	struct tracing_cpu_buffer *b = local_buffer();
+	uint32_t head = (uint32_t)atomic_get(&b->head);
+	struct tracing_pkt_hdr *hdr;
+
+	if (size == 0U) {
+		b->tmp_head = head;
+		return 0;
+	}
+
+	if ((head + PKT_HDR_SIZE + size) > b->tmp_head) {
+		b->tmp_head = head;
+		return -EINVAL;
+	}
+
+	hdr = pkt_hdr(b, head);
+	hdr->len = size;
+	hdr->stamp = k_cycle_get_32();
+
+	b->tmp_head = head + PKT_SIZE(size);
+	atomic_set(&b->head, (atomic_val_t)b->tmp_head);
+
+	return 0;
+}
+
+uint32_t tracing_buffer_put(uint8_t *data, uint32_t size)
+{
+	uint8_t *dst;
+	uint32_t partial_size;
+	uint32_t total_size = 0U;
+
+	do {
+		partial_size = tracing_buffer_put_claim(&dst, size);
+		memcpy(dst, data, partial_size);
+		total_size += partial_size;
+		size -= partial_size;
+		data += partial_size;
+	} while (size && partial_size);
+
+	if (size) {
+		/* Packets are never split. */
+		(void)tracing_buffer_put_finish(0);
+		return 0;
+	}
+
+	(void)tracing_buffer_put_finish(total_size);
+
+	return total_size;
+}
+
+/* Find the CPU buffer holding the oldest pending packet. */
+static struct tracing_cpu_buffer *oldest_buffer_get(void)
+{
+	struct tracing_cpu_buffer *oldest = NULL;
+	uint32_t oldest_stamp = 0U;
+
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		struct tracing_cpu_buffer *b = &tracing_cpu_buffers[i];
+		uint32_t tail = (uint32_t)atomic_get(&b->tail);
+		uint32_t stamp;
+
+		if (tail == (uint32_t)atomic_get(&b->head)) {
+			continue;
+		}
+
+		stamp = pkt_hdr(b, tail)->stamp;
+		if ((oldest == NULL) || ((int32_t)(stamp - oldest_stamp) < 0)) {
+			oldest = b;
+			oldest_stamp = stamp;
+		}
+	}
+
+	return oldest;
+}
+
+#ifdef CONFIG_TRACING_BUFFER_OVERWRITE
+static bool next_packet_get(void)
+{
+	struct tracing_cpu_buffer *b;
+
+	while ((b = oldest_buffer_get()) != NULL) {
+		uint32_t tail = (uint32_t)atomic_get(&b->tail);
+		uint32_t len = pkt_hdr(b, tail)->len;
+		uint32_t start = (tail + PKT_HDR_SIZE) & BUF_MASK;
+		uint32_t first;
+
+		if (len > sizeof(rd_copy)) {
+			/* Either the header was overwritten while being read,
+			 * in which case the tail has moved, or the buffer is
+			 * corrupted and its content is discarded.
+			 */
+			(void)atomic_cas(&b->tail, (atomic_val_t)tail,
+					 atomic_get(&b->head));
+			continue;
+		}
+
+		first = MIN(len, CONFIG_TRACING_BUFFER_SIZE - start);
+		memcpy(rd_copy, &b->data[start], first);
+		memcpy(&rd_copy[first], &b->data[0], len - first);
+
+		/* The copy is valid only if the producer has not overwritten
+		 * the packet in the meantime.
+		 */
+		if (atomic_cas(&b->tail, (atomic_val_t)tail,
+			       (atomic_val_t)(tail + PKT_SIZE(len)))) {
+			rd.data = rd_copy;
+			rd.pos = 0U;
+			rd.len = len;
+			return true;
+		}
+	}
+
+	return false;
+}
+#else
+static bool next_packet_get(void)
+{
+	struct tracing_cpu_buffer *b = oldest_buffer_get();
+	uint32_t tail;
+
+	if (b == NULL) {
+		return false;
+	}
+
+	tail = (uint32_t)atomic_get(&b->tail);
+	rd.cpu_buf = b;
+	rd.len = pkt_hdr(b, tail)->len;
+	rd.pos = 0U;
+	rd.next_tail = tail + PKT_SIZE(rd.len);
+	rd.data = NULL;
+
+	return true;
+}
+#endif
+
+uint32_t tracing_buffer_get_claim(uint8_t **data, uint32_t size)
+{
+	if ((rd.len == 0U) && !next_packet_get()) {
+		return 0;
+	}
+
+	size = MIN(size, rd.len - rd.pos);
+
+#ifdef CONFIG_TRACING_BUFFER_OVERWRITE
+	*data = &rd.data[rd.pos];
+#else
+	uint32_t idx = (rd.next_tail - PKT_SIZE(rd.len) + PKT_HDR_SIZE +
+			rd.pos) & BUF_MASK;
+
+	size = MIN(size, CONFIG_TRACING_BUFFER_SIZE - idx);
+	*data = &rd.cpu_buf->data[idx];
+#endif
+
+	return size;
+}
+
+int tracing_buffer_get_finish(uint32_t size)
+{
+	if (size > (rd.len - rd.pos)) {
+		return -EINVAL;
+	}
+
+	rd.pos += size;
+
+	if ((rd.len != 0U) && (rd.pos == rd.len)) {
+#ifndef CONFIG_TRACING_BUFFER_OVERWRITE
+		atomic_set(&rd.cpu_buf->tail, (atomic_val_t)rd.next_tail);
+#endif
+		rd.len = 0U;
+	}
+
+	return 0;
+}
+
+uint32_t tracing_buffer_get(uint8_t *data, uint32_t size)
+{
+	uint8_t *src;
+	uint32_t partial_size;
+	uint32_t total_size = 0U;
+
+	do {
+		partial_size = tracing_buffer_get_claim(&src, size);
+		memcpy(data, src, partial_size);
+		(void)tracing_buffer_get_finish(partial_size);
+		total_size += partial_size;
+		size -= partial_size;
+		data += partial_size;
+	} while (size && partial_size);
+
+	return total_size;
+}
+
+void tracing_buffer_init(void)
+{
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		atomic_set(&tracing_cpu_buffers[i].head, 0);
+		atomic_set(&tracing_cpu_buffers[i].tail, 0);
+		tracing_cpu_buffers[i].tmp_head = 0U;
+	}
+}
+
+bool tracing_buffer_is_empty(void)
+{
+	if (rd.len != 0U) {
+		return false;
+	}
+
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		if (atomic_get(&tracing_cpu_buffers[i].tail) !=
+		    atomic_get(&tracing_cpu_buffers[i].head)) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+uint32_t tracing_buffer_capacity_get(void)
+{
+	return CONFIG_TRACING_BUFFER_SIZE;
+}
+
+uint32_t tracing_buffer_space_get(void)
+{
+#ifdef CONFIG_TRACING_BUFFER_OVERWRITE
+	/* Space is reclaimed from the oldest packets on demand. */
+	return CONFIG_TRACING_PACKET_MAX_SIZE;
+#else
+	struct tracing_cpu_buffer *b = local_buffer();
+	uint32_t used = (uint32_t)atomic_get(&b->head) -
+			(uint32_t)atomic_get(&b->tail) + PKT_HDR_SIZE;
+
+	return (used < CONFIG_TRACING_BUFFER_SIZE) ?
+	       ROUND_DOWN(CONFIG_TRACING_BUFFER_SIZE - used, PKT_HDR_SIZE) : 0;
+#endif
+}
+
+uint32_t tracing_buffer_overwritten_get(void)
+{
+#ifdef CONFIG_TRACING_BUFFER_OVERWRITE
+	return (uint32_t)atomic_get(&overwritten_cnt);
+#else
+	return 0;
+#endif
+}
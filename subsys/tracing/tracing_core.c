@@ -15,6 +15,7 @@
 
 #define TRACING_CMD_ENABLE  "enable"
 #define TRACING_CMD_DISABLE "disable"
+#define TRACING_CMD_DUMP    "dump"
 
 #ifdef CONFIG_TRACING_BACKEND_UART
 #define TRACING_BACKEND_NAME "tracing_backend_uart"
@@ -60,6 +61,9 @@ static void tracing_thread_func(void *dummy1, void *dummy2, void *dummy3)
 		if (tracing_buffer_is_empty()) {
 			k_sem_take(&tracing_thread_sem, K_FOREVER);
 		} else {
+			/* With per-CPU buffers every claim returns the oldest
+			 * pending packet of all CPUs.
+			 */
 			transferring_length =
 				tracing_buffer_get_claim(
 						&transferring_buf,
@@ -118,6 +122,11 @@ SYS_INIT(tracing_init, APPLICATION, 0);
 #ifdef CONFIG_TRACING_ASYNC
 void tracing_trigger_output(bool before_put_is_empty)
 {
+	if (IS_ENABLED(CONFIG_TRACING_BUFFER_OVERWRITE)) {
+		/* Flight recorder buffers are only output on request. */
+		return;
+	}
+
 	if (before_put_is_empty) {
 		k_timer_start(&tracing_thread_timer,
 			      K_MSEC(CONFIG_TRACING_THREAD_WAIT_THRESHOLD),
@@ -129,6 +138,11 @@ bool is_tracing_thread(void)
 {
 	return (!k_is_in_isr() && (k_current_get() == tracing_thread_tid));
 }
+
+void tracing_flight_recorder_dump(void)
+{
+	k_sem_give(&tracing_thread_sem);
+}
 #endif
 
 bool is_tracing_enabled(void)
@@ -142,6 +156,10 @@ void tracing_cmd_handle(uint8_t *buf, uint32_t length)
 		tracing_set_state(TRACING_ENABLE);
 	} else if (strncmp(buf, TRACING_CMD_DISABLE, length) == 0) {
 		tracing_set_state(TRACING_DISABLE);
+#ifdef CONFIG_TRACING_ASYNC
+	} else if (strncmp(buf, TRACING_CMD_DUMP, length) == 0) {
+		tracing_flight_recorder_dump();
+#endif
 	}
 }
 
@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Demand paging benchmark.
+ *
+ * Maps an anonymous memory arena a few pages larger than the free page
+ * frames and touches its pages with several access patterns, reporting for
+ * each the page faults, evictions and eviction algorithm work per thousand
+ * accesses, and the average cost of an access and of a page fault. Run it
+ * once per eviction algorithm, read ahead setting and backing store to
+ * compare them.
+ */
+
+#include <zephyr.h>
+#include <tc_util.h>
+#include <timing/timing.h>
+#include <sys/mem_manage.h>
+
+#ifdef CONFIG_BACKING_STORE_RAM_COMPRESSED
+#define EXTRA_PAGES (CONFIG_BACKING_STORE_RAM_COMPRESSED_PAGES - 1)
+#else
+#define EXTRA_PAGES (CONFIG_BACKING_STORE_RAM_PAGES - 1)
+#endif
+#define N_ROUNDS 8
+#define STRIDE 3
+#define N_RANDOM 4096
+
+static volatile uint8_t *arena;
+static size_t arena_pages;
+
+/* The hot set is half of the free page frames */
+static size_t hot_pages;
+
+static uint32_t lcg_state = 1U;
+
+static uint32_t lcg_next(void)
+{
+	lcg_state = lcg_state * 1103515245U + 12345U;
+
+	return lcg_state >> 16;
+}
+
+static inline uint8_t page_touch(size_t page)
+{
+	return arena[page * CONFIG_MMU_PAGE_SIZE];
+}
+
+static size_t sequential(void)
+{
+	for (int round = 0; round < N_ROUNDS; round++) {
+		for (size_t page = 0; page < arena_pages; page++) {
+			(void)page_touch(page);
+		}
+	}
+
+	return N_ROUNDS * arena_pages;
+}
+
+static size_t strided(void)
+{
+	size_t accesses = 0;
+
+	for (int round = 0; round < N_ROUNDS; round++) {
+		for (size_t first = 0; first < STRIDE; first++) {
+			for (size_t page = first; page < arena_pages;
+			     page += STRIDE) {
+				(void)page_touch(page);
+				accesses++;
+			}
+		}
+	}
+
+	return accesses;
+}
+
+/* Nine accesses out of ten go to the hot set, the others anywhere */
+static size_t hot_cold(void)
+{
+	for (int i = 0; i < N_RANDOM; i++) {
+		uint32_t r = lcg_next();
+
+		if ((r % 10U) != 0U) {
+			(void)page_touch((r / 10U) % hot_pages);
+		} else {
+			(void)page_touch((r / 10U) % arena_pages);
+		}
+	}
+
+	return N_RANDOM;
+}
+
+static uint32_t fault_cycles_to_ns(uint64_t cycles)
+{
+	if (IS_ENABLED(CONFIG_DEMAND_PAGING_STATS_USING_TIMING_FUNCTIONS)) {
+		return (uint32_t)timing_cycles_to_ns(cycles);
+	}
+
+	return (uint32_t)k_cyc_to_ns_floor64(cycles);
+}
+
+static void pattern_run(const char *name, size_t (*pattern)(void))
+{
+	struct k_mem_paging_stats_t before, after;
+	unsigned long faults, evictions, scanned;
+	timing_t start, end;
+	uint64_t cycles;
+	size_t accesses;
+
+	k_mem_paging_stats_get(&before);
+
+	start = timing_counter_get();
+	accesses = pattern();
+	end = timing_counter_get();
+	cycles = timing_cycles_get(&start, &end);
+
+	k_mem_paging_stats_get(&after);
+
+	faults = after.pagefaults.cnt - before.pagefaults.cnt;
+	evictions = (after.eviction.clean + after.eviction.dirty) -
+		    (before.eviction.clean + before.eviction.dirty);
+	scanned = after.eviction.scanned - before.eviction.scanned;
+
+	TC_PRINT("%-12s %6zu accesses, %4lu faults/1000, %4lu evictions/1000, "
+		 "%5lu frames scanned/1000, %u ns/access\n", name, accesses,
+		 (unsigned long)(faults * 1000ULL / accesses),
+		 (unsigned long)(evictions * 1000ULL / accesses),
+		 (unsigned long)(scanned * 1000ULL / accesses),
+		 (uint32_t)(timing_cycles_to_ns(cycles) / accesses));
+	TC_PRINT("%-12s %lu pages given a second chance\n", "",
+		 after.eviction.second_chance - before.eviction.second_chance);
+	if (faults != 0UL) {
+		TC_PRINT("%-12s %u ns/fault\n", "", fault_cycles_to_ns(
+			 (after.pagefaults.cycles - before.pagefaults.cycles) /
+			 faults));
+	}
+#ifdef CONFIG_EVICTION_CLOCK_PRO
+	TC_PRINT("%-12s %lu promoted, %lu demoted, %lu refaults\n", "",
+		 after.eviction.promoted - before.eviction.promoted,
+		 after.eviction.demoted - before.eviction.demoted,
+		 after.eviction.refaults - before.eviction.refaults);
+#endif
+#ifdef CONFIG_DEMAND_PAGING_READ_AHEAD
+	TC_PRINT("%-12s %lu pages read ahead on %lu faults\n", "",
+		 after.read_ahead.pages - before.read_ahead.pages,
+		 after.read_ahead.triggers - before.read_ahead.triggers);
+#endif
+#ifdef CONFIG_BACKING_STORE_RAM_COMPRESSED
+	if (after.compression.bytes != 0UL) {
+		TC_PRINT("%-12s %lu pages stored, compression ratio %lu%%, "
+			 "%lu incompressible\n", "", after.compression.pages,
+			 after.compression.pages * CONFIG_MMU_PAGE_SIZE * 100UL /
+			 after.compression.bytes,
+			 after.compression.incompressible);
+	}
+#endif
+}
+
+void main(void)
+{
+	size_t free_pages = k_mem_free_get() / CONFIG_MMU_PAGE_SIZE;
+
+	timing_init();
+	timing_start();
+
+	TC_START("Demand paging benchmark");
+
+	arena_pages = free_pages + EXTRA_PAGES;
+	hot_pages = MAX(free_pages / 2U, 1U);
+	arena = k_mem_map(arena_pages * CONFIG_MMU_PAGE_SIZE, K_MEM_PERM_RW);
+	if (arena == NULL) {
+		TC_PRINT("failed to map %zu pages\n", arena_pages);
+		TC_END_REPORT(TC_FAIL);
+		return;
+	}
+
+	TC_PRINT("%s eviction%s%s, %zu free page frames, %zu pages mapped\n",
+		 IS_ENABLED(CONFIG_EVICTION_CLOCK_PRO) ? "Clock-Pro" :
+		 IS_ENABLED(CONFIG_EVICTION_CLOCK) ? "Clock" :
+		 IS_ENABLED(CONFIG_EVICTION_NRU) ? "NRU" : "custom",
+		 IS_ENABLED(CONFIG_DEMAND_PAGING_READ_AHEAD) ?
+		 " with read ahead" : "",
+		 IS_ENABLED(CONFIG_BACKING_STORE_RAM_COMPRESSED) ?
+		 ", compressed backing store" : "", free_pages, arena_pages);
+
+	/* Make every page dirty once so that later patterns only read */
+	for (size_t page = 0; page < arena_pages; page++) {
+		arena[page * CONFIG_MMU_PAGE_SIZE] = (uint8_t)page;
+	}
+
+	pattern_run("sequential", sequential);
+	pattern_run("strided", strided);
+	pattern_run("hot/cold", hot_cold);
+
+	timing_stop();
+	TC_END_REPORT(TC_PASS);
+}
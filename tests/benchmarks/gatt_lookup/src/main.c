@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * GATT attribute lookup benchmark.
+ *
+ * Registers dynamic services for a database of about 300 attributes and
+ * measures, without a radio, the GATT side of ATT requests:
+ *
+ * - read: resolving a handle and reading the attribute, as done for an
+ *   ATT Read Request, for handles at the start, middle and end of the
+ *   database.
+ * - handle: getting the handle of a static attribute, as done to send a
+ *   notification or an indication.
+ *
+ * CONFIG_BT_GATT_ATTR_INDEX makes both independent of the database size.
+ */
+
+#include <zephyr.h>
+#include <string.h>
+#include <tc_util.h>
+#include <timing/timing.h>
+#include <bluetooth/bluetooth.h>
+#include <bluetooth/gatt.h>
+
+#define N_ITERATIONS 1000
+#define N_SVCS 33
+#define N_CHRCS 4
+#define ATTRS_PER_SVC (1 + 2 * N_CHRCS)
+
+static struct bt_uuid_128 svc_uuid = BT_UUID_INIT_128(
+	0xf0, 0xde, 0xbc, 0x9a, 0x78, 0x56, 0x34, 0x12,
+	0x78, 0x56, 0x34, 0x12, 0x78, 0x56, 0x34, 0x12);
+static struct bt_uuid_128 chrc_uuid = BT_UUID_INIT_128(
+	0xf2, 0xde, 0xbc, 0x9a, 0x78, 0x56, 0x34, 0x12,
+	0x78, 0x56, 0x34, 0x12, 0x78, 0x56, 0x34, 0x12);
+
+static uint32_t chrc_value = 0x12345678;
+
+static ssize_t read_value(struct bt_conn *conn,
+			  const struct bt_gatt_attr *attr, void *buf,
+			  uint16_t len, uint16_t offset)
+{
+	return bt_gatt_attr_read(conn, attr, buf, len, offset,
+				 attr->user_data, sizeof(chrc_value));
+}
+
+static const struct bt_gatt_attr svc_template[] = {
+	BT_GATT_PRIMARY_SERVICE(&svc_uuid),
+	BT_GATT_CHARACTERISTIC(&chrc_uuid.uuid, BT_GATT_CHRC_READ,
+			       BT_GATT_PERM_READ, read_value, NULL,
+			       &chrc_value),
+	BT_GATT_CHARACTERISTIC(&chrc_uuid.uuid, BT_GATT_CHRC_READ,
+			       BT_GATT_PERM_READ, read_value, NULL,
+			       &chrc_value),
+	BT_GATT_CHARACTERISTIC(&chrc_uuid.uuid, BT_GATT_CHRC_READ,
+			       BT_GATT_PERM_READ, read_value, NULL,
+			       &chrc_value),
+	BT_GATT_CHARACTERISTIC(&chrc_uuid.uuid, BT_GATT_CHRC_READ,
+			       BT_GATT_PERM_READ, read_value, NULL,
+			       &chrc_value),
+};
+
+BUILD_ASSERT(ARRAY_SIZE(svc_template) == ATTRS_PER_SVC);
+
+static struct bt_gatt_attr svc_attrs[N_SVCS][ATTRS_PER_SVC];
+static struct bt_gatt_service svcs[N_SVCS];
+
+static int errors;
+
+struct read_data {
+	uint8_t buf[sizeof(chrc_value)];
+	ssize_t len;
+};
+
+static uint8_t read_cb(const struct bt_gatt_attr *attr, uint16_t handle,
+		       void *user_data)
+{
+	struct read_data *data = user_data;
+
+	data->len = attr->read(NULL, attr, data->buf, sizeof(data->buf), 0);
+
+	return BT_GATT_ITER_STOP;
+}
+
+static void read_run(const char *name, const struct bt_gatt_attr *attr)
+{
+	uint16_t handle = bt_gatt_attr_get_handle(attr);
+	struct read_data data;
+	timing_t start, end;
+	uint32_t avg;
+
+	start = timing_counter_get();
+	for (int i = 0; i < N_ITERATIONS; i++) {
+		data.len = 0;
+		bt_gatt_foreach_attr(handle, handle, read_cb, &data);
+		errors += (data.len != sizeof(chrc_value));
+	}
+	end = timing_counter_get();
+
+	avg = (uint32_t)(timing_cycles_get(&start, &end) / N_ITERATIONS);
+	TC_PRINT("read %-6s (0x%04x): %6u cycles, %7u ns\n", name, handle,
+		 avg, (uint32_t)timing_cycles_to_ns(avg));
+}
+
+static void handle_run(const char *name, const struct bt_gatt_attr *attr)
+{
+	uint16_t handle = 0;
+	timing_t start, end;
+	uint32_t avg;
+
+	start = timing_counter_get();
+	for (int i = 0; i < N_ITERATIONS; i++) {
+		handle = bt_gatt_attr_get_handle(attr);
+	}
+	end = timing_counter_get();
+
+	errors += (handle == 0U);
+
+	avg = (uint32_t)(timing_cycles_get(&start, &end) / N_ITERATIONS);
+	TC_PRINT("handle %-4s (0x%04x): %6u cycles, %7u ns\n", name, handle,
+		 avg, (uint32_t)timing_cycles_to_ns(avg));
+}
+
+void main(void)
+{
+	const struct bt_gatt_attr *sc;
+
+	timing_init();
+	timing_start();
+
+	TC_START("GATT attribute lookup benchmark");
+	TC_PRINT("%s\n", IS_ENABLED(CONFIG_BT_GATT_ATTR_INDEX) ?
+		 "attribute index" : "database walk");
+
+	for (int i = 0; i < N_SVCS; i++) {
+		memcpy(svc_attrs[i], svc_template, sizeof(svc_template));
+		svcs[i].attrs = svc_attrs[i];
+		svcs[i].attr_count = ATTRS_PER_SVC;
+		errors += (bt_gatt_service_register(&svcs[i]) != 0);
+	}
+
+	/* Characteristic values are the last attribute of each pair */
+	read_run("first", &svc_attrs[0][2]);
+	read_run("middle", &svc_attrs[N_SVCS / 2][2]);
+	read_run("last", &svc_attrs[N_SVCS - 1][ATTRS_PER_SVC - 1]);
+
+	sc = bt_gatt_find_by_uuid(NULL, 0, BT_UUID_GATT_SC);
+	if (sc != NULL) {
+		handle_run("sc", sc);
+	} else {
+		errors++;
+	}
+
+	timing_stop();
+
+	if (errors != 0) {
+		TC_PRINT("%d failed registrations or lookups\n", errors);
+	}
+	TC_END_REPORT(errors == 0 ? TC_PASS : TC_FAIL);
+}
@@ -0,0 +1,276 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * JSON benchmark.
+ *
+ * Decodes a small corpus of representative payloads, an LwM2M style
+ * resource report and a cloud device configuration, with both
+ * json_obj_parse() and the streaming decoder, and reports the average
+ * cost of each in cycles and bytes per microsecond. The streaming decoder
+ * is fed in MTU sized chunks as it would be from a network buffer.
+ *
+ * The decoded values are then encoded again, once sizing the output with
+ * json_calc_encoded_len() before json_obj_encode_buf(), and once with the
+ * single pass json_obj_encode_buf_len().
+ */
+
+#include <zephyr.h>
+#include <tc_util.h>
+#include <timing/timing.h>
+#include <data/json.h>
+
+#define N_ITERATIONS 256
+#define CHUNK_SIZE 64
+
+struct lwm2m_resource {
+	const char *n;
+	int v;
+	int t;
+};
+
+struct lwm2m_report {
+	const char *bn;
+	int bt;
+	struct lwm2m_resource e[8];
+	size_t e_len;
+};
+
+static const struct json_obj_descr lwm2m_resource_descr[] = {
+	JSON_OBJ_DESCR_PRIM(struct lwm2m_resource, n, JSON_TOK_STRING),
+	JSON_OBJ_DESCR_PRIM(struct lwm2m_resource, v, JSON_TOK_NUMBER),
+	JSON_OBJ_DESCR_PRIM(struct lwm2m_resource, t, JSON_TOK_NUMBER),
+};
+
+static const struct json_obj_descr lwm2m_report_descr[] = {
+	JSON_OBJ_DESCR_PRIM(struct lwm2m_report, bn, JSON_TOK_STRING),
+	JSON_OBJ_DESCR_PRIM(struct lwm2m_report, bt, JSON_TOK_NUMBER),
+	JSON_OBJ_DESCR_OBJ_ARRAY(struct lwm2m_report, e, 8, e_len,
+				 lwm2m_resource_descr,
+				 ARRAY_SIZE(lwm2m_resource_descr)),
+};
+
+static const char lwm2m_payload[] = "{\"bn\":\"/3303/0/\",\"bt\":1632000000,"
+	"\"e\":[{\"n\":\"5700\",\"v\":2150,\"t\":0},"
+	"{\"n\":\"5701\",\"v\":1,\"t\":0},"
+	"{\"n\":\"5601\",\"v\":1820,\"t\":-60},"
+	"{\"n\":\"5602\",\"v\":2470,\"t\":-60},"
+	"{\"n\":\"5603\",\"v\":-4000,\"t\":-120},"
+	"{\"n\":\"5604\",\"v\":8500,\"t\":-120}]}";
+
+struct cloud_config {
+	const char *device_id;
+	const char *firmware_url;
+	const char *server;
+	int report_interval;
+	int sample_interval;
+	int retries;
+	bool gps_enabled;
+	bool low_power;
+	int thresholds[4];
+	size_t thresholds_len;
+};
+
+static const struct json_obj_descr cloud_config_descr[] = {
+	JSON_OBJ_DESCR_PRIM(struct cloud_config, device_id, JSON_TOK_STRING),
+	JSON_OBJ_DESCR_PRIM(struct cloud_config, firmware_url,
+			    JSON_TOK_STRING),
+	JSON_OBJ_DESCR_PRIM(struct cloud_config, server, JSON_TOK_STRING),
+	JSON_OBJ_DESCR_PRIM(struct cloud_config, report_interval,
+			    JSON_TOK_NUMBER),
+	JSON_OBJ_DESCR_PRIM(struct cloud_config, sample_interval,
+			    JSON_TOK_NUMBER),
+	JSON_OBJ_DESCR_PRIM(struct cloud_config, retries, JSON_TOK_NUMBER),
+	JSON_OBJ_DESCR_PRIM(struct cloud_config, gps_enabled, JSON_TOK_TRUE),
+	JSON_OBJ_DESCR_PRIM(struct cloud_config, low_power, JSON_TOK_TRUE),
+	JSON_OBJ_DESCR_ARRAY(struct cloud_config, thresholds, 4,
+			     thresholds_len, JSON_TOK_NUMBER),
+};
+
+static const char cloud_config_payload[] = "{"
+	"\"device_id\":\"nrf-352656100367872\","
+	"\"firmware_url\":\"https://fota.example.com/images/app_update.bin"
+	"?token=ZXlKaGJHY2lPaUpJVXpJMU5pSXNJblI1Y0NJNklrcFhWQ0o5\","
+	"\"server\":\"coaps://lwm2m.example.com:5684\","
+	"\"report_interval\":3600,"
+	"\"sample_interval\":60,"
+	"\"retries\":3,"
+	"\"gps_enabled\":true,"
+	"\"low_power\":false,"
+	"\"thresholds\":[-20,0,35,85]"
+	"}";
+
+struct payload {
+	const char *name;
+	const char *json;
+	size_t len;
+	const struct json_obj_descr *descr;
+	size_t descr_len;
+	int expected;
+};
+
+static const struct payload corpus[] = {
+	{
+		.name = "lwm2m",
+		.json = lwm2m_payload,
+		.len = sizeof(lwm2m_payload) - 1,
+		.descr = lwm2m_report_descr,
+		.descr_len = ARRAY_SIZE(lwm2m_report_descr),
+		.expected = BIT_MASK(ARRAY_SIZE(lwm2m_report_descr)),
+	},
+	{
+		.name = "cloud config",
+		.json = cloud_config_payload,
+		.len = sizeof(cloud_config_payload) - 1,
+		.descr = cloud_config_descr,
+		.descr_len = ARRAY_SIZE(cloud_config_descr),
+		.expected = BIT_MASK(ARRAY_SIZE(cloud_config_descr)),
+	},
+};
+
+static union {
+	struct lwm2m_report lwm2m;
+	struct cloud_config cloud;
+} decoded;
+
+/* json_obj_parse() decodes in place, so it works on a copy */
+static char parse_buf[512];
+static char str_buf[512];
+static char encode_buf[512];
+
+static int bench_parse(const struct payload *p, uint64_t *cycles)
+{
+	timing_t start, end;
+	int ret;
+
+	memcpy(parse_buf, p->json, p->len);
+
+	start = timing_counter_get();
+	ret = json_obj_parse(parse_buf, p->len, p->descr, p->descr_len,
+			     &decoded);
+	end = timing_counter_get();
+
+	*cycles += timing_cycles_get(&start, &end);
+
+	return ret;
+}
+
+static int bench_stream(const struct payload *p, uint64_t *cycles)
+{
+	struct json_obj_stream stream;
+	timing_t start, end;
+	int ret = -EAGAIN;
+
+	start = timing_counter_get();
+	json_obj_stream_init(&stream, p->descr, p->descr_len, &decoded,
+			     str_buf, sizeof(str_buf));
+	for (size_t pos = 0; pos < p->len; pos += CHUNK_SIZE) {
+		ret = json_obj_stream_parse(&stream, &p->json[pos],
+					    MIN(CHUNK_SIZE, p->len - pos));
+	}
+	end = timing_counter_get();
+
+	*cycles += timing_cycles_get(&start, &end);
+
+	return ret;
+}
+
+static ssize_t bench_encode_two_pass(const struct payload *p,
+				     uint64_t *cycles)
+{
+	timing_t start, end;
+	ssize_t len;
+
+	start = timing_counter_get();
+	len = json_calc_encoded_len(p->descr, p->descr_len, &decoded);
+	if (len >= 0 && len < sizeof(encode_buf)) {
+		if (json_obj_encode_buf(p->descr, p->descr_len, &decoded,
+					encode_buf, sizeof(encode_buf)) < 0) {
+			len = -EINVAL;
+		}
+	}
+	end = timing_counter_get();
+
+	*cycles += timing_cycles_get(&start, &end);
+
+	return len;
+}
+
+static ssize_t bench_encode_single_pass(const struct payload *p,
+					uint64_t *cycles)
+{
+	timing_t start, end;
+	ssize_t len;
+
+	start = timing_counter_get();
+	len = json_obj_encode_buf_len(p->descr, p->descr_len, &decoded,
+				      encode_buf, sizeof(encode_buf));
+	end = timing_counter_get();
+
+	*cycles += timing_cycles_get(&start, &end);
+
+	return len;
+}
+
+static void report(const char *what, const struct payload *p,
+		   uint64_t cycles)
+{
+	uint32_t avg = (uint32_t)(cycles / N_ITERATIONS);
+	uint64_t ns = timing_cycles_to_ns(avg);
+
+	TC_PRINT("%-12s %-14s %6u cycles %6u ns %4u bytes/us\n", p->name,
+		 what, avg, (uint32_t)ns,
+		 ns ? (uint32_t)((uint64_t)p->len * NSEC_PER_USEC / ns) : 0U);
+}
+
+void main(void)
+{
+	int status = TC_PASS;
+
+	timing_init();
+	timing_start();
+
+	TC_START("JSON benchmark");
+
+	for (int i = 0; i < ARRAY_SIZE(corpus); i++) {
+		const struct payload *p = &corpus[i];
+		uint64_t parse_cycles = 0;
+		uint64_t stream_cycles = 0;
+		uint64_t two_pass_cycles = 0;
+		uint64_t single_pass_cycles = 0;
+
+		for (int n = 0; n < N_ITERATIONS; n++) {
+			if (bench_parse(p, &parse_cycles) != p->expected ||
+			    bench_stream(p, &stream_cycles) != p->expected) {
+				TC_PRINT("%s: decoding failed\n", p->name);
+				status = TC_FAIL;
+				break;
+			}
+		}
+
+		report("json_obj_parse", p, parse_cycles);
+		report("stream", p, stream_cycles);
+
+		for (int n = 0; n < N_ITERATIONS; n++) {
+			ssize_t two_pass, single_pass;
+
+			two_pass = bench_encode_two_pass(p, &two_pass_cycles);
+			single_pass = bench_encode_single_pass(
+				p, &single_pass_cycles);
+			if (two_pass < 0 || two_pass != single_pass) {
+				TC_PRINT("%s: encoding failed\n", p->name);
+				status = TC_FAIL;
+				break;
+			}
+		}
+
+		report("calc+encode", p, two_pass_cycles);
+		report("single pass", p, single_pass_cycles);
+	}
+
+	timing_stop();
+	TC_END_REPORT(status);
+}
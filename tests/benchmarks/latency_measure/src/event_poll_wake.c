@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file measure wakeup latency of multi-condition waits
+ *
+ * This file contains the test that measures the time from a thread posting
+ * one of several conditions to a higher priority thread waiting for any of
+ * them being back in execution. An event object is compared to the k_poll()
+ * pattern over a set of poll signals, where the waiter has to register the
+ * poll events and reset the raised signal on every iteration, and to
+ * k_poll() on the event object itself.
+ */
+
+#include <zephyr.h>
+#include <timing/timing.h>
+#include "utils.h"
+
+/* the number of wakeups measured for each pattern */
+#define N_TEST_WAKE 1000
+
+/* the number of conditions the waiter waits for */
+#define N_CONDITIONS 8
+
+#define STACK_SIZE (512 + CONFIG_TEST_EXTRA_STACKSIZE)
+/* stack used by the waiting thread */
+static K_THREAD_STACK_DEFINE(waiter_stack, STACK_SIZE);
+
+static struct k_thread waiter_data;
+
+static K_EVENT_DEFINE(wake_event);
+
+static struct k_poll_signal wake_signals[N_CONDITIONS];
+
+static timing_t timestamp_wake;
+
+static void event_waiter(void *p1, void *p2, void *p3)
+{
+	for (int i = 0; i < N_TEST_WAKE; i++) {
+		k_event_wait(&wake_event, BIT_MASK(N_CONDITIONS), true,
+			     K_FOREVER);
+		timestamp_wake = timing_counter_get();
+	}
+}
+
+static void signal_waiter(void *p1, void *p2, void *p3)
+{
+	struct k_poll_event events[N_CONDITIONS];
+	unsigned int signaled;
+	int result;
+
+	for (int i = 0; i < N_TEST_WAKE; i++) {
+		for (int j = 0; j < N_CONDITIONS; j++) {
+			k_poll_event_init(&events[j], K_POLL_TYPE_SIGNAL,
+					  K_POLL_MODE_NOTIFY_ONLY,
+					  &wake_signals[j]);
+		}
+
+		k_poll(events, N_CONDITIONS, K_FOREVER);
+		timestamp_wake = timing_counter_get();
+
+		for (int j = 0; j < N_CONDITIONS; j++) {
+			k_poll_signal_check(&wake_signals[j], &signaled,
+					    &result);
+			if (signaled != 0U) {
+				k_poll_signal_reset(&wake_signals[j]);
+			}
+		}
+	}
+}
+
+static void event_poll_waiter(void *p1, void *p2, void *p3)
+{
+	struct k_poll_event event;
+
+	for (int i = 0; i < N_TEST_WAKE; i++) {
+		k_poll_event_init(&event, K_POLL_TYPE_EVENTS,
+				  K_POLL_MODE_NOTIFY_ONLY, &wake_event);
+
+		k_poll(&event, 1, K_FOREVER);
+		timestamp_wake = timing_counter_get();
+
+		k_event_clear(&wake_event, BIT_MASK(N_CONDITIONS));
+	}
+}
+
+static void event_post(int i)
+{
+	k_event_post(&wake_event, BIT(i % N_CONDITIONS));
+}
+
+static void signal_raise(int i)
+{
+	k_poll_signal_raise(&wake_signals[i % N_CONDITIONS], i);
+}
+
+static void wake_measure(const char *tag, k_thread_entry_t waiter,
+			 void (*wake)(int i))
+{
+	uint32_t diff = 0;
+	timing_t timestamp_start;
+
+	bench_test_start();
+	timing_start();
+
+	/* The waiter preempts this thread each time it is woken up, and
+	 * blocks again before this thread resumes.
+	 */
+	k_thread_create(&waiter_data, waiter_stack, STACK_SIZE, waiter,
+			NULL, NULL, NULL, K_PRIO_PREEMPT(3), 0, K_NO_WAIT);
+	k_thread_name_set(&waiter_data, "wake_waiter");
+
+	for (int i = 0; i < N_TEST_WAKE; i++) {
+		timestamp_start = timing_counter_get();
+		wake(i);
+		diff += timing_cycles_get(&timestamp_start, &timestamp_wake);
+	}
+
+	k_thread_join(&waiter_data, K_FOREVER);
+
+	timing_stop();
+
+	if (bench_test_end() == 0) {
+		PRINT_STATS_AVG(tag, diff, N_TEST_WAKE);
+	} else {
+		error_count++;
+		PRINT_OVERFLOW_ERROR();
+	}
+}
+
+/**
+ *
+ * @brief The function tests the wakeup latency of multi-condition waits
+ *
+ * @return N/A
+ */
+void event_poll_wake(void)
+{
+	for (int i = 0; i < N_CONDITIONS; i++) {
+		k_poll_signal_init(&wake_signals[i]);
+	}
+
+	wake_measure("Average event wait wakeup time", event_waiter,
+		     event_post);
+	wake_measure("Average poll signals wakeup time", signal_waiter,
+		     signal_raise);
+	wake_measure("Average event poll wakeup time", event_poll_waiter,
+		     event_post);
+}
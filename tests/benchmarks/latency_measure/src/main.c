@@ -28,6 +28,7 @@ extern int sema_test(void);
 extern int sema_context_switch(void);
 extern int suspend_resume(void);
 extern void heap_malloc_free(void);
+extern void event_poll_wake(void);
 
 void test_thread(void *arg1, void *arg2, void *arg3)
 {
@@ -60,6 +61,8 @@ void test_thread(void *arg1, void *arg2, void *arg3)
 
 	heap_malloc_free();
 
+	event_poll_wake();
+
 	TC_END_REPORT(error_count);
 }
 
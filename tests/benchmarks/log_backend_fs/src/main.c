@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * File system log backend throughput benchmark.
+ *
+ * Formatted log lines are passed to the backend as the log output would,
+ * and the time taken and the number of flash program operations made by
+ * the flash simulator are reported for the configured batching and
+ * synchronization policy.
+ */
+
+#include <zephyr.h>
+#include <string.h>
+#include <tc_util.h>
+#include <stats/stats.h>
+#include <logging/log_backend_fs.h>
+
+#define BENCHMARK_LINES 1000
+
+int write_log_to_file(uint8_t *data, size_t length, void *ctx);
+
+static int flash_sim_write_calls_find(struct stats_hdr *hdr, void *arg,
+				      const char *name, uint16_t off)
+{
+	if (!strcmp(name, "flash_write_calls")) {
+		uint32_t **flash_write_stat = (uint32_t **) arg;
+		*flash_write_stat = (uint32_t *)((uint8_t *)hdr + off);
+	}
+
+	return 0;
+}
+
+void main(void)
+{
+	struct stats_hdr *sim_stats = stats_group_find("flash_sim_stats");
+	uint32_t *flash_write_stat = NULL;
+	uint32_t start, cycles, programs;
+	uint64_t elapsed_ns;
+	char line[48];
+	int status = TC_PASS;
+	int rc = 0;
+
+	TC_START("File system log backend throughput benchmark");
+
+	if (sim_stats) {
+		stats_walk(sim_stats, flash_sim_write_calls_find,
+			   &flash_write_stat);
+	}
+
+	if (!flash_write_stat) {
+		TC_PRINT("flash_write_calls statistic not found\n");
+		TC_END_REPORT(TC_FAIL);
+		return;
+	}
+
+	programs = *flash_write_stat;
+	start = k_cycle_get_32();
+
+	for (int i = 0; i < BENCHMARK_LINES; i++) {
+		int len = snprintk(line, sizeof(line),
+				   "[00:00:00.000,000] <inf> bench: line %d\r\n",
+				   i);
+
+		rc = write_log_to_file((uint8_t *)line, len, NULL);
+		if (rc != len) {
+			TC_PRINT("write failed: %d\n", rc);
+			status = TC_FAIL;
+			break;
+		}
+	}
+
+	if (status == TC_PASS) {
+		rc = log_backend_fs_flush();
+		if (rc != 0) {
+			TC_PRINT("flush failed: %d\n", rc);
+			status = TC_FAIL;
+		}
+	}
+
+	cycles = k_cycle_get_32() - start;
+	programs = *flash_write_stat - programs;
+	elapsed_ns = k_cyc_to_ns_floor64(cycles);
+
+	TC_PRINT("batch size: %d B, %u ns per line, %u lines/s, "
+		 "%u flash programs per %d lines\n",
+		 CONFIG_LOG_BACKEND_FS_BATCH_SIZE,
+		 (uint32_t)(elapsed_ns / BENCHMARK_LINES),
+		 elapsed_ns ? (uint32_t)((BENCHMARK_LINES *
+					  (uint64_t)NSEC_PER_SEC) / elapsed_ns) : 0,
+		 programs, BENCHMARK_LINES);
+
+	TC_END_REPORT(status);
+}
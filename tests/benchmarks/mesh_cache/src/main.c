@@ -0,0 +1,214 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Bluetooth mesh network cache benchmark.
+ *
+ * Feeds the network layer of a node, without a radio, with packets from as
+ * many sources as the Replay Protection List holds, in turn, as a relay of
+ * a large network sees them once the caches are full. For each packet, it
+ * measures:
+ *
+ * - decode: bt_mesh_net_decode(), which looks the packet up in the
+ *   duplicate and message caches, decrypts it and adds it to the caches.
+ * - duplicate: bt_mesh_net_decode() of the same packet again, as received
+ *   from another relay, which the duplicate cache rejects.
+ * - proxy: bt_mesh_net_decode() of the same packet received through the
+ *   GATT bearer, which is decrypted again unless
+ *   CONFIG_BT_MESH_NET_DECRYPT_CACHE is enabled.
+ * - rpl: bt_mesh_rpl_check() of the packet, which updates the entry of its
+ *   source.
+ * - replay: bt_mesh_rpl_check() of the packet again, which is rejected.
+ *
+ * The packets are sent on the last of several subnets, and the mesh
+ * statistics report the cryptographic operations done and saved.
+ */
+
+#include <zephyr.h>
+#include <string.h>
+#include <tc_util.h>
+#include <timing/timing.h>
+#include <bluetooth/bluetooth.h>
+#include <bluetooth/mesh.h>
+
+#include "mesh/net.h"
+#include "mesh/rpl.h"
+#include "mesh/subnet.h"
+
+#define N_PACKETS 4096
+#define N_SRCS CONFIG_BT_MESH_CRPL
+#define NET_IDX (CONFIG_BT_MESH_SUBNET_COUNT - 1)
+#define LOCAL_ADDR 0x0001
+#define FIRST_SRC 0x0100
+
+static const uint8_t net_key[16] = { 1, 2, 3 };
+static const uint8_t dev_key[16] = { 4, 5, 6 };
+static const uint8_t payload[8] = { 0xde, 0xad, 0xbe, 0xef };
+
+static struct bt_mesh_model models[] = {
+	BT_MESH_MODEL_CFG_SRV,
+};
+
+static struct bt_mesh_elem elems[] = {
+	BT_MESH_ELEM(0, models, BT_MESH_MODEL_NONE),
+};
+
+static const struct bt_mesh_comp comp = {
+	.elem = elems,
+	.elem_count = ARRAY_SIZE(elems),
+};
+
+static const struct bt_mesh_prov prov;
+
+enum {
+	DECODE,
+	DUPLICATE,
+	PROXY,
+	RPL,
+	REPLAY,
+	N_OPS,
+};
+
+static const char *const op_names[N_OPS] = {
+	"decode", "duplicate", "proxy", "rpl", "replay",
+};
+
+static uint64_t op_cycles[N_OPS];
+static int errors;
+
+static void packet_encode(struct net_buf_simple *buf, uint16_t src)
+{
+	struct bt_mesh_msg_ctx ctx = {
+		.net_idx = NET_IDX,
+		.app_idx = 0,
+		.addr = LOCAL_ADDR,
+		.send_ttl = 0,
+	};
+	struct bt_mesh_net_tx tx = {
+		.sub = bt_mesh_subnet_get(NET_IDX),
+		.ctx = &ctx,
+		.src = src,
+	};
+
+	net_buf_simple_reset(buf);
+	net_buf_simple_reserve(buf, BT_MESH_NET_HDR_LEN);
+	net_buf_simple_add_mem(buf, payload, sizeof(payload));
+
+	errors += (bt_mesh_net_encode(&tx, buf, false) != 0);
+}
+
+static void packet_receive(struct net_buf_simple *buf)
+{
+	NET_BUF_SIMPLE_DEFINE(copy, BT_MESH_NET_MAX_PDU_LEN);
+	NET_BUF_SIMPLE_DEFINE(proxy, BT_MESH_NET_MAX_PDU_LEN);
+	NET_BUF_SIMPLE_DEFINE(out, BT_MESH_NET_MAX_PDU_LEN);
+	struct bt_mesh_net_rx rx = { 0 };
+	timing_t start, end;
+	bool replay;
+	int err;
+
+	net_buf_simple_add_mem(&copy, buf->data, buf->len);
+	net_buf_simple_add_mem(&proxy, buf->data, buf->len);
+
+	start = timing_counter_get();
+	err = bt_mesh_net_decode(buf, BT_MESH_NET_IF_ADV, &rx, &out);
+	end = timing_counter_get();
+	op_cycles[DECODE] += timing_cycles_get(&start, &end);
+	errors += (err != 0);
+
+	start = timing_counter_get();
+	err = bt_mesh_net_decode(&copy, BT_MESH_NET_IF_ADV, &rx, &out);
+	end = timing_counter_get();
+	op_cycles[DUPLICATE] += timing_cycles_get(&start, &end);
+	errors += (err == 0);
+
+	start = timing_counter_get();
+	err = bt_mesh_net_decode(&proxy, BT_MESH_NET_IF_PROXY, &rx, &out);
+	end = timing_counter_get();
+	op_cycles[PROXY] += timing_cycles_get(&start, &end);
+	errors += (err != 0);
+
+	rx.local_match = 1U;
+
+	start = timing_counter_get();
+	replay = bt_mesh_rpl_check(&rx, NULL);
+	end = timing_counter_get();
+	op_cycles[RPL] += timing_cycles_get(&start, &end);
+	errors += replay;
+
+	start = timing_counter_get();
+	replay = bt_mesh_rpl_check(&rx, NULL);
+	end = timing_counter_get();
+	op_cycles[REPLAY] += timing_cycles_get(&start, &end);
+	errors += !replay;
+}
+
+void main(void)
+{
+	NET_BUF_SIMPLE_DEFINE(buf, BT_MESH_NET_MAX_PDU_LEN);
+	struct bt_mesh_statistic stat;
+	uint8_t key[16];
+	uint32_t avg;
+	int err;
+
+	timing_init();
+	timing_start();
+
+	TC_START("Bluetooth mesh network cache benchmark");
+	TC_PRINT("%u sources, RPL size %u, message cache size %u\n", N_SRCS,
+		 CONFIG_BT_MESH_CRPL, CONFIG_BT_MESH_MSG_CACHE_SIZE);
+	TC_PRINT("%u subnets, credential index %s, decryption cache %s\n",
+		 CONFIG_BT_MESH_SUBNET_COUNT,
+		 IS_ENABLED(CONFIG_BT_MESH_NET_CRED_INDEX) ? "on" : "off",
+		 IS_ENABLED(CONFIG_BT_MESH_NET_DECRYPT_CACHE) ? "on" : "off");
+
+	err = bt_mesh_init(&prov, &comp);
+	if (!err) {
+		err = bt_mesh_provision(net_key, 0, 0, 0, LOCAL_ADDR, dev_key);
+	}
+	for (uint16_t i = 1; !err && i < CONFIG_BT_MESH_SUBNET_COUNT; i++) {
+		memcpy(key, net_key, sizeof(key));
+		key[15] = i;
+		err = bt_mesh_subnet_add(i, key);
+	}
+	if (err) {
+		TC_PRINT("Mesh setup failed (err %d)\n", err);
+		TC_END_REPORT(TC_FAIL);
+		return;
+	}
+
+	/* Fill the caches, then measure */
+	for (int i = 0; i < N_SRCS; i++) {
+		packet_encode(&buf, FIRST_SRC + i);
+		packet_receive(&buf);
+	}
+
+	(void)memset(op_cycles, 0, sizeof(op_cycles));
+	bt_mesh_stat_reset();
+
+	for (int i = 0; i < N_PACKETS; i++) {
+		packet_encode(&buf, FIRST_SRC + (i % N_SRCS));
+		packet_receive(&buf);
+	}
+
+	for (int op = 0; op < N_OPS; op++) {
+		avg = (uint32_t)(op_cycles[op] / N_PACKETS);
+		TC_PRINT("%-10s %6u cycles, %7u ns\n", op_names[op], avg,
+			 (uint32_t)timing_cycles_to_ns(avg));
+	}
+
+	bt_mesh_stat_get(&stat);
+	TC_PRINT("deobfuscations %u, decryptions %u, cached %u\n",
+		 stat.net_deobfuscate, stat.net_decrypt,
+		 stat.net_decrypt_cached);
+
+	timing_stop();
+
+	if (errors != 0) {
+		TC_PRINT("%d unexpected results\n", errors);
+	}
+	TC_END_REPORT(errors == 0 ? TC_PASS : TC_FAIL);
+}
@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Message queue benchmark.
+ *
+ * Measures the throughput, in messages per second, of a regular message
+ * queue and of a single-producer/single-consumer one:
+ *
+ * - put/get: a thread puts a message and gets it back, the queue is never
+ *   full nor empty when it is used, which is the lock-free path of the
+ *   SPSC mode.
+ * - isr->thread: an ISR puts a batch of messages which a thread then gets.
+ * - thread->thread: a producer thread streams messages to a consumer
+ *   thread of lower priority, so that the producer sleeps on a full queue
+ *   and is woken up by the consumer.
+ */
+
+#include <zephyr.h>
+#include <tc_util.h>
+#include <timing/timing.h>
+#include <irq_offload.h>
+
+#define N_MSGS 10000
+#define QUEUE_LEN 16
+#define BATCH 8
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACKSIZE)
+
+struct msg {
+	uint32_t seq;
+	uint32_t value;
+};
+
+static char __aligned(4) queue_buf[QUEUE_LEN * sizeof(struct msg)];
+static struct k_msgq queue;
+
+static K_THREAD_STACK_DEFINE(producer_stack, STACK_SIZE);
+static struct k_thread producer_thread;
+
+static int errors;
+
+static void queue_init(bool spsc)
+{
+	if (spsc) {
+		k_msgq_spsc_init(&queue, queue_buf, sizeof(struct msg),
+				 QUEUE_LEN);
+	} else {
+		k_msgq_init(&queue, queue_buf, sizeof(struct msg), QUEUE_LEN);
+	}
+}
+
+static void msg_check(struct msg *msg, uint32_t seq)
+{
+	if (msg->seq != seq || msg->value != ~seq) {
+		errors++;
+	}
+}
+
+static void put_get(void)
+{
+	struct msg msg;
+
+	for (uint32_t i = 0; i < N_MSGS; i++) {
+		msg.seq = i;
+		msg.value = ~i;
+		errors += (k_msgq_put(&queue, &msg, K_NO_WAIT) != 0);
+		errors += (k_msgq_get(&queue, &msg, K_NO_WAIT) != 0);
+		msg_check(&msg, i);
+	}
+}
+
+static void isr_put_batch(const void *arg)
+{
+	uint32_t first = POINTER_TO_UINT(arg);
+	struct msg msg;
+
+	for (uint32_t i = first; i < first + BATCH; i++) {
+		msg.seq = i;
+		msg.value = ~i;
+		errors += (k_msgq_put(&queue, &msg, K_NO_WAIT) != 0);
+	}
+}
+
+static void isr_to_thread(void)
+{
+	struct msg msg;
+
+	for (uint32_t i = 0; i < N_MSGS; i += BATCH) {
+		irq_offload(isr_put_batch, UINT_TO_POINTER(i));
+		for (uint32_t j = i; j < i + BATCH; j++) {
+			errors += (k_msgq_get(&queue, &msg, K_NO_WAIT) != 0);
+			msg_check(&msg, j);
+		}
+	}
+}
+
+static void producer_entry(void *p1, void *p2, void *p3)
+{
+	struct msg msg;
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (uint32_t i = 0; i < N_MSGS; i++) {
+		msg.seq = i;
+		msg.value = ~i;
+		errors += (k_msgq_put(&queue, &msg, K_FOREVER) != 0);
+	}
+}
+
+static void thread_to_thread(void)
+{
+	struct msg msg;
+
+	k_thread_create(&producer_thread, producer_stack, STACK_SIZE,
+			producer_entry, NULL, NULL, NULL,
+			CONFIG_MAIN_THREAD_PRIORITY - 1, 0, K_NO_WAIT);
+
+	for (uint32_t i = 0; i < N_MSGS; i++) {
+		errors += (k_msgq_get(&queue, &msg, K_FOREVER) != 0);
+		msg_check(&msg, i);
+	}
+
+	k_thread_join(&producer_thread, K_FOREVER);
+}
+
+static void pattern_run(const char *name, void (*pattern)(void))
+{
+	uint64_t ns[2];
+	timing_t start, end;
+
+	for (int spsc = 0; spsc < 2; spsc++) {
+		queue_init(spsc);
+
+		start = timing_counter_get();
+		pattern();
+		end = timing_counter_get();
+
+		ns[spsc] = MAX(timing_cycles_to_ns(timing_cycles_get(&start,
+								      &end)),
+			       1ULL);
+	}
+
+	TC_PRINT("%-15s k_msgq %8u msgs/s, SPSC k_msgq %8u msgs/s\n", name,
+		 (uint32_t)(N_MSGS * 1000000000ULL / ns[0]),
+		 (uint32_t)(N_MSGS * 1000000000ULL / ns[1]));
+}
+
+void main(void)
+{
+	timing_init();
+	timing_start();
+
+	TC_START("Message queue benchmark");
+
+	pattern_run("put/get", put_get);
+	pattern_run("isr->thread", isr_to_thread);
+	pattern_run("thread->thread", thread_to_thread);
+
+	timing_stop();
+
+	if (errors != 0) {
+		TC_PRINT("%d lost or corrupted messages\n", errors);
+	}
+	TC_END_REPORT(errors == 0 ? TC_PASS : TC_FAIL);
+}
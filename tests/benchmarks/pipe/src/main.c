@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Pipe benchmark.
+ *
+ * Streams blocks of data from a producer thread to a consumer thread
+ * through a pipe and reports the throughput, for several block sizes:
+ *
+ * - copy: the producer fills a block and writes it with k_pipe_put(), the
+ *   consumer reads it with k_pipe_get() and then checks it.
+ * - claim: the producer fills the pipe's buffer in place and the consumer
+ *   checks the data in place, using the claim and commit APIs.
+ *
+ * The producer has a higher priority than the consumer so that it waits
+ * on a full pipe, as when a fast source feeds a slower sink.
+ */
+
+#include <zephyr.h>
+#include <tc_util.h>
+#include <timing/timing.h>
+
+#define STREAM_LEN (64 * 1024)
+#define PIPE_LEN 1024
+#define MAX_BLOCK 256
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACKSIZE)
+
+K_PIPE_DEFINE(bench_pipe, PIPE_LEN, 4);
+
+static K_THREAD_STACK_DEFINE(producer_stack, STACK_SIZE);
+static struct k_thread producer_thread;
+
+static size_t block_len;
+static int errors;
+
+static void block_fill(uint8_t *block, size_t offset, size_t len)
+{
+	for (size_t i = 0; i < len; i++) {
+		block[i] = (uint8_t)(offset + i);
+	}
+}
+
+static void block_check(const uint8_t *block, size_t offset, size_t len)
+{
+	for (size_t i = 0; i < len; i++) {
+		if (block[i] != (uint8_t)(offset + i)) {
+			errors++;
+			return;
+		}
+	}
+}
+
+static void copy_producer(void *p1, void *p2, void *p3)
+{
+	static uint8_t block[MAX_BLOCK];
+	size_t written;
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (size_t offset = 0; offset < STREAM_LEN; offset += block_len) {
+		block_fill(block, offset, block_len);
+		errors += (k_pipe_put(&bench_pipe, block, block_len, &written,
+				      block_len, K_FOREVER) != 0);
+	}
+}
+
+static void copy_consumer(void)
+{
+	static uint8_t block[MAX_BLOCK];
+	size_t read;
+
+	for (size_t offset = 0; offset < STREAM_LEN; offset += block_len) {
+		errors += (k_pipe_get(&bench_pipe, block, block_len, &read,
+				      block_len, K_FOREVER) != 0);
+		block_check(block, offset, block_len);
+	}
+}
+
+static void claim_producer(void *p1, void *p2, void *p3)
+{
+	uint8_t *block;
+	size_t claimed;
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (size_t offset = 0; offset < STREAM_LEN; offset += claimed) {
+		if (k_pipe_put_claim(&bench_pipe, &block, block_len, &claimed,
+				     K_FOREVER) != 0) {
+			errors++;
+			return;
+		}
+		block_fill(block, offset, claimed);
+		errors += (k_pipe_put_commit(&bench_pipe, claimed) != 0);
+	}
+}
+
+static void claim_consumer(void)
+{
+	uint8_t *block;
+	size_t claimed;
+
+	for (size_t offset = 0; offset < STREAM_LEN; offset += claimed) {
+		if (k_pipe_get_claim(&bench_pipe, &block, block_len, &claimed,
+				     K_FOREVER) != 0) {
+			errors++;
+			return;
+		}
+		block_check(block, offset, claimed);
+		errors += (k_pipe_get_commit(&bench_pipe, claimed) != 0);
+	}
+}
+
+static uint32_t stream_run(k_thread_entry_t producer, void (*consumer)(void))
+{
+	timing_t start, end;
+	uint64_t ns;
+
+	start = timing_counter_get();
+
+	k_thread_create(&producer_thread, producer_stack, STACK_SIZE, producer,
+			NULL, NULL, NULL, CONFIG_MAIN_THREAD_PRIORITY - 1, 0,
+			K_NO_WAIT);
+	consumer();
+	k_thread_join(&producer_thread, K_FOREVER);
+
+	end = timing_counter_get();
+	ns = MAX(timing_cycles_to_ns(timing_cycles_get(&start, &end)), 1ULL);
+
+	/* KiB per second */
+	return (uint32_t)(STREAM_LEN * 1000000000ULL / ns / 1024U);
+}
+
+void main(void)
+{
+	static const size_t block_lens[] = { 16, 64, 256 };
+	uint32_t copy, claim;
+
+	timing_init();
+	timing_start();
+
+	TC_START("Pipe benchmark");
+
+	for (int i = 0; i < ARRAY_SIZE(block_lens); i++) {
+		block_len = block_lens[i];
+		copy = stream_run(copy_producer, copy_consumer);
+		claim = stream_run(claim_producer, claim_consumer);
+
+		TC_PRINT("%3zu byte blocks: copy %7u KiB/s, claim %7u KiB/s\n",
+			 block_len, copy, claim);
+	}
+
+	timing_stop();
+
+	if (errors != 0) {
+		TC_PRINT("%d failed transfers or corrupted blocks\n", errors);
+	}
+	TC_END_REPORT(errors == 0 ? TC_PASS : TC_FAIL);
+}
@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * POSIX synchronization benchmark.
+ *
+ * Measures the cost of uncontended pthread mutex, read-write lock and
+ * thread-specific data operations, then runs one pthread per CPU, each
+ * locking and unlocking its own mutex, to show how unrelated mutexes
+ * scale on SMP.
+ */
+
+#include <zephyr.h>
+#include <tc_util.h>
+#include <timing/timing.h>
+#include <pthread.h>
+
+#define N_OPS 1000
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACKSIZE)
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, CONFIG_MP_NUM_CPUS, STACK_SIZE);
+
+static pthread_mutex_t mutexes[CONFIG_MP_NUM_CPUS];
+static pthread_rwlock_t rwlock;
+static pthread_key_t key;
+static PTHREAD_BARRIER_DEFINE(start_barrier, CONFIG_MP_NUM_CPUS);
+
+static uint64_t thread_cycles[CONFIG_MP_NUM_CPUS];
+
+static void print_avg(const char *name, timing_t *start, timing_t *end)
+{
+	uint32_t cycles = (uint32_t)(timing_cycles_get(start, end) / N_OPS);
+
+	TC_PRINT("%-28s: %6u cycles, %6u ns\n", name, cycles,
+		 (uint32_t)timing_cycles_to_ns(cycles));
+}
+
+static void *single_thread(void *arg)
+{
+	pthread_mutex_t *mutex = &mutexes[0];
+	timing_t start, end;
+	void *value = NULL;
+
+	ARG_UNUSED(arg);
+
+	start = timing_counter_get();
+	for (int i = 0; i < N_OPS; i++) {
+		pthread_mutex_lock(mutex);
+		pthread_mutex_unlock(mutex);
+	}
+	end = timing_counter_get();
+	print_avg("mutex lock/unlock", &start, &end);
+
+	start = timing_counter_get();
+	for (int i = 0; i < N_OPS; i++) {
+		pthread_rwlock_rdlock(&rwlock);
+		pthread_rwlock_unlock(&rwlock);
+	}
+	end = timing_counter_get();
+	print_avg("rwlock rdlock/unlock", &start, &end);
+
+	start = timing_counter_get();
+	for (int i = 0; i < N_OPS; i++) {
+		pthread_rwlock_wrlock(&rwlock);
+		pthread_rwlock_unlock(&rwlock);
+	}
+	end = timing_counter_get();
+	print_avg("rwlock wrlock/unlock", &start, &end);
+
+	start = timing_counter_get();
+	for (int i = 0; i < N_OPS; i++) {
+		pthread_setspecific(key, INT_TO_POINTER(i));
+	}
+	end = timing_counter_get();
+	print_avg("pthread_setspecific", &start, &end);
+
+	start = timing_counter_get();
+	for (int i = 0; i < N_OPS; i++) {
+		value = pthread_getspecific(key);
+	}
+	end = timing_counter_get();
+	print_avg("pthread_getspecific", &start, &end);
+
+	if (value != INT_TO_POINTER(N_OPS - 1)) {
+		TC_PRINT("unexpected thread-specific value %p\n", value);
+	}
+
+	return NULL;
+}
+
+static void *scaling_thread(void *arg)
+{
+	int id = POINTER_TO_INT(arg);
+	pthread_mutex_t *mutex = &mutexes[id];
+	timing_t start, end;
+
+	pthread_barrier_wait(&start_barrier);
+
+	start = timing_counter_get();
+	for (int i = 0; i < N_OPS; i++) {
+		pthread_mutex_lock(mutex);
+		pthread_mutex_unlock(mutex);
+	}
+	end = timing_counter_get();
+
+	thread_cycles[id] = timing_cycles_get(&start, &end);
+
+	return NULL;
+}
+
+static void run(void *(*entry)(void *), int n_threads)
+{
+	pthread_t threads[CONFIG_MP_NUM_CPUS];
+	pthread_attr_t attr;
+
+	for (int i = 0; i < n_threads; i++) {
+		pthread_attr_init(&attr);
+		pthread_attr_setstack(&attr, &stacks[i][0], STACK_SIZE);
+		pthread_create(&threads[i], &attr, entry, INT_TO_POINTER(i));
+	}
+
+	for (int i = 0; i < n_threads; i++) {
+		pthread_join(threads[i], NULL);
+	}
+}
+
+void main(void)
+{
+	uint64_t total = 0;
+
+	timing_init();
+	timing_start();
+
+	TC_START("POSIX benchmark");
+	TC_PRINT("%d CPUs, %d operations per measure\n", CONFIG_MP_NUM_CPUS,
+		 N_OPS);
+
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		pthread_mutex_init(&mutexes[i], NULL);
+	}
+	pthread_rwlock_init(&rwlock, NULL);
+	pthread_key_create(&key, NULL);
+
+	run(single_thread, 1);
+
+	run(scaling_thread, CONFIG_MP_NUM_CPUS);
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		total += thread_cycles[i];
+	}
+	total /= CONFIG_MP_NUM_CPUS * N_OPS;
+	TC_PRINT("%-28s: %6u cycles, %6u ns\n", "per-CPU mutex lock/unlock",
+		 (uint32_t)total, (uint32_t)timing_cycles_to_ns(total));
+
+	pthread_key_delete(key);
+
+	timing_stop();
+	TC_END_REPORT(TC_PASS);
+}
@@ -0,0 +1,191 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Read-mostly data benchmark.
+ *
+ * One thread per CPU looks up entries of a shared table, protected in turn
+ * by a spinlock, a reader-writer spinlock and read-copy-update, while the
+ * table is updated now and then.  The cost of a lookup shows how well each
+ * primitive scales with the number of CPUs reading at the same time.
+ */
+
+#include <zephyr.h>
+#include <tc_util.h>
+#include <timing/timing.h>
+
+#define N_LOOKUPS 10000
+#define N_ENTRIES 16
+#define UPDATE_PERIOD 1000
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACKSIZE)
+
+struct table {
+	uint32_t entries[N_ENTRIES];
+};
+
+enum method {
+	METHOD_SPINLOCK,
+	METHOD_RWSPINLOCK,
+	METHOD_RCU,
+};
+
+static const char *const method_names[] = {
+	[METHOD_SPINLOCK] = "k_spinlock",
+	[METHOD_RWSPINLOCK] = "k_rwspinlock",
+	[METHOD_RCU] = "rcu",
+};
+
+static K_THREAD_STACK_ARRAY_DEFINE(reader_stacks, CONFIG_MP_NUM_CPUS,
+				   STACK_SIZE);
+static struct k_thread reader_threads[CONFIG_MP_NUM_CPUS];
+static K_SEM_DEFINE(start_sem, 0, CONFIG_MP_NUM_CPUS);
+static K_SEM_DEFINE(done_sem, 0, CONFIG_MP_NUM_CPUS);
+static atomic_t ready;
+
+static struct k_spinlock lock;
+static struct k_rwspinlock rwlock;
+static struct table tables[2];
+static struct table *current_table = &tables[0];
+static struct k_spinlock update_lock;
+
+static enum method method;
+static uint64_t reader_cycles[CONFIG_MP_NUM_CPUS];
+static uint32_t checksums[CONFIG_MP_NUM_CPUS];
+
+static uint32_t lookup(int i)
+{
+	k_spinlock_key_t key;
+	k_rcu_key_t rcu_key;
+	uint32_t value;
+
+	switch (method) {
+	case METHOD_SPINLOCK:
+		key = k_spin_lock(&lock);
+		value = current_table->entries[i % N_ENTRIES];
+		k_spin_unlock(&lock, key);
+		break;
+	case METHOD_RWSPINLOCK:
+		key = k_rwspin_read_lock(&rwlock);
+		value = current_table->entries[i % N_ENTRIES];
+		k_rwspin_read_unlock(&rwlock, key);
+		break;
+	default:
+		rcu_key = k_rcu_read_lock();
+		value = k_rcu_dereference(current_table)->entries[i % N_ENTRIES];
+		k_rcu_read_unlock(rcu_key);
+		break;
+	}
+
+	return value;
+}
+
+/* Replace the table with a copy where one entry changed */
+static void update(int i)
+{
+	k_spinlock_key_t key;
+	struct table *old, *new;
+
+	switch (method) {
+	case METHOD_SPINLOCK:
+		key = k_spin_lock(&lock);
+		current_table->entries[i % N_ENTRIES]++;
+		k_spin_unlock(&lock, key);
+		break;
+	case METHOD_RWSPINLOCK:
+		key = k_rwspin_write_lock(&rwlock);
+		current_table->entries[i % N_ENTRIES]++;
+		k_rwspin_write_unlock(&rwlock, key);
+		break;
+	default:
+		/* Writers serialize among themselves, not with readers */
+		key = k_spin_lock(&update_lock);
+		old = current_table;
+		new = old == &tables[0] ? &tables[1] : &tables[0];
+		*new = *old;
+		new->entries[i % N_ENTRIES]++;
+		k_rcu_assign_pointer(current_table, new);
+		k_spin_unlock(&update_lock, key);
+
+		/* The old table is reused by the next update */
+		k_rcu_synchronize();
+		break;
+	}
+}
+
+static void reader(void *p1, void *p2, void *p3)
+{
+	int id = POINTER_TO_INT(p1);
+	timing_t start, end;
+	uint32_t sum;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (true) {
+		k_sem_take(&start_sem, K_FOREVER);
+
+		/* Start all the readers at the same time */
+		atomic_inc(&ready);
+		while (atomic_get(&ready) < CONFIG_MP_NUM_CPUS) {
+		}
+
+		sum = 0;
+		start = timing_counter_get();
+		for (int i = 0; i < N_LOOKUPS; i++) {
+			sum += lookup(i);
+			if (id == 0 && (i % UPDATE_PERIOD) == 0) {
+				update(i / UPDATE_PERIOD);
+			}
+		}
+		end = timing_counter_get();
+
+		reader_cycles[id] = timing_cycles_get(&start, &end);
+		checksums[id] = sum;
+		k_sem_give(&done_sem);
+	}
+}
+
+void main(void)
+{
+	uint64_t total;
+
+	timing_init();
+	timing_start();
+
+	TC_START("Read-mostly data benchmark");
+	TC_PRINT("%d CPUs, %d lookups per CPU, one update every %d\n",
+		 CONFIG_MP_NUM_CPUS, N_LOOKUPS, UPDATE_PERIOD);
+
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		k_thread_create(&reader_threads[i], reader_stacks[i],
+				STACK_SIZE, reader, INT_TO_POINTER(i),
+				NULL, NULL, K_PRIO_PREEMPT(5), 0, K_NO_WAIT);
+	}
+
+	for (method = METHOD_SPINLOCK; method <= METHOD_RCU; method++) {
+		atomic_clear(&ready);
+
+		for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+			k_sem_give(&start_sem);
+		}
+		for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+			k_sem_take(&done_sem, K_FOREVER);
+		}
+
+		total = 0;
+		for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+			total += reader_cycles[i];
+		}
+		total /= CONFIG_MP_NUM_CPUS * N_LOOKUPS;
+
+		TC_PRINT("%-12s: %6u cycles, %6u ns per lookup\n",
+			 method_names[method], (uint32_t)total,
+			 (uint32_t)timing_cycles_to_ns(total));
+	}
+
+	timing_stop();
+	TC_END_REPORT(TC_PASS);
+}
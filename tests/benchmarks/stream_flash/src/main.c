@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Stream flash throughput benchmark.
+ *
+ * Simulates a firmware download: chunks arrive from the "network" at a
+ * fixed interval and are written with stream_flash_buffered_write() to the
+ * flash simulator, which simulates erase and program times. The download
+ * is done once with synchronous writes and once with asynchronous double
+ * buffered writes, and the resulting throughput and the time the receiving
+ * thread spent blocked in writes are reported for both.
+ */
+
+#include <zephyr.h>
+#include <tc_util.h>
+#include <drivers/flash.h>
+#include <storage/stream_flash.h>
+
+#define FLASH_SIM_NODE DT_INST(0, zephyr_sim_flash)
+#define IMAGE_SIZE (64 * 1024)
+#define CHUNK_SIZE 256
+#define CHUNK_INTERVAL_US 500
+#define BUF_LEN 512
+
+static uint8_t chunk[CHUNK_SIZE];
+static uint8_t buf[BUF_LEN];
+static uint8_t async_buf[BUF_LEN];
+static struct stream_flash_ctx ctx;
+
+static int download(const struct device *fdev, bool async,
+		    uint32_t *total_us, uint32_t *blocked_us)
+{
+	uint32_t start, blocked = 0;
+	int rc;
+
+	rc = stream_flash_init(&ctx, fdev, buf, BUF_LEN, 0, IMAGE_SIZE, NULL);
+	if (rc == 0 && async) {
+		rc = stream_flash_async_enable(&ctx, async_buf);
+	}
+
+	if (rc != 0) {
+		return rc;
+	}
+
+	start = k_cycle_get_32();
+
+	for (size_t off = 0; off < IMAGE_SIZE; off += CHUNK_SIZE) {
+		bool last = (off + CHUNK_SIZE == IMAGE_SIZE);
+		uint32_t write_start;
+
+		/* Wait for the next chunk to be received */
+		k_usleep(CHUNK_INTERVAL_US);
+
+		write_start = k_cycle_get_32();
+		rc = stream_flash_buffered_write(&ctx, chunk, CHUNK_SIZE,
+						 last);
+		blocked += k_cycle_get_32() - write_start;
+
+		if (rc != 0) {
+			return rc;
+		}
+	}
+
+	*total_us = k_cyc_to_us_floor32(k_cycle_get_32() - start);
+	*blocked_us = k_cyc_to_us_floor32(blocked);
+
+	return 0;
+}
+
+void main(void)
+{
+	const struct device *fdev = device_get_binding(DT_LABEL(FLASH_SIM_NODE));
+	int status = TC_PASS;
+
+	TC_START("Stream flash throughput benchmark");
+	TC_PRINT("%u KiB image in %u byte chunks every %u us\n",
+		 IMAGE_SIZE / 1024, CHUNK_SIZE, CHUNK_INTERVAL_US);
+
+	memset(chunk, 0xa5, sizeof(chunk));
+
+	for (int async = 0; async < 2; async++) {
+		uint32_t total_us, blocked_us;
+		int rc;
+
+		rc = download(fdev, async, &total_us, &blocked_us);
+		if (rc != 0) {
+			TC_PRINT("download failed: %d\n", rc);
+			status = TC_FAIL;
+			break;
+		}
+
+		TC_PRINT("%-5s: %6u us, %4u KiB/s, blocked in writes %6u us\n",
+			 async ? "async" : "sync", total_us,
+			 (uint32_t)((uint64_t)IMAGE_SIZE * USEC_PER_SEC /
+				    1024 / total_us), blocked_us);
+	}
+
+	TC_END_REPORT(status);
+}
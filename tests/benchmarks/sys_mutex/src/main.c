@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * sys_mutex benchmark.
+ *
+ * Measures the average cost of an uncontended sys_mutex lock/unlock pair,
+ * first from a supervisor thread and then from a user mode thread, which
+ * is where CONFIG_SYS_MUTEX_FAST_PATH avoids the system calls. The user
+ * thread is timed from the supervisor thread that starts it, as the
+ * timing functions are not available in user mode.
+ */
+
+#include <zephyr.h>
+#include <tc_util.h>
+#include <timing/timing.h>
+#include <sys/mutex.h>
+#include <app_memory/app_memdomain.h>
+
+#define N_ITERATIONS 10000
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACKSIZE)
+
+K_APPMEM_PARTITION_DEFINE(bench_partition);
+K_APP_DMEM(bench_partition) SYS_MUTEX_DEFINE(bench_mutex);
+K_APP_DMEM(bench_partition) static int user_errors;
+
+static struct k_mem_domain bench_domain;
+static K_THREAD_STACK_DEFINE(user_stack, STACK_SIZE);
+static struct k_thread user_thread;
+static K_SEM_DEFINE(start_sem, 0, 1);
+static K_SEM_DEFINE(done_sem, 0, 1);
+
+static int lock_unlock_loop(void)
+{
+	int errors = 0;
+
+	for (int i = 0; i < N_ITERATIONS; i++) {
+		errors += (sys_mutex_lock(&bench_mutex, K_FOREVER) != 0);
+		errors += (sys_mutex_unlock(&bench_mutex) != 0);
+	}
+
+	return errors;
+}
+
+static void user_entry(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	k_sem_take(&start_sem, K_FOREVER);
+	user_errors = lock_unlock_loop();
+	k_sem_give(&done_sem);
+}
+
+static void report(const char *mode, uint64_t cycles)
+{
+	uint32_t avg = (uint32_t)(cycles / N_ITERATIONS);
+
+	TC_PRINT("%-10s lock+unlock: %5u cycles, %6u ns\n", mode, avg,
+		 (uint32_t)timing_cycles_to_ns(avg));
+}
+
+void main(void)
+{
+	struct k_mem_partition *parts[] = { &bench_partition };
+	timing_t start, end;
+	int status = TC_PASS;
+	int errors;
+
+	timing_init();
+	timing_start();
+
+	TC_START("sys_mutex benchmark");
+	TC_PRINT("%s\n", IS_ENABLED(CONFIG_SYS_MUTEX_FAST_PATH) ?
+		 "user mode fast path" : "system call per operation");
+
+	start = timing_counter_get();
+	errors = lock_unlock_loop();
+	end = timing_counter_get();
+	report("supervisor", timing_cycles_get(&start, &end));
+
+	k_mem_domain_init(&bench_domain, ARRAY_SIZE(parts), parts);
+	k_thread_create(&user_thread, user_stack, STACK_SIZE, user_entry,
+			NULL, NULL, NULL, K_PRIO_PREEMPT(5),
+			K_USER | K_INHERIT_PERMS, K_FOREVER);
+	k_mem_domain_add_thread(&bench_domain, &user_thread);
+	k_thread_access_grant(&user_thread, &bench_mutex, &start_sem,
+			      &done_sem);
+	k_thread_start(&user_thread);
+
+	start = timing_counter_get();
+	k_sem_give(&start_sem);
+	k_sem_take(&done_sem, K_FOREVER);
+	end = timing_counter_get();
+	report("user", timing_cycles_get(&start, &end));
+
+	if (errors != 0 || user_errors != 0) {
+		TC_PRINT("lock/unlock failures: %d supervisor, %d user\n",
+			 errors, user_errors);
+		status = TC_FAIL;
+	}
+
+	timing_stop();
+	TC_END_REPORT(status);
+}
@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Tracing buffer benchmark.
+ *
+ * One thread per CPU emits bursts of CTF sized raw tracing packets at the
+ * same time and measures the cost of each put with the timing subsystem.
+ * Between bursts the tracing thread is given time to drain the buffers,
+ * except in flight recorder mode where the buffers simply wrap.
+ */
+
+#include <zephyr.h>
+#include <tc_util.h>
+#include <timing/timing.h>
+#include <tracing/tracing_format.h>
+#include <tracing_buffer.h>
+
+#define N_ROUNDS 16
+#define N_EVENTS 32
+#define EVENT_SIZE 16
+
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACKSIZE)
+
+static K_THREAD_STACK_ARRAY_DEFINE(emitter_stacks, CONFIG_MP_NUM_CPUS,
+				   STACK_SIZE);
+static struct k_thread emitter_threads[CONFIG_MP_NUM_CPUS];
+static K_SEM_DEFINE(start_sem, 0, CONFIG_MP_NUM_CPUS);
+static K_SEM_DEFINE(done_sem, 0, CONFIG_MP_NUM_CPUS);
+
+static uint64_t emitter_cycles[CONFIG_MP_NUM_CPUS];
+
+static void emitter(void *p1, void *p2, void *p3)
+{
+	int id = POINTER_TO_INT(p1);
+	uint8_t event[EVENT_SIZE];
+	timing_t start, end;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (int i = 0; i < sizeof(event); i++) {
+		event[i] = (uint8_t)(id + i);
+	}
+
+	while (true) {
+		k_sem_take(&start_sem, K_FOREVER);
+
+		start = timing_counter_get();
+		for (int i = 0; i < N_EVENTS; i++) {
+			tracing_format_raw_data(event, sizeof(event));
+		}
+		end = timing_counter_get();
+
+		emitter_cycles[id] += timing_cycles_get(&start, &end);
+		k_sem_give(&done_sem);
+	}
+}
+
+static void buffers_drain_wait(void)
+{
+	if (IS_ENABLED(CONFIG_TRACING_BUFFER_OVERWRITE)) {
+		return;
+	}
+
+	while (!tracing_buffer_is_empty()) {
+		k_msleep(CONFIG_TRACING_THREAD_WAIT_THRESHOLD);
+	}
+}
+
+void main(void)
+{
+	uint64_t total = 0;
+
+	timing_init();
+	timing_start();
+
+	TC_START("Tracing buffer benchmark");
+	TC_PRINT("%d CPUs, %s buffers%s\n", CONFIG_MP_NUM_CPUS,
+		 IS_ENABLED(CONFIG_TRACING_BUFFER_PER_CPU) ? "per-CPU" : "shared",
+		 IS_ENABLED(CONFIG_TRACING_BUFFER_OVERWRITE) ?
+		 ", overwrite mode" : "");
+
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		k_thread_create(&emitter_threads[i], emitter_stacks[i],
+				STACK_SIZE, emitter, INT_TO_POINTER(i),
+				NULL, NULL, K_PRIO_PREEMPT(5), 0, K_NO_WAIT);
+	}
+
+	for (int round = 0; round < N_ROUNDS; round++) {
+		buffers_drain_wait();
+
+		for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+			k_sem_give(&start_sem);
+		}
+
+		for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+			k_sem_take(&done_sem, K_FOREVER);
+		}
+	}
+
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		uint32_t avg = (uint32_t)(emitter_cycles[i] /
+					  (N_ROUNDS * N_EVENTS));
+
+		TC_PRINT("emitter %d: %u cycles, %u ns per event\n", i, avg,
+			 (uint32_t)timing_cycles_to_ns(avg));
+		total += emitter_cycles[i];
+	}
+
+	TC_PRINT("average: %u cycles per event\n",
+		 (uint32_t)(total / (CONFIG_MP_NUM_CPUS * N_ROUNDS * N_EVENTS)));
+	TC_PRINT("overwritten packets: %u\n", tracing_buffer_overwritten_get());
+
+	timing_stop();
+	TC_END_REPORT(TC_PASS);
+}
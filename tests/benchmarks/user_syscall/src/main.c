@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * User mode system call benchmark.
+ *
+ * Measures the average cost of pairs of system calls on kernel objects
+ * made from a user mode thread, where the object lookup and permission
+ * check are a large share of the work and are skipped for objects in the
+ * thread's cache with CONFIG_USERSPACE_OBJ_CACHE:
+ *
+ * - sem: k_sem_give()/k_sem_take() on a single semaphore.
+ * - msgq: k_msgq_put()/k_msgq_get() on a single message queue.
+ * - sem ring: k_sem_give()/k_sem_take() on each of more semaphores than
+ *   the default cache size in turn, the worst case for the cache.
+ *
+ * The user thread is timed from the supervisor thread that starts it, as
+ * the timing functions are not available in user mode.
+ */
+
+#include <zephyr.h>
+#include <tc_util.h>
+#include <timing/timing.h>
+#include <app_memory/app_memdomain.h>
+
+#define N_ITERATIONS 10000
+#define N_SEMS 8
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACKSIZE)
+
+K_APPMEM_PARTITION_DEFINE(bench_partition);
+K_APP_DMEM(bench_partition) static int user_errors;
+K_APP_DMEM(bench_partition) static int pattern_idx;
+
+K_SEM_DEFINE(bench_sem, 0, 1);
+K_MSGQ_DEFINE(bench_msgq, sizeof(uint32_t), 1, 4);
+static struct k_sem ring_sems[N_SEMS];
+
+static struct k_mem_domain bench_domain;
+static K_THREAD_STACK_DEFINE(user_stack, STACK_SIZE);
+static struct k_thread user_thread;
+static K_SEM_DEFINE(start_sem, 0, 1);
+static K_SEM_DEFINE(done_sem, 0, 1);
+
+static int sem_loop(void)
+{
+	int errors = 0;
+
+	for (int i = 0; i < N_ITERATIONS; i++) {
+		k_sem_give(&bench_sem);
+		errors += (k_sem_take(&bench_sem, K_NO_WAIT) != 0);
+	}
+
+	return errors;
+}
+
+static int msgq_loop(void)
+{
+	int errors = 0;
+	uint32_t msg;
+
+	for (uint32_t i = 0; i < N_ITERATIONS; i++) {
+		msg = i;
+		errors += (k_msgq_put(&bench_msgq, &msg, K_NO_WAIT) != 0);
+		errors += (k_msgq_get(&bench_msgq, &msg, K_NO_WAIT) != 0);
+		errors += (msg != i);
+	}
+
+	return errors;
+}
+
+static int sem_ring_loop(void)
+{
+	int errors = 0;
+	struct k_sem *sem;
+
+	for (int i = 0; i < N_ITERATIONS; i++) {
+		sem = &ring_sems[i % N_SEMS];
+		k_sem_give(sem);
+		errors += (k_sem_take(sem, K_NO_WAIT) != 0);
+	}
+
+	return errors;
+}
+
+static const struct {
+	const char *name;
+	int (*loop)(void);
+} patterns[] = {
+	{ "sem", sem_loop },
+	{ "msgq", msgq_loop },
+	{ "sem ring", sem_ring_loop },
+};
+
+static void user_entry(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (;;) {
+		k_sem_take(&start_sem, K_FOREVER);
+		user_errors += patterns[pattern_idx].loop();
+		k_sem_give(&done_sem);
+	}
+}
+
+void main(void)
+{
+	struct k_mem_partition *parts[] = { &bench_partition };
+	timing_t start, end;
+	uint32_t avg;
+
+	timing_init();
+	timing_start();
+
+	TC_START("User mode system call benchmark");
+	TC_PRINT("%s\n", IS_ENABLED(CONFIG_USERSPACE_OBJ_CACHE) ?
+		 "verified object cache" : "object lookup per system call");
+
+	for (int i = 0; i < N_SEMS; i++) {
+		k_sem_init(&ring_sems[i], 0, 1);
+	}
+
+	k_mem_domain_init(&bench_domain, ARRAY_SIZE(parts), parts);
+	k_thread_create(&user_thread, user_stack, STACK_SIZE, user_entry,
+			NULL, NULL, NULL, K_PRIO_PREEMPT(5), K_USER,
+			K_FOREVER);
+	k_mem_domain_add_thread(&bench_domain, &user_thread);
+	k_thread_access_grant(&user_thread, &bench_sem, &bench_msgq,
+			      &start_sem, &done_sem);
+	for (int i = 0; i < N_SEMS; i++) {
+		k_object_access_grant(&ring_sems[i], &user_thread);
+	}
+	k_thread_start(&user_thread);
+
+	for (int i = 0; i < ARRAY_SIZE(patterns); i++) {
+		pattern_idx = i;
+
+		start = timing_counter_get();
+		k_sem_give(&start_sem);
+		k_sem_take(&done_sem, K_FOREVER);
+		end = timing_counter_get();
+
+		avg = (uint32_t)(timing_cycles_get(&start, &end) /
+				 N_ITERATIONS);
+		TC_PRINT("%-9s 2 system calls: %5u cycles, %6u ns\n",
+			 patterns[i].name, avg,
+			 (uint32_t)timing_cycles_to_ns(avg));
+	}
+
+	k_thread_abort(&user_thread);
+	timing_stop();
+
+	if (user_errors != 0) {
+		TC_PRINT("%d failed system calls\n", user_errors);
+	}
+	TC_END_REPORT(user_errors == 0 ? TC_PASS : TC_FAIL);
+}
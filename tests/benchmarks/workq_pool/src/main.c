@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Work queue pool benchmark.
+ *
+ * Compares a single work queue with a pool of one work queue per CPU:
+ * throughput is the rate at which a burst of work items, each busy for a
+ * fixed time, completes, and latency is the time from submitting a work
+ * item to an idle queue until its handler starts.
+ */
+
+#include <zephyr.h>
+#include <tc_util.h>
+#include <timing/timing.h>
+
+#define N_ITEMS 256
+#define N_LATENCY 64
+#define WORK_US 50
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACKSIZE)
+#define QUEUE_PRIORITY K_PRIO_PREEMPT(1)
+
+K_WORK_QUEUE_POOL_DEFINE(pool, CONFIG_MP_NUM_CPUS, STACK_SIZE);
+static K_THREAD_STACK_DEFINE(single_stack, STACK_SIZE);
+static struct k_work_q single_queue;
+
+static struct k_work items[N_ITEMS];
+static K_SEM_DEFINE(done_sem, 0, N_ITEMS);
+
+static timing_t submit_time;
+static uint64_t latency_cycles;
+
+typedef int (*submit_fn_t)(void *target, struct k_work *work);
+
+static void busy_handler(struct k_work *work)
+{
+	k_busy_wait(WORK_US);
+	k_sem_give(&done_sem);
+}
+
+static void latency_handler(struct k_work *work)
+{
+	timing_t now = timing_counter_get();
+
+	latency_cycles += timing_cycles_get(&submit_time, &now);
+	k_sem_give(&done_sem);
+}
+
+static int queue_submit(void *target, struct k_work *work)
+{
+	return k_work_submit_to_queue(target, work);
+}
+
+static int pool_submit(void *target, struct k_work *work)
+{
+	return k_work_submit_to_pool(target, work);
+}
+
+static void run(const char *name, submit_fn_t submit, void *target)
+{
+	timing_t start, end;
+	uint64_t ns;
+
+	for (int i = 0; i < N_ITEMS; i++) {
+		k_work_init(&items[i], busy_handler);
+	}
+
+	start = timing_counter_get();
+	for (int i = 0; i < N_ITEMS; i++) {
+		(void)submit(target, &items[i]);
+	}
+	for (int i = 0; i < N_ITEMS; i++) {
+		k_sem_take(&done_sem, K_FOREVER);
+	}
+	end = timing_counter_get();
+
+	ns = timing_cycles_to_ns(timing_cycles_get(&start, &end));
+	TC_PRINT("%-6s throughput: %6u items/s (%u us per item)\n", name,
+		 (uint32_t)(N_ITEMS * 1000000000ULL / ns),
+		 (uint32_t)(ns / N_ITEMS / 1000U));
+
+	latency_cycles = 0;
+	k_work_init(&items[0], latency_handler);
+	for (int i = 0; i < N_LATENCY; i++) {
+		submit_time = timing_counter_get();
+		(void)submit(target, &items[0]);
+		k_sem_take(&done_sem, K_FOREVER);
+	}
+
+	TC_PRINT("%-6s latency: %6u ns\n", name,
+		 (uint32_t)timing_cycles_to_ns(latency_cycles / N_LATENCY));
+}
+
+void main(void)
+{
+	timing_init();
+	timing_start();
+
+	TC_START("Work queue pool benchmark");
+	TC_PRINT("%d CPUs, %d work items of %d us\n", CONFIG_MP_NUM_CPUS,
+		 N_ITEMS, WORK_US);
+
+	k_work_queue_start(&single_queue, single_stack,
+			   K_THREAD_STACK_SIZEOF(single_stack), QUEUE_PRIORITY,
+			   NULL);
+	k_work_queue_pool_start(&pool, QUEUE_PRIORITY, NULL);
+
+	run("queue", queue_submit, &single_queue);
+	run("pool", pool_submit, &pool);
+
+	timing_stop();
+	TC_END_REPORT(TC_PASS);
+}
@@ -0,0 +1,429 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * GATT notification throughput test.
+ *
+ * The peripheral notifies N_CHRCS characteristics at 50 Hz, as a sensor hub
+ * does, and the central checks that it receives the values of each
+ * characteristic in order, ending with the last one. Both log the rate they
+ * achieved, to compare the prj.conf build with the prj_aggregate.conf one,
+ * which enables CONFIG_BT_GATT_NOTIFY_AGGREGATE.
+ *
+ * Every NOTIFY_CB_ROUNDS rounds, the first characteristic is notified with a
+ * completion callback, which is sent right away instead of being aggregated,
+ * and shall not be followed by the stale value of the previous round.
+ *
+ * Both devices register the same service, so the central uses the handles
+ * of its own copy instead of discovering them.
+ */
+
+#include <stddef.h>
+#include <string.h>
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <sys/byteorder.h>
+
+#include <bluetooth/bluetooth.h>
+#include <bluetooth/conn.h>
+#include <bluetooth/uuid.h>
+#include <bluetooth/gatt.h>
+
+#include "bs_types.h"
+#include "bs_tracing.h"
+#include "time_machine.h"
+#include "bstests.h"
+
+#define N_CHRCS 16
+#define N_ROUNDS 250
+#define ROUND_PERIOD_MS 20
+#define NOTIFY_CB_ROUNDS 10
+#define ATTRS_PER_CHRC 3
+#define WAIT_TIME 20 /*seconds*/
+
+extern enum bst_result_t bst_result;
+
+#define FAIL(...)					\
+	do {						\
+		bst_result = Failed;			\
+		bs_trace_error_time_line(__VA_ARGS__);	\
+	} while (0)
+
+#define PASS(...)					\
+	do {						\
+		bst_result = Passed;			\
+		bs_trace_info_time(1, __VA_ARGS__);	\
+	} while (0)
+
+struct value {
+	uint16_t seq;
+	uint8_t chrc;
+	uint8_t data[17];
+} __packed;
+
+static struct bt_uuid_128 svc_uuid = BT_UUID_INIT_128(
+	0xf0, 0xde, 0xbc, 0x9a, 0x78, 0x56, 0x34, 0x12,
+	0x78, 0x56, 0x34, 0x12, 0x78, 0x56, 0x34, 0x12);
+static struct bt_uuid_128 chrc_uuid = BT_UUID_INIT_128(
+	0xf1, 0xde, 0xbc, 0x9a, 0x78, 0x56, 0x34, 0x12,
+	0x78, 0x56, 0x34, 0x12, 0x78, 0x56, 0x34, 0x12);
+
+static const struct bt_gatt_attr chrc_template[] = {
+	BT_GATT_CHARACTERISTIC(&chrc_uuid.uuid, BT_GATT_CHRC_NOTIFY,
+			       BT_GATT_PERM_NONE, NULL, NULL, NULL),
+};
+
+static struct _bt_gatt_ccc cccs[N_CHRCS];
+static struct bt_gatt_attr attrs[1 + N_CHRCS * ATTRS_PER_CHRC];
+static struct bt_gatt_service svc = {
+	.attrs = attrs,
+	.attr_count = ARRAY_SIZE(attrs),
+};
+
+#define VALUE_ATTR(i) (&attrs[2 + (i) * ATTRS_PER_CHRC])
+#define CCC_ATTR(i) (&attrs[3 + (i) * ATTRS_PER_CHRC])
+
+static struct bt_conn *default_conn;
+static K_SEM_DEFINE(sem_connected, 0, 1);
+static K_SEM_DEFINE(sem_mtu, 0, 1);
+static K_SEM_DEFINE(sem_done, 0, 1);
+
+static struct bt_gatt_exchange_params mtu_params;
+static struct bt_gatt_subscribe_params sub_params[N_CHRCS];
+static uint16_t last_seq[N_CHRCS];
+static uint8_t chrcs_done;
+static uint32_t rx_count;
+static uint32_t rx_start;
+
+static int service_register(void)
+{
+	attrs[0] = (struct bt_gatt_attr)BT_GATT_PRIMARY_SERVICE(&svc_uuid);
+
+	for (int i = 0; i < N_CHRCS; i++) {
+		memcpy(&attrs[1 + i * ATTRS_PER_CHRC], chrc_template,
+		       sizeof(chrc_template));
+		*CCC_ATTR(i) = (struct bt_gatt_attr)BT_GATT_CCC_MANAGED(
+			&cccs[i], BT_GATT_PERM_READ | BT_GATT_PERM_WRITE);
+	}
+
+	return bt_gatt_service_register(&svc);
+}
+
+static void connected(struct bt_conn *conn, uint8_t err)
+{
+	if (err) {
+		FAIL("Connection failed (err 0x%02x)\n", err);
+		return;
+	}
+
+	if (!default_conn) {
+		default_conn = bt_conn_ref(conn);
+	}
+
+	k_sem_give(&sem_connected);
+}
+
+static void disconnected(struct bt_conn *conn, uint8_t reason)
+{
+	if (bst_result != Passed) {
+		FAIL("Disconnected (reason 0x%02x)\n", reason);
+	}
+}
+
+BT_CONN_CB_DEFINE(conn_callbacks) = {
+	.connected = connected,
+	.disconnected = disconnected,
+};
+
+static void test_notify_init(void)
+{
+	bst_ticker_set_next_tick_absolute(WAIT_TIME*1e6);
+	bst_result = In_progress;
+}
+
+static void test_notify_tick(bs_time_t HW_device_time)
+{
+	if (bst_result != Passed) {
+		FAIL("test_notify failed (not passed after %i seconds)\n",
+		     WAIT_TIME);
+	}
+}
+
+static bool all_subscribed(void)
+{
+	for (int i = 0; i < N_CHRCS; i++) {
+		if (!bt_gatt_is_subscribed(default_conn, VALUE_ATTR(i),
+					   BT_GATT_CCC_NOTIFY)) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+static void notify_cb(struct bt_conn *conn, void *user_data)
+{
+}
+
+static int value_notify(int i, struct value *value, bool cb)
+{
+	struct bt_gatt_notify_params params = {
+		.attr = VALUE_ATTR(i),
+		.data = value,
+		.len = sizeof(*value),
+		.func = cb ? notify_cb : NULL,
+	};
+
+	return bt_gatt_notify_cb(default_conn, &params);
+}
+
+static void test_peripheral_main(void)
+{
+	struct value value = { 0 };
+	uint32_t start, elapsed;
+	int32_t remaining;
+	int err;
+
+	err = bt_enable(NULL);
+	if (err) {
+		FAIL("Bluetooth init failed (err %d)\n", err);
+		return;
+	}
+
+	err = service_register();
+	if (err) {
+		FAIL("Service registration failed (err %d)\n", err);
+		return;
+	}
+
+	err = bt_le_adv_start(BT_LE_ADV_CONN_NAME, NULL, 0, NULL, 0);
+	if (err) {
+		FAIL("Advertising failed to start (err %d)\n", err);
+		return;
+	}
+
+	k_sem_take(&sem_connected, K_FOREVER);
+
+	while (!all_subscribed()) {
+		k_sleep(K_MSEC(100));
+	}
+
+	start = k_uptime_get_32();
+
+	for (uint16_t round = 1; round <= N_ROUNDS; round++) {
+		value.seq = sys_cpu_to_le16(round);
+
+		for (int i = 0; i < N_CHRCS; i++) {
+			value.chrc = i;
+			err = value_notify(i, &value,
+					   !i && !(round % NOTIFY_CB_ROUNDS));
+			if (err) {
+				FAIL("Notification failed (err %d)\n", err);
+				return;
+			}
+		}
+
+		/* Rounds that took too long are not made up for */
+		remaining = start + round * ROUND_PERIOD_MS -
+			    k_uptime_get_32();
+		if (remaining > 0) {
+			k_msleep(remaining);
+		}
+	}
+
+	elapsed = k_uptime_get_32() - start;
+	printk("Peripheral: %u notifications in %u ms, %u/s (%u/s wanted)\n",
+	       N_ROUNDS * N_CHRCS, elapsed,
+	       N_ROUNDS * N_CHRCS * 1000U / elapsed,
+	       N_CHRCS * 1000U / ROUND_PERIOD_MS);
+
+	PASS("Peripheral tests passed\n");
+}
+
+static uint8_t notify_func(struct bt_conn *conn,
+			   struct bt_gatt_subscribe_params *params,
+			   const void *data, uint16_t length)
+{
+	const struct value *value = data;
+	uint16_t seq;
+
+	if (!data) {
+		params->value_handle = 0U;
+		return BT_GATT_ITER_STOP;
+	}
+
+	if (length != sizeof(*value) || value->chrc >= N_CHRCS) {
+		FAIL("Unexpected notification (len %u)\n", length);
+		return BT_GATT_ITER_STOP;
+	}
+
+	if (!rx_count++) {
+		rx_start = k_uptime_get_32();
+	}
+
+	/* Values may be coalesced, but never reordered */
+	seq = sys_le16_to_cpu(value->seq);
+	if (seq <= last_seq[value->chrc]) {
+		FAIL("Characteristic %u: value %u after %u\n", value->chrc,
+		     seq, last_seq[value->chrc]);
+		return BT_GATT_ITER_STOP;
+	}
+
+	last_seq[value->chrc] = seq;
+
+	if (seq == N_ROUNDS && ++chrcs_done == N_CHRCS) {
+		k_sem_give(&sem_done);
+	}
+
+	return BT_GATT_ITER_CONTINUE;
+}
+
+static void device_found(const bt_addr_le_t *addr, int8_t rssi, uint8_t type,
+			 struct net_buf_simple *ad)
+{
+	int err;
+
+	if (type != BT_GAP_ADV_TYPE_ADV_IND || default_conn) {
+		return;
+	}
+
+	err = bt_le_scan_stop();
+	if (err) {
+		FAIL("Stop LE scan failed (err %d)\n", err);
+		return;
+	}
+
+	err = bt_conn_le_create(addr, BT_CONN_LE_CREATE_CONN,
+				BT_LE_CONN_PARAM_DEFAULT, &default_conn);
+	if (err) {
+		FAIL("Create conn failed (err %d)\n", err);
+	}
+}
+
+static void mtu_exchanged(struct bt_conn *conn, uint8_t err,
+			  struct bt_gatt_exchange_params *params)
+{
+	if (err) {
+		FAIL("MTU exchange failed (err 0x%02x)\n", err);
+		return;
+	}
+
+	k_sem_give(&sem_mtu);
+}
+
+static void test_central_main(void)
+{
+	/* Multiple Handle Value Notifications supported */
+	const uint8_t cli_features = BIT(2);
+	const struct bt_gatt_attr *attr;
+	uint32_t elapsed;
+	int err;
+
+	err = bt_enable(NULL);
+	if (err) {
+		FAIL("Bluetooth init failed (err %d)\n", err);
+		return;
+	}
+
+	err = service_register();
+	if (err) {
+		FAIL("Service registration failed (err %d)\n", err);
+		return;
+	}
+
+	err = bt_le_scan_start(BT_LE_SCAN_PASSIVE, device_found);
+	if (err) {
+		FAIL("Scanning failed to start (err %d)\n", err);
+		return;
+	}
+
+	k_sem_take(&sem_connected, K_FOREVER);
+
+	mtu_params.func = mtu_exchanged;
+	err = bt_gatt_exchange_mtu(default_conn, &mtu_params);
+	if (err) {
+		FAIL("MTU exchange failed (err %d)\n", err);
+		return;
+	}
+
+	k_sem_take(&sem_mtu, K_FOREVER);
+
+	attr = bt_gatt_find_by_uuid(NULL, 0, BT_UUID_GATT_CLIENT_FEATURES);
+	if (!attr) {
+		FAIL("No Client Supported Features characteristic\n");
+		return;
+	}
+
+	err = bt_gatt_write_without_response(default_conn,
+					     bt_gatt_attr_get_handle(attr),
+					     &cli_features,
+					     sizeof(cli_features), false);
+	if (err) {
+		FAIL("Client features write failed (err %d)\n", err);
+		return;
+	}
+
+	for (int i = 0; i < N_CHRCS; i++) {
+		sub_params[i].notify = notify_func;
+		sub_params[i].value = BT_GATT_CCC_NOTIFY;
+		sub_params[i].value_handle =
+			bt_gatt_attr_get_handle(VALUE_ATTR(i));
+		sub_params[i].ccc_handle = bt_gatt_attr_get_handle(CCC_ATTR(i));
+
+		err = bt_gatt_subscribe(default_conn, &sub_params[i]);
+		if (err) {
+			FAIL("Subscribe failed (err %d)\n", err);
+			return;
+		}
+	}
+
+	err = k_sem_take(&sem_done, K_SECONDS(WAIT_TIME));
+	if (err) {
+		FAIL("Last values not received (%u notifications)\n",
+		     rx_count);
+		return;
+	}
+
+	elapsed = k_uptime_get_32() - rx_start;
+	printk("Central: %u notifications in %u ms, %u/s\n", rx_count,
+	       elapsed, rx_count * 1000U / MAX(elapsed, 1U));
+
+	PASS("Central tests passed\n");
+}
+
+static const struct bst_test_instance test_def[] = {
+	{
+		.test_id = "peripheral",
+		.test_descr = "Notify characteristics at 50 Hz",
+		.test_post_init_f = test_notify_init,
+		.test_tick_f = test_notify_tick,
+		.test_main_f = test_peripheral_main
+	},
+	{
+		.test_id = "central",
+		.test_descr = "Receive notifications and check the last values",
+		.test_post_init_f = test_notify_init,
+		.test_tick_f = test_notify_tick,
+		.test_main_f = test_central_main
+	},
+	BSTEST_END_MARKER
+};
+
+struct bst_test_list *test_notify_install(struct bst_test_list *tests)
+{
+	return bst_add_tests(tests, test_def);
+}
+
+bst_test_install_t test_installers[] = {
+	test_notify_install,
+	NULL
+};
+
+void main(void)
+{
+	bst_main();
+}
@@ -0,0 +1,361 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <time.h>
+#include <zephyr/types.h>
+#include <ztest.h>
+
+#define CONFIG_BT_CTLR_ASSERT_HANDLER 1
+#define CONFIG_BT_LOG_LEVEL 1
+
+#include "ticker/ticker.c"
+
+/*
+ * Unit test and benchmark of the ticker, driven by a simulated counter.
+ *
+ * Many periodic ticker nodes with slot reservations, as of the connections
+ * of a central, are started, updated and stopped while the counter is
+ * advanced to each compare value set by the ticker. With
+ * CONFIG_BT_TICKER_INDEX, the index is checked against the ticker node list
+ * after every ticker_job.
+ *
+ * The benchmark measures the host time spent in ticker_job per expiry and
+ * per update for increasing numbers of ticker nodes. The simulated time of
+ * native_posix doesn't advance while the CPU runs, hence the host clock.
+ */
+
+#define TICKER_NODES     200
+#define TICKER_USER_OPS  (TICKER_NODES + 1)
+#define TICKER_USER_ID   0
+
+#define N_EXPIRE         4096
+#define N_UPDATE         1024
+
+/* Expiries of test_ticker_order, the same with and without the index */
+#define EXPIRE_COUNT     2959U
+#define EXPIRE_TRACE     0x7540a805U
+
+static struct ticker_node nodes[TICKER_NODES];
+static struct ticker_user users[1];
+static struct ticker_user_op user_ops[TICKER_USER_OPS];
+
+static uint32_t cntr;
+static uint32_t cntr_cc;
+static uint8_t sched_pending;
+
+static uint32_t rand_seed;
+static uint32_t expire_count;
+static uint32_t expire_last;
+static uint32_t expire_trace;
+static uint32_t op_failures;
+
+static uint64_t job_ns;
+static uint32_t job_count;
+
+uint32_t cntr_cnt_get(void)
+{
+	return cntr;
+}
+
+uint32_t cntr_start(void)
+{
+	return 0;
+}
+
+uint32_t cntr_stop(void)
+{
+	return 0;
+}
+
+void bt_ctlr_assert_handle(char *file, uint32_t line)
+{
+	zassert_unreachable("Controller assert %s:%u", file, line);
+}
+
+static uint64_t host_ns_get(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ((uint64_t)ts.tv_sec * 1000000000ULL) + ts.tv_nsec;
+}
+
+static uint32_t rand_get(uint32_t range)
+{
+	rand_seed = (rand_seed * 1103515245U) + 12345U;
+
+	return (rand_seed >> 8) % range;
+}
+
+static uint8_t caller_id_get(uint8_t user_id)
+{
+	return TICKER_CALL_ID_PROGRAM;
+}
+
+static void sched(uint8_t caller_id, uint8_t callee_id, uint8_t chain,
+		  void *instance)
+{
+	sched_pending |= BIT(callee_id);
+}
+
+static void trigger_set(uint32_t value)
+{
+	cntr_cc = value;
+}
+
+#if defined(CONFIG_BT_TICKER_INDEX)
+static uint8_t index_check_subtree(struct ticker_instance *instance,
+				   uint8_t id, uint8_t parent, uint8_t *list)
+{
+	struct ticker_node *ticker;
+
+	if (id == TICKER_NULL) {
+		return *list;
+	}
+
+	ticker = &instance->nodes[id];
+	zassert_equal(ticker->index_parent, parent, "Bad parent of %u", id);
+	if (parent != TICKER_NULL) {
+		zassert_true(instance->nodes[parent].index_priority >=
+			     ticker->index_priority, "Bad priority of %u", id);
+	}
+
+	/* In-order traversal matches the list */
+	*list = index_check_subtree(instance, ticker->index_left, id, list);
+	zassert_equal(*list, id, "Index order differs at %u", id);
+	*list = ticker->next;
+
+	return index_check_subtree(instance, ticker->index_right, id, list);
+}
+#endif /* CONFIG_BT_TICKER_INDEX */
+
+static void ticker_check(void)
+{
+	struct ticker_instance *instance = &_instance[0];
+	uint32_t ticks_to_expire = 0U;
+	uint8_t count = 0U;
+	uint8_t id;
+
+	for (id = instance->ticker_id_head; id != TICKER_NULL;
+	     id = nodes[id].next) {
+		zassert_true(++count <= TICKER_NODES, "Loop in ticker list");
+		ticks_to_expire += nodes[id].ticks_to_expire;
+
+#if defined(CONFIG_BT_TICKER_INDEX)
+		zassert_equal(ticker_index_key(instance, &nodes[id]),
+			      ticks_to_expire, "Bad index key of %u", id);
+#endif /* CONFIG_BT_TICKER_INDEX */
+	}
+
+#if defined(CONFIG_BT_TICKER_INDEX)
+	id = instance->ticker_id_head;
+	id = index_check_subtree(instance, instance->index_root, TICKER_NULL,
+				 &id);
+	zassert_equal(id, TICKER_NULL, "Index misses ticker nodes");
+#endif /* CONFIG_BT_TICKER_INDEX */
+}
+
+static void ticker_run(void)
+{
+	struct ticker_instance *instance = &_instance[0];
+	uint64_t start;
+
+	while (sched_pending) {
+		if (sched_pending & BIT(TICKER_CALL_ID_WORKER)) {
+			sched_pending &= ~BIT(TICKER_CALL_ID_WORKER);
+			ticker_worker(instance);
+			continue;
+		}
+
+		sched_pending &= ~BIT(TICKER_CALL_ID_JOB);
+
+		start = host_ns_get();
+		ticker_job(instance);
+		job_ns += host_ns_get() - start;
+		job_count++;
+	}
+}
+
+static void ticker_advance(void)
+{
+	cntr = cntr_cc;
+	ticker_trigger(0);
+	ticker_run();
+}
+
+static void timeout(uint32_t ticks_at_expire, uint32_t remainder,
+		    uint16_t lazy, uint8_t force, void *context)
+{
+	uint32_t id = (uint32_t)(uintptr_t)context;
+
+	if (expire_count) {
+		zassert_false(ticker_ticks_diff_get(ticks_at_expire,
+						    expire_last) &
+			      BIT(HAL_TICKER_CNTR_MSBIT),
+			      "Expiry of %u out of order", id);
+	}
+
+	expire_last = ticks_at_expire;
+	expire_trace = (expire_trace * 31U) + (ticks_at_expire ^ (id << 24));
+	expire_count++;
+}
+
+static void op_cb(uint32_t status, void *op_context)
+{
+	op_failures += (status != TICKER_STATUS_SUCCESS);
+}
+
+static void ticker_setup(void)
+{
+	uint32_t err;
+
+	(void)memset(nodes, 0, sizeof(nodes));
+	(void)memset(users, 0, sizeof(users));
+	(void)memset(_instance, 0, sizeof(_instance));
+
+	users[TICKER_USER_ID].count_user_op = ARRAY_SIZE(user_ops);
+
+	err = ticker_init(0, ARRAY_SIZE(nodes), nodes, ARRAY_SIZE(users), users,
+			  ARRAY_SIZE(user_ops), user_ops, caller_id_get, sched,
+			  trigger_set);
+	zassert_equal(err, TICKER_STATUS_SUCCESS, "Ticker init failed");
+
+	cntr = 0U;
+	sched_pending = 0U;
+	rand_seed = 1U;
+	expire_count = 0U;
+	expire_trace = 0U;
+	op_failures = 0U;
+}
+
+static void ticker_start_random(uint8_t id)
+{
+	/* Connection interval of 30 ms to 1 s, event of 0.5 to 2.5 ms */
+	uint32_t period = HAL_TICKER_US_TO_TICKS(1250U * (24U +
+							   rand_get(776U)));
+	uint32_t slot = HAL_TICKER_US_TO_TICKS(500U + rand_get(2000U));
+	uint32_t ret;
+
+	ret = ticker_start(0, TICKER_USER_ID, id, cntr, rand_get(period),
+			   period, TICKER_NULL_REMAINDER, TICKER_NULL_LAZY,
+			   slot, timeout, (void *)(uintptr_t)id, op_cb, NULL);
+	zassert_true((ret == TICKER_STATUS_SUCCESS) ||
+		     (ret == TICKER_STATUS_BUSY), "Ticker start failed");
+}
+
+static void ticker_update_random(uint8_t id)
+{
+	uint32_t drift = 1U + rand_get(HAL_TICKER_US_TO_TICKS(1000U));
+	uint32_t ret;
+
+	if (rand_get(2U)) {
+		ret = ticker_update(0, TICKER_USER_ID, id, drift, 0, 0, 0, 0, 0,
+				    op_cb, NULL);
+	} else {
+		ret = ticker_update(0, TICKER_USER_ID, id, 0, drift, 0, 0, 0, 0,
+				    op_cb, NULL);
+	}
+	zassert_true((ret == TICKER_STATUS_SUCCESS) ||
+		     (ret == TICKER_STATUS_BUSY), "Ticker update failed");
+}
+
+static void ticker_start_all(uint8_t count)
+{
+	for (uint8_t id = 0U; id < count; id++) {
+		ticker_start_random(id);
+	}
+	ticker_run();
+	ticker_check();
+}
+
+void test_ticker_order(void)
+{
+	uint8_t count = 64U;
+	uint32_t ret;
+
+	ticker_setup();
+	ticker_start_all(count);
+	zassert_equal(op_failures, 0U, "Ticker start failures");
+
+	for (int i = 0; i < N_EXPIRE; i++) {
+		uint8_t id = rand_get(count);
+
+		switch (rand_get(8U)) {
+		case 0:
+			ret = ticker_stop(0, TICKER_USER_ID, id, op_cb, NULL);
+			zassert_true((ret == TICKER_STATUS_SUCCESS) ||
+				     (ret == TICKER_STATUS_BUSY),
+				     "Ticker stop failed");
+			ticker_run();
+			ticker_check();
+
+			ticker_start_random(id);
+			break;
+		case 1:
+		case 2:
+			ticker_update_random(id);
+			break;
+		default:
+			break;
+		}
+
+		ticker_run();
+		ticker_check();
+
+		ticker_advance();
+		ticker_check();
+	}
+
+	zassert_equal(op_failures, 0U, "Ticker operation failures");
+	zassert_equal(expire_count, EXPIRE_COUNT, "Expiry count differs");
+	zassert_equal(expire_trace, EXPIRE_TRACE, "Expiry trace differs");
+}
+
+void test_ticker_benchmark(void)
+{
+	static const uint8_t counts[] = { 8, 32, 64, 128, TICKER_NODES };
+
+	TC_PRINT("Ticker index %s\n",
+		 IS_ENABLED(CONFIG_BT_TICKER_INDEX) ? "on" : "off");
+
+	for (int i = 0; i < ARRAY_SIZE(counts); i++) {
+		uint32_t expire_ns, update_ns;
+
+		ticker_setup();
+		ticker_start_all(counts[i]);
+
+		job_ns = 0U;
+		job_count = 0U;
+		for (int j = 0; j < N_EXPIRE; j++) {
+			ticker_advance();
+		}
+		expire_ns = job_ns / job_count;
+
+		job_ns = 0U;
+		job_count = 0U;
+		for (int j = 0; j < N_UPDATE; j++) {
+			ticker_update_random(rand_get(counts[i]));
+			ticker_run();
+		}
+		update_ns = job_ns / job_count;
+
+		ticker_check();
+		zassert_equal(op_failures, 0U, "Ticker operation failures");
+
+		TC_PRINT("%3u nodes: expiry job %6u ns, update job %6u ns\n",
+			 counts[i], expire_ns, update_ns);
+	}
+}
+
+void test_main(void)
+{
+	ztest_test_suite(test_ctrl_ticker,
+			 ztest_unit_test(test_ticker_order),
+			 ztest_unit_test(test_ticker_benchmark));
+	ztest_run_test_suite(test_ctrl_ticker);
+}
@@ -265,6 +265,38 @@ void test_gatt_write(void)
 			  "Attribute write value don't match");
 }
 
+static uint8_t count_handle(const struct bt_gatt_attr *attr, uint16_t handle,
+			    void *user_data)
+{
+	const struct bt_gatt_attr *found = NULL;
+
+	/* Resolve the handle alone and back, twice for cached handles */
+	bt_gatt_foreach_attr(handle, handle, find_attr, &found);
+	zassert_equal_ptr(found, attr, "Attribute by handle don't match");
+	zassert_equal(bt_gatt_attr_get_handle(attr), handle,
+		      "Attribute handle don't match");
+	zassert_equal(bt_gatt_attr_get_handle(attr), handle,
+		      "Attribute handle don't match");
+
+	return count_attr(attr, handle, user_data);
+}
+
+void test_gatt_handle(void)
+{
+	uint16_t num = 0;
+
+	/* Attempt to unregister first/middle and walk the database */
+	zassert_false(bt_gatt_service_unregister(&test_svc),
+		     "Test service unregister failed");
+	bt_gatt_foreach_attr(0x0001, 0xffff, count_handle, &num);
+
+	zassert_false(bt_gatt_service_register(&test_svc),
+		     "Test service re-registration failed");
+	num = 0;
+	bt_gatt_foreach_attr(test_attrs[0].handle, 0xffff, count_handle, &num);
+	zassert_equal(num, 7, "Number of attributes don't match");
+}
+
 /*test case main entry*/
 void test_main(void)
 {
@@ -273,6 +305,7 @@ void test_main(void)
 			 ztest_unit_test(test_gatt_unregister),
 			 ztest_unit_test(test_gatt_foreach),
 			 ztest_unit_test(test_gatt_read),
-			 ztest_unit_test(test_gatt_write));
+			 ztest_unit_test(test_gatt_write),
+			 ztest_unit_test(test_gatt_handle));
 	ztest_run_test_suite(test_gatt);
 }
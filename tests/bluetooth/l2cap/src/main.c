@@ -69,10 +69,17 @@ void test_l2cap_register(void)
 		     "Test dynamic PSM server duplicate succeeded");
 }
 
+void test_l2cap_recv_benchmark(void);
+void test_l2cap_recv_slow_consumer(void);
+void test_l2cap_recv_contiguous(void);
+
 /*test case main entry*/
 void test_main(void)
 {
 	ztest_test_suite(test_l2cap,
-			 ztest_unit_test(test_l2cap_register));
+			 ztest_unit_test(test_l2cap_register),
+			 ztest_unit_test(test_l2cap_recv_benchmark),
+			 ztest_unit_test(test_l2cap_recv_slow_consumer),
+			 ztest_unit_test(test_l2cap_recv_contiguous));
 	ztest_run_test_suite(test_l2cap);
 }
@@ -0,0 +1,491 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Receive path of LE credit based channels, without a controller.
+ *
+ * A connection is added as if it had been established and a peer connects a
+ * channel to a local server. The K-frames of the peer are passed to
+ * bt_l2cap_recv() as if they had been received from the controller, in
+ * buffers of the size of the ACL RX buffers, and the PDUs sent to the peer,
+ * as the credits given, are taken from the TX queue of the connection.
+ *
+ * The benchmark measures the time to reassemble and deliver an SDU to an
+ * application that reads it, for SDUs of 1 to 4 K-frames, which depends on
+ * CONFIG_BT_L2CAP_RX_ZERO_COPY.
+ *
+ * The contiguous SDU test has an application that only reads the data of the
+ * SDU buffer, as the Object Transfer Service does, on a channel that doesn't
+ * set rx_zero_copy, which shall get SDUs copied to that buffer whatever
+ * CONFIG_BT_L2CAP_RX_ZERO_COPY is.
+ *
+ * The slow consumer test has an application that completes SDUs
+ * asynchronously, at a lower rate than the peer can send them, and reports
+ * how many credits the peer and the application held, which depends on
+ * CONFIG_BT_L2CAP_RX_CREDITS_TUNING.
+ */
+
+#include <zephyr.h>
+#include <string.h>
+#include <ztest.h>
+#include <timing/timing.h>
+#include <sys/byteorder.h>
+
+#include <bluetooth/buf.h>
+#include <bluetooth/bluetooth.h>
+#include <bluetooth/conn.h>
+#include <bluetooth/l2cap.h>
+
+#include <host/hci_core.h>
+#include <host/conn_internal.h>
+#include <host/l2cap_internal.h>
+
+#define TEST_PSM	0x0090
+#define PEER_CID	0x0040
+#define PEER_MTU	64
+#define PEER_MPS	64
+
+#define SDU_MTU		980
+#define SDU_BUF_COUNT	12
+#define RX_CREDITS	12
+
+#define N_SDUS		256
+#define N_CONTIGUOUS_SDUS	16
+#define N_SLOW_SDUS	64
+#define N_HELD		8
+#define DRAIN_TICKS	12
+#define MAX_TICKS	(N_SLOW_SDUS * DRAIN_TICKS * 4)
+
+NET_BUF_POOL_FIXED_DEFINE(acl_pool, CONFIG_BT_BUF_ACL_RX_COUNT,
+			  BT_BUF_ACL_SIZE(CONFIG_BT_BUF_ACL_RX_SIZE), NULL);
+NET_BUF_POOL_FIXED_DEFINE(sdu_pool, SDU_BUF_COUNT, SDU_MTU, NULL);
+
+static const bt_addr_le_t peer_addr = {
+	.type = BT_ADDR_LE_RANDOM,
+	.a = { { 0x01, 0x02, 0x03, 0x04, 0x05, 0xc0 } },
+};
+
+static struct bt_conn *conn;
+static struct bt_l2cap_le_chan test_chan;
+static uint16_t test_init_credits;
+static bool test_async;
+static bool test_zero_copy = true;
+static bool test_contiguous;
+
+static uint16_t peer_dcid;
+static int peer_credits;
+static uint8_t peer_ident;
+
+static uint16_t sdu_len;
+static uint32_t rx_sdus;
+static uint32_t rx_errors;
+
+static struct net_buf *held[N_HELD];
+static uint32_t held_in;
+static uint32_t held_out;
+
+static struct net_buf *chan_alloc_buf(struct bt_l2cap_chan *chan)
+{
+	return net_buf_alloc(&sdu_pool, K_NO_WAIT);
+}
+
+static int chan_recv(struct bt_l2cap_chan *chan, struct net_buf *buf)
+{
+	uint8_t expected = rx_sdus;
+	struct net_buf *frag;
+	size_t len = 0;
+
+	/* Read the SDU as an application would, from the whole fragment chain
+	 * unless it expects contiguous SDUs.
+	 */
+	for (frag = buf; frag; frag = test_contiguous ? NULL : frag->frags) {
+		for (int i = 0; i < frag->len; i++) {
+			rx_errors += (frag->data[i] != expected++);
+		}
+		len += frag->len;
+	}
+
+	rx_errors += (len != sdu_len);
+	rx_sdus++;
+
+	if (!test_async) {
+		return 0;
+	}
+
+	if (held_in - held_out == N_HELD) {
+		rx_errors++;
+		return 0;
+	}
+
+	held[held_in++ % N_HELD] = buf;
+
+	return -EINPROGRESS;
+}
+
+static const struct bt_l2cap_chan_ops chan_ops = {
+	.alloc_buf = chan_alloc_buf,
+	.recv = chan_recv,
+};
+
+static int chan_accept(struct bt_conn *conn, struct bt_l2cap_chan **chan)
+{
+	(void)memset(&test_chan, 0, sizeof(test_chan));
+	test_chan.chan.ops = &chan_ops;
+	test_chan.rx.mtu = SDU_MTU;
+	test_chan.rx.init_credits = test_init_credits;
+#if defined(CONFIG_BT_L2CAP_RX_ZERO_COPY)
+	test_chan.rx_zero_copy = test_zero_copy;
+#endif /* CONFIG_BT_L2CAP_RX_ZERO_COPY */
+
+	*chan = &test_chan.chan;
+
+	return 0;
+}
+
+static struct bt_l2cap_server test_recv_server = {
+	.accept = chan_accept,
+	.psm = TEST_PSM,
+};
+
+static struct net_buf *peer_buf_alloc(void)
+{
+	struct net_buf *buf;
+
+	buf = net_buf_alloc(&acl_pool, K_NO_WAIT);
+	if (buf) {
+		net_buf_reserve(buf, BT_BUF_RESERVE + BT_HCI_ACL_HDR_SIZE +
+				BT_L2CAP_HDR_SIZE);
+	}
+
+	return buf;
+}
+
+static void peer_send(struct net_buf *buf, uint16_t cid)
+{
+	struct bt_l2cap_hdr *hdr;
+
+	hdr = net_buf_push(buf, sizeof(*hdr));
+	hdr->len = sys_cpu_to_le16(buf->len - sizeof(*hdr));
+	hdr->cid = sys_cpu_to_le16(cid);
+
+	bt_l2cap_recv(conn, buf);
+}
+
+static void peer_sig_send(uint8_t code, const void *data, uint16_t len)
+{
+	struct bt_l2cap_sig_hdr *hdr;
+	struct net_buf *buf;
+
+	buf = peer_buf_alloc();
+	zassert_not_null(buf, "No buffer for signaling");
+
+	peer_ident = (peer_ident % 0xff) + 1;
+
+	hdr = net_buf_add(buf, sizeof(*hdr));
+	hdr->code = code;
+	hdr->ident = peer_ident;
+	hdr->len = sys_cpu_to_le16(len);
+	net_buf_add_mem(buf, data, len);
+
+	peer_send(buf, BT_L2CAP_CID_LE_SIG);
+}
+
+/* Process the PDUs sent to the peer */
+static void peer_recv(void)
+{
+	struct bt_l2cap_le_conn_rsp *rsp;
+	struct bt_l2cap_le_credits *ev;
+	struct bt_l2cap_sig_hdr *sig;
+	struct bt_l2cap_hdr *hdr;
+	struct net_buf *buf;
+
+	while ((buf = net_buf_get(&conn->tx_queue, K_NO_WAIT))) {
+		hdr = net_buf_pull_mem(buf, sizeof(*hdr));
+		if (sys_le16_to_cpu(hdr->cid) != BT_L2CAP_CID_LE_SIG) {
+			net_buf_unref(buf);
+			continue;
+		}
+
+		sig = net_buf_pull_mem(buf, sizeof(*sig));
+		switch (sig->code) {
+		case BT_L2CAP_LE_CONN_RSP:
+			rsp = (void *)buf->data;
+			zassert_equal(sys_le16_to_cpu(rsp->result),
+				      BT_L2CAP_LE_SUCCESS, "Connection refused");
+			peer_dcid = sys_le16_to_cpu(rsp->dcid);
+			peer_credits = sys_le16_to_cpu(rsp->credits);
+			break;
+		case BT_L2CAP_LE_CREDITS:
+			ev = (void *)buf->data;
+			if (sys_le16_to_cpu(ev->cid) == peer_dcid) {
+				peer_credits += sys_le16_to_cpu(ev->credits);
+			}
+			break;
+		default:
+			break;
+		}
+
+		net_buf_unref(buf);
+	}
+}
+
+/* Next K-frame of SDU number sdu, of sdu_len bytes, at offset */
+static struct net_buf *peer_frame(uint32_t sdu, uint16_t *offset)
+{
+	struct net_buf *buf;
+
+	buf = peer_buf_alloc();
+	if (!buf) {
+		return NULL;
+	}
+
+	if (!*offset) {
+		net_buf_add_le16(buf, sdu_len);
+	}
+
+	while (buf->len < test_chan.rx.mps && *offset < sdu_len) {
+		net_buf_add_u8(buf, (uint8_t)(sdu + *offset));
+		(*offset)++;
+	}
+
+	return buf;
+}
+
+static void peer_flush(void)
+{
+	struct k_work_sync sync;
+
+	(void)k_work_flush(&test_chan.rx_work, &sync);
+	peer_recv();
+}
+
+static void conn_setup(void)
+{
+	if (conn) {
+		return;
+	}
+
+	zassert_false(bt_l2cap_server_register(&test_recv_server),
+		      "Test server registration failed");
+
+	conn = bt_conn_add_le(BT_ID_DEFAULT, &peer_addr);
+	zassert_not_null(conn, "Unable to add connection");
+
+	bt_conn_set_state(conn, BT_CONN_CONNECTED);
+	bt_l2cap_connected(conn);
+}
+
+static void chan_connect(uint16_t init_credits, bool async)
+{
+	struct bt_l2cap_le_conn_req req = {
+		.psm = sys_cpu_to_le16(TEST_PSM),
+		.scid = sys_cpu_to_le16(PEER_CID),
+		.mtu = sys_cpu_to_le16(PEER_MTU),
+		.mps = sys_cpu_to_le16(PEER_MPS),
+		.credits = sys_cpu_to_le16(1),
+	};
+
+	conn_setup();
+
+	test_init_credits = init_credits;
+	test_async = async;
+	peer_dcid = 0U;
+	peer_credits = 0;
+	rx_sdus = 0U;
+	rx_errors = 0U;
+	held_in = 0U;
+	held_out = 0U;
+
+	peer_sig_send(BT_L2CAP_LE_CONN_REQ, &req, sizeof(req));
+	peer_recv();
+
+	zassert_not_equal(peer_dcid, 0U, "Channel not connected");
+	zassert_true(peer_credits > 0, "No initial credits");
+}
+
+static void chan_disconnect(void)
+{
+	struct bt_l2cap_disconn_req req = {
+		.dcid = sys_cpu_to_le16(peer_dcid),
+		.scid = sys_cpu_to_le16(PEER_CID),
+	};
+
+	peer_flush();
+	peer_sig_send(BT_L2CAP_DISCONN_REQ, &req, sizeof(req));
+	peer_recv();
+}
+
+static bool chan_release(void)
+{
+	int err;
+
+	if (held_out == held_in) {
+		return false;
+	}
+
+	err = bt_l2cap_chan_recv_complete(&test_chan.chan,
+					  held[held_out++ % N_HELD]);
+	rx_errors += (err != 0);
+
+	return true;
+}
+
+void test_l2cap_recv_benchmark(void)
+{
+	static const uint16_t lens[] = { 64, 490, SDU_MTU };
+	struct net_buf *frames[CONFIG_BT_BUF_ACL_RX_COUNT];
+	struct k_work_sync sync;
+	timing_t start, end;
+	uint64_t cycles;
+	uint32_t sdus = 0U;
+
+	TC_PRINT("SDU reassembly %s, credits tuning %s\n",
+		 IS_ENABLED(CONFIG_BT_L2CAP_RX_ZERO_COPY) ? "zero-copy" :
+		 "copy",
+		 IS_ENABLED(CONFIG_BT_L2CAP_RX_CREDITS_TUNING) ? "on" : "off");
+
+	timing_init();
+	timing_start();
+
+	chan_connect(0U, false);
+
+	for (int i = 0; i < ARRAY_SIZE(lens); i++) {
+		uint32_t avg;
+		int n;
+
+		sdu_len = lens[i];
+		cycles = 0U;
+
+		for (int j = 0; j < N_SDUS; j++) {
+			uint16_t offset = 0U;
+
+			for (n = 0; offset < sdu_len; n++) {
+				zassert_true(n < ARRAY_SIZE(frames),
+					     "Too many K-frames");
+				frames[n] = peer_frame(sdus, &offset);
+				zassert_not_null(frames[n], "No ACL buffer");
+			}
+
+			zassert_true(peer_credits >= n, "No credits to send");
+			peer_credits -= n;
+
+			start = timing_counter_get();
+			for (int k = 0; k < n; k++) {
+				peer_send(frames[k], peer_dcid);
+			}
+			(void)k_work_flush(&test_chan.rx_work, &sync);
+			end = timing_counter_get();
+			cycles += timing_cycles_get(&start, &end);
+
+			peer_recv();
+			sdus++;
+		}
+
+		avg = (uint32_t)(cycles / N_SDUS);
+		TC_PRINT("%4u bytes, %u K-frames: %6u cycles, %7u ns\n",
+			 sdu_len, n, avg, (uint32_t)timing_cycles_to_ns(avg));
+	}
+
+	timing_stop();
+
+	chan_disconnect();
+
+	zassert_equal(rx_sdus, sdus, "SDUs lost");
+	zassert_equal(rx_errors, 0U, "Receive errors");
+}
+
+void test_l2cap_recv_slow_consumer(void)
+{
+	uint32_t ticks, sdus = 0U;
+	uint32_t peak_held = 0U;
+	int peak_credits = 0;
+	uint16_t offset = 0U;
+	struct net_buf *buf;
+
+	chan_connect(RX_CREDITS, true);
+
+	sdu_len = SDU_MTU;
+
+	/* The peer sends a K-frame per tick while it has credits and the
+	 * controller has buffers, the application completes an SDU every
+	 * DRAIN_TICKS ticks.
+	 */
+	for (ticks = 0U; rx_sdus < N_SLOW_SDUS; ticks++) {
+		zassert_true(ticks < MAX_TICKS, "Peer stalled");
+
+		if (peer_credits > 0 && sdus < N_SLOW_SDUS) {
+			buf = peer_frame(sdus, &offset);
+			if (buf) {
+				peer_credits--;
+				peer_send(buf, peer_dcid);
+				if (offset == sdu_len) {
+					offset = 0U;
+					sdus++;
+				}
+			}
+		}
+
+		peer_flush();
+
+		if (!(ticks % DRAIN_TICKS)) {
+			(void)chan_release();
+			peer_recv();
+		}
+
+		peak_credits = MAX(peak_credits, peer_credits);
+		peak_held = MAX(peak_held, held_in - held_out);
+	}
+
+	while (chan_release()) {
+	}
+
+	peer_recv();
+
+	TC_PRINT("%u SDUs in %u ticks, peer credits up to %d, "
+		 "SDUs held up to %u\n", rx_sdus, ticks, peak_credits,
+		 peak_held);
+
+	chan_disconnect();
+
+	zassert_equal(rx_errors, 0U, "Receive errors");
+	zassert_true(peak_credits <= RX_CREDITS, "Too many credits given");
+}
+
+void test_l2cap_recv_contiguous(void)
+{
+	uint32_t sdus;
+
+	test_zero_copy = false;
+	test_contiguous = true;
+
+	chan_connect(0U, false);
+
+	sdu_len = SDU_MTU;
+
+	for (sdus = 0U; sdus < N_CONTIGUOUS_SDUS; sdus++) {
+		uint16_t offset = 0U;
+		struct net_buf *buf;
+
+		while (offset < sdu_len) {
+			buf = peer_frame(sdus, &offset);
+			zassert_not_null(buf, "No ACL buffer");
+
+			zassert_true(peer_credits > 0, "No credits to send");
+			peer_credits--;
+
+			peer_send(buf, peer_dcid);
+			peer_flush();
+		}
+	}
+
+	chan_disconnect();
+
+	test_zero_copy = true;
+	test_contiguous = false;
+
+	zassert_equal(rx_sdus, sdus, "SDUs lost");
+	zassert_equal(rx_errors, 0U, "SDUs not contiguous");
+}
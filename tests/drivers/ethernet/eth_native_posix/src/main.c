@@ -0,0 +1,198 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Latency and throughput of the native_posix TAP driver, measured with
+ * ICMPv4 echo requests answered by the host.
+ *
+ * The host side must be set up before running zephyr.exe, e.g. with
+ * "net-setup.sh" from the net-tools project, which creates the "zeth"
+ * TAP interface with address 192.0.2.2. If that subnet is already in use
+ * on the host, change CONFIG_NET_CONFIG_MY_IPV4_ADDR and
+ * CONFIG_NET_CONFIG_PEER_IPV4_ADDR accordingly.
+ */
+
+#include <ztest.h>
+#include <net/net_if.h>
+#include <net/net_ip.h>
+#include <net/net_pkt.h>
+
+#include "icmpv4.h"
+
+#define ECHO_ID		0x2710
+#define REPLY_TIMEOUT	K_SECONDS(1)
+
+/* Small echo requests, sent one at a time */
+#define N_PINGS		100
+#define PING_SIZE	56
+
+/*
+ * Large echo requests, sent in bursts. Both the request and the reply
+ * span several network buffers, and the replies queue up on the TAP
+ * device faster than they are read.
+ */
+#define N_BURSTS	20
+#define BURST_LEN	32
+#define BURST_SIZE	1024
+
+static struct net_if *iface;
+static struct in_addr peer_addr;
+static uint8_t payload[BURST_SIZE];
+static atomic_t replies;
+static atomic_t bad_replies;
+static K_SEM_DEFINE(reply_sem, 0, BURST_LEN);
+
+static enum net_verdict echo_reply(struct net_pkt *pkt,
+				   struct net_ipv4_hdr *ip_hdr,
+				   struct net_icmp_hdr *icmp_hdr)
+{
+	NET_PKT_DATA_ACCESS_CONTIGUOUS_DEFINE(icmp_access,
+					      struct net_icmpv4_echo_req);
+	struct net_icmpv4_echo_req *echo;
+	uint8_t data[64];
+	size_t offset = 0;
+	size_t len;
+
+	echo = (struct net_icmpv4_echo_req *)net_pkt_get_data(pkt,
+							      &icmp_access);
+	if (echo == NULL || ntohs(echo->identifier) != ECHO_ID) {
+		return NET_DROP;
+	}
+
+	/* The host echoes the payload back, so a frame mangled on the way
+	 * out shows up here.
+	 */
+	net_pkt_skip(pkt, sizeof(*echo));
+	while (net_pkt_remaining_data(pkt)) {
+		len = MIN(net_pkt_remaining_data(pkt), sizeof(data));
+
+		if (offset + len > sizeof(payload) ||
+		    net_pkt_read(pkt, data, len) ||
+		    memcmp(data, &payload[offset], len)) {
+			atomic_inc(&bad_replies);
+			break;
+		}
+
+		offset += len;
+	}
+
+	atomic_inc(&replies);
+	k_sem_give(&reply_sem);
+
+	net_pkt_unref(pkt);
+	return NET_OK;
+}
+
+static struct net_icmpv4_handler echo_reply_handler = {
+	.type = NET_ICMPV4_ECHO_REPLY,
+	.code = 0,
+	.handler = echo_reply,
+};
+
+static int ping(uint16_t seq, size_t size)
+{
+	return net_icmpv4_send_echo_request(iface, &peer_addr, ECHO_ID, seq,
+					    payload, size);
+}
+
+static void test_setup(void)
+{
+	int i;
+
+	iface = net_if_get_default();
+	zassert_not_null(iface, "No network interface");
+
+	zassert_equal(net_addr_pton(AF_INET, CONFIG_NET_CONFIG_PEER_IPV4_ADDR,
+				    &peer_addr), 0, NULL);
+
+	for (i = 0; i < sizeof(payload); i++) {
+		payload[i] = i;
+	}
+
+	net_icmpv4_register_handler(&echo_reply_handler);
+
+	/* Resolve the peer address, the host may take a while to answer
+	 * if the TAP interface has just come up.
+	 */
+	for (i = 0; i < 10; i++) {
+		zassert_equal(ping(0, PING_SIZE), 0, "Cannot send request");
+		if (k_sem_take(&reply_sem, REPLY_TIMEOUT) == 0) {
+			break;
+		}
+	}
+
+	zassert_true(i < 10, "No reply from %s, is the host TAP set up?",
+		     CONFIG_NET_CONFIG_PEER_IPV4_ADDR);
+}
+
+static void test_latency(void)
+{
+	uint64_t total = 0;
+	uint32_t min = UINT32_MAX;
+	uint32_t max = 0;
+	uint32_t start, us;
+	int i;
+
+	for (i = 0; i < N_PINGS; i++) {
+		start = k_cycle_get_32();
+		zassert_equal(ping(i + 1, PING_SIZE), 0, "Cannot send request");
+		zassert_equal(k_sem_take(&reply_sem, REPLY_TIMEOUT), 0,
+			      "No reply to request %d", i + 1);
+		us = k_cyc_to_us_floor32(k_cycle_get_32() - start);
+
+		total += us;
+		min = MIN(min, us);
+		max = MAX(max, us);
+	}
+
+	zassert_equal(atomic_get(&bad_replies), 0, "Corrupted replies");
+
+	TC_PRINT("%d x %d byte pings: min %u us, avg %u us, max %u us\n",
+		 N_PINGS, PING_SIZE, min, (uint32_t)(total / N_PINGS), max);
+}
+
+static void test_throughput(void)
+{
+	uint32_t start, us;
+	int i, j;
+
+	atomic_set(&replies, 0);
+	start = k_cycle_get_32();
+
+	for (i = 0; i < N_BURSTS; i++) {
+		for (j = 0; j < BURST_LEN; j++) {
+			zassert_equal(ping(j + 1, BURST_SIZE), 0,
+				      "Cannot send request");
+		}
+
+		for (j = 0; j < BURST_LEN; j++) {
+			zassert_equal(k_sem_take(&reply_sem, REPLY_TIMEOUT), 0,
+				      "Burst %d: %d of %d replies", i, j,
+				      BURST_LEN);
+		}
+	}
+
+	us = MAX(k_cyc_to_us_floor32(k_cycle_get_32() - start), 1);
+
+	zassert_equal(atomic_get(&replies), N_BURSTS * BURST_LEN, NULL);
+	zassert_equal(atomic_get(&bad_replies), 0, "Corrupted replies");
+
+	TC_PRINT("%d x %d byte pings in bursts of %d: %u us, %u pkt/s, "
+		 "%u kbit/s\n", N_BURSTS * BURST_LEN, BURST_SIZE, BURST_LEN,
+		 us, (uint32_t)(N_BURSTS * BURST_LEN * 1000000ULL / us),
+		 (uint32_t)(N_BURSTS * BURST_LEN * BURST_SIZE * 2 * 8 *
+			    1000ULL / us));
+}
+
+void test_main(void)
+{
+	ztest_test_suite(eth_native_posix,
+			 ztest_unit_test(test_setup),
+			 ztest_unit_test(test_latency),
+			 ztest_unit_test(test_throughput));
+
+	ztest_run_test_suite(eth_native_posix);
+}
@@ -299,6 +299,143 @@ static void test_get_mock(void)
 #endif
 }
 
+#ifdef CONFIG_FLASH_SIMULATOR_STATS
+#include <stats/stats.h>
+#include <string.h>
+
+struct sim_stat_find {
+	const char *name;
+	uint32_t *val;
+};
+
+static int sim_stat_find_cb(struct stats_hdr *hdr, void *arg,
+			    const char *name, uint16_t off)
+{
+	struct sim_stat_find *find = arg;
+
+	if (!strcmp(name, find->name)) {
+		find->val = (uint32_t *)((uint8_t *)hdr + off);
+	}
+
+	return 0;
+}
+
+static uint32_t *sim_stat(const char *name)
+{
+	struct sim_stat_find find = { .name = name };
+	struct stats_hdr *sim_stats = stats_group_find("flash_sim_stats");
+
+	if (sim_stats) {
+		stats_walk(sim_stats, sim_stat_find_cb, &find);
+	}
+
+	return find.val;
+}
+#endif /* CONFIG_FLASH_SIMULATOR_STATS */
+
+static void test_timing(void)
+{
+#if defined(CONFIG_FLASH_SIMULATOR_SIMULATE_TIMING) && \
+	defined(CONFIG_FLASH_SIMULATOR_STATS)
+	const size_t page = CONFIG_FLASH_SIMULATOR_PROG_PAGE_SIZE;
+	uint32_t *erase_time = sim_stat("flash_erase_time_us");
+	uint32_t *write_time = sim_stat("flash_write_time_us");
+	uint32_t *read_time = sim_stat("flash_read_time_us");
+	uint32_t expected, total = 0U;
+	uint32_t before;
+	int64_t start, elapsed, margin;
+	int rc;
+
+	zassert_not_null(erase_time, "Erase time statistic not found");
+	zassert_not_null(write_time, "Write time statistic not found");
+	zassert_not_null(read_time, "Read time statistic not found");
+
+	start = k_uptime_get();
+
+	/* Erase of two units */
+	expected = CONFIG_FLASH_SIMULATOR_MIN_ERASE_TIME_US +
+		   2 * CONFIG_FLASH_SIMULATOR_UNIT_ERASE_TIME_US;
+	before = *erase_time;
+	rc = flash_erase(flash_dev, FLASH_SIMULATOR_BASE_OFFSET,
+			 2 * FLASH_SIMULATOR_ERASE_UNIT);
+	zassert_equal(0, rc, "flash_erase should succeed");
+	zassert_equal(*erase_time - before, expected, "Unexpected erase time");
+	total += expected;
+
+	/* Write of a page from the middle of a page, touching two pages */
+	expected = CONFIG_FLASH_SIMULATOR_MIN_WRITE_TIME_US +
+		   2 * CONFIG_FLASH_SIMULATOR_PAGE_PROG_TIME_US;
+	(void)memset(test_read_buf, 0, page);
+	before = *write_time;
+	rc = flash_write(flash_dev, FLASH_SIMULATOR_BASE_OFFSET + page / 2,
+			 test_read_buf, page);
+	zassert_equal(0, rc, "flash_write should succeed");
+	zassert_equal(*write_time - before, expected, "Unexpected write time");
+	total += expected;
+
+	/* Read of an erase unit */
+	expected = CONFIG_FLASH_SIMULATOR_MIN_READ_TIME_US;
+#if CONFIG_FLASH_SIMULATOR_READ_BANDWIDTH > 0
+	expected += ((uint64_t)FLASH_SIMULATOR_ERASE_UNIT * USEC_PER_SEC) /
+		    (CONFIG_FLASH_SIMULATOR_READ_BANDWIDTH * 1024U);
+#endif
+	before = *read_time;
+	rc = flash_read(flash_dev, FLASH_SIMULATOR_BASE_OFFSET,
+			test_read_buf, FLASH_SIMULATOR_ERASE_UNIT);
+	zassert_equal(0, rc, "flash_read should succeed");
+	zassert_equal(*read_time - before, expected, "Unexpected read time");
+	total += expected;
+
+	/* The operations took their time, up to a tick off when sleeping.
+	 * Signed, as the tolerance may well exceed the expected time.
+	 */
+	elapsed = k_uptime_get() - start;
+	margin = (int64_t)k_ticks_to_ms_ceil32(1) + 1;
+	zassert_within(elapsed, (int64_t)(total / USEC_PER_MSEC), margin,
+		       "Operations took %u ms, expected %u us",
+		       (uint32_t)elapsed, total);
+#else
+	ztest_test_skip();
+#endif
+}
+
+static void test_wear(void)
+{
+#ifdef CONFIG_FLASH_SIMULATOR_STATS
+	uint32_t *erase_units = sim_stat("erase_units");
+	uint32_t *max_cycles = sim_stat("max_erase_cycles");
+	uint32_t *unit0_cycles = sim_stat("erase_cycles_unit0");
+	uint32_t *unit1_cycles = sim_stat("erase_cycles_unit1");
+	int rc;
+
+	zassert_not_null(erase_units, "Erased units statistic not found");
+	zassert_not_null(max_cycles, "Max erase cycles statistic not found");
+	zassert_not_null(unit0_cycles, "Unit 0 statistic not found");
+	zassert_not_null(unit1_cycles, "Unit 1 statistic not found");
+
+	stats_reset(stats_group_find("flash_sim_stats"));
+
+	/* Three erases of the first unit and one of the second one */
+	for (int i = 0; i < 3; i++) {
+		rc = flash_erase(flash_dev, FLASH_SIMULATOR_BASE_OFFSET,
+				 FLASH_SIMULATOR_ERASE_UNIT);
+		zassert_equal(0, rc, "flash_erase should succeed");
+	}
+
+	rc = flash_erase(flash_dev, FLASH_SIMULATOR_BASE_OFFSET +
+			 FLASH_SIMULATOR_ERASE_UNIT,
+			 FLASH_SIMULATOR_ERASE_UNIT);
+	zassert_equal(0, rc, "flash_erase should succeed");
+
+	zassert_equal(*erase_units, 4, "Unexpected erased units");
+	zassert_equal(*max_cycles, 3, "Unexpected maximum erase cycles");
+	zassert_equal(*unit0_cycles, 3, "Unexpected erase cycles of unit 0");
+	zassert_equal(*unit1_cycles, 1, "Unexpected erase cycles of unit 1");
+#else
+	ztest_test_skip();
+#endif
+}
+
 void test_main(void)
 {
 	ztest_test_suite(flash_sim_api,
@@ -310,7 +447,9 @@ void test_main(void)
 			 ztest_unit_test(test_align),
 			 ztest_unit_test(test_get_erase_value),
 			 ztest_unit_test(test_double_write),
-			 ztest_unit_test(test_get_mock));
+			 ztest_unit_test(test_get_mock),
+			 ztest_unit_test(test_timing),
+			 ztest_unit_test(test_wear));
 
 	ztest_run_test_suite(flash_sim_api);
 }
@@ -0,0 +1,236 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <irq_offload.h>
+
+#define STACK_SIZE (512 + CONFIG_TEST_EXTRA_STACKSIZE)
+
+#define PRIO_WAIT (CONFIG_ZTEST_THREAD_PRIORITY + 1)
+
+#define WAIT_TIMEOUT K_MSEC(100)
+#define RUN_MS 10
+
+#define EVENT_A BIT(0)
+#define EVENT_B BIT(5)
+#define EVENT_C BIT(31)
+
+K_EVENT_DEFINE(static_event);
+struct k_event test_event;
+
+K_THREAD_STACK_DEFINE(waiter_stack, STACK_SIZE);
+struct k_thread waiter_tid;
+
+ZTEST_BMEM uint32_t waiter_events;
+ZTEST_BMEM uint32_t waiter_result;
+ZTEST_BMEM bool waiter_all;
+
+static void waiter_entry(void *p1, void *p2, void *p3)
+{
+	if (waiter_all) {
+		waiter_result = k_event_wait_all(&test_event, waiter_events,
+						 false, WAIT_TIMEOUT);
+	} else {
+		waiter_result = k_event_wait(&test_event, waiter_events,
+					     false, WAIT_TIMEOUT);
+	}
+}
+
+static void poster_entry(void *p1, void *p2, void *p3)
+{
+	k_event_post(&test_event, POINTER_TO_UINT(p1));
+}
+
+/* Start a thread waiting for events, and let it block */
+static void waiter_start(uint32_t events, bool all)
+{
+	waiter_events = events;
+	waiter_all = all;
+	waiter_result = UINT32_MAX;
+
+	k_thread_create(&waiter_tid, waiter_stack, STACK_SIZE, waiter_entry,
+			NULL, NULL, NULL, PRIO_WAIT,
+			K_USER | K_INHERIT_PERMS, K_NO_WAIT);
+	k_msleep(RUN_MS);
+}
+
+static void waiter_join(void)
+{
+	zassert_equal(k_thread_join(&waiter_tid, K_FOREVER), 0, NULL);
+}
+
+static void event_isr_post(const void *events)
+{
+	k_event_post(&test_event, POINTER_TO_UINT(events));
+}
+
+/**
+ * @brief Test that events are set, posted and cleared without waiting
+ */
+void test_event_no_wait(void)
+{
+	k_event_init(&test_event);
+
+	zassert_equal(k_event_wait(&test_event, EVENT_A, false, K_NO_WAIT), 0,
+		      NULL);
+
+	k_event_post(&test_event, EVENT_A);
+	k_event_post(&test_event, EVENT_B);
+	zassert_equal(k_event_wait(&test_event, EVENT_A | EVENT_C, false,
+				   K_NO_WAIT), EVENT_A, NULL);
+	zassert_equal(k_event_wait_all(&test_event, EVENT_A | EVENT_B, false,
+				       K_NO_WAIT), EVENT_A | EVENT_B, NULL);
+	zassert_equal(k_event_wait_all(&test_event, EVENT_A | EVENT_C, false,
+				       K_NO_WAIT), 0, NULL);
+
+	k_event_clear(&test_event, EVENT_A);
+	zassert_equal(k_event_wait(&test_event, EVENT_A | EVENT_B, false,
+				   K_NO_WAIT), EVENT_B, NULL);
+
+	k_event_set(&test_event, EVENT_C);
+	zassert_equal(k_event_wait(&test_event, EVENT_A | EVENT_B, false,
+				   K_NO_WAIT), 0, NULL);
+	zassert_equal(k_event_wait(&test_event, ~0U, false, K_NO_WAIT),
+		      EVENT_C, NULL);
+
+	/* Reset clears the events before checking them */
+	zassert_equal(k_event_wait(&test_event, EVENT_C, true, K_NO_WAIT), 0,
+		      NULL);
+	zassert_equal(k_event_wait(&test_event, ~0U, false, K_NO_WAIT), 0,
+		      NULL);
+
+	zassert_equal(k_event_wait(&test_event, 0, false, K_NO_WAIT), 0, NULL);
+}
+
+/**
+ * @brief Test that a statically defined event object is usable
+ */
+void test_event_static(void)
+{
+	zassert_equal(k_event_wait(&static_event, ~0U, false, K_NO_WAIT), 0,
+		      NULL);
+	k_event_post(&static_event, EVENT_B);
+	zassert_equal(k_event_wait(&static_event, ~0U, false, K_NO_WAIT),
+		      EVENT_B, NULL);
+}
+
+/**
+ * @brief Test waking a thread waiting for any of a set of events
+ */
+void test_event_wait_any(void)
+{
+	k_event_init(&test_event);
+
+	waiter_start(EVENT_A | EVENT_B, false);
+
+	/* Not waited for */
+	k_event_post(&test_event, EVENT_C);
+	k_msleep(RUN_MS);
+	zassert_equal(waiter_result, UINT32_MAX, "woken by other event");
+
+	k_event_post(&test_event, EVENT_B);
+	waiter_join();
+	zassert_equal(waiter_result, EVENT_B, NULL);
+}
+
+/**
+ * @brief Test waking a thread waiting for all of a set of events
+ */
+void test_event_wait_all(void)
+{
+	k_event_init(&test_event);
+
+	waiter_start(EVENT_A | EVENT_C, true);
+
+	k_event_post(&test_event, EVENT_A);
+	k_msleep(RUN_MS);
+	zassert_equal(waiter_result, UINT32_MAX, "woken by partial events");
+
+	k_event_post(&test_event, EVENT_B | EVENT_C);
+	waiter_join();
+	zassert_equal(waiter_result, EVENT_A | EVENT_C, NULL);
+}
+
+/**
+ * @brief Test that a wait for events times out
+ */
+void test_event_wait_timeout(void)
+{
+	k_event_init(&test_event);
+
+	waiter_start(EVENT_A, false);
+	k_event_post(&test_event, EVENT_B);
+	waiter_join();
+	zassert_equal(waiter_result, 0, NULL);
+
+	/* Clearing does not satisfy an all-wait */
+	k_event_set(&test_event, EVENT_A);
+	waiter_start(EVENT_A | EVENT_B, true);
+	k_event_clear(&test_event, EVENT_A);
+	waiter_join();
+	zassert_equal(waiter_result, 0, NULL);
+}
+
+/**
+ * @brief Test posting events from an ISR
+ */
+void test_event_post_from_isr(void)
+{
+	k_event_init(&test_event);
+
+	waiter_start(EVENT_C, false);
+	irq_offload(event_isr_post, UINT_TO_POINTER(EVENT_C));
+	waiter_join();
+	zassert_equal(waiter_result, EVENT_C, NULL);
+}
+
+/**
+ * @brief Test k_poll() on an event object
+ */
+void test_event_poll(void)
+{
+	struct k_poll_event poll_event =
+		K_POLL_EVENT_INITIALIZER(K_POLL_TYPE_EVENTS,
+					 K_POLL_MODE_NOTIFY_ONLY,
+					 &test_event);
+
+	k_event_init(&test_event);
+
+	zassert_equal(k_poll(&poll_event, 1, K_NO_WAIT), -EAGAIN, NULL);
+
+	irq_offload(event_isr_post, UINT_TO_POINTER(EVENT_A));
+	zassert_equal(k_poll(&poll_event, 1, K_NO_WAIT), 0, NULL);
+	zassert_equal(poll_event.state, K_POLL_STATE_EVENTS, NULL);
+	zassert_equal(k_event_wait(&test_event, ~0U, true, K_NO_WAIT), 0,
+		      NULL);
+
+	/* Block polling until a lower priority thread posts */
+	poll_event.state = K_POLL_STATE_NOT_READY;
+	k_thread_create(&waiter_tid, waiter_stack, STACK_SIZE, poster_entry,
+			UINT_TO_POINTER(EVENT_B), NULL, NULL, PRIO_WAIT, 0,
+			K_NO_WAIT);
+	zassert_equal(k_poll(&poll_event, 1, WAIT_TIMEOUT), 0, NULL);
+	zassert_equal(poll_event.state, K_POLL_STATE_EVENTS, NULL);
+	zassert_equal(k_event_wait(&test_event, ~0U, false, K_NO_WAIT),
+		      EVENT_B, NULL);
+	waiter_join();
+}
+
+void test_main(void)
+{
+	k_thread_access_grant(k_current_get(), &test_event, &static_event,
+			      &waiter_tid, &waiter_stack);
+
+	ztest_test_suite(test_events,
+			 ztest_user_unit_test(test_event_no_wait),
+			 ztest_user_unit_test(test_event_static),
+			 ztest_user_unit_test(test_event_wait_any),
+			 ztest_user_unit_test(test_event_wait_all),
+			 ztest_user_unit_test(test_event_wait_timeout),
+			 ztest_unit_test(test_event_post_from_isr),
+			 ztest_unit_test(test_event_poll));
+	ztest_run_test_suite(test_events);
+}
@@ -36,6 +36,8 @@ extern void arm_core_mpu_disable(void);
 #define STACKSIZE (256 + CONFIG_TEST_EXTRA_STACKSIZE)
 
 K_SEM_DEFINE(test_revoke_sem, 0, 1);
+K_SEM_DEFINE(test_null_sem, 0, 1);
+K_SEM_DEFINE(test_null_revoke_sem, 0, 1);
 
 /* Used for tests that switch between domains, we will switch between the
  * default domain and this one.
@@ -559,6 +561,12 @@ static void test_revoke_noperms_object(void)
  */
 static void test_access_after_revoke(void)
 {
+	/* Use the object first, so that it is in the verified object cache
+	 * with CONFIG_USERSPACE_OBJ_CACHE
+	 */
+	k_sem_give(&test_revoke_sem);
+	zassert_equal(k_sem_take(&test_revoke_sem, K_NO_WAIT), 0, NULL);
+
 	k_object_release(&test_revoke_sem);
 
 	/* Try to access an object after revoking access to it */
@@ -569,6 +577,34 @@ static void test_access_after_revoke(void)
 	zassert_unreachable("Using revoked object did not fault");
 }
 
+/**
+ * @brief Test to pass a NULL object after a permission was revoked
+ *
+ * @details Revoking a permission invalidates the verified object caches
+ * of CONFIG_USERSPACE_OBJ_CACHE. Their emptied entries must not match a
+ * NULL object.
+ *
+ * @ingroup kernel_memprotect_tests
+ */
+static void test_null_object_after_revoke(void)
+{
+	k_sem_give(&test_null_sem);
+	zassert_equal(k_sem_take(&test_null_sem, K_NO_WAIT), 0, NULL);
+
+	/* Start a new permission generation, then use the object again so
+	 * that the emptied cache is looked up afterwards
+	 */
+	k_object_release(&test_null_revoke_sem);
+	k_sem_give(&test_null_sem);
+	zassert_equal(k_sem_take(&test_null_sem, K_NO_WAIT), 0, NULL);
+
+	set_fault(K_ERR_KERNEL_OOPS);
+
+	k_sem_take(NULL, K_NO_WAIT);
+
+	zassert_unreachable("Passing a NULL object did not fault");
+}
+
 static void umode_enter_func(void)
 {
 	zassert_true(k_is_user_context(),
@@ -992,7 +1028,8 @@ void test_main(void)
 #endif
 	k_thread_access_grant(k_current_get(),
 			      &test_thread, &test_stack,
-			      &test_revoke_sem, &kpipe);
+			      &test_revoke_sem, &test_null_sem,
+			      &test_null_revoke_sem, &kpipe);
 	ztest_test_suite(userspace,
 		ztest_user_unit_test(test_is_usermode),
 		ztest_user_unit_test(test_write_control),
@@ -1012,6 +1049,7 @@ void test_main(void)
 		ztest_1cpu_user_unit_test(test_write_other_stack),
 		ztest_user_unit_test(test_revoke_noperms_object),
 		ztest_user_unit_test(test_access_after_revoke),
+		ztest_user_unit_test(test_null_object_after_revoke),
 		ztest_unit_test(test_user_mode_enter),
 		ztest_user_unit_test(test_write_kobject_user_pipe),
 		ztest_user_unit_test(test_read_kobject_user_pipe),
@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "test_msgq.h"
+
+#define N_MSGS 64
+
+K_MSGQ_SPSC_DEFINE(kmsgq_spsc, MSG_SIZE, MSGQ_LEN, 4);
+static struct k_msgq spsc_msgq;
+static char __aligned(4) spsc_buffer[MSG_SIZE * MSGQ_LEN];
+
+K_THREAD_STACK_EXTERN(tstack);
+extern struct k_thread tdata;
+
+static void producer_entry(void *p1, void *p2, void *p3)
+{
+	struct k_msgq *q = p1;
+
+	for (uint32_t i = 0; i < N_MSGS; i++) {
+		zassert_equal(k_msgq_put(q, &i, K_FOREVER), 0, NULL);
+	}
+}
+
+static void isr_put(const void *p)
+{
+	struct k_msgq *q = (struct k_msgq *)p;
+	uint32_t msg = MSG0;
+
+	zassert_equal(k_msgq_put(q, &msg, K_NO_WAIT), 0, NULL);
+}
+
+static void blocked_put_entry(void *p1, void *p2, void *p3)
+{
+	uint32_t msg = MSG1;
+
+	zassert_equal(k_msgq_put((struct k_msgq *)p1, &msg, K_FOREVER),
+		      -ENOMSG, NULL);
+}
+
+/**
+ * @addtogroup kernel_message_queue_tests
+ * @{
+ */
+
+/**
+ * @brief Test a single-producer/single-consumer message queue between threads
+ *
+ * @details The queue is shorter than the message stream so that both the
+ * consumer, when the producer has a lower priority, and the producer, when
+ * it has a higher one, have to sleep and be woken up by the other side.
+ *
+ * @see k_msgq_spsc_init(), k_msgq_put(), k_msgq_get()
+ */
+void test_msgq_spsc_thread(void)
+{
+	int prio[] = { K_PRIO_PREEMPT(2), K_PRIO_PREEMPT(0) };
+	int old_prio = k_thread_priority_get(k_current_get());
+	uint32_t msg;
+
+	k_thread_priority_set(k_current_get(), K_PRIO_PREEMPT(1));
+
+	for (int i = 0; i < ARRAY_SIZE(prio); i++) {
+		k_msgq_spsc_init(&spsc_msgq, spsc_buffer, MSG_SIZE, MSGQ_LEN);
+
+		k_thread_create(&tdata, tstack, STACK_SIZE, producer_entry,
+				&spsc_msgq, NULL, NULL, prio[i], 0, K_NO_WAIT);
+
+		for (uint32_t n = 0; n < N_MSGS; n++) {
+			zassert_equal(k_msgq_get(&spsc_msgq, &msg, K_FOREVER),
+				      0, NULL);
+			/**TESTPOINT: messages come out in order */
+			zassert_equal(msg, n, NULL);
+		}
+
+		k_thread_join(&tdata, K_FOREVER);
+		zassert_equal(k_msgq_num_used_get(&spsc_msgq), 0, NULL);
+	}
+
+	k_thread_priority_set(k_current_get(), old_prio);
+}
+
+/**
+ * @brief Test a single-producer/single-consumer message queue fed by an ISR
+ *
+ * @see K_MSGQ_SPSC_DEFINE(), k_msgq_put(), k_msgq_get(), k_msgq_peek()
+ */
+void test_msgq_spsc_isr(void)
+{
+	struct k_msgq_attrs attrs;
+	uint32_t msg;
+
+	zassert_equal(k_msgq_get(&kmsgq_spsc, &msg, K_NO_WAIT), -ENOMSG, NULL);
+
+	for (int i = 0; i < MSGQ_LEN; i++) {
+		irq_offload(isr_put, &kmsgq_spsc);
+	}
+
+	/**TESTPOINT: a full queue fails immediately in ISR context */
+	zassert_equal(k_msgq_put(&kmsgq_spsc, &msg, K_NO_WAIT), -ENOMSG, NULL);
+	zassert_equal(k_msgq_num_free_get(&kmsgq_spsc), 0, NULL);
+	k_msgq_get_attrs(&kmsgq_spsc, &attrs);
+	zassert_equal(attrs.used_msgs, MSGQ_LEN, NULL);
+
+	zassert_equal(k_msgq_peek(&kmsgq_spsc, &msg), 0, NULL);
+	zassert_equal(msg, MSG0, NULL);
+	for (int i = 0; i < MSGQ_LEN; i++) {
+		zassert_equal(k_msgq_get(&kmsgq_spsc, &msg, K_NO_WAIT), 0,
+			      NULL);
+		zassert_equal(msg, MSG0, NULL);
+	}
+
+	/**TESTPOINT: an empty queue times out */
+	zassert_equal(k_msgq_get(&kmsgq_spsc, &msg, TIMEOUT), -EAGAIN, NULL);
+}
+
+/**
+ * @brief Test purging a single-producer/single-consumer message queue
+ *
+ * @see k_msgq_spsc_init(), k_msgq_purge()
+ */
+void test_msgq_spsc_purge(void)
+{
+	uint32_t msg = MSG0;
+
+	k_msgq_spsc_init(&spsc_msgq, spsc_buffer, MSG_SIZE, MSGQ_LEN);
+	for (int i = 0; i < MSGQ_LEN; i++) {
+		zassert_equal(k_msgq_put(&spsc_msgq, &msg, K_NO_WAIT), 0, NULL);
+	}
+
+	k_thread_create(&tdata, tstack, STACK_SIZE, blocked_put_entry,
+			&spsc_msgq, NULL, NULL, K_PRIO_PREEMPT(0), 0,
+			K_NO_WAIT);
+	k_msleep(TIMEOUT_MS >> 1);
+
+	/**TESTPOINT: the blocked producer sees -ENOMSG */
+	k_msgq_purge(&spsc_msgq);
+	k_thread_join(&tdata, K_FOREVER);
+
+	zassert_equal(k_msgq_num_used_get(&spsc_msgq), 0, NULL);
+	zassert_equal(k_msgq_peek(&spsc_msgq, &msg), -ENOMSG, NULL);
+
+	/**TESTPOINT: the queue is usable after a purge */
+	msg = MSG1;
+	zassert_equal(k_msgq_put(&spsc_msgq, &msg, K_NO_WAIT), 0, NULL);
+	msg = 0;
+	zassert_equal(k_msgq_get(&spsc_msgq, &msg, K_NO_WAIT), 0, NULL);
+	zassert_equal(msg, MSG1, NULL);
+}
+
+/**
+ * @}
+ */
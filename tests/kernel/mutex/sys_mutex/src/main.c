@@ -49,6 +49,9 @@
 #include <zephyr.h>
 #include <ztest.h>
 #include <sys/mutex.h>
+#ifdef CONFIG_SYS_MUTEX_FAST_PATH
+#include <ztest_error_hook.h>
+#endif
 
 #define STACKSIZE (512 + CONFIG_TEST_EXTRA_STACKSIZE)
 
@@ -362,19 +365,30 @@ void test_mutex(void)
 	TC_PRINT("Recursive locking tests successful\n");
 }
 
+#ifdef CONFIG_SYS_MUTEX_FAST_PATH
+/* The fast path accesses the mutex memory before making a system call,
+ * so the checks of bad mutexes are made by calling the system calls.
+ */
+#define checked_mutex_lock(mutex) z_sys_mutex_kernel_lock(mutex, K_NO_WAIT)
+#define checked_mutex_unlock(mutex) z_sys_mutex_kernel_unlock(mutex)
+#else
+#define checked_mutex_lock(mutex) sys_mutex_lock(mutex, K_NO_WAIT)
+#define checked_mutex_unlock(mutex) sys_mutex_unlock(mutex)
+#endif
+
 void test_supervisor_access(void)
 {
 	int rv;
 
 #ifdef CONFIG_USERSPACE
 	/* coverage for get_k_mutex checks */
-	rv = sys_mutex_lock((struct sys_mutex *)NULL, K_NO_WAIT);
+	rv = checked_mutex_lock((struct sys_mutex *)NULL);
 	zassert_true(rv == -EINVAL, "accepted bad mutex pointer");
-	rv = sys_mutex_lock((struct sys_mutex *)k_current_get(), K_NO_WAIT);
+	rv = checked_mutex_lock((struct sys_mutex *)k_current_get());
 	zassert_true(rv == -EINVAL, "accepted object that was not a mutex");
-	rv = sys_mutex_unlock((struct sys_mutex *)NULL);
+	rv = checked_mutex_unlock((struct sys_mutex *)NULL);
 	zassert_true(rv == -EINVAL, "accepted bad mutex pointer");
-	rv = sys_mutex_unlock((struct sys_mutex *)k_current_get());
+	rv = checked_mutex_unlock((struct sys_mutex *)k_current_get());
 	zassert_true(rv == -EINVAL, "accepted object that was not a mutex");
 #endif /* CONFIG_USERSPACE */
 
@@ -384,15 +398,43 @@ void test_supervisor_access(void)
 	zassert_true(rv == -EINVAL, "mutex wasn't locked");
 }
 
+#ifdef CONFIG_SYS_MUTEX_FAST_PATH
+static K_THREAD_STACK_DEFINE(no_access_stack, STACKSIZE);
+static struct k_thread no_access_thread;
+static ZTEST_BMEM bool no_access_returned;
+
+static void no_access_entry(void *p1, void *p2, void *p3)
+{
+	ztest_set_fault_valid(true);
+	(void)sys_mutex_lock(&no_access_mutex, K_NO_WAIT);
+
+	/* Not reached, the thread is aborted on the fault */
+	ztest_set_fault_valid(false);
+	no_access_returned = true;
+}
+#endif
+
 void test_user_access(void)
 {
 #ifdef CONFIG_USERSPACE
 	int rv;
 
-	rv = sys_mutex_lock(&no_access_mutex, K_NO_WAIT);
+	rv = checked_mutex_lock(&no_access_mutex);
 	zassert_true(rv == -EACCES, "accessed mutex not in memory domain");
-	rv = sys_mutex_unlock(&no_access_mutex);
+	rv = checked_mutex_unlock(&no_access_mutex);
 	zassert_true(rv == -EACCES, "accessed mutex not in memory domain");
+
+#ifdef CONFIG_SYS_MUTEX_FAST_PATH
+	/* The fast path itself faults on a mutex outside of the memory
+	 * domain instead of returning -EACCES
+	 */
+	k_thread_create(&no_access_thread, no_access_stack, STACKSIZE,
+			no_access_entry, NULL, NULL, NULL,
+			K_LOWEST_APPLICATION_THREAD_PRIO,
+			K_USER | K_INHERIT_PERMS, K_NO_WAIT);
+	k_thread_join(&no_access_thread, K_FOREVER);
+	zassert_false(no_access_returned, "accessed mutex outside of domain");
+#endif /* CONFIG_SYS_MUTEX_FAST_PATH */
 #else
 	ztest_test_skip();
 #endif /* CONFIG_USERSPACE */
@@ -424,6 +466,10 @@ void test_main(void)
 #ifdef CONFIG_USERSPACE
 	k_thread_access_grant(k_current_get(),
 			      &thread_12_thread_data, &thread_12_stack_area);
+#endif
+#ifdef CONFIG_SYS_MUTEX_FAST_PATH
+	k_thread_access_grant(k_current_get(),
+			      &no_access_thread, &no_access_stack);
 #endif
 	rv = sys_mutex_lock(&not_my_mutex, K_NO_WAIT);
 	if (rv != 0) {
@@ -27,6 +27,8 @@ extern void test_pipe_alloc(void);
 extern void test_pipe_reader_wait(void);
 extern void test_pipe_block_writer_wait(void);
 extern void test_pipe_cleanup(void);
+extern void test_pipe_claim(void);
+extern void test_pipe_claim_stream(void);
 #ifdef CONFIG_USERSPACE
 extern void test_pipe_user_thread2thread(void);
 extern void test_pipe_user_put_fail(void);
@@ -41,6 +43,8 @@ extern void test_pipe_put_unreach_data(void);
 extern void test_pipe_put_unreach_size(void);
 extern void test_pipe_read_avail_null(void);
 extern void test_pipe_write_avail_null(void);
+extern void test_pipe_user_claim(void);
+extern void test_pipe_user_claim_unreach(void);
 #endif
 
 extern void test_pipe_avail_r_lt_w(void);
@@ -50,7 +54,7 @@ extern void test_pipe_avail_r_eq_w_empty(void);
 extern void test_pipe_avail_no_buffer(void);
 
 /* k objects */
-extern struct k_pipe pipe, kpipe, khalfpipe, put_get_pipe;
+extern struct k_pipe pipe, kpipe, khalfpipe, put_get_pipe, user_claim_pipe;
 extern struct k_sem end_sema;
 extern struct k_stack tstack;
 extern struct k_thread tdata;
@@ -76,6 +80,8 @@ dummy_test(test_pipe_put_unreach_data);
 dummy_test(test_pipe_put_unreach_size);
 dummy_test(test_pipe_read_avail_null);
 dummy_test(test_pipe_write_avail_null);
+dummy_test(test_pipe_user_claim);
+dummy_test(test_pipe_user_claim_unreach);
 #endif /* !CONFIG_USERSPACE */
 
 /*test case main entry*/
@@ -83,7 +89,7 @@ void test_main(void)
 {
 	k_thread_access_grant(k_current_get(), &pipe,
 			      &kpipe, &end_sema, &tdata, &tstack,
-			      &khalfpipe, &put_get_pipe);
+			      &khalfpipe, &put_get_pipe, &user_claim_pipe);
 
 	k_thread_heap_assign(k_current_get(), &test_pool);
 
@@ -114,6 +120,10 @@ void test_main(void)
 			 ztest_unit_test(test_pipe_avail_w_lt_r),
 			 ztest_unit_test(test_pipe_avail_r_eq_w_full),
 			 ztest_unit_test(test_pipe_avail_r_eq_w_empty),
-			 ztest_unit_test(test_pipe_avail_no_buffer));
+			 ztest_unit_test(test_pipe_avail_no_buffer),
+			 ztest_unit_test(test_pipe_claim),
+			 ztest_1cpu_unit_test(test_pipe_claim_stream),
+			 ztest_user_unit_test(test_pipe_user_claim),
+			 ztest_user_unit_test(test_pipe_user_claim_unreach));
 	ztest_run_test_suite(pipe_api);
 }
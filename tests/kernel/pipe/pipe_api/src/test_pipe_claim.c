@@ -0,0 +1,208 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <ztest_error_hook.h>
+
+#define STACK_SIZE	(1024 + CONFIG_TEST_EXTRA_STACKSIZE)
+#define TIMEOUT		K_MSEC(100)
+#define CLAIM_PIPE_LEN	16
+#define STREAM_LEN	256
+#define CHUNK_LEN	5
+
+/* Pipes whose buffer user mode threads can access */
+#define CLAIM_PIPE_DEFINE(name)						\
+	static ZTEST_BMEM unsigned char __aligned(4)			\
+		name##_buf[CLAIM_PIPE_LEN];				\
+	STRUCT_SECTION_ITERABLE(k_pipe, name) =				\
+		Z_PIPE_INITIALIZER(name, name##_buf, CLAIM_PIPE_LEN)
+
+CLAIM_PIPE_DEFINE(claim_pipe);
+CLAIM_PIPE_DEFINE(user_claim_pipe);
+
+static ZTEST_DMEM unsigned char __aligned(4) data[] =
+"abcdefghijklmnopqrstuvwxyz";
+
+extern struct k_pipe kpipe;
+K_THREAD_STACK_EXTERN(tstack);
+extern struct k_thread tdata;
+
+static void claim_basic(struct k_pipe *p)
+{
+	unsigned char out[CLAIM_PIPE_LEN];
+	uint8_t *ptr;
+	size_t claimed, rd_byte;
+
+	/**TESTPOINT: claiming data in an empty pipe fails or times out */
+	zassert_equal(k_pipe_get_claim(p, &ptr, 1, &claimed, K_NO_WAIT),
+		      -EIO, NULL);
+	zassert_equal(k_pipe_get_claim(p, &ptr, 1, &claimed, TIMEOUT),
+		      -EAGAIN, NULL);
+	zassert_equal(k_pipe_put_claim(p, &ptr, 0, &claimed, K_NO_WAIT),
+		      -EINVAL, NULL);
+
+	/**TESTPOINT: a commit may be smaller than the claim */
+	zassert_equal(k_pipe_put_claim(p, &ptr, 10, &claimed, K_NO_WAIT), 0,
+		      NULL);
+	zassert_equal(claimed, 10, NULL);
+	zassert_equal(k_pipe_put_claim(p, &ptr, 1, &claimed, K_NO_WAIT),
+		      -EBUSY, NULL);
+	memcpy(ptr, data, 6);
+	zassert_equal(k_pipe_put_commit(p, 11), -EINVAL, NULL);
+	zassert_equal(k_pipe_put_commit(p, 6), 0, NULL);
+	zassert_equal(k_pipe_put_commit(p, 0), -EINVAL, NULL);
+	zassert_equal(k_pipe_read_avail(p), 6, NULL);
+
+	/**TESTPOINT: claims end where the ring buffer wraps around */
+	zassert_equal(k_pipe_put_claim(p, &ptr, CLAIM_PIPE_LEN, &claimed,
+				       K_NO_WAIT), 0, NULL);
+	zassert_equal(claimed, CLAIM_PIPE_LEN - 6, NULL);
+	memcpy(ptr, &data[6], claimed);
+	zassert_equal(k_pipe_put_commit(p, claimed), 0, NULL);
+	zassert_equal(k_pipe_put_claim(p, &ptr, 1, &claimed, K_NO_WAIT),
+		      -EIO, NULL);
+
+	/**TESTPOINT: data is read in place */
+	zassert_equal(k_pipe_get_claim(p, &ptr, 4, &claimed, K_NO_WAIT), 0,
+		      NULL);
+	zassert_equal(claimed, 4, NULL);
+	zassert_equal(memcmp(ptr, data, 4), 0, NULL);
+	zassert_equal(k_pipe_get_commit(p, 4), 0, NULL);
+
+	zassert_equal(k_pipe_put_claim(p, &ptr, 8, &claimed, K_NO_WAIT), 0,
+		      NULL);
+	zassert_equal(claimed, 4, NULL);
+	memcpy(ptr, &data[CLAIM_PIPE_LEN], claimed);
+	zassert_equal(k_pipe_put_commit(p, claimed), 0, NULL);
+
+	/**TESTPOINT: claims and regular reads see the same data */
+	zassert_equal(k_pipe_get(p, out, CLAIM_PIPE_LEN, &rd_byte,
+				 CLAIM_PIPE_LEN, K_NO_WAIT), 0, NULL);
+	zassert_equal(rd_byte, CLAIM_PIPE_LEN, NULL);
+	zassert_equal(memcmp(out, &data[4], CLAIM_PIPE_LEN), 0, NULL);
+}
+
+static void claim_producer(void *p1, void *p2, void *p3)
+{
+	struct k_pipe *p = p1;
+	uint8_t *ptr;
+	size_t claimed;
+
+	for (size_t i = 0; i < STREAM_LEN; i += claimed) {
+		zassert_equal(k_pipe_put_claim(p, &ptr, STREAM_LEN - i,
+					       &claimed, K_FOREVER), 0, NULL);
+		for (size_t j = 0; j < claimed; j++) {
+			ptr[j] = (uint8_t)(i + j);
+		}
+		zassert_equal(k_pipe_put_commit(p, claimed), 0, NULL);
+	}
+}
+
+/* Alternate regular reads, which pend until a commit fills them, and
+ * claims, which pend until a commit makes data available.
+ */
+static void claim_consumer(struct k_pipe *p)
+{
+	unsigned char out[CHUNK_LEN];
+	uint8_t *ptr;
+	size_t i = 0, len;
+	bool claim = false;
+
+	while (i < STREAM_LEN) {
+		if (claim) {
+			zassert_equal(k_pipe_get_claim(p, &ptr, CHUNK_LEN,
+						       &len, K_FOREVER), 0,
+				      NULL);
+		} else {
+			zassert_equal(k_pipe_get(p, out,
+						 MIN(CHUNK_LEN, STREAM_LEN - i),
+						 &len, 1, K_FOREVER), 0, NULL);
+			ptr = out;
+		}
+
+		for (size_t j = 0; j < len; j++) {
+			zassert_equal(ptr[j], (uint8_t)(i + j), NULL);
+		}
+		if (claim) {
+			zassert_equal(k_pipe_get_commit(p, len), 0, NULL);
+		}
+
+		i += len;
+		claim = !claim;
+	}
+}
+
+/**
+ * @addtogroup kernel_pipe_tests
+ * @{
+ */
+
+/**
+ * @brief Test claiming space and data in a pipe's buffer
+ * @see k_pipe_put_claim(), k_pipe_put_commit(), k_pipe_get_claim(),
+ * k_pipe_get_commit()
+ */
+void test_pipe_claim(void)
+{
+	claim_basic(&claim_pipe);
+}
+
+/**
+ * @brief Test streaming data through a pipe with claims
+ *
+ * @details The producer writes in place and the consumer mixes regular
+ * reads and claims. With a higher priority producer, the producer waits for
+ * space to be freed, with a lower priority one, the consumer waits for data.
+ *
+ * @see k_pipe_put_claim(), k_pipe_put_commit(), k_pipe_get_claim(),
+ * k_pipe_get_commit(), k_pipe_get()
+ */
+void test_pipe_claim_stream(void)
+{
+	int prio[] = { K_PRIO_PREEMPT(0), K_PRIO_PREEMPT(2) };
+	int old_prio = k_thread_priority_get(k_current_get());
+
+	k_thread_priority_set(k_current_get(), K_PRIO_PREEMPT(1));
+
+	for (int i = 0; i < ARRAY_SIZE(prio); i++) {
+		k_thread_create(&tdata, tstack, STACK_SIZE, claim_producer,
+				&claim_pipe, NULL, NULL, prio[i], 0,
+				K_NO_WAIT);
+		claim_consumer(&claim_pipe);
+		k_thread_join(&tdata, K_FOREVER);
+		zassert_equal(k_pipe_read_avail(&claim_pipe), 0, NULL);
+	}
+
+	k_thread_priority_set(k_current_get(), old_prio);
+}
+
+#ifdef CONFIG_USERSPACE
+/**
+ * @brief Test claims from user mode on a pipe whose buffer it can access
+ * @see k_pipe_put_claim(), k_pipe_get_claim()
+ */
+void test_pipe_user_claim(void)
+{
+	claim_basic(&user_claim_pipe);
+}
+
+/**
+ * @brief Test claims from user mode on a pipe whose buffer it can't access
+ * @see k_pipe_put_claim()
+ */
+void test_pipe_user_claim_unreach(void)
+{
+	uint8_t *ptr;
+	size_t claimed;
+
+	ztest_set_fault_valid(true);
+	k_pipe_put_claim(&kpipe, &ptr, 1, &claimed, K_NO_WAIT);
+}
+#endif
+
+/**
+ * @}
+ */
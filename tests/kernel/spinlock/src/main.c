@@ -178,12 +178,18 @@ void test_spinlock_mutual_exclusion(void)
 extern void test_spinlock_no_recursive(void);
 extern void test_spinlock_unlock_error(void);
 extern void test_spinlock_release_error(void);
+extern void test_rwspinlock_basic(void);
+extern void test_rwspinlock_writer_exclusion(void);
+extern void test_rcu_synchronize(void);
 
 
 void test_main(void)
 {
 	ztest_test_suite(spinlock,
 			 ztest_unit_test(test_spinlock_basic),
+			 ztest_unit_test(test_rwspinlock_basic),
+			 ztest_unit_test(test_rwspinlock_writer_exclusion),
+			 ztest_unit_test(test_rcu_synchronize),
 			 ztest_unit_test(test_spinlock_bounce),
 			 ztest_unit_test(test_spinlock_mutual_exclusion),
 			 ztest_unit_test(test_spinlock_no_recursive),
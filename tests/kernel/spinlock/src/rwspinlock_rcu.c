@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2021 Intel Corporation.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <zephyr.h>
+#include <ztest.h>
+#include <spinlock.h>
+
+BUILD_ASSERT(CONFIG_MP_NUM_CPUS > 1);
+
+#define OTHER_STACK_SIZE 1024
+#define N_ROUNDS 2000
+#define RCU_VALID 0x5a5a5a5a
+
+K_THREAD_STACK_DEFINE(other_stack, OTHER_STACK_SIZE);
+static struct k_thread other_thread;
+
+static struct k_rwspinlock rwlock;
+static volatile int pair_a, pair_b;
+static volatile bool done;
+
+struct rcu_data {
+	volatile uint32_t valid;
+};
+
+static struct rcu_data rcu_buffers[2];
+static struct rcu_data *rcu_ptr;
+static volatile int rcu_reads;
+
+/**
+ * @brief Test basic reader-writer spinlock
+ *
+ * @ingroup kernel_spinlock_tests
+ *
+ * @see k_rwspin_read_lock(), k_rwspin_write_lock()
+ */
+void test_rwspinlock_basic(void)
+{
+	k_spinlock_key_t key;
+	static struct k_rwspinlock l;
+
+	key = k_rwspin_read_lock(&l);
+	zassert_equal(atomic_get(&l.state), 1, "Reader not counted");
+	k_rwspin_read_unlock(&l, key);
+	zassert_equal(atomic_get(&l.state), 0, "Reader not released");
+
+	key = k_rwspin_write_lock(&l);
+	zassert_equal(atomic_get(&l.state), Z_RWSPIN_WRITER,
+		      "Writer failed to lock");
+	k_rwspin_write_unlock(&l, key);
+	zassert_equal(atomic_get(&l.state), 0, "Writer failed to unlock");
+}
+
+static void writer_fn(void *p1, void *p2, void *p3)
+{
+	k_spinlock_key_t key;
+
+	for (int i = 0; !done; i++) {
+		key = k_rwspin_write_lock(&rwlock);
+		pair_a = i;
+		k_busy_wait(1);
+		pair_b = i;
+		k_rwspin_write_unlock(&rwlock, key);
+	}
+}
+
+/**
+ * @brief Test that readers never see a write in progress
+ *
+ * @details A thread on another CPU keeps updating two variables with
+ * the lock held for writing, while this thread checks with the lock
+ * held for reading that they are equal.
+ *
+ * @ingroup kernel_spinlock_tests
+ */
+void test_rwspinlock_writer_exclusion(void)
+{
+	k_spinlock_key_t key;
+	int a, b;
+
+	done = false;
+	k_thread_create(&other_thread, other_stack, OTHER_STACK_SIZE,
+			writer_fn, NULL, NULL, NULL, 0, 0, K_NO_WAIT);
+
+	for (int i = 0; i < N_ROUNDS; i++) {
+		key = k_rwspin_read_lock(&rwlock);
+		a = pair_a;
+		b = pair_b;
+		k_rwspin_read_unlock(&rwlock, key);
+
+		zassert_equal(a, b, "Reader saw a partial write");
+	}
+
+	done = true;
+	k_thread_join(&other_thread, K_FOREVER);
+}
+
+static void rcu_reader_fn(void *p1, void *p2, void *p3)
+{
+	struct rcu_data *data;
+	k_rcu_key_t key;
+
+	while (!done) {
+		key = k_rcu_read_lock();
+		data = k_rcu_dereference(rcu_ptr);
+		k_busy_wait(5);
+		zassert_equal(data->valid, RCU_VALID,
+			      "Reader saw reclaimed data");
+		k_rcu_read_unlock(key);
+		rcu_reads++;
+	}
+}
+
+/**
+ * @brief Test that k_rcu_synchronize() waits for readers
+ *
+ * @details A thread on another CPU keeps reading the data, while this
+ * thread publishes a new version, waits for the readers of the old
+ * version, and poisons it.
+ *
+ * @ingroup kernel_spinlock_tests
+ *
+ * @see k_rcu_read_lock(), k_rcu_synchronize()
+ */
+void test_rcu_synchronize(void)
+{
+	struct rcu_data *old;
+
+	rcu_buffers[0].valid = RCU_VALID;
+	rcu_ptr = &rcu_buffers[0];
+	rcu_reads = 0;
+
+	done = false;
+	k_thread_create(&other_thread, other_stack, OTHER_STACK_SIZE,
+			rcu_reader_fn, NULL, NULL, NULL, 0, 0, K_NO_WAIT);
+
+	for (int i = 1; i < N_ROUNDS; i++) {
+		old = rcu_ptr;
+		rcu_buffers[i % 2].valid = RCU_VALID;
+		k_rcu_assign_pointer(rcu_ptr, &rcu_buffers[i % 2]);
+
+		k_rcu_synchronize();
+		old->valid = 0;
+	}
+
+	done = true;
+	k_thread_join(&other_thread, K_FOREVER);
+
+	zassert_true(rcu_reads > 0, "Reader did not run");
+}
@@ -0,0 +1,376 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACKSIZE)
+#define POOL_PRIORITY K_PRIO_PREEMPT(1)
+#define N_THREADS 3
+#define N_ITEMS (4 * N_THREADS)
+#define SLOW_MS 10
+#define WAIT_TIMEOUT K_MSEC(1000)
+#define N_FEEDS 20
+
+/* The test thread is cooperative, so pool threads only run once it
+ * blocks: this keeps submission order deterministic.
+ */
+BUILD_ASSERT(CONFIG_ZTEST_THREAD_PRIORITY < 0,
+	     "ZTEST thread not cooperative");
+
+K_WORK_QUEUE_POOL_DEFINE(pool, N_THREADS, STACK_SIZE);
+
+/* Given by handlers when done. */
+static K_SEM_DEFINE(done_sem, 0, N_ITEMS);
+
+/* Given by blocking handlers when started, and taken by them to
+ * complete.
+ */
+static K_SEM_DEFINE(started_sem, 0, 1);
+static K_SEM_DEFINE(release_sem, 0, 1);
+
+struct test_item {
+	struct k_work work;
+	k_tid_t thread;
+};
+
+static struct test_item items[N_ITEMS];
+static struct k_work block_work;
+static struct k_work slow_work;
+static struct k_work resubmit_work;
+static struct k_work_delayable dwork;
+static struct k_work_sync work_sync;
+static struct k_work feed_work;
+
+static K_THREAD_STACK_DEFINE(feeder_stack, STACK_SIZE);
+static struct k_thread feeder_thread;
+
+static k_tid_t volatile blocked_thread;
+static atomic_t running;
+static atomic_t resubmits_left;
+static volatile bool slow_done;
+static atomic_t feeds_accepted;
+
+static void item_handler(struct k_work *work)
+{
+	struct test_item *item = CONTAINER_OF(work, struct test_item, work);
+
+	item->thread = k_current_get();
+	k_sem_give(&done_sem);
+}
+
+static void block_handler(struct k_work *work)
+{
+	blocked_thread = k_current_get();
+	k_sem_give(&started_sem);
+	k_sem_take(&release_sem, K_FOREVER);
+	k_sem_give(&done_sem);
+}
+
+static void slow_handler(struct k_work *work)
+{
+	k_sem_give(&started_sem);
+	k_msleep(SLOW_MS);
+	slow_done = true;
+	k_sem_give(&done_sem);
+}
+
+static void resubmit_handler(struct k_work *work)
+{
+	zassert_equal(atomic_inc(&running), 0, "handler re-entered");
+
+	if (atomic_dec(&resubmits_left) > 0) {
+		zassert_true(k_work_submit_to_pool(&pool, work) >= 0, NULL);
+	}
+
+	/* Give the other pool threads a chance to pick it up */
+	k_msleep(1);
+
+	atomic_dec(&running);
+	k_sem_give(&done_sem);
+}
+
+static void delayed_handler(struct k_work *work)
+{
+	k_sem_give(&done_sem);
+}
+
+static void feed_handler(struct k_work *work)
+{
+}
+
+/* Keep submitting work to the pool, releasing the blocked pool thread
+ * part way through.
+ */
+static void feeder(void *p1, void *p2, void *p3)
+{
+	for (int i = 0; i < N_FEEDS; i++) {
+		if (i == N_FEEDS / 4) {
+			k_sem_give(&release_sem);
+		}
+
+		if (k_work_submit_to_pool(&pool, &feed_work) == 1) {
+			atomic_inc(&feeds_accepted);
+		}
+
+		k_msleep(1);
+	}
+}
+
+static bool is_pool_thread(k_tid_t thread)
+{
+	for (int i = 0; i < N_THREADS; i++) {
+		if (thread == k_work_queue_thread_get(&pool.queues[i])) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/* Block a pool thread, returning its queue. */
+static struct k_work_q *pool_block(void)
+{
+	k_work_init(&block_work, block_handler);
+	zassert_equal(k_work_submit_to_pool(&pool, &block_work), 1, NULL);
+	zassert_equal(k_sem_take(&started_sem, WAIT_TIMEOUT), 0, NULL);
+
+	for (int i = 0; i < N_THREADS; i++) {
+		if (blocked_thread ==
+		    k_work_queue_thread_get(&pool.queues[i])) {
+			return &pool.queues[i];
+		}
+	}
+
+	zassert_unreachable("blocked thread not in the pool");
+
+	return NULL;
+}
+
+static void items_init(void)
+{
+	for (int i = 0; i < N_ITEMS; i++) {
+		k_work_init(&items[i].work, item_handler);
+		items[i].thread = NULL;
+	}
+}
+
+static void done_wait(int count)
+{
+	for (int i = 0; i < count; i++) {
+		zassert_equal(k_sem_take(&done_sem, WAIT_TIMEOUT), 0,
+			      "work %d did not complete", i);
+	}
+}
+
+/* Wait for the handler of a work item to return: handlers give done_sem
+ * before returning, and the cooperative test thread runs as soon as they
+ * do, so the work item can still be running.
+ */
+static void idle_wait(struct k_work *work)
+{
+	(void)k_work_flush(work, &work_sync);
+	zassert_equal(k_work_busy_get(work), 0, NULL);
+}
+
+/* Check that the pool accepts, runs and completes work, spreading it
+ * over its threads.
+ */
+static void test_pool_submit(void)
+{
+	items_init();
+
+	for (int i = 0; i < N_ITEMS; i++) {
+		zassert_equal(k_work_submit_to_pool(&pool, &items[i].work), 1,
+			      NULL);
+	}
+
+	done_wait(N_ITEMS);
+
+	for (int i = 0; i < N_ITEMS; i++) {
+		zassert_true(is_pool_thread(items[i].thread),
+			     "item %d not run by the pool", i);
+		idle_wait(&items[i].work);
+	}
+}
+
+/* Check that work queued behind a blocked handler is taken by the
+ * other pool threads.
+ */
+static void test_pool_steal(void)
+{
+	struct k_work_q *blocked = pool_block();
+
+	items_init();
+
+	for (int i = 0; i < N_ITEMS; i++) {
+		zassert_equal(k_work_submit_to_queue(blocked, &items[i].work),
+			      1, NULL);
+	}
+
+	done_wait(N_ITEMS);
+
+	for (int i = 0; i < N_ITEMS; i++) {
+		zassert_true(is_pool_thread(items[i].thread), NULL);
+		zassert_not_equal(items[i].thread,
+				  k_work_queue_thread_get(blocked),
+				  "item %d run by the blocked thread", i);
+	}
+
+	k_sem_give(&release_sem);
+	done_wait(1);
+}
+
+/* Check that a work item resubmitted while running is never run by two
+ * pool threads at once.
+ */
+static void test_pool_no_reentrancy(void)
+{
+	int runs = 2 * N_THREADS;
+
+	k_work_init(&resubmit_work, resubmit_handler);
+	atomic_set(&running, 0);
+	atomic_set(&resubmits_left, runs - 1);
+
+	zassert_equal(k_work_submit_to_pool(&pool, &resubmit_work), 1, NULL);
+	done_wait(runs);
+
+	idle_wait(&resubmit_work);
+}
+
+/* Check that flushing waits for a work item taken by another thread
+ * together with its flusher.
+ */
+static void test_pool_flush(void)
+{
+	struct k_work_q *blocked = pool_block();
+
+	k_work_init(&slow_work, slow_handler);
+	slow_done = false;
+
+	zassert_equal(k_work_submit_to_queue(blocked, &slow_work), 1, NULL);
+	zassert_true(k_work_flush(&slow_work, &work_sync), NULL);
+	zassert_true(slow_done, "flush returned before the handler");
+
+	zassert_equal(k_sem_take(&started_sem, K_NO_WAIT), 0, NULL);
+	k_sem_give(&release_sem);
+	done_wait(2);
+}
+
+/* Check synchronous cancellation of a running pool work item. */
+static void test_pool_cancel_sync(void)
+{
+	k_work_init(&slow_work, slow_handler);
+	slow_done = false;
+
+	zassert_equal(k_work_submit_to_pool(&pool, &slow_work), 1, NULL);
+	zassert_equal(k_sem_take(&started_sem, WAIT_TIMEOUT), 0, NULL);
+
+	zassert_true(k_work_cancel_sync(&slow_work, &work_sync), NULL);
+	zassert_true(slow_done, "cancel returned before the handler");
+	zassert_equal(k_work_busy_get(&slow_work), 0, NULL);
+	done_wait(1);
+}
+
+/* Check delayed submission to the pool. */
+static void test_pool_delayable(void)
+{
+	uint32_t start;
+
+	k_work_init_delayable(&dwork, delayed_handler);
+
+	start = k_uptime_get_32();
+	zassert_equal(k_work_schedule_for_pool(&pool, &dwork,
+					       K_MSEC(SLOW_MS)), 1, NULL);
+	zassert_equal(k_work_schedule_for_pool(&pool, &dwork, K_NO_WAIT), 0,
+		      NULL);
+	done_wait(1);
+	zassert_true(k_uptime_get_32() - start >= SLOW_MS, NULL);
+	(void)k_work_flush_delayable(&dwork, &work_sync);
+
+	zassert_equal(k_work_schedule_for_pool(&pool, &dwork,
+					       K_MSEC(10 * SLOW_MS)), 1, NULL);
+	zassert_equal(k_work_reschedule_for_pool(&pool, &dwork, K_NO_WAIT), 1,
+		      NULL);
+	zassert_equal(k_sem_take(&done_sem, K_MSEC(SLOW_MS)), 0, NULL);
+
+	zassert_equal(k_work_schedule_for_pool(&pool, &dwork,
+					       K_MSEC(SLOW_MS)), 1, NULL);
+	zassert_true(k_work_cancel_delayable_sync(&dwork, &work_sync), NULL);
+	zassert_equal(k_sem_take(&done_sem, K_MSEC(2 * SLOW_MS)), -EAGAIN,
+		      NULL);
+}
+
+/* Check draining and plugging of the whole pool. */
+static void test_pool_drain(void)
+{
+	items_init();
+
+	zassert_equal(k_work_queue_pool_unplug(&pool), -EALREADY, NULL);
+
+	for (int i = 0; i < N_ITEMS; i++) {
+		zassert_equal(k_work_submit_to_pool(&pool, &items[i].work), 1,
+			      NULL);
+	}
+
+	zassert_equal(k_work_queue_pool_drain(&pool, true), 1, NULL);
+
+	for (int i = 0; i < N_ITEMS; i++) {
+		zassert_not_null(items[i].thread, "item %d not drained", i);
+	}
+
+	zassert_equal(k_work_submit_to_pool(&pool, &items[0].work), -EBUSY,
+		      NULL);
+	zassert_equal(k_work_queue_pool_unplug(&pool), 0, NULL);
+	zassert_equal(k_work_queue_pool_unplug(&pool), -EALREADY, NULL);
+
+	done_wait(N_ITEMS);
+	zassert_equal(k_work_submit_to_pool(&pool, &items[0].work), 1, NULL);
+	done_wait(1);
+}
+
+/* Check that a drain without plugging completes while work keeps coming,
+ * rejecting it until the whole pool has drained.
+ */
+static void test_pool_drain_busy(void)
+{
+	atomic_val_t accepted;
+
+	(void)pool_block();
+
+	k_work_init(&feed_work, feed_handler);
+	atomic_set(&feeds_accepted, 0);
+	k_thread_create(&feeder_thread, feeder_stack, STACK_SIZE, feeder,
+			NULL, NULL, NULL, K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+
+	zassert_equal(k_work_queue_pool_drain(&pool, false), 1, NULL);
+	accepted = atomic_get(&feeds_accepted);
+	done_wait(1);
+
+	k_thread_join(&feeder_thread, K_FOREVER);
+	idle_wait(&feed_work);
+
+	zassert_equal(accepted, 0, "%ld submissions accepted while draining",
+		      (long)accepted);
+	zassert_true(atomic_get(&feeds_accepted) > 0,
+		     "submissions rejected after draining");
+	zassert_equal(k_work_queue_pool_unplug(&pool), -EALREADY, NULL);
+}
+
+void test_main(void)
+{
+	k_work_queue_pool_start(&pool, POOL_PRIORITY, NULL);
+
+	ztest_test_suite(work_queue_pool,
+			 ztest_unit_test(test_pool_submit),
+			 ztest_unit_test(test_pool_steal),
+			 ztest_unit_test(test_pool_no_reentrancy),
+			 ztest_unit_test(test_pool_flush),
+			 ztest_unit_test(test_pool_cancel_sync),
+			 ztest_unit_test(test_pool_delayable),
+			 ztest_unit_test(test_pool_drain),
+			 ztest_unit_test(test_pool_drain_busy));
+	ztest_run_test_suite(work_queue_pool);
+}
@@ -8,6 +8,7 @@
 #include <stdbool.h>
 #include <ztest.h>
 #include <data/json.h>
+#include <net/buf.h>
 
 struct test_nested {
 	int nested_int;
@@ -75,6 +76,31 @@ static const struct json_obj_descr obj_array_descr[] = {
 				 elt_descr, ARRAY_SIZE(elt_descr)),
 };
 
+/* Element with tail padding: 8 bytes, not the 12 of its members each
+ * padded to the alignment of the struct.
+ */
+struct flags {
+	int id;
+	bool on;
+	bool hot;
+};
+
+struct flags_array {
+	struct flags flags[3];
+	size_t num_flags;
+};
+
+static const struct json_obj_descr flags_descr[] = {
+	JSON_OBJ_DESCR_PRIM(struct flags, id, JSON_TOK_NUMBER),
+	JSON_OBJ_DESCR_PRIM(struct flags, on, JSON_TOK_TRUE),
+	JSON_OBJ_DESCR_PRIM(struct flags, hot, JSON_TOK_TRUE),
+};
+
+static const struct json_obj_descr flags_array_descr[] = {
+	JSON_OBJ_DESCR_OBJ_ARRAY(struct flags_array, flags, 3, num_flags,
+				 flags_descr, ARRAY_SIZE(flags_descr)),
+};
+
 
 struct array {
 	struct elt objects;
@@ -339,6 +365,32 @@ static void test_json_obj_arr_decoding(void)
 	}
 }
 
+static void test_json_obj_arr_elem_layout(void)
+{
+	char encoded[] = "{\"flags\":["
+		"{\"id\":1,\"on\":true,\"hot\":false},"
+		"{\"id\":2,\"on\":false,\"hot\":true},"
+		"{\"id\":3,\"on\":true,\"hot\":true}"
+		"]}";
+	struct flags_array fa;
+	int ret;
+
+	ret = json_obj_parse(encoded, sizeof(encoded) - 1, flags_array_descr,
+			     ARRAY_SIZE(flags_array_descr), &fa);
+
+	zassert_equal(ret, 1, "Array of padded objects decoded correctly");
+	zassert_equal(fa.num_flags, 3, "Number of objects decoded correctly");
+
+	for (int i = 0; i < fa.num_flags; i++) {
+		zassert_equal(fa.flags[i].id, i + 1,
+			      "Element %d decoded at its offset", i);
+		zassert_equal(fa.flags[i].on, i != 1,
+			      "Element %d first boolean decoded", i);
+		zassert_equal(fa.flags[i].hot, i != 0,
+			      "Element %d second boolean decoded", i);
+	}
+}
+
 struct encoding_test {
 	char *str;
 	int result;
@@ -546,9 +598,347 @@ static void test_json_encode_bounds_check(void)
 	zassert_equal(ret, 0, "Bounds check passed");
 	zassert_equal(strlen(buf), 9, "encoded value length");
 
+	memset(buf, 'x', sizeof(buf));
 	ret = json_obj_encode_buf(descr, ARRAY_SIZE(descr),
 				     &str, buf, 9);
 	zassert_equal(ret, -ENOMEM, "Bounds check rejected");
+	zassert_true(memchr(buf, '\0', 9) != NULL,
+		     "Partial output NUL terminated");
+	zassert_true(!strncmp(buf, "{\"val\":0}", strlen(buf)),
+		     "Partial output is a prefix of the encoded value");
+}
+
+NET_BUF_POOL_FIXED_DEFINE(json_pool, 1, 16, NULL);
+
+static void test_json_encode_net_buf(void)
+{
+	struct number {
+		uint32_t val;
+	} str = { 0 };
+	const struct json_obj_descr descr[] = {
+		JSON_OBJ_DESCR_PRIM(struct number, val, JSON_TOK_NUMBER),
+	};
+	/* Encodes to {"val":0} for a total of 9 bytes, without a NUL */
+	const char encoded[] = "{\"val\":0}";
+	struct net_buf *buf;
+	uint8_t *data;
+	ssize_t ret;
+
+	buf = net_buf_alloc(&json_pool, K_NO_WAIT);
+	zassert_not_null(buf, "Failed to allocate buffer");
+	zassert_equal(net_buf_tailroom(buf), 16, "Unexpected tail room");
+
+	/* Fits, appended after the existing data */
+	net_buf_add_mem(buf, "ab", 2);
+	ret = json_obj_encode_net_buf(descr, ARRAY_SIZE(descr), &str, buf);
+	zassert_equal(ret, 9, "Encoded length returned");
+	zassert_equal(buf->len, 11, "Buffer extended by the encoded length");
+	zassert_mem_equal(buf->data, "ab", 2, "Existing data preserved");
+	zassert_mem_equal(buf->data + 2, encoded, 9, "Encoded contents");
+
+	/* Fits exactly in the tail room */
+	net_buf_reset(buf);
+	memset(net_buf_add(buf, 7), 'a', 7);
+	ret = json_obj_encode_net_buf(descr, ARRAY_SIZE(descr), &str, buf);
+	zassert_equal(ret, 9, "Encoded length returned");
+	zassert_equal(buf->len, 16, "Tail room used up");
+	zassert_equal(net_buf_tailroom(buf), 0, "Tail room used up");
+	zassert_mem_equal(buf->data + 7, encoded, 9, "Encoded contents");
+
+	/* One byte short, the buffer is left unchanged */
+	net_buf_reset(buf);
+	memset(net_buf_add(buf, 8), 'a', 8);
+	data = buf->data;
+	ret = json_obj_encode_net_buf(descr, ARRAY_SIZE(descr), &str, buf);
+	zassert_equal(ret, -ENOMEM, "Bounds check rejected");
+	zassert_equal(buf->len, 8, "Buffer length unchanged");
+	zassert_equal_ptr(buf->data, data, "Buffer data unchanged");
+	zassert_mem_equal(buf->data, "aaaaaaaa", 8, "Buffer contents unchanged");
+
+	net_buf_unref(buf);
+}
+
+struct collector {
+	char buf[256];
+	size_t used;
+	int calls;
+};
+
+static int collect_bytes(const char *bytes, size_t len, void *data)
+{
+	struct collector *collector = data;
+
+	if (len >= sizeof(collector->buf) - collector->used) {
+		return -ENOMEM;
+	}
+
+	memcpy(&collector->buf[collector->used], bytes, len);
+	collector->used += len;
+	collector->buf[collector->used] = '\0';
+	collector->calls++;
+
+	return 0;
+}
+
+static void test_json_encode_single_pass(void)
+{
+	struct test_nested nested = {
+		.nested_int = INT32_MIN,
+		.nested_bool = true,
+		.nested_string = "a long string with \"quotes\", a \\ and a\n"
+				 "line break, long enough to need more than "
+				 "one flush of the staging buffer",
+	};
+	const char encoded[] = "{\"nested_int\":-2147483648,"
+		"\"nested_bool\":true,"
+		"\"nested_string\":\"a long string with \\\"quotes\\\", a \\\\ "
+		"and a\\nline break, long enough to need more than one flush "
+		"of the staging buffer\"}";
+	struct collector collector = { 0 };
+	char buf[sizeof(encoded)];
+	ssize_t len;
+	int ret;
+
+	memset(buf, 'x', sizeof(buf));
+	len = json_obj_encode_buf_len(nested_descr, ARRAY_SIZE(nested_descr),
+				      &nested, buf, 16);
+	zassert_equal(len, sizeof(encoded) - 1,
+		      "Exact size returned when the buffer is too small");
+	zassert_true(memchr(buf, '\0', 16) != NULL,
+		     "Partial output NUL terminated");
+	zassert_true(!strncmp(buf, encoded, strlen(buf)),
+		     "Partial output is a prefix of the encoded value");
+
+	len = json_obj_encode_buf_len(nested_descr, ARRAY_SIZE(nested_descr),
+				      &nested, buf, sizeof(buf));
+	zassert_equal(len, sizeof(encoded) - 1, "Encoded size returned");
+	zassert_true(!strcmp(buf, encoded), "Encoded contents consistent");
+
+	ret = json_obj_encode(nested_descr, ARRAY_SIZE(nested_descr),
+			      &nested, collect_bytes, &collector);
+	zassert_equal(ret, 0, "Encoding with a callback returned no errors");
+	zassert_true(!strcmp(collector.buf, encoded),
+		     "Callback encoded contents consistent");
+	zassert_true(collector.calls < 8, "Output appended in spans");
+}
+
+static void test_json_encode_buf_len_error(void)
+{
+	struct pair {
+		int first;
+		int second;
+	} pair = { .first = 1 };
+	/* The second field cannot be encoded */
+	const struct json_obj_descr descr[] = {
+		JSON_OBJ_DESCR_PRIM(struct pair, first, JSON_TOK_NUMBER),
+		JSON_OBJ_DESCR_PRIM(struct pair, second, JSON_TOK_NULL),
+	};
+	char buf[32];
+	ssize_t len;
+
+	memset(buf, 'x', sizeof(buf));
+	len = json_obj_encode_buf_len(descr, ARRAY_SIZE(descr), &pair, buf,
+				      sizeof(buf));
+	zassert_equal(len, -EINVAL, "Encoding error returned");
+	zassert_true(memchr(buf, '\0', sizeof(buf)) != NULL,
+		     "Output up to the error NUL terminated");
+	zassert_true(!strcmp(buf, "{\"first\":1,\"second\":"),
+		     "Output up to the error kept");
+}
+
+static int stream_parse_chunked(const char *encoded, size_t len,
+				size_t chunk_size,
+				const struct json_obj_descr *descr,
+				size_t descr_len, void *val)
+{
+	static char str_buf[256];
+	struct json_obj_stream stream;
+	int ret = -EAGAIN;
+
+	json_obj_stream_init(&stream, descr, descr_len, val, str_buf,
+			     sizeof(str_buf));
+
+	for (size_t pos = 0; pos < len; pos += chunk_size) {
+		ret = json_obj_stream_parse(&stream, &encoded[pos],
+					    MIN(chunk_size, len - pos));
+		if (ret != -EAGAIN) {
+			break;
+		}
+	}
+
+	return ret;
+}
+
+static void test_json_stream_decoding(void)
+{
+	const char encoded[] = "{\"some_string\":\"zephyr 123\\uABCD456\","
+		"\"some_int\":\t42\n,"
+		"\"some_bool\":true    \t  \n\r   ,"
+		"\"some_nested_struct\":{    "
+		"\"nested_int\":-1234,\n\n"
+		"\"nested_bool\":false,\t"
+		"\"nested_string\":\"this should be escaped: \\t\"},"
+		"\"some_array\":[11,22, 33,\t45,\n299],"
+		"\"another_b!@l\":true,"
+		"\"if\":false,"
+		"\"another-array\":[2,3,5,7],"
+		"\"4nother_ne$+\":{\"nested_int\":1234,"
+		"\"nested_bool\":true,"
+		"\"nested_string\":\"no escape necessary\"}"
+		"}\n";
+	const int expected_array[] = { 11, 22, 33, 45, 299 };
+	const size_t chunk_sizes[] = { 1, 2, 7, 64, sizeof(encoded) };
+	struct test_struct ts;
+	int ret;
+
+	for (int i = 0; i < ARRAY_SIZE(chunk_sizes); i++) {
+		memset(&ts, 0, sizeof(ts));
+
+		ret = stream_parse_chunked(encoded, sizeof(encoded) - 1,
+					   chunk_sizes[i], test_descr,
+					   ARRAY_SIZE(test_descr), &ts);
+
+		zassert_equal(ret, (1 << ARRAY_SIZE(test_descr)) - 1,
+			      "All fields decoded with %zu byte chunks",
+			      chunk_sizes[i]);
+		zassert_true(!strcmp(ts.some_string, "zephyr 123\\uABCD456"),
+			     "String decoded correctly");
+		zassert_equal(ts.some_int, 42,
+			      "Positive integer decoded correctly");
+		zassert_equal(ts.some_bool, true, "Boolean decoded correctly");
+		zassert_equal(ts.some_nested_struct.nested_int, -1234,
+			      "Nested negative integer decoded correctly");
+		zassert_true(!strcmp(ts.some_nested_struct.nested_string,
+				     "this should be escaped: \\t"),
+			     "Nested string decoded correctly");
+		zassert_equal(ts.some_array_len, 5,
+			      "Array has correct number of items");
+		zassert_true(!memcmp(ts.some_array, expected_array,
+				     sizeof(expected_array)),
+			     "Array decoded with expected values");
+		zassert_true(ts.another_bxxl,
+			     "Named boolean (special chars) decoded correctly");
+		zassert_equal(ts.another_array_len, 4,
+			      "Named array has correct number of items");
+		zassert_equal(ts.xnother_nexx.nested_int, 1234,
+			      "Named nested integer decoded correctly");
+		zassert_true(!strcmp(ts.xnother_nexx.nested_string,
+				     "no escape necessary"),
+			     "Named nested string decoded correctly");
+	}
+}
+
+static void test_json_stream_obj_arr_decoding(void)
+{
+	const char encoded[] = "{\"elements\":["
+		"{\"name\":\"Simón Bolívar\",\"height\":168},"
+		"{\"height\":160,\"name\":\"Muggsy Bogues\"},"
+		"{\"name\":\"Pelé\",\"height\":173}"
+		"]}";
+	struct obj_array oa;
+	int ret;
+
+	ret = stream_parse_chunked(encoded, sizeof(encoded) - 1, 3,
+				   obj_array_descr,
+				   ARRAY_SIZE(obj_array_descr), &oa);
+
+	zassert_equal(ret, 1, "Array of object fields decoded correctly");
+	zassert_equal(oa.num_elements, 3,
+		      "Number of object fields decoded correctly");
+	zassert_true(!strcmp(oa.elements[1].name, "Muggsy Bogues"),
+		     "Out of order field decoded correctly");
+	zassert_equal(oa.elements[2].height, 173,
+		      "Last element decoded correctly");
+}
+
+static void test_json_stream_skip_unknown(void)
+{
+	const char encoded[] = "{\"unknown\":{\"a\":[1,{\"b\":\"}]\"}],"
+		"\"c\":true,\"d\":null},\"nested_int\":7,\"other\":\"x\\\"y\","
+		"\"none\":null,\"deep\":[[[[[[[[[[[[null]]]]]]]]]]]],"
+		"\"nested_bool\":true}";
+	struct test_nested nested;
+	int ret;
+
+	ret = stream_parse_chunked(encoded, sizeof(encoded) - 1, 5,
+				   nested_descr, ARRAY_SIZE(nested_descr),
+				   &nested);
+
+	zassert_equal(ret, 0x3, "Unknown keys skipped, known decoded");
+	zassert_equal(nested.nested_int, 7, "Integer decoded correctly");
+	zassert_true(nested.nested_bool, "Boolean decoded correctly");
+}
+
+/* Objects nested in each other, all decoded to the same struct */
+struct link {
+	int value;
+};
+
+static const struct json_obj_descr link_descr[2];
+static const struct json_obj_descr link_descr[] = {
+	JSON_OBJ_DESCR_PRIM(struct link, value, JSON_TOK_NUMBER),
+	JSON_OBJ_DESCR_OBJECT_NAMED(struct link, "next", value, link_descr),
+};
+
+static void test_json_stream_skip_at_max_depth(void)
+{
+	const char encoded[] = "{\"next\":{\"next\":{\"next\":{\"next\":"
+		"{\"next\":{\"next\":{\"next\":"
+		"{\"unknown\":{\"a\":[1,{}]},\"value\":7}"
+		"}}}}}}}";
+	struct link link = { 0 };
+	int ret;
+
+	BUILD_ASSERT(JSON_STREAM_MAX_DEPTH == 8, "Nesting of the test object");
+
+	ret = stream_parse_chunked(encoded, sizeof(encoded) - 1, 4,
+				   link_descr, ARRAY_SIZE(link_descr), &link);
+
+	zassert_equal(ret, 0x2, "Deepest object parsed, result %d", ret);
+	zassert_equal(link.value, 7, "Deepest value decoded correctly");
+}
+
+static void test_json_stream_errors(void)
+{
+	struct encoding_test encoded[] = {
+		{ "{\"some_int\":\"str\"}", -EINVAL },
+		{ "{\"some_bool\":truX}", -EINVAL },
+		{ "{\"some_int\":null}", -EINVAL },
+		{ "{\"unknown\":nul}", -EINVAL },
+		{ "{\"some_array\":[1,null]}", -EINVAL },
+		{ "{\"some_int\":12a}", -EINVAL },
+		{ "[\"some_int\",1]", -EINVAL },
+		{ "{\"some_int\" 1}", -EINVAL },
+		{ "{\"some_array\":[1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,16,17]}",
+		  -ENOSPC },
+	};
+	struct json_obj_stream stream;
+	struct test_struct ts;
+	char str_buf[8];
+	int ret;
+
+	for (int i = 0; i < ARRAY_SIZE(encoded); i++) {
+		ret = stream_parse_chunked(encoded[i].str,
+					   strlen(encoded[i].str), 4,
+					   test_descr, ARRAY_SIZE(test_descr),
+					   &ts);
+		zassert_equal(ret, encoded[i].result,
+			      "Decoding '%s' result %d, expected %d",
+			      encoded[i].str, ret, encoded[i].result);
+	}
+
+	json_obj_stream_init(&stream, test_descr, ARRAY_SIZE(test_descr),
+			     &ts, str_buf, sizeof(str_buf));
+	ret = json_obj_stream_parse(&stream, "{\"some_string\":\"12345678\"}",
+				    26);
+	zassert_equal(ret, -ENOMEM, "String buffer bounds check rejected");
+	ret = json_obj_stream_parse(&stream, "}", 1);
+	zassert_equal(ret, -ENOMEM, "Error is sticky");
+
+	json_obj_stream_init(&stream, test_descr, ARRAY_SIZE(test_descr),
+			     &ts, str_buf, sizeof(str_buf));
+	ret = json_obj_stream_parse(&stream, "{\"some_int\":1", 13);
+	zassert_equal(ret, -EAGAIN, "Incomplete object needs more data");
 }
 
 void test_main(void)
@@ -559,6 +949,7 @@ void test_main(void)
 			 ztest_unit_test(test_json_decoding_array_array),
 			 ztest_unit_test(test_json_obj_arr_encoding),
 			 ztest_unit_test(test_json_obj_arr_decoding),
+			 ztest_unit_test(test_json_obj_arr_elem_layout),
 			 ztest_unit_test(test_json_invalid_string),
 			 ztest_unit_test(test_json_invalid_bool),
 			 ztest_unit_test(test_json_invalid_null),
@@ -572,7 +963,15 @@ void test_main(void)
 			 ztest_unit_test(test_json_escape_empty),
 			 ztest_unit_test(test_json_escape_no_op),
 			 ztest_unit_test(test_json_escape_bounds_check),
-			 ztest_unit_test(test_json_encode_bounds_check)
+			 ztest_unit_test(test_json_encode_bounds_check),
+			 ztest_unit_test(test_json_encode_net_buf),
+			 ztest_unit_test(test_json_encode_single_pass),
+			 ztest_unit_test(test_json_encode_buf_len_error),
+			 ztest_unit_test(test_json_stream_decoding),
+			 ztest_unit_test(test_json_stream_obj_arr_decoding),
+			 ztest_unit_test(test_json_stream_skip_unknown),
+			 ztest_unit_test(test_json_stream_skip_at_max_depth),
+			 ztest_unit_test(test_json_stream_errors)
 			 );
 
 	ztest_run_test_suite(lib_json_test);
@@ -13,6 +13,7 @@ extern void test_posix_normal_mutex(void);
 extern void test_posix_recursive_mutex(void);
 extern void test_posix_semaphore(void);
 extern void test_posix_rw_lock(void);
+extern void test_posix_rw_lock_writer_preference(void);
 extern void test_posix_realtime(void);
 extern void test_posix_timer(void);
 extern void test_posix_pthread_execution(void);
@@ -21,6 +22,7 @@ extern void test_posix_pthread_create_negative(void);
 extern void test_posix_pthread_termination(void);
 extern void test_posix_multiple_threads_single_key(void);
 extern void test_posix_single_thread_multiple_keys(void);
+extern void test_posix_key_reuse(void);
 extern void test_nanosleep_NULL_NULL(void);
 extern void test_nanosleep_NULL_notNULL(void);
 extern void test_nanosleep_notNULL_NULL(void);
@@ -45,6 +47,7 @@ void test_main(void)
 			ztest_unit_test(test_posix_pthread_termination),
 			ztest_unit_test(test_posix_multiple_threads_single_key),
 			ztest_unit_test(test_posix_single_thread_multiple_keys),
+			ztest_unit_test(test_posix_key_reuse),
 			ztest_unit_test(test_posix_clock),
 			ztest_unit_test(test_posix_semaphore),
 			ztest_unit_test(test_posix_normal_mutex),
@@ -53,6 +56,7 @@ void test_main(void)
 			ztest_unit_test(test_posix_realtime),
 			ztest_unit_test(test_posix_timer),
 			ztest_unit_test(test_posix_rw_lock),
+			ztest_unit_test(test_posix_rw_lock_writer_preference),
 			ztest_unit_test(test_nanosleep_NULL_NULL),
 			ztest_unit_test(test_nanosleep_NULL_notNULL),
 			ztest_unit_test(test_nanosleep_notNULL_NULL),
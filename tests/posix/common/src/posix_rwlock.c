@@ -143,3 +143,53 @@ void test_posix_rw_lock(void)
 	zassert_false(pthread_rwlock_destroy(&rwlock),
 		      "Failed to destroy rwlock");
 }
+
+static void *thread_writer(void *p1)
+{
+	zassert_false(pthread_rwlock_wrlock(&rwlock),
+		      "Failed to acquire WR lock");
+	zassert_false(pthread_rwlock_unlock(&rwlock), "Failed to unlock");
+
+	return NULL;
+}
+
+/**
+ * @brief Test that a waiting writer gets the lock before new readers
+ */
+void test_posix_rw_lock_writer_preference(void)
+{
+	pthread_attr_t attr;
+	struct sched_param schedparam;
+	pthread_t newthread;
+
+	zassert_false(pthread_rwlock_init(&rwlock, NULL),
+		      "Failed to create rwlock");
+	zassert_false(pthread_rwlock_rdlock(&rwlock), "Failed to lock");
+
+	zassert_equal(pthread_attr_init(&attr), 0,
+		      "Unable to create pthread object attrib");
+	schedparam.sched_priority = 1;
+	pthread_attr_setschedparam(&attr, &schedparam);
+	pthread_attr_setstack(&attr, &stack[0][0], STACKSZ);
+	zassert_false(pthread_create(&newthread, &attr, thread_writer, NULL),
+		      "Low memory to thread new thread");
+
+	/* Let the writer block on the read lock held */
+	usleep(USEC_PER_MSEC);
+
+	zassert_equal(pthread_rwlock_tryrdlock(&rwlock), EBUSY,
+		      "Reader overtook a waiting writer");
+	zassert_equal(pthread_rwlock_destroy(&rwlock), EBUSY,
+		      "Destroyed a locked rwlock");
+
+	zassert_false(pthread_rwlock_unlock(&rwlock), "Failed to unlock");
+	zassert_false(pthread_join(newthread, NULL), "Failed to join");
+
+	zassert_false(pthread_rwlock_tryrdlock(&rwlock), "Failed to lock");
+	zassert_false(pthread_rwlock_unlock(&rwlock), "Failed to unlock");
+	zassert_equal(pthread_rwlock_unlock(&rwlock), EPERM,
+		      "Unlocked a rwlock not held");
+
+	zassert_false(pthread_rwlock_destroy(&rwlock),
+		      "Failed to destroy rwlock");
+}
@@ -212,3 +212,72 @@ void test_posix_single_thread_multiple_keys(void)
 	}
 	printk("\n");
 }
+
+static void *thread_key_reuse(void *p1)
+{
+	pthread_key_t all_keys[CONFIG_MAX_PTHREAD_KEY_COUNT];
+	pthread_key_t extra_key;
+	int i;
+
+	for (i = 0; i < CONFIG_MAX_PTHREAD_KEY_COUNT; i++) {
+		zassert_false(pthread_key_create(&all_keys[i], NULL),
+			      "attempt to create key failed");
+	}
+
+	/* TESTPOINT: Check that the number of keys is limited */
+	zassert_equal(pthread_key_create(&extra_key, NULL), EAGAIN,
+		      "created more keys than available");
+
+	zassert_false(pthread_setspecific(all_keys[0], &extra_key),
+		      "pthread_setspecific failed");
+	zassert_false(pthread_key_delete(all_keys[0]),
+		      "attempt to delete key failed");
+
+	/* TESTPOINT: Check that a deleted key is invalid */
+	zassert_equal(pthread_setspecific(all_keys[0], &extra_key), EINVAL,
+		      "value associated with a deleted key");
+	zassert_equal(pthread_key_delete(all_keys[0]), EINVAL,
+		      "deleted key deleted again");
+
+	/* TESTPOINT: Check that a reused key has no value */
+	zassert_false(pthread_key_create(&extra_key, NULL),
+		      "attempt to create key failed");
+	zassert_is_null(pthread_getspecific(extra_key),
+			"reused key kept the value of the deleted key");
+
+	zassert_false(pthread_key_delete(extra_key),
+		      "attempt to delete key failed");
+	for (i = 1; i < CONFIG_MAX_PTHREAD_KEY_COUNT; i++) {
+		zassert_false(pthread_key_delete(all_keys[i]),
+			      "attempt to delete key failed");
+	}
+
+	return NULL;
+}
+
+/**
+ * @brief Test pthread key reuse and limits
+ *
+ * @details A thread creates keys until none is left, checks that a
+ * deleted key is invalid and that its value is not visible through a
+ * key reusing it.
+ */
+void test_posix_key_reuse(void)
+{
+	pthread_attr_t attr;
+	struct sched_param schedparam;
+	pthread_t newthread;
+
+	zassert_false(pthread_attr_init(&attr),
+		      "Unable to create pthread object attr");
+
+	schedparam.sched_priority = 2;
+	pthread_attr_setschedparam(&attr, &schedparam);
+	pthread_attr_setstack(&attr, &stackp[0][0], STACKSZ);
+
+	zassert_false(pthread_create(&newthread, &attr, thread_key_reuse,
+				     NULL),
+		      "attempt to create thread failed");
+
+	pthread_join(newthread, NULL);
+}
@@ -158,12 +158,59 @@ void test_check_flash(void)
 	flash_area_close(ctx.flash_area);
 }
 
+/* Start another upload with a context while a block is being written */
+void test_reinit_during_write(void)
+{
+	static struct flash_img_context ctx;
+	static uint8_t data[2 * CONFIG_IMG_BLOCK_BUF_SIZE];
+	static uint8_t read_buf[sizeof(data)];
+	const struct flash_area *fa;
+	int ret;
+
+	for (int i = 0; i < sizeof(data); i++) {
+		data[i] = (uint8_t)i;
+	}
+
+	ret = flash_img_init(&ctx);
+	zassert_true(ret == 0, "Flash img init");
+	ret = flash_area_erase(ctx.flash_area, 0, ctx.flash_area->fa_size);
+	zassert_true(ret == 0, "Flash erase failure (%d)", ret);
+
+	ret = flash_area_open(FLASH_AREA_ID(image_1), &fa);
+	zassert_true(ret == 0, "Flash area open failure (%d)", ret);
+
+	/* With CONFIG_IMG_ASYNC_WRITE, the last block is still queued */
+	ret = flash_img_buffered_write(&ctx, data, sizeof(data), false);
+	zassert_true(ret == 0, "Flash img buffered write");
+
+	/* Which is written before the context is initialized again */
+	ret = flash_img_init(&ctx);
+	zassert_true(ret == 0, "Flash img init again");
+	ret = flash_area_read(fa, 0, read_buf, sizeof(read_buf));
+	zassert_true(ret == 0, "Flash read failure (%d)", ret);
+	zassert_mem_equal(read_buf, data, sizeof(data), "Blocks written");
+
+	ret = flash_area_erase(ctx.flash_area, 0, ctx.flash_area->fa_size);
+	zassert_true(ret == 0, "Flash erase failure (%d)", ret);
+	ret = flash_img_buffered_write(&ctx, data, sizeof(data), true);
+	zassert_true(ret == 0, "Flash img buffered write after init");
+	zassert_equal(flash_img_bytes_written(&ctx), sizeof(data),
+		      "Bytes written after init");
+
+	ret = flash_area_read(fa, 0, read_buf, sizeof(read_buf));
+	zassert_true(ret == 0, "Flash read failure (%d)", ret);
+	zassert_mem_equal(read_buf, data, sizeof(data), "Image written");
+
+	flash_area_close(fa);
+}
+
 void test_main(void)
 {
 	ztest_test_suite(test_util,
 			ztest_unit_test(test_collecting),
 			ztest_unit_test(test_init_id),
-			ztest_unit_test(test_check_flash)
+			ztest_unit_test(test_check_flash),
+			ztest_unit_test(test_reinit_during_write)
 			);
 	ztest_run_test_suite(test_util);
 }
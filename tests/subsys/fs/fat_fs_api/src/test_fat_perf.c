@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "test_fat.h"
+#include <stats/stats.h>
+#include <string.h>
+
+/*
+ * Benchmark of small file writes on the flash simulator, with and without
+ * CONFIG_DISK_FLASH_CACHE. Each file is created, written and closed, which
+ * syncs the disk. The time is the simulated time, which includes the flash
+ * operation times with CONFIG_FLASH_SIMULATOR_SIMULATE_TIMING.
+ */
+
+#define PERF_DIR	FATFS_MNTP"/perf"
+#define PERF_FILE_COUNT	32
+#define PERF_FILE_SIZE	2048
+
+static int flash_sim_erase_calls_find(struct stats_hdr *hdr, void *arg,
+				      const char *name, uint16_t off)
+{
+	if (!strcmp(name, "flash_erase_calls")) {
+		uint32_t **flash_erase_stat = (uint32_t **) arg;
+		*flash_erase_stat = (uint32_t *)((uint8_t *)hdr + off);
+	}
+
+	return 0;
+}
+
+static void perf_file_write(int i, const uint8_t *data)
+{
+	struct fs_file_t file;
+	char path[32];
+	ssize_t brw;
+	int res;
+
+	snprintk(path, sizeof(path), PERF_DIR"/f%d.bin", i);
+	fs_file_t_init(&file);
+
+	res = fs_open(&file, path, FS_O_CREATE | FS_O_WRITE);
+	zassert_equal(res, 0, "Failed opening %s [%d]", path, res);
+
+	brw = fs_write(&file, data, PERF_FILE_SIZE);
+	zassert_equal(brw, PERF_FILE_SIZE, "Failed writing %s [%zd]", path,
+		      brw);
+
+	res = fs_close(&file);
+	zassert_equal(res, 0, "Failed closing %s [%d]", path, res);
+}
+
+static void perf_file_check(int i, uint8_t *data)
+{
+	struct fs_file_t file;
+	char path[32];
+	ssize_t brw;
+	int res;
+
+	snprintk(path, sizeof(path), PERF_DIR"/f%d.bin", i);
+	fs_file_t_init(&file);
+
+	res = fs_open(&file, path, FS_O_READ);
+	zassert_equal(res, 0, "Failed opening %s [%d]", path, res);
+
+	(void)memset(data, 0, PERF_FILE_SIZE);
+	brw = fs_read(&file, data, PERF_FILE_SIZE);
+	zassert_equal(brw, PERF_FILE_SIZE, "Failed reading %s [%zd]", path,
+		      brw);
+
+	for (int j = 0; j < PERF_FILE_SIZE; j++) {
+		zassert_equal(data[j], (uint8_t)(i + j), "%s differs at %d",
+			      path, j);
+	}
+
+	res = fs_close(&file);
+	zassert_equal(res, 0, "Failed closing %s [%d]", path, res);
+
+	res = fs_unlink(path);
+	zassert_equal(res, 0, "Failed deleting %s [%d]", path, res);
+}
+
+void test_fat_perf(void)
+{
+	static uint8_t data[PERF_FILE_SIZE];
+	struct stats_hdr *sim_stats;
+	uint32_t *erase_calls = NULL;
+	uint32_t erases;
+	uint32_t elapsed;
+	int64_t start;
+	int res;
+
+	sim_stats = stats_group_find("flash_sim_stats");
+	if (!sim_stats) {
+		ztest_test_skip();
+	}
+
+	stats_walk(sim_stats, flash_sim_erase_calls_find, &erase_calls);
+	zassert_not_null(erase_calls, "Erase calls statistic not found");
+
+	res = fs_mkdir(PERF_DIR);
+	zassert_equal(res, 0, "Failed creating %s [%d]", PERF_DIR, res);
+
+	erases = *erase_calls;
+	start = k_uptime_get();
+
+	for (int i = 0; i < PERF_FILE_COUNT; i++) {
+		for (int j = 0; j < PERF_FILE_SIZE; j++) {
+			data[j] = i + j;
+		}
+
+		perf_file_write(i, data);
+	}
+
+	elapsed = k_uptime_get() - start;
+	erases = *erase_calls - erases;
+
+	TC_PRINT("Disk cache %s: %d files of %d bytes in %u ms\n",
+		 IS_ENABLED(CONFIG_DISK_FLASH_CACHE) ? "on" : "off",
+		 PERF_FILE_COUNT, PERF_FILE_SIZE, elapsed);
+	TC_PRINT("%u files/s, %u erases, %u erases/MB\n",
+		 (PERF_FILE_COUNT * 1000U) / MAX(elapsed, 1U), erases,
+		 (uint32_t)(((uint64_t)erases << 20) /
+			    (PERF_FILE_COUNT * PERF_FILE_SIZE)));
+
+	for (int i = 0; i < PERF_FILE_COUNT; i++) {
+		perf_file_check(i, data);
+	}
+
+	res = fs_unlink(PERF_DIR);
+	zassert_equal(res, 0, "Failed deleting %s [%d]", PERF_DIR, res);
+}
@@ -15,6 +15,7 @@
 #include <zephyr.h>
 #include <ztest.h>
 #include <fs/fs.h>
+#include <logging/log_backend_fs.h>
 
 #define DT_DRV_COMPAT zephyr_fstab_littlefs
 #define TEST_AUTOMOUNT DT_PROP(DT_DRV_INST(0), automount)
@@ -97,6 +98,7 @@ static void test_log_fs_file_content(void)
 	fs_file_t_init(&file);
 
 	rc = write_log_to_file(to_log, sizeof(to_log), NULL);
+	(void)log_backend_fs_flush();
 
 	sprintf(fname, "%s/%s0000", CONFIG_LOG_BACKEND_FS_DIR, log_prefix);
 
@@ -113,6 +115,7 @@ static void test_log_fs_file_content(void)
 
 	to_log[sizeof(to_log)-2] = '2';
 	rc = write_log_to_file(to_log, sizeof(to_log), NULL);
+	(void)log_backend_fs_flush();
 
 	zassert_equal(fs_open(&file, fname, FS_O_READ), 0,
 		      "Can not open log file.");
@@ -153,6 +156,7 @@ static void test_log_fs_file_size(void)
 		/* Written length not tracked here. */
 		ARG_UNUSED(rc);
 	}
+	(void)log_backend_fs_flush();
 
 	zassert_equal(fs_stat(fname, &entry), 0, "Can not get file info.");
 	size_t exp_size = CONFIG_LOG_BACKEND_FS_FILE_SIZE -
@@ -207,6 +211,7 @@ static void test_log_fs_files_max(void)
 		/* Written length not tracked here. */
 		ARG_UNUSED(rc);
 	}
+	(void)log_backend_fs_flush();
 
 	rc = fs_opendir(&dir, CONFIG_LOG_BACKEND_FS_DIR);
 	zassert_equal(rc, 0, "Can not open directory.");
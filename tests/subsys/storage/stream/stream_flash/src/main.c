@@ -644,6 +644,69 @@ static void test_stream_flash_progress_clear(void)
 #endif
 }
 
+#ifdef CONFIG_STREAM_FLASH_ASYNC
+static uint8_t async_buf[BUF_LEN];
+
+static void test_stream_flash_async_write(void)
+{
+	size_t total = page_size + BUF_LEN + BUF_LEN / 2;
+	size_t chunk = 100;
+	int rc;
+
+	init_target();
+
+	rc = stream_flash_async_enable(&ctx, async_buf);
+	zassert_equal(rc, 0, "expected success");
+
+	rc = stream_flash_async_enable(&ctx, async_buf);
+	zassert_equal(rc, -EALREADY, "expected failure when enabled twice");
+
+	for (size_t off = 0; off < total; off += chunk) {
+		rc = stream_flash_buffered_write(&ctx, write_buf,
+						 MIN(chunk, total - off),
+						 false);
+		zassert_equal(rc, 0, "expected success");
+	}
+
+	rc = stream_flash_async_wait(&ctx);
+	zassert_equal(rc, 0, "expected success");
+	zassert_equal(stream_flash_bytes_written(&ctx),
+		      total - total % BUF_LEN,
+		      "expected all full buffers to be written");
+
+	rc = stream_flash_buffered_write(&ctx, NULL, 0, true);
+	zassert_equal(rc, 0, "expected success");
+	zassert_equal(stream_flash_bytes_written(&ctx), total,
+		      "expected all data to be written after flush");
+
+	VERIFY_WRITTEN(0, total);
+	VERIFY_ERASED(total, BUF_LEN);
+
+	/* Errors of background writes are reported and stay reported */
+	init_target();
+
+	rc = stream_flash_async_enable(&ctx, async_buf);
+	zassert_equal(rc, 0, "expected success");
+
+	cb_ret = -EFAULT;
+	rc = stream_flash_buffered_write(&ctx, write_buf, BUF_LEN, false);
+	zassert_equal(rc, 0, "expected the error to be reported later");
+
+	rc = stream_flash_async_wait(&ctx);
+	zassert_equal(rc, -EFAULT, "expected failure from callback");
+
+	rc = stream_flash_buffered_write(&ctx, write_buf, BUF_LEN, true);
+	zassert_equal(rc, -EFAULT, "expected failure to be sticky");
+	zassert_equal(stream_flash_bytes_written(&ctx), 0,
+		      "expected failed buffer not to be accounted");
+}
+#else
+static void test_stream_flash_async_write(void)
+{
+	ztest_test_skip();
+}
+#endif /* CONFIG_STREAM_FLASH_ASYNC */
+
 void test_main(void)
 {
 	fdev = device_get_binding(FLASH_NAME);
@@ -667,7 +730,8 @@ void test_main(void)
 	     ztest_unit_test(test_stream_flash_bytes_written),
 	     ztest_unit_test(test_stream_flash_progress_api),
 	     ztest_unit_test(test_stream_flash_progress_resume),
-	     ztest_unit_test(test_stream_flash_progress_clear)
+	     ztest_unit_test(test_stream_flash_progress_clear),
+	     ztest_unit_test(test_stream_flash_async_write)
 	 );
 
 	ztest_run_test_suite(lib_stream_flash_test);
@@ -0,0 +1,202 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Per-CPU tracing buffer tests.
+ *
+ * Tracing itself is left disabled, so that the kernel does not emit
+ * events, and the tracing thread is never woken up: packets are written
+ * and read back through the tracing buffer API by the test only.
+ */
+
+#include <ztest.h>
+#include <kernel_structs.h>
+#include <tracing_core.h>
+#include <tracing_buffer.h>
+
+struct event {
+	uint32_t cpu;
+	uint32_t seq;
+};
+
+/* Buffer space taken by an event, including the packet header */
+#define EVENT_PKT_SIZE 16
+#define EVENTS_PER_BUFFER (CONFIG_TRACING_BUFFER_SIZE / EVENT_PKT_SIZE)
+
+#define EVENTS_PER_CPU 8
+#define N_EVENTS (EVENTS_PER_CPU * CONFIG_MP_NUM_CPUS)
+
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACKSIZE)
+
+static K_THREAD_STACK_ARRAY_DEFINE(emitter_stacks, CONFIG_MP_NUM_CPUS,
+				   STACK_SIZE);
+static struct k_thread emitter_threads[CONFIG_MP_NUM_CPUS];
+static struct k_sem emitter_sems[CONFIG_MP_NUM_CPUS];
+static K_SEM_DEFINE(done_sem, 0, 1);
+
+static uint32_t last_stamp;
+
+static bool event_put(uint32_t seq)
+{
+	struct event ev = { .seq = seq };
+	uint32_t ret;
+
+	TRACING_LOCK();
+	ev.cpu = _current_cpu->id;
+	ret = tracing_buffer_put((uint8_t *)&ev, sizeof(ev));
+	TRACING_UNLOCK();
+
+	return ret == sizeof(ev);
+}
+
+static bool event_get(struct event *ev)
+{
+	return tracing_buffer_get((uint8_t *)ev, sizeof(*ev)) == sizeof(*ev);
+}
+
+static void buffers_drain(void)
+{
+	struct event ev;
+
+	while (event_get(&ev)) {
+	}
+
+	zassert_true(tracing_buffer_is_empty(), NULL);
+}
+
+/*
+ * Emitters take turns, each one emitting the next event of the sequence
+ * once the cycle counter has moved past the stamp of the previous one.
+ */
+static void emitter(void *p1, void *p2, void *p3)
+{
+	int id = POINTER_TO_INT(p1);
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (uint32_t seq = id; seq < N_EVENTS; seq += CONFIG_MP_NUM_CPUS) {
+		k_sem_take(&emitter_sems[id], K_FOREVER);
+
+		while (k_cycle_get_32() == last_stamp) {
+			k_busy_wait(1);
+		}
+
+		zassert_true(event_put(seq), "Event %u dropped", seq);
+		last_stamp = k_cycle_get_32();
+
+		if (seq == N_EVENTS - 1) {
+			k_sem_give(&done_sem);
+		} else {
+			k_sem_give(&emitter_sems[(id + 1) %
+						 CONFIG_MP_NUM_CPUS]);
+		}
+	}
+}
+
+/**
+ * @brief Test that packets of all CPUs are read in timestamp order
+ */
+static void test_merge_order(void)
+{
+	uint32_t cpus_seen = 0;
+	struct event ev;
+
+	zassert_false(is_tracing_enabled(), "Tracing must be disabled");
+	buffers_drain();
+
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		k_sem_init(&emitter_sems[i], 0, 1);
+		k_thread_create(&emitter_threads[i], emitter_stacks[i],
+				STACK_SIZE, emitter, INT_TO_POINTER(i),
+				NULL, NULL, K_PRIO_PREEMPT(5), 0, K_FOREVER);
+#ifdef CONFIG_SCHED_CPU_MASK
+		zassert_equal(k_thread_cpu_mask_clear(&emitter_threads[i]), 0,
+			      NULL);
+		zassert_equal(k_thread_cpu_mask_enable(&emitter_threads[i], i),
+			      0, NULL);
+#endif
+		k_thread_start(&emitter_threads[i]);
+	}
+
+	k_sem_give(&emitter_sems[0]);
+	zassert_equal(k_sem_take(&done_sem, K_SECONDS(10)), 0,
+		      "Emitters did not finish");
+
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		k_thread_join(&emitter_threads[i], K_FOREVER);
+	}
+
+	for (uint32_t seq = 0; seq < N_EVENTS; seq++) {
+		zassert_true(event_get(&ev), "Event %u missing", seq);
+		zassert_equal(ev.seq, seq, "Event %u read instead of %u",
+			      ev.seq, seq);
+		cpus_seen |= BIT(ev.cpu);
+	}
+
+	zassert_false(event_get(&ev), "Unexpected event %u", ev.seq);
+
+	if (IS_ENABLED(CONFIG_SCHED_CPU_MASK)) {
+		zassert_equal(cpus_seen, BIT_MASK(CONFIG_MP_NUM_CPUS),
+			      "Events not emitted on every CPU");
+	}
+}
+
+/**
+ * @brief Test what a full buffer keeps
+ *
+ * In flight recorder mode the oldest packets are overwritten and the
+ * newest ones kept. Otherwise, new packets are dropped.
+ */
+static void test_buffer_full(void)
+{
+	uint32_t overwritten = tracing_buffer_overwritten_get();
+	uint32_t n_put = 0;
+	uint32_t first;
+	struct event ev;
+	unsigned int key;
+
+	buffers_drain();
+
+	/* Stay on one CPU, so that all events go to the same buffer */
+	key = arch_irq_lock();
+	for (uint32_t seq = 0; seq < 2 * EVENTS_PER_BUFFER; seq++) {
+		if (event_put(seq)) {
+			n_put++;
+		}
+	}
+	arch_irq_unlock(key);
+
+	if (IS_ENABLED(CONFIG_TRACING_BUFFER_OVERWRITE)) {
+		zassert_equal(n_put, 2 * EVENTS_PER_BUFFER,
+			      "Events dropped instead of overwritten");
+		zassert_equal(tracing_buffer_overwritten_get() - overwritten,
+			      EVENTS_PER_BUFFER, "Unexpected overwrite count");
+		first = EVENTS_PER_BUFFER;
+	} else {
+		zassert_equal(n_put, EVENTS_PER_BUFFER,
+			      "Unexpected number of events kept");
+		zassert_equal(tracing_buffer_overwritten_get(), 0, NULL);
+		first = 0;
+	}
+
+	for (uint32_t seq = first; seq < first + EVENTS_PER_BUFFER; seq++) {
+		zassert_true(event_get(&ev), "Event %u missing", seq);
+		zassert_equal(ev.seq, seq, "Event %u read instead of %u",
+			      ev.seq, seq);
+	}
+
+	zassert_false(event_get(&ev), "Unexpected event %u", ev.seq);
+}
+
+void test_main(void)
+{
+	ztest_test_suite(tracing_buffer,
+			 ztest_unit_test(test_merge_order),
+			 ztest_unit_test(test_buffer_full));
+
+	ztest_run_test_suite(tracing_buffer);
+}